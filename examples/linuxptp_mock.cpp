@@ -0,0 +1,454 @@
+// SPDX-License-Identifier: MIT
+/*
+ * RPi-AES67 - linuxptp Backend Check Against a Mock ptp4l
+ *
+ * Serves the ptp4l management protocol on a Unix-domain socket: answers
+ * PORT_DATA_SET, TIME_STATUS_NP, PARENT_DATA_SET, CURRENT_DATA_SET and
+ * TIME_PROPERTIES_DATA_SET, accepts SUBSCRIBE_EVENTS_NP and pushes port
+ * state and time sync notifications to subscribers. Checks that
+ * LinuxPTPClient decodes every response and notification, then runs
+ * PTPSync with the linuxptp backend against it, restarts the mock and
+ * checks that PTPSync holds over, reconnects, resubscribes and locks
+ * again. Any failed check fails the run.
+ */
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <getopt.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include "rpi_aes67/logger.h"
+#include "rpi_aes67/linuxptp_client.h"
+#include "rpi_aes67/ptp_sync.h"
+
+using namespace rpi_aes67;
+
+namespace {
+
+// Management message layout (see linuxptp_client.cpp)
+constexpr size_t HEADER_SIZE = 34;
+constexpr size_t TLV_OFFSET = 48;
+constexpr uint8_t MESSAGE_TYPE_MANAGEMENT = 0x0D;
+constexpr uint16_t TLV_MANAGEMENT = 0x0001;
+constexpr uint8_t ACTION_GET = 0;
+constexpr uint8_t ACTION_SET = 1;
+constexpr uint8_t ACTION_RESPONSE = 2;
+constexpr int NOTIFY_PORT_STATE = 0;
+constexpr int NOTIFY_TIME_SYNC = 1;
+
+// What the mock reports
+constexpr uint64_t GM_IDENTITY = 0x0200c0fffe000001ULL;
+constexpr uint64_t PORT_IDENTITY = 0x0200c0fffe0000aaULL;
+constexpr int64_t MASTER_OFFSET_NS = -42;
+constexpr double MEAN_PATH_DELAY_NS = 1500.5;
+constexpr uint16_t STEPS_REMOVED = 1;
+constexpr int8_t LOG_SYNC_INTERVAL = -3;
+constexpr int16_t UTC_OFFSET = 37;
+constexpr uint8_t GM_PRIORITY1 = 100;
+constexpr uint8_t GM_PRIORITY2 = 120;
+constexpr uint8_t GM_CLOCK_CLASS = 6;
+constexpr uint8_t GM_CLOCK_ACCURACY = 0x21;
+
+// Time sync notification interval (ptp4l sends one per Sync)
+constexpr auto NOTIFY_INTERVAL = std::chrono::milliseconds(125);
+
+struct MockOptions {
+    std::string socket_path = "/tmp/rpi-aes67-mock-ptp4l." + std::to_string(getpid());
+    double outage_s = 5.0;
+};
+
+void put16(uint8_t* p, uint16_t v) {
+    p[0] = static_cast<uint8_t>(v >> 8);
+    p[1] = static_cast<uint8_t>(v);
+}
+
+void put32(uint8_t* p, uint32_t v) {
+    put16(p, static_cast<uint16_t>(v >> 16));
+    put16(p + 2, static_cast<uint16_t>(v));
+}
+
+void put64(uint8_t* p, uint64_t v) {
+    put32(p, static_cast<uint32_t>(v >> 32));
+    put32(p + 4, static_cast<uint32_t>(v));
+}
+
+uint16_t get16(const uint8_t* p) {
+    return static_cast<uint16_t>((p[0] << 8) | p[1]);
+}
+
+/**
+ * @brief ptp4l stand-in on a Unix-domain datagram socket
+ */
+class MockPTP4L {
+public:
+    ~MockPTP4L() { stop(); }
+    
+    bool start(const std::string& path) {
+        path_ = path;
+        ::unlink(path_.c_str());
+        fd_ = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, path_.c_str(), sizeof(addr.sun_path) - 1);
+        if (fd_ < 0 || bind(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+            std::cerr << "Mock ptp4l: cannot bind " << path_ << ": " << strerror(errno) << "\n";
+            stop();
+            return false;
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            subscribers_.clear();
+        }
+        subscriptions_ = 0;
+        running_ = true;
+        thread_ = std::thread([this] { run(); });
+        return true;
+    }
+    
+    // Vanish like a dying ptp4l: the socket and its path go away
+    void stop() {
+        running_ = false;
+        if (thread_.joinable()) thread_.join();
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+            ::unlink(path_.c_str());
+        }
+    }
+    
+    // Change the port state and notify subscribers, as ptp4l does
+    void set_port_state(LinuxPTPPortState state) {
+        port_state_ = state;
+        notify(NOTIFY_PORT_STATE, PMC_PORT_DATA_SET);
+    }
+    
+    [[nodiscard]] uint32_t subscriptions() const { return subscriptions_; }
+
+private:
+    struct Subscriber {
+        sockaddr_un addr;
+        socklen_t length;
+        uint8_t events;
+    };
+    
+    void run() {
+        auto next_notify = std::chrono::steady_clock::now();
+        while (running_) {
+            pollfd pfd{fd_, POLLIN, 0};
+            if (poll(&pfd, 1, 10) > 0) {
+                uint8_t request[256];
+                sockaddr_un from{};
+                socklen_t from_length = sizeof(from);
+                ssize_t n = recvfrom(fd_, request, sizeof(request), MSG_DONTWAIT,
+                                     reinterpret_cast<sockaddr*>(&from), &from_length);
+                if (n >= static_cast<ssize_t>(TLV_OFFSET + 6)) {
+                    handle(request, static_cast<size_t>(n), from, from_length);
+                }
+            }
+            if (std::chrono::steady_clock::now() >= next_notify) {
+                notify(NOTIFY_TIME_SYNC, PMC_TIME_STATUS_NP);
+                next_notify += NOTIFY_INTERVAL;
+            }
+        }
+    }
+    
+    void handle(const uint8_t* request, size_t size, const sockaddr_un& from, socklen_t from_length) {
+        if ((request[0] & 0x0F) != MESSAGE_TYPE_MANAGEMENT || get16(request + TLV_OFFSET) != TLV_MANAGEMENT) {
+            return;
+        }
+        uint8_t action = request[46] & 0x0F;
+        uint16_t id = get16(request + TLV_OFFSET + 4);
+        
+        if (action == ACTION_SET && id == PMC_SUBSCRIBE_EVENTS_NP && size >= TLV_OFFSET + 6 + 2 + 1) {
+            // Duration is ignored: the run is shorter than any subscription
+            Subscriber subscriber{from, from_length, request[TLV_OFFSET + 6 + 2]};
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                subscribers_.push_back(subscriber);
+            }
+            subscriptions_++;
+            reply(request, id, request + TLV_OFFSET + 6, size - TLV_OFFSET - 6, from, from_length);
+            return;
+        }
+        if (action != ACTION_GET) return;
+        
+        uint8_t data[64];
+        size_t length = dataset(id, data);
+        if (length > 0) {
+            reply(request, id, data, length, from, from_length);
+        }
+    }
+    
+    // Management TLV data for a dataset; 0 if the mock does not serve it
+    size_t dataset(uint16_t id, uint8_t* p) const {
+        std::memset(p, 0, 64);
+        switch (id) {
+            case PMC_TIME_STATUS_NP:
+                put64(p, static_cast<uint64_t>(MASTER_OFFSET_NS));
+                put64(p + 8, static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count()));
+                put32(p + 38, 1);                       // gmPresent
+                put64(p + 42, GM_IDENTITY);
+                return 50;
+            
+            case PMC_CURRENT_DATA_SET:
+                put16(p, STEPS_REMOVED);
+                put64(p + 2, static_cast<uint64_t>(MASTER_OFFSET_NS * 65536));
+                put64(p + 10, static_cast<uint64_t>(static_cast<int64_t>(MEAN_PATH_DELAY_NS * 65536.0)));
+                return 18;
+            
+            case PMC_PORT_DATA_SET:
+                put64(p, PORT_IDENTITY);
+                put16(p + 8, 1);
+                p[10] = static_cast<uint8_t>(port_state_.load());
+                p[22] = static_cast<uint8_t>(LOG_SYNC_INTERVAL);
+                p[25] = 2;                              // versionNumber
+                return 26;
+            
+            case PMC_TIME_PROPERTIES_DATA_SET:
+                put16(p, static_cast<uint16_t>(UTC_OFFSET));
+                p[2] = 0x04;                            // currentUtcOffsetValid
+                p[3] = 0x20;                            // timeSource: GPS
+                return 4;
+            
+            case PMC_PARENT_DATA_SET:
+                put64(p, GM_IDENTITY);
+                put16(p + 8, 1);
+                p[18] = GM_PRIORITY1;
+                p[19] = GM_CLOCK_CLASS;
+                p[20] = GM_CLOCK_ACCURACY;
+                put16(p + 21, 0x4E5D);                  // offsetScaledLogVariance
+                p[23] = GM_PRIORITY2;
+                put64(p + 24, GM_IDENTITY);
+                return 32;
+            
+            default:
+                return 0;
+        }
+    }
+    
+    // Response (or notification, request == nullptr) for one management ID
+    void reply(const uint8_t* request, uint16_t id, const uint8_t* data, size_t size,
+               const sockaddr_un& to, socklen_t to_length) {
+        uint8_t message[TLV_OFFSET + 6 + 128] = {};
+        size_t length = TLV_OFFSET + 6 + size;
+        if (length > sizeof(message)) return;
+        
+        message[0] = MESSAGE_TYPE_MANAGEMENT;
+        message[1] = 0x02;
+        put16(message + 2, static_cast<uint16_t>(length));
+        message[4] = request ? request[4] : 0;
+        put64(message + 20, PORT_IDENTITY);
+        put16(message + 28, 1);
+        if (request) {
+            std::memcpy(message + 30, request + 30, 2);                 // sequenceId
+            std::memcpy(message + HEADER_SIZE, request + 20, 10);       // Back to the requester
+        } else {
+            std::memset(message + HEADER_SIZE, 0xFF, 10);
+        }
+        message[32] = 0x04;
+        message[33] = 0x7F;
+        message[46] = ACTION_RESPONSE;
+        
+        put16(message + TLV_OFFSET, TLV_MANAGEMENT);
+        put16(message + TLV_OFFSET + 2, static_cast<uint16_t>(2 + size));
+        put16(message + TLV_OFFSET + 4, id);
+        std::memcpy(message + TLV_OFFSET + 6, data, size);
+        sendto(fd_, message, length, MSG_DONTWAIT, reinterpret_cast<const sockaddr*>(&to), to_length);
+    }
+    
+    void notify(int event, uint16_t id) {
+        uint8_t data[64];
+        size_t length = dataset(id, data);
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& subscriber : subscribers_) {
+            if (subscriber.events & (1 << event)) {
+                reply(nullptr, id, data, length, subscriber.addr, subscriber.length);
+            }
+        }
+    }
+    
+    std::string path_;
+    int fd_ = -1;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<LinuxPTPPortState> port_state_{LinuxPTPPortState::Slave};
+    std::atomic<uint32_t> subscriptions_{0};
+    std::mutex mutex_;
+    std::vector<Subscriber> subscribers_;
+};
+
+bool check(bool ok, const std::string& what) {
+    std::cout << (ok ? "  ok    " : "  FAIL  ") << what << "\n";
+    return ok;
+}
+
+// Wait up to timeout for a condition, polling every 10 ms
+bool wait_for(std::chrono::milliseconds timeout, const std::function<bool()>& condition) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!condition()) {
+        if (std::chrono::steady_clock::now() >= deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return true;
+}
+
+// LinuxPTPClient against the mock: every response and both notifications
+bool check_client(MockPTP4L& mock, const MockOptions& options) {
+    std::cout << "LinuxPTPClient:\n";
+    LinuxPTPClient client;
+    bool ok = check(client.open(options.socket_path, 0), "connects");
+    
+    LinuxPTPStatus status;
+    uint32_t answered = 0;
+    const uint16_t ids[] = {PMC_PORT_DATA_SET, PMC_TIME_STATUS_NP, PMC_PARENT_DATA_SET,
+                            PMC_CURRENT_DATA_SET, PMC_TIME_PROPERTIES_DATA_SET};
+    for (uint16_t id : ids) {
+        client.get(id);
+        if (client.receive(status, 1000) == id) answered++;
+    }
+    ok &= check(answered == std::size(ids), "answers all five GETs");
+    ok &= check(status.port_state == LinuxPTPPortState::Slave &&
+                status.log_sync_interval == LOG_SYNC_INTERVAL, "PORT_DATA_SET decoded");
+    ok &= check(status.master_offset_ns == MASTER_OFFSET_NS && status.gm_present &&
+                status.gm_identity == GM_IDENTITY, "TIME_STATUS_NP decoded");
+    ok &= check(status.gm_priority1 == GM_PRIORITY1 && status.gm_priority2 == GM_PRIORITY2 &&
+                status.gm_clock_class == GM_CLOCK_CLASS && status.gm_clock_accuracy == GM_CLOCK_ACCURACY,
+                "PARENT_DATA_SET decoded");
+    ok &= check(status.steps_removed == STEPS_REMOVED && status.offset_from_master_ns == MASTER_OFFSET_NS &&
+                status.mean_path_delay_ns == MEAN_PATH_DELAY_NS, "CURRENT_DATA_SET decoded");
+    ok &= check(status.current_utc_offset == UTC_OFFSET && status.current_utc_offset_valid,
+                "TIME_PROPERTIES_DATA_SET decoded");
+    
+    // Subscription: the echo, then time sync notifications without asking
+    client.subscribe(60);
+    ok &= check(client.receive(status, 1000) == PMC_SUBSCRIBE_EVENTS_NP, "subscription acknowledged");
+    uint32_t time_sync = 0;
+    auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(600);
+    while (std::chrono::steady_clock::now() < until) {
+        if (client.receive(status, 100) == PMC_TIME_STATUS_NP) time_sync++;
+    }
+    ok &= check(time_sync >= 3, "time sync notifications pushed (" + std::to_string(time_sync) + ")");
+    
+    mock.set_port_state(LinuxPTPPortState::Uncalibrated);
+    bool port_state = false;
+    until = std::chrono::steady_clock::now() + std::chrono::milliseconds(1000);
+    while (!port_state && std::chrono::steady_clock::now() < until) {
+        port_state = client.receive(status, 100) == PMC_PORT_DATA_SET &&
+                     status.port_state == LinuxPTPPortState::Uncalibrated;
+    }
+    ok &= check(port_state, "port state notification pushed");
+    mock.set_port_state(LinuxPTPPortState::Slave);
+    return ok;
+}
+
+// PTPSync on the linuxptp backend: lock, ptp4l restart, holdover, relock
+bool check_ptp_sync(MockPTP4L& mock, const MockOptions& options) {
+    std::cout << "PTPSync (linuxptp backend):\n";
+    PTPConfig config;
+    config.backend = "linuxptp";
+    config.uds_path = options.socket_path;
+    config.interface = "lo";                    // No PHC: follows CLOCK_REALTIME
+    
+    PTPSync ptp;
+    if (!check(ptp.initialize(config), "initializes")) return false;
+    ptp.start();
+    
+    bool ok = check(wait_for(std::chrono::milliseconds(3000), [&] { return ptp.is_synchronized(); }),
+                    "locks to ptp4l");
+    ok &= check(wait_for(std::chrono::milliseconds(1000),
+                         [&] { return ptp.get_offset_from_master() == MASTER_OFFSET_NS; }),
+                "reports ptp4l's master offset");
+    ok &= check(ptp.get_clock_info().clock_id == GM_IDENTITY, "reports the grandmaster");
+    
+    mock.stop();
+    std::cout << "  ptp4l stopped\n";
+    ok &= check(wait_for(std::chrono::milliseconds(5000),
+                         [&] { return ptp.get_state() == PTPState::Holdover; }),
+                "holds over when ptp4l stops answering");
+    ok &= check(ptp.has_valid_time(), "time stays valid in holdover");
+    
+    std::this_thread::sleep_for(std::chrono::milliseconds(static_cast<int64_t>(options.outage_s * 1000)));
+    if (!mock.start(options.socket_path)) {
+        ptp.stop();
+        return false;
+    }
+    std::cout << "  ptp4l restarted\n";
+    
+    // PTPSync retries after its response timeout, so allow for one more
+    ok &= check(wait_for(std::chrono::milliseconds(8000), [&] { return mock.subscriptions() > 0; }),
+                "reconnects and resubscribes");
+    ok &= check(wait_for(std::chrono::milliseconds(3000), [&] { return ptp.is_synchronized(); }),
+                "locks again");
+    
+    ptp.stop();
+    return ok;
+}
+
+void print_usage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "\n"
+              << "Options:\n"
+              << "  --socket PATH         Mock ptp4l socket (default: /tmp/rpi-aes67-mock-ptp4l.<pid>)\n"
+              << "  --outage S            Time ptp4l stays away on restart (default: 5)\n"
+              << "  -h, --help            Show this help\n";
+}
+
+bool parse_options(int argc, char* argv[], MockOptions& options) {
+    static struct option long_options[] = {
+        {"socket", required_argument, nullptr, 's'},
+        {"outage", required_argument, nullptr, 'o'},
+        {"help", no_argument, nullptr, 'h'},
+        {nullptr, 0, nullptr, 0}
+    };
+    
+    int opt;
+    while ((opt = getopt_long(argc, argv, "h", long_options, nullptr)) != -1) {
+        switch (opt) {
+            case 's': options.socket_path = optarg; break;
+            case 'o': options.outage_s = std::stod(optarg); break;
+            case 'h':
+                print_usage(argv[0]);
+                std::exit(0);
+            default: return false;
+        }
+    }
+    return options.outage_s >= 0.0;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    MockOptions options;
+    if (!parse_options(argc, argv, options)) {
+        print_usage(argv[0]);
+        return 2;
+    }
+    
+    Logger::init("linuxptp_mock", LogLevel::Warning);
+    
+    MockPTP4L mock;
+    if (!mock.start(options.socket_path)) {
+        return 2;
+    }
+    
+    bool ok = check_client(mock, options);
+    ok = check_ptp_sync(mock, options) && ok;
+    mock.stop();
+    
+    std::cout << (ok ? "PASS" : "FAIL") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,234 @@
+// SPDX-License-Identifier: MIT
+/*
+ * RPi-AES67 - Media Clock Check and Benchmark
+ *
+ * Checks MediaClock against a 128-bit reference at the boundaries where
+ * split quotient/remainder arithmetic could go wrong: the PTP epoch, the
+ * current TAI epoch, every RTP wrap near it, multiples of the rate
+ * denominator and the top of the 64-bit range, plus a pseudo-random
+ * sweep. Then reports conversions per second in both directions. Any
+ * mismatch fails the run.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+#include <getopt.h>
+
+#include "rpi_aes67/media_clock.h"
+
+using namespace rpi_aes67;
+
+namespace {
+
+using u128 = unsigned __int128;
+
+// TAI around 2026; RTP timestamps derived from it overflow a 64-bit product
+constexpr uint64_t TAI_NOW_NS = 1792000000000000000ULL;
+constexpr uint64_t RTP_WRAP = 1ULL << 32;
+
+volatile uint64_t bench_sink = 0;
+
+struct BenchOptions {
+    uint64_t iterations = 10000000;
+    uint64_t random_checks = 1000000;
+};
+
+struct CheckResult {
+    uint64_t checks = 0;
+    uint64_t failures = 0;
+};
+
+uint64_t reference_samples_at(uint32_t sample_rate, uint64_t ns) {
+    return static_cast<uint64_t>(static_cast<u128>(ns) * sample_rate / 1000000000ULL);
+}
+
+uint64_t reference_ns_at(uint32_t sample_rate, uint64_t samples) {
+    return static_cast<uint64_t>((static_cast<u128>(samples) * 1000000000ULL + sample_rate - 1) / sample_rate);
+}
+
+// Deterministic xorshift so failures reproduce
+uint64_t next_random(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+void report(CheckResult& result, bool ok, const char* what, uint32_t sample_rate, uint64_t value) {
+    result.checks++;
+    if (ok) return;
+    if (result.failures++ < 10) {
+        std::cerr << what << " mismatch at " << sample_rate << " Hz, input " << value << "\n";
+    }
+}
+
+// samples_at and ns_at against the reference, and their round trip
+void check_point(CheckResult& result, const MediaClockRate& rate, uint64_t ns) {
+    uint64_t samples = rate.samples_at(ns);
+    report(result, samples == reference_samples_at(rate.sample_rate, ns), "samples_at", rate.sample_rate, ns);
+    
+    // ns_at(samples) must not overflow: samples_at never exceeds the range it maps back to
+    uint64_t start = rate.ns_at(samples);
+    report(result, start == reference_ns_at(rate.sample_rate, samples), "ns_at", rate.sample_rate, samples);
+    report(result, start <= ns && rate.samples_at(start) == samples &&
+                   (start == 0 || rate.samples_at(start - 1) + 1 == samples),
+           "round trip", rate.sample_rate, ns);
+}
+
+// RTP -> PTP unfolding from references up to just under half a wrap away
+void check_unfold(CheckResult& result, const MediaClock& clock, uint64_t ns) {
+    const MediaClockRate& rate = clock.rate();
+    uint64_t expected = rate.ns_at(rate.samples_at(ns));
+    uint32_t rtp = clock.rtp_timestamp(ns);
+    uint64_t half_wrap_ns = rate.ns_at(RTP_WRAP / 2 - 1);
+    
+    for (uint64_t distance : {uint64_t{0}, uint64_t{1}, uint64_t{1000000}, half_wrap_ns - 1000000}) {
+        report(result, clock.ptp_time(rtp, ns + distance) == expected, "ptp_time (reference after)",
+               clock.sample_rate(), ns);
+        if (ns >= distance) {
+            report(result, clock.ptp_time(rtp, ns - distance) == expected, "ptp_time (reference before)",
+                   clock.sample_rate(), ns);
+        }
+    }
+}
+
+CheckResult run_checks(uint64_t random_checks) {
+    CheckResult result;
+    const std::vector<uint32_t> rates = {8000, 32000, 44100, 48000, 88200, 96000, 192000, 384000};
+    const std::vector<uint32_t> offsets = {0, 1, 0x7FFFFFFFu, 0x80000000u, 0xFFFFFFFFu};
+    
+    for (uint32_t sample_rate : rates) {
+        MediaClockRate rate = MediaClock::rate_for(sample_rate);
+        std::vector<uint64_t> points;
+        
+        // The PTP epoch and the first few samples
+        for (uint64_t ns = 0; ns < 100000; ++ns) points.push_back(ns);
+        
+        // Around the current TAI epoch, the denominator and the top of the range
+        for (uint64_t base : {TAI_NOW_NS, rate.den * 1000003, UINT64_MAX - 100000}) {
+            for (uint64_t d = 0; d < 100000; ++d) points.push_back(base + d);
+        }
+        
+        // Every sample boundary on either side of the RTP wraps near now
+        uint64_t wrap = rate.samples_at(TAI_NOW_NS) / RTP_WRAP;
+        for (uint64_t k = wrap - 2; k <= wrap + 2; ++k) {
+            uint64_t edge = rate.ns_at(k * RTP_WRAP);
+            for (uint64_t d = 0; d < 20000; ++d) {
+                points.push_back(edge - 10000 + d);
+            }
+        }
+        
+        uint64_t state = 0x9E3779B97F4A7C15ULL ^ sample_rate;
+        for (uint64_t i = 0; i < random_checks; ++i) {
+            points.push_back(next_random(state));
+        }
+        
+        for (uint64_t ns : points) {
+            check_point(result, rate, ns);
+        }
+        
+        // RTP unfolding for each offset, across the wraps and the epoch
+        for (uint32_t offset : offsets) {
+            MediaClock clock(sample_rate, offset);
+            for (uint64_t k = wrap - 1; k <= wrap + 1; ++k) {
+                uint64_t edge = rate.ns_at(k * RTP_WRAP - offset);
+                for (uint64_t d = 0; d < 2000; ++d) {
+                    check_unfold(result, clock, edge - 1000000 + d * 1000);
+                }
+            }
+            for (uint64_t ns = 0; ns < 200000; ns += 7) {
+                check_unfold(result, clock, ns);
+            }
+            
+            // A timestamp before the epoch cannot be unfolded
+            report(result, clock.ptp_time(clock.rtp_timestamp(0) - 1, 0) == 0, "ptp_time (before epoch)",
+                   sample_rate, offset);
+        }
+    }
+    return result;
+}
+
+template <typename Convert>
+double conversions_per_second(uint64_t iterations, Convert convert) {
+    uint64_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < iterations; ++i) {
+        sink += convert(TAI_NOW_NS + i * 20833);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    bench_sink = sink;   // Keep the loop from being optimised away
+    return seconds > 0.0 ? static_cast<double>(iterations) / seconds : 0.0;
+}
+
+void print_usage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "\n"
+              << "Options:\n"
+              << "  --iterations N        Conversions per benchmark (default: 10000000)\n"
+              << "  --random N            Random points checked per rate (default: 1000000)\n"
+              << "  -h, --help            Show this help\n";
+}
+
+bool parse_options(int argc, char* argv[], BenchOptions& options) {
+    static struct option long_options[] = {
+        {"iterations", required_argument, nullptr, 'n'},
+        {"random", required_argument, nullptr, 'r'},
+        {"help", no_argument, nullptr, 'h'},
+        {nullptr, 0, nullptr, 0}
+    };
+    
+    int opt;
+    while ((opt = getopt_long(argc, argv, "h", long_options, nullptr)) != -1) {
+        switch (opt) {
+            case 'n': options.iterations = std::stoull(optarg); break;
+            case 'r': options.random_checks = std::stoull(optarg); break;
+            case 'h':
+                print_usage(argv[0]);
+                std::exit(0);
+            default: return false;
+        }
+    }
+    return options.iterations > 0;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    if (!parse_options(argc, argv, options)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    
+    CheckResult result = run_checks(options.random_checks);
+    std::cout << result.checks << " checks against the 128-bit reference, "
+              << result.failures << " failed\n";
+    
+    MediaClock clock(48000, 3367415686u);
+    const MediaClockRate rate = clock.rate();
+    double to_rtp = conversions_per_second(options.iterations,
+                                           [&](uint64_t ns) { return clock.rtp_timestamp(ns); });
+    double to_ptp = conversions_per_second(options.iterations, [&](uint64_t ns) {
+        return clock.ptp_time(static_cast<uint32_t>(ns >> 12), TAI_NOW_NS);
+    });
+    double reference = conversions_per_second(options.iterations, [&](uint64_t ns) {
+        return static_cast<uint32_t>(reference_samples_at(rate.sample_rate, ns));
+    });
+    
+    std::cout << std::fixed << std::setprecision(2)
+              << std::left << std::setw(14) << "conversion" << std::right
+              << std::setw(16) << "Mconv/s" << std::setw(10) << "ns/conv" << "\n";
+    for (auto [name, per_second] : {std::pair<const char*, double>{"ptp->rtp", to_rtp},
+                                    {"rtp->ptp", to_ptp},
+                                    {"u128 ptp->rtp", reference}}) {
+        std::cout << std::left << std::setw(14) << name << std::right
+                  << std::setw(16) << per_second / 1e6 << std::setw(10) << 1e9 / per_second << "\n";
+    }
+    
+    return result.failures == 0 ? 0 : 1;
+}
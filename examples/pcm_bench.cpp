@@ -0,0 +1,236 @@
+// SPDX-License-Identifier: MIT
+/*
+ * RPi-AES67 - PCM Codec Benchmark
+ *
+ * Times every PCMCodec conversion between the AES67 wire encodings and
+ * the host sample formats, interleaved and planar, with the scalar
+ * kernels and with the kernels dispatched for this CPU, and reports
+ * samples per second for each. The dispatched kernels must produce the
+ * same bytes as the scalar ones, NaN and infinite input included,
+ * otherwise the run fails.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <iterator>
+#include <limits>
+#include <getopt.h>
+
+#include "rpi_aes67/pcm_codec.h"
+
+using namespace rpi_aes67;
+
+namespace {
+
+struct BenchOptions {
+    uint32_t channels = 64;             // 64 ch at 96 kHz is the target stream
+    uint32_t frames = 96;               // One 1 ms packet at 96 kHz
+    uint64_t iterations = 20000;
+    std::string isa;                    // Dispatched kernel set (default: best for this CPU)
+};
+
+struct Case {
+    const char* name;
+    PCMEncoding encoding;
+    SampleFormat format;
+    bool decode;
+    bool planar;
+};
+
+const Case CASES[] = {
+    {"L16 -> S16", PCMEncoding::L16, SampleFormat::S16, true, false},
+    {"L24 -> S24", PCMEncoding::L24, SampleFormat::S24, true, false},
+    {"L32 -> S32", PCMEncoding::L32, SampleFormat::S32, true, false},
+    {"L24 -> S32", PCMEncoding::L24, SampleFormat::S32, true, false},
+    {"L16 -> F32", PCMEncoding::L16, SampleFormat::F32, true, false},
+    {"L24 -> F32", PCMEncoding::L24, SampleFormat::F32, true, false},
+    {"L32 -> F32", PCMEncoding::L32, SampleFormat::F32, true, false},
+    {"S16 -> L16", PCMEncoding::L16, SampleFormat::S16, false, false},
+    {"S24 -> L24", PCMEncoding::L24, SampleFormat::S24, false, false},
+    {"S32 -> L32", PCMEncoding::L32, SampleFormat::S32, false, false},
+    {"S32 -> L24", PCMEncoding::L24, SampleFormat::S32, false, false},
+    {"F32 -> L16", PCMEncoding::L16, SampleFormat::F32, false, false},
+    {"F32 -> L24", PCMEncoding::L24, SampleFormat::F32, false, false},
+    {"F32 -> L32", PCMEncoding::L32, SampleFormat::F32, false, false},
+    {"L24 -> F32p", PCMEncoding::L24, SampleFormat::F32, true, true},
+    {"F32p -> L24", PCMEncoding::L24, SampleFormat::F32, false, true},
+};
+
+// Float input the encoders must agree on besides ordinary samples
+const float SPECIAL_VALUES[] = {
+    std::numeric_limits<float>::quiet_NaN(),
+    -std::numeric_limits<float>::quiet_NaN(),
+    std::numeric_limits<float>::infinity(),
+    -std::numeric_limits<float>::infinity(),
+};
+
+// Buffers for one case; float input spans beyond full scale to exercise
+// clipping, with NaN and infinities spread over vector lanes and the tail
+struct Buffers {
+    std::vector<uint8_t> wire;
+    std::vector<uint8_t> host;
+    std::vector<void*> planes;
+    
+    Buffers(const Case& c, uint32_t channels, uint32_t frames) {
+        size_t samples = static_cast<size_t>(channels) * frames;
+        wire.resize(samples * PCMCodec::sample_size(c.encoding));
+        host.resize(samples * PCMCodec::sample_size(c.format));
+        
+        uint32_t state = 0x12345678;
+        for (auto& byte : wire) {
+            state = state * 1664525u + 1013904223u;
+            byte = static_cast<uint8_t>(state >> 24);
+        }
+        if (c.format == SampleFormat::F32) {
+            auto* values = reinterpret_cast<float*>(host.data());
+            for (size_t i = 0; i < samples; ++i) {
+                state = state * 1664525u + 1013904223u;
+                values[i] = static_cast<float>(static_cast<int32_t>(state)) / 1.5e9f;
+            }
+            for (size_t i = 0; i < samples; i += 37) {
+                values[i] = SPECIAL_VALUES[(i / 37) % std::size(SPECIAL_VALUES)];
+            }
+            values[samples - 1] = SPECIAL_VALUES[0];
+        } else {
+            std::memcpy(host.data(), wire.data(), std::min(host.size(), wire.size()));
+        }
+        
+        size_t plane_bytes = static_cast<size_t>(frames) * PCMCodec::sample_size(c.format);
+        for (uint32_t ch = 0; ch < channels; ++ch) {
+            planes.push_back(host.data() + ch * plane_bytes);
+        }
+    }
+    
+    void run(const Case& c, uint32_t channels, uint32_t frames) {
+        size_t samples = static_cast<size_t>(channels) * frames;
+        if (c.planar && c.decode) {
+            PCMCodec::decode_planar(wire.data(), c.encoding, planes.data(), c.format, frames, channels);
+        } else if (c.planar) {
+            PCMCodec::encode_planar(planes.data(), c.format, wire.data(), c.encoding, frames, channels);
+        } else if (c.decode) {
+            PCMCodec::decode(wire.data(), c.encoding, host.data(), c.format, samples);
+        } else {
+            PCMCodec::encode(host.data(), c.format, wire.data(), c.encoding, samples);
+        }
+    }
+    
+    const std::vector<uint8_t>& output(const Case& c) const { return c.decode ? host : wire; }
+};
+
+double samples_per_second(const Case& c, const BenchOptions& options, std::vector<uint8_t>& output) {
+    Buffers buffers(c, options.channels, options.frames);
+    buffers.run(c, options.channels, options.frames);   // Warm up and capture the result
+    output = buffers.output(c);
+    
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < options.iterations; ++i) {
+        buffers.run(c, options.channels, options.frames);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double samples = static_cast<double>(options.iterations) * options.channels * options.frames;
+    return seconds > 0.0 ? samples / seconds : 0.0;
+}
+
+bool parse_isa(const std::string& name, PCMCodec::Isa& isa) {
+    for (auto candidate : {PCMCodec::Isa::Scalar, PCMCodec::Isa::SSE4, PCMCodec::Isa::AVX2, PCMCodec::Isa::NEON}) {
+        if (name == PCMCodec::isa_name(candidate)) {
+            isa = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+void print_usage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "\n"
+              << "Options:\n"
+              << "  --channels N          Interleaved channels (default: 64)\n"
+              << "  --frames N            Frames per conversion call (default: 96)\n"
+              << "  --iterations N        Conversion calls per kernel (default: 20000)\n"
+              << "  --isa NAME            sse4.1, avx2 or neon to compare with scalar (default: best available)\n"
+              << "  -h, --help            Show this help\n";
+}
+
+bool parse_options(int argc, char* argv[], BenchOptions& options) {
+    static struct option long_options[] = {
+        {"channels", required_argument, nullptr, 'c'},
+        {"frames", required_argument, nullptr, 'f'},
+        {"iterations", required_argument, nullptr, 'n'},
+        {"isa", required_argument, nullptr, 'i'},
+        {"help", no_argument, nullptr, 'h'},
+        {nullptr, 0, nullptr, 0}
+    };
+    
+    int opt;
+    while ((opt = getopt_long(argc, argv, "h", long_options, nullptr)) != -1) {
+        switch (opt) {
+            case 'c': options.channels = static_cast<uint32_t>(std::stoul(optarg)); break;
+            case 'f': options.frames = static_cast<uint32_t>(std::stoul(optarg)); break;
+            case 'n': options.iterations = std::stoull(optarg); break;
+            case 'i': options.isa = optarg; break;
+            case 'h':
+                print_usage(argv[0]);
+                std::exit(0);
+            default: return false;
+        }
+    }
+    return options.channels > 0 && options.frames > 0 && options.iterations > 0;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    if (!parse_options(argc, argv, options)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    
+    PCMCodec::Isa dispatched = PCMCodec::active_isa();
+    if (!options.isa.empty()) {
+        PCMCodec::Isa requested;
+        if (!parse_isa(options.isa, requested)) {
+            std::cerr << "Unknown instruction set " << options.isa << "\n";
+            return 1;
+        }
+        if (PCMCodec::select_isa(requested) != requested) {
+            std::cerr << options.isa << " is not supported on this CPU\n";
+            return 1;
+        }
+        dispatched = requested;
+    }
+    
+    std::cout << std::fixed << std::setprecision(1)
+              << options.channels << " ch x " << options.frames << " frames, "
+              << options.iterations << " calls per kernel, scalar vs "
+              << PCMCodec::isa_name(dispatched) << "\n"
+              << std::left << std::setw(14) << "conversion" << std::right
+              << std::setw(14) << "scalar MS/s" << std::setw(14) << "vector MS/s"
+              << std::setw(10) << "speedup" << "\n";
+    
+    bool agree = true;
+    for (const auto& c : CASES) {
+        std::vector<uint8_t> scalar_output;
+        std::vector<uint8_t> vector_output;
+        
+        PCMCodec::select_isa(PCMCodec::Isa::Scalar);
+        double scalar_rate = samples_per_second(c, options, scalar_output);
+        PCMCodec::select_isa(dispatched);
+        double vector_rate = samples_per_second(c, options, vector_output);
+        
+        bool same = scalar_output == vector_output;
+        agree = agree && same;
+        std::cout << std::left << std::setw(14) << c.name << std::right
+                  << std::setw(14) << scalar_rate / 1e6 << std::setw(14) << vector_rate / 1e6
+                  << std::setw(9) << vector_rate / scalar_rate << "x"
+                  << (same ? "" : "  MISMATCH") << "\n";
+    }
+    
+    return agree ? 0 : 1;
+}
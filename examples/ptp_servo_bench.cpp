@@ -0,0 +1,456 @@
+// SPDX-License-Identifier: MIT
+/*
+ * RPi-AES67 - PTP Servo Benchmark
+ *
+ * Runs PTPSync against an in-process simulated grandmaster and reports
+ * lock time, steady-state offset RMS and MTIE. Exits non-zero when a
+ * --max-* limit is exceeded, so it can gate servo changes in CI.
+ *
+ * With --outage-at the grandmaster goes silent for --outage seconds. The
+ * run then also fails if get_current_time() ever reads backwards, if the
+ * holdover drift exceeds get_time_uncertainty_ns() (or --max-drift), if
+ * the uncertainty does not grow during holdover, or if the time scale
+ * steps instead of slewing when the grandmaster returns.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <deque>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <getopt.h>
+
+#include "rpi_aes67/logger.h"
+#include "rpi_aes67/ptp_sync.h"
+#include "rpi_aes67/ptp_grandmaster_sim.h"
+
+using namespace rpi_aes67;
+
+namespace {
+
+struct BenchOptions {
+    std::string interface = "lo";
+    uint16_t event_port = 31900;
+    uint16_t general_port = 32000;
+    double duration_s = 60.0;
+    double ppm = 50.0;
+    int8_t log_sync_interval = -3;
+    int64_t delay_ns = 0;
+    int64_t jitter_ns = 0;
+    double step_at_s = 0.0;
+    int64_t step_ns = 0;
+    double outage_at_s = 0.0;
+    double outage_s = 10.0;
+    int64_t max_drift_ns = 0;
+    double kp = 0.7;
+    double ki = 0.3;
+    int64_t lock_threshold_ns = 10000;
+    double settle_s = 5.0;
+    double max_lock_s = 0.0;
+    double max_rms_ns = 0.0;
+    double max_mtie_ns = 0.0;
+};
+
+// Time interval error sample: follower minus grandmaster at one raw instant
+struct Sample {
+    double t_s;
+    int64_t error_ns;
+};
+
+constexpr double SAMPLE_INTERVAL_S = 0.01;
+// Error must stay within the lock threshold this long to count as locked
+constexpr double LOCK_HOLD_S = 1.0;
+// Error change between samples beyond twice the slew limit counts as a step
+constexpr int64_t STEP_TOLERANCE_NS = 1000;
+
+void print_usage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "\n"
+              << "Options:\n"
+              << "  --interface NAME      Interface (default: lo)\n"
+              << "  --ports EVENT,GENERAL UDP ports (default: 31900,32000)\n"
+              << "  --duration S          Run time in seconds (default: 60)\n"
+              << "  --ppm PPM             Grandmaster frequency offset (default: 50)\n"
+              << "  --log-sync N          log2 sync interval (default: -3)\n"
+              << "  --delay NS            Injected path delay (default: 0)\n"
+              << "  --jitter NS           Injected path delay jitter (default: 0)\n"
+              << "  --step-at S           Step the grandmaster at this time\n"
+              << "  --step NS             Step size (default: 0)\n"
+              << "  --outage-at S         Silence the grandmaster at this time\n"
+              << "  --outage S            Outage length (default: 10)\n"
+              << "  --max-drift NS        Fail if the error drifts further in holdover\n"
+              << "  --kp K, --ki K        Servo gain scales (default: 0.7, 0.3)\n"
+              << "  --lock-threshold NS   Error bound that counts as locked (default: 10000)\n"
+              << "  --settle S            Time after lock excluded from statistics (default: 5)\n"
+              << "  --max-lock S          Fail if lock takes longer\n"
+              << "  --max-rms NS          Fail if steady-state offset RMS is larger\n"
+              << "  --max-mtie NS         Fail if MTIE at 1 s is larger\n"
+              << "  -h, --help            Show this help\n";
+}
+
+bool parse_options(int argc, char* argv[], BenchOptions& options) {
+    static struct option long_options[] = {
+        {"interface", required_argument, nullptr, 'i'},
+        {"ports", required_argument, nullptr, 'p'},
+        {"duration", required_argument, nullptr, 'd'},
+        {"ppm", required_argument, nullptr, 'f'},
+        {"log-sync", required_argument, nullptr, 's'},
+        {"delay", required_argument, nullptr, 'D'},
+        {"jitter", required_argument, nullptr, 'j'},
+        {"step-at", required_argument, nullptr, 'a'},
+        {"step", required_argument, nullptr, 'S'},
+        {"outage-at", required_argument, nullptr, 'o'},
+        {"outage", required_argument, nullptr, 'O'},
+        {"max-drift", required_argument, nullptr, 'x'},
+        {"kp", required_argument, nullptr, 'P'},
+        {"ki", required_argument, nullptr, 'I'},
+        {"lock-threshold", required_argument, nullptr, 't'},
+        {"settle", required_argument, nullptr, 'w'},
+        {"max-lock", required_argument, nullptr, 'L'},
+        {"max-rms", required_argument, nullptr, 'R'},
+        {"max-mtie", required_argument, nullptr, 'M'},
+        {"help", no_argument, nullptr, 'h'},
+        {nullptr, 0, nullptr, 0}
+    };
+    
+    int opt;
+    while ((opt = getopt_long(argc, argv, "h", long_options, nullptr)) != -1) {
+        switch (opt) {
+            case 'i': options.interface = optarg; break;
+            case 'p': {
+                std::string ports = optarg;
+                size_t comma = ports.find(',');
+                if (comma == std::string::npos) return false;
+                options.event_port = static_cast<uint16_t>(std::stoi(ports.substr(0, comma)));
+                options.general_port = static_cast<uint16_t>(std::stoi(ports.substr(comma + 1)));
+                break;
+            }
+            case 'd': options.duration_s = std::stod(optarg); break;
+            case 'f': options.ppm = std::stod(optarg); break;
+            case 's': options.log_sync_interval = static_cast<int8_t>(std::stoi(optarg)); break;
+            case 'D': options.delay_ns = std::stoll(optarg); break;
+            case 'j': options.jitter_ns = std::stoll(optarg); break;
+            case 'a': options.step_at_s = std::stod(optarg); break;
+            case 'S': options.step_ns = std::stoll(optarg); break;
+            case 'o': options.outage_at_s = std::stod(optarg); break;
+            case 'O': options.outage_s = std::stod(optarg); break;
+            case 'x': options.max_drift_ns = std::stoll(optarg); break;
+            case 'P': options.kp = std::stod(optarg); break;
+            case 'I': options.ki = std::stod(optarg); break;
+            case 't': options.lock_threshold_ns = std::stoll(optarg); break;
+            case 'w': options.settle_s = std::stod(optarg); break;
+            case 'L': options.max_lock_s = std::stod(optarg); break;
+            case 'R': options.max_rms_ns = std::stod(optarg); break;
+            case 'M': options.max_mtie_ns = std::stod(optarg); break;
+            case 'h':
+                print_usage(argv[0]);
+                std::exit(0);
+            default: return false;
+        }
+    }
+    // One disturbance per run: the statistics stop at it
+    return !(options.outage_at_s > 0.0 && options.step_ns != 0 && options.step_at_s > 0.0) &&
+           options.outage_s > 0.0;
+}
+
+// Start of the first run of samples in [first, last) that stays within
+// the threshold for LOCK_HOLD_S; negative if there is none
+double find_lock(const std::vector<Sample>& samples, size_t first, size_t last, int64_t threshold_ns) {
+    size_t run_start = last;
+    for (size_t i = first; i < last; ++i) {
+        if (std::llabs(samples[i].error_ns) > threshold_ns) {
+            run_start = last;
+            continue;
+        }
+        if (run_start == last) run_start = i;
+        if (samples[i].t_s - samples[run_start].t_s >= LOCK_HOLD_S) {
+            return samples[run_start].t_s;
+        }
+    }
+    return -1.0;
+}
+
+// Maximum time interval error: largest peak-to-peak error within any
+// window of tau seconds (sliding min/max, one pass)
+double mtie(const std::vector<Sample>& samples, size_t first, size_t last, double tau_s) {
+    std::deque<size_t> min_queue;
+    std::deque<size_t> max_queue;
+    size_t window_start = first;
+    double result = 0.0;
+    for (size_t i = first; i < last; ++i) {
+        while (!min_queue.empty() && samples[min_queue.back()].error_ns >= samples[i].error_ns) min_queue.pop_back();
+        while (!max_queue.empty() && samples[max_queue.back()].error_ns <= samples[i].error_ns) max_queue.pop_back();
+        min_queue.push_back(i);
+        max_queue.push_back(i);
+        
+        while (samples[i].t_s - samples[window_start].t_s > tau_s) {
+            ++window_start;
+            if (min_queue.front() < window_start) min_queue.pop_front();
+            if (max_queue.front() < window_start) max_queue.pop_front();
+        }
+        double range = static_cast<double>(samples[max_queue.front()].error_ns - samples[min_queue.front()].error_ns);
+        result = std::max(result, range);
+    }
+    return result;
+}
+
+// Read get_current_time() back to back from the first valid time scale
+// on (before it the system clock stands in) and count backwards reads
+void watch_monotonic(const PTPSync& ptp, const std::atomic<bool>& stop, std::atomic<uint64_t>& reads,
+                     std::atomic<uint64_t>& backwards) {
+    while (!stop && !ptp.get_time_scale().valid) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    
+    int64_t last = ptp.get_current_time().count();
+    while (!stop) {
+        for (int i = 0; i < 1000; ++i) {
+            int64_t now = ptp.get_current_time().count();
+            if (now < last) backwards.fetch_add(1, std::memory_order_relaxed);
+            last = now;
+        }
+        reads.fetch_add(1000, std::memory_order_relaxed);
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    if (!parse_options(argc, argv, options)) {
+        print_usage(argv[0]);
+        return 2;
+    }
+    
+    Logger::init("ptp_servo_bench", LogLevel::Warning);
+    
+    PTPGrandmasterSimConfig gm_config;
+    gm_config.interface = options.interface;
+    gm_config.event_port = options.event_port;
+    gm_config.general_port = options.general_port;
+    gm_config.log_sync_interval = options.log_sync_interval;
+    gm_config.frequency_offset_ppm = options.ppm;
+    gm_config.path_delay_ns = options.delay_ns;
+    gm_config.path_delay_jitter_ns = options.jitter_ns;
+    
+    PTPGrandmasterSim grandmaster;
+    if (!grandmaster.start(gm_config)) {
+        std::cerr << "Failed to start the grandmaster simulator" << std::endl;
+        return 2;
+    }
+    
+    PTPConfig ptp_config;
+    ptp_config.interface = options.interface;
+    ptp_config.event_port = options.event_port;
+    ptp_config.general_port = options.general_port;
+    ptp_config.servo_kp = options.kp;
+    ptp_config.servo_ki = options.ki;
+    if (options.outage_at_s > 0.0) {
+        // Expire holdover only well after the outage
+        ptp_config.holdover_timeout_s = static_cast<uint32_t>(options.outage_s) + 60;
+    }
+    
+    PTPSync ptp;
+    if (!ptp.initialize(ptp_config)) {
+        std::cerr << "Failed to initialize PTP" << std::endl;
+        return 2;
+    }
+    ptp.start();
+    
+    std::atomic<bool> stop_watch{false};
+    std::atomic<uint64_t> reads{0};
+    std::atomic<uint64_t> backwards{0};
+    std::thread watcher(watch_monotonic, std::cref(ptp), std::cref(stop_watch), std::ref(reads),
+                        std::ref(backwards));
+    
+    // Sample the follower's published time scale against the grandmaster
+    // at the same raw instant, so reading jitter does not enter the error
+    std::vector<Sample> samples;
+    samples.reserve(static_cast<size_t>(options.duration_s / SAMPLE_INTERVAL_S) + 1);
+    const int64_t start_raw = PTPSync::monotonic_raw_ns();
+    bool stepped = options.step_ns == 0 || options.step_at_s <= 0.0;
+    size_t step_index = 0;
+    
+    // Outage: silent from outage_index, back from return_index
+    const bool outage = options.outage_at_s > 0.0;
+    size_t outage_index = 0;
+    size_t return_index = 0;
+    size_t holdover_samples = 0;
+    int64_t holdover_entry_error = 0;
+    int64_t holdover_first_uncertainty = 0;
+    int64_t holdover_last_uncertainty = 0;
+    int64_t max_drift = 0;
+    uint64_t over_bound = 0;
+    uint64_t uncertainty_drops = 0;
+    uint64_t steps = 0;
+    int64_t largest_jump = 0;
+    const double slew_rate = ptp_config.slew_max_ppm / 1e6;
+    
+    auto next = std::chrono::steady_clock::now();
+    while (true) {
+        next += std::chrono::microseconds(static_cast<int64_t>(SAMPLE_INTERVAL_S * 1e6));
+        std::this_thread::sleep_until(next);
+        
+        int64_t raw = PTPSync::monotonic_raw_ns();
+        double t_s = static_cast<double>(raw - start_raw) / 1e9;
+        if (t_s >= options.duration_s) break;
+        
+        if (!stepped && t_s >= options.step_at_s) {
+            grandmaster.step(options.step_ns);
+            stepped = true;
+            step_index = samples.size();
+        }
+        if (outage && outage_index == 0 && t_s >= options.outage_at_s) {
+            grandmaster.set_enabled(false);
+            outage_index = samples.size();
+        }
+        if (outage_index > 0 && return_index == 0 && t_s >= options.outage_at_s + options.outage_s) {
+            grandmaster.set_enabled(true);
+            return_index = samples.size();
+        }
+        
+        PTPTimeScale scale = ptp.get_time_scale();
+        if (!scale.valid) continue;
+        int64_t error = scale.at(raw) - grandmaster.time_at(raw);
+        
+        // From the outage on the time scale may only slew: the error moves
+        // by at most the slew limit on top of the frequency error
+        if (outage_index > 0 && !samples.empty()) {
+            const Sample& previous = samples.back();
+            int64_t allowed = static_cast<int64_t>(2.0 * slew_rate * (t_s - previous.t_s) * 1e9) + STEP_TOLERANCE_NS;
+            int64_t jump = std::llabs(error - previous.error_ns);
+            largest_jump = std::max(largest_jump, jump);
+            if (jump > allowed) steps++;
+        }
+        
+        // Holdover: the drift must stay within the reported bound, which
+        // grows. Path asymmetry is invisible to PTP, so the error at entry
+        // is the reference rather than zero
+        if (outage_index > 0 && return_index == 0 && ptp.get_state() == PTPState::Holdover) {
+            int64_t uncertainty = ptp.get_time_uncertainty_ns();
+            if (holdover_samples++ == 0) {
+                holdover_entry_error = error;
+                holdover_first_uncertainty = uncertainty;
+            } else if (uncertainty < holdover_last_uncertainty) {
+                uncertainty_drops++;
+            }
+            holdover_last_uncertainty = uncertainty;
+            int64_t drift = std::llabs(error - holdover_entry_error);
+            if (drift > uncertainty) over_bound++;
+            max_drift = std::max(max_drift, drift);
+        }
+        samples.push_back({t_s, error});
+    }
+    
+    stop_watch = true;
+    watcher.join();
+    ptp.stop();
+    grandmaster.stop();
+    
+    // Statistics window: from lock + settle up to the step or outage (if any)
+    size_t end = step_index > 0 ? step_index : samples.size();
+    if (outage_index > 0) end = outage_index;
+    double lock_s = find_lock(samples, 0, end, options.lock_threshold_ns);
+    size_t first = end;
+    if (lock_s >= 0.0) {
+        first = 0;
+        while (first < end && samples[first].t_s < lock_s + options.settle_s) ++first;
+    }
+    
+    double sum = 0.0;
+    double sum_sq = 0.0;
+    int64_t max_abs = 0;
+    for (size_t i = first; i < end; ++i) {
+        double error = static_cast<double>(samples[i].error_ns);
+        sum += error;
+        sum_sq += error * error;
+        max_abs = std::max<int64_t>(max_abs, std::llabs(samples[i].error_ns));
+    }
+    size_t count = end - first;
+    double mean = count > 0 ? sum / static_cast<double>(count) : 0.0;
+    double rms = count > 0 ? std::sqrt(sum_sq / static_cast<double>(count)) : 0.0;
+    
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Grandmaster: " << options.ppm << " ppm, sync 2^" << static_cast<int>(options.log_sync_interval)
+              << " s, delay " << options.delay_ns << " ns, jitter " << options.jitter_ns << " ns\n";
+    std::cout << std::defaultfloat << "Servo: kp " << options.kp << ", ki " << options.ki << "\n"
+              << std::fixed;
+    if (lock_s < 0.0) {
+        std::cout << "Lock time: not locked within " << options.lock_threshold_ns << " ns\n";
+    } else {
+        std::cout << "Lock time: " << lock_s << " s (within " << options.lock_threshold_ns << " ns)\n";
+    }
+    std::cout << "Steady state (" << count << " samples): mean " << mean << " ns, RMS " << rms
+              << " ns, max " << max_abs << " ns\n";
+    
+    double mtie_1s = 0.0;
+    for (double tau : {0.1, 1.0, 10.0}) {
+        double value = count > 0 ? mtie(samples, first, end, tau) : 0.0;
+        if (tau == 1.0) mtie_1s = value;
+        std::cout << "MTIE(" << tau << " s): " << value << " ns\n";
+    }
+    
+    bool recovered = true;
+    if (step_index > 0) {
+        double relock_s = find_lock(samples, step_index, samples.size(), options.lock_threshold_ns);
+        if (relock_s < 0.0) {
+            recovered = false;
+            std::cout << "Step " << options.step_ns << " ns: not recovered\n";
+        } else {
+            std::cout << "Step " << options.step_ns << " ns: recovered in "
+                      << relock_s - samples[step_index].t_s << " s\n";
+        }
+    }
+    
+    if (outage) {
+        std::cout << "Outage " << options.outage_s << " s: " << holdover_samples * SAMPLE_INTERVAL_S
+                  << " s in holdover, drift " << max_drift << " ns, uncertainty "
+                  << holdover_first_uncertainty << " -> " << holdover_last_uncertainty << " ns\n";
+        if (holdover_samples == 0) {
+            recovered = false;
+            std::cout << "Outage: holdover never entered\n";
+        } else if (holdover_last_uncertainty <= holdover_first_uncertainty || uncertainty_drops > 0) {
+            recovered = false;
+            std::cout << "Outage: uncertainty did not grow during holdover\n";
+        }
+        if (over_bound > 0) {
+            recovered = false;
+            std::cout << "Outage: drift beyond the reported uncertainty in " << over_bound << " samples\n";
+        }
+        if (options.max_drift_ns > 0 && max_drift > options.max_drift_ns) {
+            recovered = false;
+            std::cout << "Outage: drift beyond " << options.max_drift_ns << " ns\n";
+        }
+        std::cout << "Outage: largest change between samples " << largest_jump << " ns";
+        if (steps > 0) {
+            recovered = false;
+            std::cout << ", " << steps << " step(s) instead of a slew";
+        }
+        std::cout << "\n";
+        
+        double relock_s = return_index > 0 ? find_lock(samples, return_index, samples.size(),
+                                                       options.lock_threshold_ns) : -1.0;
+        if (relock_s < 0.0) {
+            recovered = false;
+            std::cout << "Outage: not relocked after the grandmaster returned\n";
+        } else {
+            std::cout << "Outage: relocked " << relock_s - samples[return_index].t_s
+                      << " s after the grandmaster returned\n";
+        }
+    }
+    std::cout << "get_current_time: " << reads.load() << " reads, " << backwards.load() << " backwards\n";
+    
+    bool failed = lock_s < 0.0 || !recovered || backwards > 0;
+    if (options.max_lock_s > 0.0 && lock_s > options.max_lock_s) failed = true;
+    if (options.max_rms_ns > 0.0 && rms > options.max_rms_ns) failed = true;
+    if (options.max_mtie_ns > 0.0 && mtie_1s > options.max_mtie_ns) failed = true;
+    std::cout << (failed ? "FAIL" : "PASS") << std::endl;
+    return failed ? 1 : 0;
+}
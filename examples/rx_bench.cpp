@@ -0,0 +1,349 @@
+// SPDX-License-Identifier: MIT
+/*
+ * RPi-AES67 - Receive Path Benchmark
+ *
+ * Feeds RTP streams over loopback from a separate sender process and
+ * compares the receive modes (poll, recvmmsg, io_uring) by packets per
+ * second per CPU core spent in the receiving process.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <memory>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include <getopt.h>
+#include <sys/socket.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+#include "rpi_aes67/logger.h"
+#include "rpi_aes67/receiver.h"
+
+using namespace rpi_aes67;
+
+namespace {
+
+struct BenchOptions {
+    std::vector<std::string> modes = {"poll", "recvmmsg", "io_uring"};
+    std::string threading = "engine";
+    uint32_t streams = 8;
+    uint32_t workers = 1;
+    uint16_t base_port = 25000;
+    double duration_s = 5.0;
+    uint32_t rate = 8000;           // Packets per second per stream (0 = unpaced)
+    uint32_t frames = 6;            // Frames per packet (6 = 125 us at 48 kHz)
+    uint8_t channels = 8;
+};
+
+struct RunResult {
+    uint64_t sent = 0;
+    uint64_t received = 0;
+    uint64_t syscalls = 0;
+    double wall_s = 0.0;
+    double cpu_s = 0.0;
+};
+
+constexpr uint8_t BIT_DEPTH = 24;
+constexpr uint32_t SEND_BATCH = 64;
+
+void print_usage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "\n"
+              << "Options:\n"
+              << "  --modes LIST          Receive modes to compare (default: poll,recvmmsg,io_uring)\n"
+              << "  --threading MODE      engine or per_receiver (default: engine)\n"
+              << "  --streams N           Receivers, one port each (default: 8)\n"
+              << "  --workers N           Engine worker threads (default: 1)\n"
+              << "  --port N              First UDP port (default: 25000)\n"
+              << "  --duration S          Seconds per mode (default: 5)\n"
+              << "  --rate PPS            Packets per second per stream, 0 = unpaced (default: 8000)\n"
+              << "  --frames N            Frames per packet (default: 6)\n"
+              << "  --channels N          Channels per stream, L24 (default: 8)\n"
+              << "  -h, --help            Show this help\n";
+}
+
+bool parse_options(int argc, char* argv[], BenchOptions& options) {
+    static struct option long_options[] = {
+        {"modes", required_argument, nullptr, 'm'},
+        {"threading", required_argument, nullptr, 't'},
+        {"streams", required_argument, nullptr, 'n'},
+        {"workers", required_argument, nullptr, 'w'},
+        {"port", required_argument, nullptr, 'p'},
+        {"duration", required_argument, nullptr, 'd'},
+        {"rate", required_argument, nullptr, 'r'},
+        {"frames", required_argument, nullptr, 'f'},
+        {"channels", required_argument, nullptr, 'c'},
+        {"help", no_argument, nullptr, 'h'},
+        {nullptr, 0, nullptr, 0}
+    };
+    
+    int opt;
+    while ((opt = getopt_long(argc, argv, "h", long_options, nullptr)) != -1) {
+        switch (opt) {
+            case 'm': {
+                options.modes.clear();
+                std::string list = optarg;
+                size_t start = 0;
+                while (start <= list.size()) {
+                    size_t comma = std::min(list.find(',', start), list.size());
+                    options.modes.push_back(list.substr(start, comma - start));
+                    start = comma + 1;
+                }
+                break;
+            }
+            case 't': options.threading = optarg; break;
+            case 'n': options.streams = static_cast<uint32_t>(std::stoul(optarg)); break;
+            case 'w': options.workers = static_cast<uint32_t>(std::stoul(optarg)); break;
+            case 'p': options.base_port = static_cast<uint16_t>(std::stoul(optarg)); break;
+            case 'd': options.duration_s = std::stod(optarg); break;
+            case 'r': options.rate = static_cast<uint32_t>(std::stoul(optarg)); break;
+            case 'f': options.frames = static_cast<uint32_t>(std::stoul(optarg)); break;
+            case 'c': options.channels = static_cast<uint8_t>(std::stoul(optarg)); break;
+            case 'h':
+                print_usage(argv[0]);
+                std::exit(0);
+            default: return false;
+        }
+    }
+    return options.streams > 0 && options.frames > 0 && options.channels > 0 &&
+           (options.threading == "engine" || options.threading == "per_receiver");
+}
+
+double cpu_seconds() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+           static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+// Sender process: round-robin RTP packets to every stream, batched with
+// sendmmsg; writes the packet count to the pipe when done
+[[noreturn]] void run_sender(const BenchOptions& options, int result_fd) {
+    int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    const size_t payload = static_cast<size_t>(options.frames) * options.channels * (BIT_DEPTH / 8);
+    std::vector<uint8_t> packets(SEND_BATCH * (12 + payload), 0);
+    std::vector<sockaddr_in> addresses(options.streams);
+    for (uint32_t i = 0; i < options.streams; ++i) {
+        addresses[i].sin_family = AF_INET;
+        addresses[i].sin_port = htons(static_cast<uint16_t>(options.base_port + i));
+        addresses[i].sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    }
+    std::vector<iovec> iovecs(SEND_BATCH);
+    std::vector<mmsghdr> msgs(SEND_BATCH);
+    
+    uint64_t sent = 0;
+    uint16_t sequence = 0;
+    uint32_t timestamp = 0;
+    const auto start = std::chrono::steady_clock::now();
+    const auto end = start + std::chrono::duration<double>(options.duration_s);
+    auto now = start;
+    while (now < end) {
+        // Paced: send what is due by now; unpaced: one full batch
+        uint64_t due = SEND_BATCH;
+        if (options.rate > 0) {
+            double elapsed = std::chrono::duration<double>(now - start).count();
+            uint64_t target = static_cast<uint64_t>(elapsed * options.rate) * options.streams;
+            due = std::min<uint64_t>(target > sent ? target - sent : 0, SEND_BATCH);
+            if (due == 0) {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+                now = std::chrono::steady_clock::now();
+                continue;
+            }
+        }
+        
+        for (uint64_t i = 0; i < due; ++i) {
+            uint64_t index = sent + i;
+            uint32_t stream = static_cast<uint32_t>(index % options.streams);
+            if (stream == 0) {
+                ++sequence;
+                timestamp += options.frames;
+            }
+            uint8_t* packet = packets.data() + i * (12 + payload);
+            packet[0] = 0x80;
+            packet[1] = 97;
+            uint16_t seq = htons(sequence);
+            uint32_t ts = htonl(timestamp);
+            std::memcpy(packet + 2, &seq, sizeof(seq));
+            std::memcpy(packet + 4, &ts, sizeof(ts));
+            
+            iovecs[i].iov_base = packet;
+            iovecs[i].iov_len = 12 + payload;
+            msgs[i].msg_hdr = {};
+            msgs[i].msg_hdr.msg_name = &addresses[stream];
+            msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+            msgs[i].msg_hdr.msg_iov = &iovecs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+        int count = sendmmsg(sock, msgs.data(), static_cast<unsigned int>(due), 0);
+        if (count > 0) sent += static_cast<uint64_t>(count);
+        now = std::chrono::steady_clock::now();
+    }
+    
+    ssize_t n = write(result_fd, &sent, sizeof(sent));
+    (void)n;
+    _exit(0);
+}
+
+// Fork before any receiver thread exists; the sender waits for a byte on
+// the start pipe (EOF = abort)
+pid_t fork_sender(const BenchOptions& options, int& start_fd, int& result_fd) {
+    int start_pipe[2];
+    int result_pipe[2];
+    if (pipe(start_pipe) < 0) return -1;
+    if (pipe(result_pipe) < 0) {
+        close(start_pipe[0]);
+        close(start_pipe[1]);
+        return -1;
+    }
+    
+    pid_t sender = fork();
+    if (sender == 0) {
+        close(start_pipe[1]);
+        close(result_pipe[0]);
+        char go;
+        if (read(start_pipe[0], &go, 1) == 1) {
+            run_sender(options, result_pipe[1]);
+        }
+        _exit(0);
+    }
+    close(start_pipe[0]);
+    close(result_pipe[1]);
+    if (sender < 0) {
+        close(start_pipe[1]);
+        close(result_pipe[0]);
+        return -1;
+    }
+    start_fd = start_pipe[1];
+    result_fd = result_pipe[0];
+    return sender;
+}
+
+bool run_mode(const BenchOptions& options, const std::string& mode, RunResult& result) {
+    int start_fd = -1;
+    int result_fd = -1;
+    pid_t sender = fork_sender(options, start_fd, result_fd);
+    if (sender < 0) return false;
+    auto abort_sender = [&]() {
+        close(start_fd);
+        close(result_fd);
+        waitpid(sender, nullptr, 0);
+        return false;
+    };
+    
+    std::shared_ptr<ReceiverEngine> engine;
+    if (options.threading == "engine") {
+        engine = std::make_shared<ReceiverEngine>();
+        ReceiverEngineConfig engine_config;
+        engine_config.workers = options.workers;
+        if (!engine->start(engine_config)) return abort_sender();
+    }
+    
+    AudioFormat format;
+    format.sample_rate = 48000;
+    format.bit_depth = BIT_DEPTH;
+    format.channels = options.channels;
+    
+    std::vector<std::shared_ptr<AES67Receiver>> receivers;
+    for (uint32_t i = 0; i < options.streams; ++i) {
+        ReceiverConfig config;
+        config.id = "bench-" + std::to_string(i);
+        config.channels = options.channels;
+        config.receive_mode = mode;
+        
+        auto receiver = std::make_shared<AES67Receiver>();
+        receiver->configure(config, AudioProcessingConfig{});
+        if (engine) receiver->set_engine(engine);
+        if (!receiver->initialize() ||
+            !receiver->connect("127.0.0.1", static_cast<uint16_t>(options.base_port + i), format) ||
+            !receiver->start()) {
+            std::cerr << "Failed to start receiver " << i << std::endl;
+            return abort_sender();
+        }
+        receivers.push_back(receiver);
+    }
+    
+    // Receiving process CPU only: this thread just waits
+    const double cpu_start = cpu_seconds();
+    const auto wall_start = std::chrono::steady_clock::now();
+    ssize_t n = write(start_fd, "x", 1);
+    close(start_fd);
+    
+    uint64_t sent = 0;
+    n = read(result_fd, &sent, sizeof(sent));
+    close(result_fd);
+    waitpid(sender, nullptr, 0);
+    // Let the receivers drain their sockets
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    result.cpu_s = cpu_seconds() - cpu_start;
+    result.wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+    result.sent = n == sizeof(sent) ? sent : 0;
+    
+    for (auto& receiver : receivers) {
+        ReceiverStatistics stats = receiver->get_statistics();
+        result.received += stats.packets_received;
+        result.syscalls += stats.rx_syscalls;
+        receiver->stop();
+        receiver->disconnect();
+    }
+    if (engine) engine->stop();
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    if (!parse_options(argc, argv, options)) {
+        print_usage(argv[0]);
+        return 2;
+    }
+    
+    Logger::init("rx_bench", LogLevel::Warning);
+    
+    std::cout << options.streams << " stream(s), " << static_cast<int>(options.channels) << " ch L24, "
+              << options.frames << " frames/packet, "
+              << (options.rate > 0 ? std::to_string(options.rate) + " pps/stream" : std::string("unpaced"))
+              << ", " << options.threading
+              << (options.threading == "engine" ? " (" + std::to_string(options.workers) + " worker(s))" : "")
+              << "\n\n";
+    std::cout << std::left << std::setw(10) << "mode" << std::right
+              << std::setw(12) << "received" << std::setw(8) << "loss%"
+              << std::setw(12) << "pkt/s" << std::setw(8) << "cpu%"
+              << std::setw(14) << "pkt/s/core" << std::setw(12) << "syscall/pkt" << "\n";
+    
+    int status = 0;
+    for (const auto& mode : options.modes) {
+        RunResult result;
+        if (!run_mode(options, mode, result)) {
+            std::cout << std::left << std::setw(10) << mode << "failed\n";
+            status = 1;
+            continue;
+        }
+        
+        double loss = result.sent > 0
+            ? 100.0 * static_cast<double>(result.sent - std::min(result.sent, result.received)) /
+              static_cast<double>(result.sent)
+            : 0.0;
+        double per_core = result.cpu_s > 0.0 ? static_cast<double>(result.received) / result.cpu_s : 0.0;
+        double syscalls = result.received > 0
+            ? static_cast<double>(result.syscalls) / static_cast<double>(result.received)
+            : 0.0;
+        std::cout << std::left << std::setw(10) << mode << std::right << std::fixed
+                  << std::setw(12) << result.received
+                  << std::setw(8) << std::setprecision(2) << loss
+                  << std::setw(12) << std::setprecision(0) << static_cast<double>(result.received) / result.wall_s
+                  << std::setw(8) << std::setprecision(1) << 100.0 * result.cpu_s / result.wall_s
+                  << std::setw(14) << std::setprecision(0) << per_core
+                  << std::setw(12) << std::setprecision(3) << syscalls << "\n";
+    }
+    return status;
+}
@@ -0,0 +1,281 @@
+// SPDX-License-Identifier: MIT
+/*
+ * RPi-AES67 - SDP Parse Benchmark
+ *
+ * Parses a corpus of AES67 session descriptions with SDPParser and with
+ * the previous regex-based parser (kept here as the reference) and
+ * reports parses per second for each. Both must agree on the stream
+ * fields of every single-section description, otherwise the run fails.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <regex>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <getopt.h>
+
+#include "rpi_aes67/logger.h"
+#include "rpi_aes67/media_clock.h"
+#include "rpi_aes67/receiver.h"
+#include "rpi_aes67/sender.h"
+
+using namespace rpi_aes67;
+
+namespace {
+
+struct BenchOptions {
+    uint64_t iterations = 20000;
+    std::vector<std::string> files;
+};
+
+// Previous SDPParser::parse: one std::regex per recognised line
+SDPInfo regex_parse(const std::string& sdp) {
+    SDPInfo info;
+    std::istringstream stream(sdp);
+    std::string line;
+    
+    while (std::getline(stream, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty()) continue;
+        
+        if (line.substr(0, 2) == "s=") {
+            info.session_name = line.substr(2);
+        } else if (line.substr(0, 2) == "o=") {
+            std::regex origin_regex(R"(o=\S+\s+(\d+)\s+\d+\s+IN\s+IP4\s+(\S+))");
+            std::smatch matches;
+            if (std::regex_search(line, matches, origin_regex)) {
+                info.session_id = matches[1];
+                info.origin_address = matches[2];
+            }
+        } else if (line.substr(0, 2) == "c=") {
+            std::regex conn_regex(R"(c=IN\s+IP4\s+([0-9.]+))");
+            std::smatch matches;
+            if (std::regex_search(line, matches, conn_regex)) {
+                info.source_ip = matches[1];
+            }
+        } else if (line.substr(0, 2) == "m=") {
+            std::regex media_regex(R"(m=audio\s+(\d+)\s+RTP/AVP\s+(\d+))");
+            std::smatch matches;
+            if (std::regex_search(line, matches, media_regex)) {
+                info.port = static_cast<uint16_t>(std::stoi(matches[1]));
+                info.payload_type = static_cast<uint8_t>(std::stoi(matches[2]));
+            }
+        } else if (line.substr(0, 9) == "a=rtpmap:") {
+            std::regex rtpmap_regex(R"(a=rtpmap:(\d+)\s+(\w+)/(\d+)/(\d+))");
+            std::smatch matches;
+            if (std::regex_search(line, matches, rtpmap_regex)) {
+                info.encoding = matches[2];
+                info.format.sample_rate = static_cast<uint32_t>(std::stoi(matches[3]));
+                info.format.channels = static_cast<uint8_t>(std::stoi(matches[4]));
+                if (info.encoding == "L16") {
+                    info.format.bit_depth = 16;
+                } else if (info.encoding == "L24") {
+                    info.format.bit_depth = 24;
+                } else if (info.encoding == "L32") {
+                    info.format.bit_depth = 32;
+                }
+            }
+        } else if (line.substr(0, 11) == "a=mediaclk:") {
+            if (!MediaClock::parse_mediaclk(line, info.media_clock_offset)) {
+                info.media_clock_offset = 0;
+            }
+        } else if (line.substr(0, 8) == "a=ptime:") {
+            double ptime = std::stod(line.substr(8));
+            info.packet_time_us = static_cast<uint32_t>(std::lround(ptime * 1000));
+        } else if (line.substr(0, 12) == "a=ts-refclk:") {
+            if (line.find("ptp=IEEE1588") != std::string::npos) {
+                std::regex ptp_regex(R"(ptp=IEEE1588-\d+:([0-9A-Fa-f:-]+))");
+                std::smatch matches;
+                if (std::regex_search(line, matches, ptp_regex)) {
+                    info.ptp_clock_id = matches[1];
+                }
+            }
+        }
+    }
+    
+    info.is_valid = !info.source_ip.empty() && info.port > 0 &&
+                    info.format.sample_rate > 0 && info.format.channels > 0;
+    return info;
+}
+
+std::vector<std::string> default_corpus() {
+    std::vector<std::string> corpus;
+    
+    AudioFormat format;
+    format.sample_rate = 48000;
+    format.channels = 8;
+    format.bit_depth = 24;
+    corpus.push_back(SDPGenerator::generate("239.69.1.10", 5004, 97, format, "Stage Left",
+                                            1311738121, "192.168.1.20", 125));
+    format.channels = 2;
+    format.bit_depth = 16;
+    corpus.push_back(SDPGenerator::generate("239.69.1.11", 5004, 96, format, "Talkback",
+                                            1311738122, "192.168.1.20", 1000));
+    
+    // Typical third-party sender with a source filter and a clock identity
+    corpus.push_back(
+        "v=0\r\n"
+        "o=- 1423986 1423994 IN IP4 169.254.98.63\r\n"
+        "s=AOIP44-serial-1614 : 2\r\n"
+        "c=IN IP4 239.65.45.154/32\r\n"
+        "t=0 0\r\n"
+        "a=keywds:Dante\r\n"
+        "m=audio 5004 RTP/AVP 97\r\n"
+        "i=2 channels: TxChan 0, TxChan 1\r\n"
+        "a=recvonly\r\n"
+        "a=rtpmap:97 L24/48000/2\r\n"
+        "a=ptime:1\r\n"
+        "a=ts-refclk:ptp=IEEE1588-2008:00-1D-C1-FF-FE-0E-10-C4:0\r\n"
+        "a=mediaclk:direct=3367415686\r\n"
+        "a=source-filter: incl IN IP4 239.65.45.154 169.254.98.63\r\n");
+    
+    // Redundant pair: two audio sections (ST 2022-7 style)
+    corpus.push_back(
+        "v=0\r\n"
+        "o=- 2872541 2872541 IN IP4 10.10.1.5\r\n"
+        "s=Program A\r\n"
+        "t=0 0\r\n"
+        "a=group:DUP primary secondary\r\n"
+        "m=audio 5004 RTP/AVP 98\r\n"
+        "c=IN IP4 239.10.1.5/64\r\n"
+        "a=source-filter: incl IN IP4 239.10.1.5 10.10.1.5\r\n"
+        "a=rtpmap:98 L24/96000/4\r\n"
+        "a=ptime:0.250\r\n"
+        "a=framecount:24\r\n"
+        "a=ts-refclk:ptp=IEEE1588-2008:AC-DE-48-FF-FE-23-45-67:0\r\n"
+        "a=mediaclk:direct=0\r\n"
+        "a=mid:primary\r\n"
+        "m=audio 5004 RTP/AVP 98\r\n"
+        "c=IN IP4 239.20.1.5/64\r\n"
+        "a=source-filter: incl IN IP4 239.20.1.5 10.20.1.5\r\n"
+        "a=rtpmap:98 L24/96000/4\r\n"
+        "a=ptime:0.250\r\n"
+        "a=framecount:24\r\n"
+        "a=ts-refclk:ptp=IEEE1588-2008:AC-DE-48-FF-FE-23-45-67:0\r\n"
+        "a=mediaclk:direct=0\r\n"
+        "a=mid:secondary\r\n");
+    return corpus;
+}
+
+bool same_stream(const SDPInfo& a, const SDPInfo& b) {
+    return a.is_valid == b.is_valid && a.source_ip == b.source_ip && a.port == b.port &&
+           a.payload_type == b.payload_type && a.encoding == b.encoding &&
+           a.format.sample_rate == b.format.sample_rate && a.format.channels == b.format.channels &&
+           a.format.bit_depth == b.format.bit_depth && a.packet_time_us == b.packet_time_us &&
+           a.ptp_clock_id == b.ptp_clock_id && a.media_clock_offset == b.media_clock_offset &&
+           a.session_id == b.session_id && a.origin_address == b.origin_address;
+}
+
+template <typename Parse>
+double parses_per_second(const std::vector<std::string>& corpus, uint64_t iterations, Parse parse) {
+    size_t valid = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < iterations; ++i) {
+        valid += parse(corpus[i % corpus.size()]).is_valid ? 1 : 0;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (valid == 0) {
+        std::cerr << "No description parsed as valid\n";
+    }
+    return seconds > 0.0 ? static_cast<double>(iterations) / seconds : 0.0;
+}
+
+void print_usage(const char* program) {
+    std::cout << "Usage: " << program << " [options] [file.sdp ...]\n"
+              << "\n"
+              << "Options:\n"
+              << "  --iterations N        Parses per parser (default: 20000)\n"
+              << "  -h, --help            Show this help\n"
+              << "\n"
+              << "Files given on the command line replace the built-in corpus.\n";
+}
+
+bool parse_options(int argc, char* argv[], BenchOptions& options) {
+    static struct option long_options[] = {
+        {"iterations", required_argument, nullptr, 'n'},
+        {"help", no_argument, nullptr, 'h'},
+        {nullptr, 0, nullptr, 0}
+    };
+    
+    int opt;
+    while ((opt = getopt_long(argc, argv, "h", long_options, nullptr)) != -1) {
+        switch (opt) {
+            case 'n': options.iterations = std::stoull(optarg); break;
+            case 'h':
+                print_usage(argv[0]);
+                std::exit(0);
+            default: return false;
+        }
+    }
+    for (int i = optind; i < argc; ++i) {
+        options.files.emplace_back(argv[i]);
+    }
+    return options.iterations > 0;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    if (!parse_options(argc, argv, options)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    Logger::init("sdp_bench", LogLevel::Error);
+    
+    std::vector<std::string> corpus;
+    for (const auto& file : options.files) {
+        std::ifstream in(file);
+        if (!in) {
+            std::cerr << "Cannot read " << file << "\n";
+            return 1;
+        }
+        std::ostringstream text;
+        text << in.rdbuf();
+        corpus.push_back(text.str());
+    }
+    if (corpus.empty()) {
+        corpus = default_corpus();
+    }
+    
+    // The stream fields must match before the timing means anything. The
+    // regex parser let later m= sections overwrite the first, so only
+    // single-section descriptions are compared
+    bool agree = true;
+    for (size_t i = 0; i < corpus.size(); ++i) {
+        SDPInfo info = SDPParser::parse(corpus[i]);
+        if (info.media.size() <= 1 && !same_stream(info, regex_parse(corpus[i]))) {
+            std::cerr << "Description " << i << ": parsers disagree";
+            if (info.error) {
+                std::cerr << " (line " << info.error.line << ": " << info.error.message << ")";
+            }
+            std::cerr << "\n";
+            agree = false;
+        }
+    }
+    
+    double regex_rate = parses_per_second(corpus, options.iterations,
+                                          [](const std::string& sdp) { return regex_parse(sdp); });
+    double parser_rate = parses_per_second(corpus, options.iterations,
+                                           [](const std::string& sdp) { return SDPParser::parse(sdp); });
+    
+    std::cout << std::fixed << std::setprecision(2)
+              << corpus.size() << " descriptions, " << options.iterations << " parses each\n"
+              << std::left << std::setw(10) << "parser" << std::right
+              << std::setw(14) << "parses/s" << std::setw(12) << "us/parse" << "\n"
+              << std::left << std::setw(10) << "regex" << std::right
+              << std::setw(14) << regex_rate << std::setw(12) << 1e6 / regex_rate << "\n"
+              << std::left << std::setw(10) << "sdp" << std::right
+              << std::setw(14) << parser_rate << std::setw(12) << 1e6 / parser_rate << "\n"
+              << "speedup   " << parser_rate / regex_rate << "x\n";
+    
+    return agree ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: MIT
+/*
+ * RPi-AES67 - Professional AES67 Sender/Receiver for Raspberry Pi 5
+ * Copyright (c) 2025 DHPKE
+ *
+ * PTP-timed scheduler for IS-05 scheduled activations.
+ */
+
+#pragma once
+
+#include <memory>
+#include <functional>
+#include <cstdint>
+
+namespace rpi_aes67 {
+
+class PTPSync;
+
+/**
+ * @brief Activation scheduler configuration
+ */
+struct ActivationSchedulerConfig {
+    int64_t prepare_lead_ns = 500000000;    // Run the prepare step this long before the deadline
+    int64_t spin_ns = 200000;               // Busy-wait the last stretch instead of sleeping
+};
+
+/**
+ * @brief Activation scheduler statistics
+ */
+struct ActivationSchedulerStatistics {
+    uint64_t scheduled = 0;
+    uint64_t fired = 0;
+    uint64_t cancelled = 0;
+    uint64_t late = 0;                  // Deadline already passed when scheduled
+    uint64_t overrun = 0;               // Prepare step still running at an on-time deadline
+    int64_t last_error_ns = 0;          // Fire step start minus deadline, last activation
+    int64_t max_error_ns = 0;           // Largest |error| of on-time activations
+    uint32_t pending = 0;
+};
+
+/**
+ * @brief Runs actions at PTP (TAI) instants
+ *
+ * Pending actions sit in a min-heap keyed on their next event: the
+ * prepare step at deadline - prepare_lead_ns, then the fire step at the
+ * deadline. The thread sleeps until shortly before the next event,
+ * re-reading PTP time as it goes so servo slewing is followed, and spins
+ * the final spin_ns so the fire step starts within microseconds of the
+ * deadline. Each prepare step runs on a thread of its own, so a slow one
+ * never delays another action; an action still preparing at its deadline
+ * fires as soon as its prepare returns. Without a synchronized PTPSync,
+ * CLOCK_TAI is used.
+ */
+class ActivationScheduler {
+public:
+    using Action = std::function<void()>;
+    
+    ActivationScheduler();
+    ~ActivationScheduler();
+    
+    // Non-copyable, non-movable
+    ActivationScheduler(const ActivationScheduler&) = delete;
+    ActivationScheduler& operator=(const ActivationScheduler&) = delete;
+    ActivationScheduler(ActivationScheduler&&) = delete;
+    ActivationScheduler& operator=(ActivationScheduler&&) = delete;
+    
+    /**
+     * @brief Start the scheduler thread
+     * @param config Scheduler configuration
+     * @param ptp PTP time source (may be null)
+     * @return true on success
+     */
+    bool start(const ActivationSchedulerConfig& config, std::shared_ptr<PTPSync> ptp);
+    
+    /**
+     * @brief Stop the thread; pending actions are dropped
+     */
+    void stop();
+    
+    /**
+     * @brief Check if the scheduler is running
+     */
+    [[nodiscard]] bool is_running() const;
+    
+    /**
+     * @brief Schedule an action
+     *
+     * The prepare step runs on a thread of its own, the fire step on the
+     * scheduler thread (or right after a prepare that overran the
+     * deadline). A deadline already in the past prepares and fires at once.
+     * @param deadline_ns TAI time in nanoseconds
+     * @param prepare Run ahead of the deadline (may be empty)
+     * @param fire Run at the deadline
+     * @return Handle for cancel(), 0 if the scheduler is not running
+     */
+    uint64_t schedule(int64_t deadline_ns, Action prepare, Action fire);
+    
+    /**
+     * @brief Cancel a pending action
+     * @return true if it had not fired yet
+     */
+    bool cancel(uint64_t handle);
+    
+    /**
+     * @brief Current time on the scheduler's time base (TAI nanoseconds)
+     */
+    [[nodiscard]] int64_t now_ns() const;
+    
+    /**
+     * @brief Get scheduler statistics
+     */
+    [[nodiscard]] ActivationSchedulerStatistics get_statistics() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace rpi_aes67
@@ -79,6 +79,11 @@ struct SenderConfig {
     std::string pipewire_source;
     bool enabled = true;
     uint32_t packet_time_us = 1000;  // 1ms default for AES67
+    std::string tx_mode = "inline";     // "inline" (send from the audio callback) or "thread" (paced TX thread)
+    std::string tx_pacing = "deadline"; // TX thread pacing: "deadline", "txtime" (fq qdisc) or "etf"
+    uint32_t tx_queue_ms = 50;          // TX thread queue (at least two PipeWire quanta)
+    int tx_cpu = -1;                    // TX thread CPU affinity (-1 = any CPU)
+    int tx_priority = 0;                // TX thread SCHED_FIFO priority (0 = keep default policy)
 };
 
 /**
@@ -93,6 +98,10 @@ struct ReceiverConfig {
     std::vector<uint8_t> bit_depths = {16, 24};
     std::string pipewire_sink;
     bool enabled = true;
+    std::string receive_mode = "recvmmsg";  // "recvmmsg" (batched), "poll", "io_uring" or "packet_ring"
+    uint32_t rx_batch_size = 32;            // Datagrams per recvmmsg call
+    uint32_t rx_batch_timeout_us = 100000;  // Max blocking time per receive call
+    uint32_t rx_ring_buffers = 256;         // io_uring provided buffers (power of two)
 };
 
 /**
@@ -101,10 +110,14 @@ struct ReceiverConfig {
 struct NetworkConfig {
     std::string interface = "eth0";
     uint8_t ptp_domain = 0;
+    std::string ptp_backend = "internal";           // "internal" or "linuxptp"
+    std::string ptp_uds_path = "/var/run/ptp4l";    // ptp4l management socket (linuxptp)
     std::string registry_url;
     bool enable_mdns = true;
     uint16_t node_port = 8080;
     uint16_t connection_port = 8081;
+    uint32_t http_workers = 2;                      // NMOS API request handler threads
+    uint32_t activation_lead_ms = 500;              // Prepare lead for scheduled activations
 };
 
 /**
@@ -115,6 +128,17 @@ struct AudioProcessingConfig {
     double jitter_buffer_ms = 10.0;
     uint32_t buffer_frames = 256;
     bool enable_sample_rate_conversion = true;
+    std::string playout_mode = "adaptive";  // "adaptive" (buffer fill) or "ptp" (media clock + link offset)
+    uint32_t link_offset_samples = 480;     // PTP playout delay behind media time
+    bool pull_playout = false;              // Render from the PipeWire graph callback (no playout thread)
+    std::string receiver_threading = "engine";  // "engine" (shared workers) or "per_receiver" (own threads)
+    uint32_t receiver_workers = 0;          // Engine worker threads (0 = one per CPU core)
+    std::vector<int> receiver_worker_cpus;  // CPU of each engine worker (empty = any CPU)
+    int receiver_worker_priority = 0;       // Engine worker SCHED_FIFO priority (0 = keep default policy)
+    uint32_t packet_ring_block_kb = 256;    // Shared packet ring block size
+    uint32_t packet_ring_blocks = 32;       // Shared packet ring block count
+    uint32_t packet_ring_timeout_ms = 1;    // Retire a partly filled ring block after this long
+    int packet_ring_cpu = -1;               // CPU of the packet ring thread (-1 = any CPU)
 };
 
 /**
@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: MIT
+/*
+ * RPi-AES67 - Professional AES67 Sender/Receiver for Raspberry Pi 5
+ * Copyright (c) 2025 DHPKE
+ *
+ * Event-driven HTTP/1.1 server for the NMOS APIs: one epoll thread for
+ * all connections and a small pool of request workers.
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+
+namespace rpi_aes67 {
+
+/**
+ * @brief HTTP server configuration
+ */
+struct HttpServerConfig {
+    std::vector<uint16_t> ports;        // Listening ports (duplicates and 0 are skipped)
+    uint32_t workers = 2;               // Request handler threads
+    uint32_t max_connections = 256;     // Further connections are closed on accept
+    size_t max_header_bytes = 16 * 1024;
+    size_t max_body_bytes = 1024 * 1024;
+    uint32_t idle_timeout_ms = 30000;   // Close keep-alive connections idle this long
+};
+
+/**
+ * @brief HTTP server statistics
+ */
+struct HttpServerStatistics {
+    uint64_t connections = 0;           // Connections accepted
+    uint64_t requests = 0;              // Requests handled
+    uint64_t reused = 0;                // Requests on an already used connection
+    uint64_t rejected = 0;              // Malformed or oversized requests
+    uint32_t open_connections = 0;
+};
+
+/**
+ * @brief Parsed HTTP request
+ */
+struct HttpRequest {
+    std::string method;
+    std::string target;                 // Request target as sent
+    std::string path;                   // Target without the query
+    std::string query;
+    std::vector<std::pair<std::string, std::string>> headers;   // Names lower-cased
+    std::string body;                   // Content-Length or de-chunked body
+    uint16_t port = 0;                  // Local port the request arrived on
+    
+    /**
+     * @brief Header value by lower-case name (empty if absent)
+     */
+    [[nodiscard]] std::string_view header(std::string_view name) const;
+};
+
+/**
+ * @brief HTTP response
+ */
+struct HttpResponse {
+    int status = 200;
+    std::string content_type = "application/json";
+    std::vector<std::pair<std::string, std::string>> headers;   // Extra headers
+    std::string body;
+    std::shared_ptr<const std::string> shared_body;             // Sent instead of body when set
+};
+
+/**
+ * @brief Non-blocking HTTP/1.1 server
+ *
+ * One thread owns every listening and client socket in an epoll set and
+ * parses requests incrementally (Content-Length and chunked bodies), so a
+ * slow client never blocks the others. Complete requests go to a pool of
+ * worker threads that run the handler. Connections are persistent unless
+ * the client asks otherwise; pipelined requests on one connection are
+ * handled one after another and answered in order.
+ */
+class HttpServer {
+public:
+    /**
+     * @brief Request handler, called on a worker thread
+     *
+     * Exceptions are answered with 500 Internal Server Error.
+     */
+    using Handler = std::function<HttpResponse(const HttpRequest&)>;
+    
+    HttpServer();
+    ~HttpServer();
+    
+    // Non-copyable, non-movable
+    HttpServer(const HttpServer&) = delete;
+    HttpServer& operator=(const HttpServer&) = delete;
+    HttpServer(HttpServer&&) = delete;
+    HttpServer& operator=(HttpServer&&) = delete;
+    
+    /**
+     * @brief Bind the ports and start the event and worker threads
+     * @param config Server configuration
+     * @param handler Request handler
+     * @return true if every port was bound
+     */
+    bool start(const HttpServerConfig& config, Handler handler);
+    
+    /**
+     * @brief Close all connections and join the threads
+     */
+    void stop();
+    
+    /**
+     * @brief Check if the server is running
+     */
+    [[nodiscard]] bool is_running() const;
+    
+    /**
+     * @brief Get server statistics
+     */
+    [[nodiscard]] HttpServerStatistics get_statistics() const;
+    
+    /**
+     * @brief Standard reason phrase for a status code
+     */
+    static const char* reason_phrase(int status);
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace rpi_aes67
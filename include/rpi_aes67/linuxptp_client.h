@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: MIT
+/*
+ * RPi-AES67 - Professional AES67 Sender/Receiver for Raspberry Pi 5
+ * Copyright (c) 2025 DHPKE
+ *
+ * linuxptp management client. Talks to a running ptp4l over its
+ * Unix-domain management socket (the protocol pmc uses) and subscribes to
+ * its port state and time sync notifications.
+ */
+
+#pragma once
+
+#include <string>
+#include <memory>
+#include <cstdint>
+
+namespace rpi_aes67 {
+
+// Management TLV IDs (IEEE 1588 Table 59, linuxptp extensions)
+constexpr uint16_t PMC_CURRENT_DATA_SET = 0x2001;
+constexpr uint16_t PMC_PARENT_DATA_SET = 0x2002;
+constexpr uint16_t PMC_TIME_PROPERTIES_DATA_SET = 0x2003;
+constexpr uint16_t PMC_PORT_DATA_SET = 0x2004;
+constexpr uint16_t PMC_TIME_STATUS_NP = 0xC000;
+constexpr uint16_t PMC_SUBSCRIBE_EVENTS_NP = 0xC003;
+
+/**
+ * @brief ptp4l port states (portDS.portState)
+ */
+enum class LinuxPTPPortState : uint8_t {
+    Unknown = 0,
+    Initializing = 1,
+    Faulty = 2,
+    Disabled = 3,
+    Listening = 4,
+    PreMaster = 5,
+    Master = 6,
+    Passive = 7,
+    Uncalibrated = 8,
+    Slave = 9
+};
+
+/**
+ * @brief ptp4l state assembled from management responses and notifications
+ */
+struct LinuxPTPStatus {
+    // TIME_STATUS_NP
+    int64_t master_offset_ns = 0;
+    int64_t ingress_time_ns = 0;
+    bool gm_present = false;
+    uint64_t gm_identity = 0;
+    
+    // CURRENT_DATA_SET
+    uint16_t steps_removed = 0;
+    int64_t offset_from_master_ns = 0;
+    double mean_path_delay_ns = 0.0;
+    
+    // PORT_DATA_SET
+    LinuxPTPPortState port_state = LinuxPTPPortState::Unknown;
+    int8_t log_sync_interval = 0;
+    
+    // TIME_PROPERTIES_DATA_SET
+    int16_t current_utc_offset = 37;
+    bool current_utc_offset_valid = false;
+    
+    // PARENT_DATA_SET
+    uint8_t gm_priority1 = 128;
+    uint8_t gm_priority2 = 128;
+    uint8_t gm_clock_class = 248;
+    uint8_t gm_clock_accuracy = 0xFE;
+};
+
+/**
+ * @brief Client for the ptp4l management socket
+ *
+ * Not thread-safe; use from one thread.
+ */
+class LinuxPTPClient {
+public:
+    LinuxPTPClient();
+    ~LinuxPTPClient();
+    
+    LinuxPTPClient(const LinuxPTPClient&) = delete;
+    LinuxPTPClient& operator=(const LinuxPTPClient&) = delete;
+    
+    /**
+     * @brief Connect to ptp4l
+     * @param uds_path ptp4l management socket (uds_address, default /var/run/ptp4l)
+     * @param domain PTP domain ptp4l runs in
+     * @return true on success
+     */
+    bool open(const std::string& uds_path, uint8_t domain);
+    
+    /**
+     * @brief Close the socket
+     */
+    void close();
+    
+    /**
+     * @brief Check if connected
+     */
+    [[nodiscard]] bool is_open() const;
+    
+    /**
+     * @brief Send a GET request for a management ID
+     * @return true if sent
+     */
+    bool get(uint16_t management_id);
+    
+    /**
+     * @brief Subscribe to port state and time sync notifications
+     * @param duration_s Subscription lifetime; renew before it expires
+     * @return true if sent
+     */
+    bool subscribe(uint16_t duration_s);
+    
+    /**
+     * @brief Wait for one management message and merge it into @p status
+     * @param status Status to update
+     * @param timeout_ms Longest time to block
+     * @return Management ID of the message applied, 0 on timeout or error
+     */
+    uint16_t receive(LinuxPTPStatus& status, int timeout_ms);
+    
+    /**
+     * @brief Port state as string
+     */
+    [[nodiscard]] static const char* port_state_to_string(LinuxPTPPortState state);
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace rpi_aes67
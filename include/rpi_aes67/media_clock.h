@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: MIT
+/*
+ * RPi-AES67 - Professional AES67 Sender/Receiver for Raspberry Pi 5
+ * Copyright (c) 2025 DHPKE
+ *
+ * Media clock (RFC 7273 "direct" mode): exact conversion between PTP time
+ * and RTP timestamps for a sample rate.
+ */
+
+#pragma once
+
+#include <string_view>
+#include <numeric>
+#include <cstdint>
+
+namespace rpi_aes67 {
+
+/**
+ * @brief Sample rate as a reduced fraction of the nanosecond clock
+ *
+ * samples = ns * num / den with num/den = sample_rate / 1e9 in lowest
+ * terms (48 kHz: 3/62500). Splitting into quotient and remainder by den
+ * keeps every intermediate product below 2^64 for any PTP time.
+ */
+struct MediaClockRate {
+    uint32_t sample_rate = 0;
+    uint64_t num = 0;
+    uint64_t den = 1;
+    
+    static constexpr MediaClockRate make(uint32_t sample_rate) {
+        uint64_t divisor = std::gcd<uint64_t, uint64_t>(sample_rate, 1000000000ULL);
+        if (divisor == 0) return MediaClockRate{};
+        return MediaClockRate{sample_rate, sample_rate / divisor, 1000000000ULL / divisor};
+    }
+    
+    /**
+     * @brief Whole samples elapsed at @p ns (floor)
+     */
+    [[nodiscard]] constexpr uint64_t samples_at(uint64_t ns) const {
+        return (ns / den) * num + ((ns % den) * num) / den;
+    }
+    
+    /**
+     * @brief First nanosecond at which sample @p samples has begun (ceiling)
+     *
+     * samples_at(ns_at(n)) == n for every n.
+     */
+    [[nodiscard]] constexpr uint64_t ns_at(uint64_t samples) const {
+        if (num == 0) return 0;
+        return (samples / num) * den + ((samples % num) * den + num - 1) / num;
+    }
+};
+
+// AES67 rates, precomputed
+constexpr MediaClockRate MEDIA_CLOCK_44100 = MediaClockRate::make(44100);
+constexpr MediaClockRate MEDIA_CLOCK_48000 = MediaClockRate::make(48000);
+constexpr MediaClockRate MEDIA_CLOCK_96000 = MediaClockRate::make(96000);
+
+static_assert(MEDIA_CLOCK_48000.num == 3 && MEDIA_CLOCK_48000.den == 62500);
+static_assert(MEDIA_CLOCK_48000.samples_at(1000000000ULL) == 48000);
+static_assert(MEDIA_CLOCK_44100.ns_at(44100) == 1000000000ULL);
+
+/**
+ * @brief Media clock of one stream
+ *
+ * RTP timestamp = (samples since the PTP epoch + offset) mod 2^32, where
+ * offset is the SDP a=mediaclk:direct= value. All conversions are exact
+ * integer arithmetic; none allocate or block, so they are safe from
+ * real-time threads.
+ */
+class MediaClock {
+public:
+    MediaClock() : MediaClock(48000) {}
+    
+    /**
+     * @brief Create a media clock
+     * @param sample_rate Sample rate in Hz
+     * @param offset RTP timestamp offset (a=mediaclk:direct=)
+     */
+    explicit MediaClock(uint32_t sample_rate, uint32_t offset = 0);
+    
+    [[nodiscard]] uint32_t sample_rate() const { return rate_.sample_rate; }
+    [[nodiscard]] uint32_t offset() const { return offset_; }
+    [[nodiscard]] const MediaClockRate& rate() const { return rate_; }
+    
+    /**
+     * @brief Whole samples since the PTP epoch at a PTP time
+     */
+    [[nodiscard]] uint64_t samples_at(uint64_t ptp_ns) const { return rate_.samples_at(ptp_ns); }
+    
+    /**
+     * @brief RTP timestamp of the sample playing at a PTP time
+     */
+    [[nodiscard]] uint32_t rtp_timestamp(uint64_t ptp_ns) const {
+        return static_cast<uint32_t>(rate_.samples_at(ptp_ns)) + offset_;
+    }
+    
+    /**
+     * @brief PTP time of an RTP timestamp
+     *
+     * The 32-bit timestamp wraps every 2^32 samples (about 24.9 hours at
+     * 48 kHz); it is unfolded to the occurrence nearest @p reference_ptp_ns.
+     *
+     * @param rtp_timestamp RTP timestamp (including the stream offset)
+     * @param reference_ptp_ns PTP time within half a wrap of the sample (usually now)
+     * @return PTP time in nanoseconds at which the sample begins
+     */
+    [[nodiscard]] uint64_t ptp_time(uint32_t rtp_timestamp, uint64_t reference_ptp_ns) const;
+    
+    /**
+     * @brief Rate constants for a sample rate (precomputed for 44.1/48/96 kHz)
+     */
+    [[nodiscard]] static MediaClockRate rate_for(uint32_t sample_rate);
+    
+    /**
+     * @brief Parse the value of an SDP a=mediaclk attribute
+     *
+     * Accepts "direct=<offset>" optionally followed by further parameters
+     * (e.g. "direct=0 rate=48000/1"), with or without the "a=mediaclk:" prefix.
+     *
+     * @param attribute Attribute text
+     * @param offset Parsed RTP offset
+     * @return true if the attribute is a well-formed direct reference
+     */
+    static bool parse_mediaclk(std::string_view attribute, uint32_t& offset);
+
+private:
+    MediaClockRate rate_;
+    uint32_t offset_ = 0;
+};
+
+}  // namespace rpi_aes67
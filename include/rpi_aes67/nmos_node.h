@@ -22,6 +22,7 @@ namespace rpi_aes67 {
 // Forward declarations
 class AES67Sender;
 class AES67Receiver;
+class PTPSync;
 
 /**
  * @brief NMOS resource types
@@ -269,10 +270,24 @@ public:
     
     /**
      * @brief Set callback for receiver connection requests
+     *
+     * Replaces the built-in receiver connect/disconnect on activation. It
+     * may be called concurrently for different receivers during a bulk
+     * activation.
      * @param callback Connection request handler
      */
     void set_connection_callback(ConnectionCallback callback);
     
+    /**
+     * @brief Set the time source for scheduled activations
+     *
+     * Scheduled IS-05 activations fire on this PTP time base, aligned to a
+     * media sample boundary. Without one, or while it is unsynchronized,
+     * CLOCK_TAI is used. Call before start().
+     * @param ptp PTP synchronization instance
+     */
+    void set_ptp_sync(std::shared_ptr<PTPSync> ptp);
+    
     /**
      * @brief Make a connection request to a sender
      * @param sender_id Target sender ID
@@ -320,6 +335,16 @@ public:
      */
     ConnectionResponse activate_connection(const std::string& receiver_id);
     
+    /**
+     * @brief Activate the staged connections of several receivers at once
+     *
+     * The receivers are switched in parallel, so the call takes about as
+     * long as the slowest one.
+     * @param receiver_ids Receiver IDs
+     * @return One response per receiver, in order
+     */
+    std::vector<ConnectionResponse> activate_connections(const std::vector<std::string>& receiver_ids);
+    
     // ==================== Node Information ====================
     
     /**
@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: MIT
+/*
+ * RPi-AES67 - Professional AES67 Sender/Receiver for Raspberry Pi 5
+ * Copyright (c) 2025 DHPKE
+ *
+ * Shared AF_PACKET / TPACKET_V3 capture ring that demultiplexes the RTP
+ * streams of many receivers from one memory-mapped ring.
+ */
+
+#pragma once
+
+#include <string>
+#include <memory>
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+
+namespace rpi_aes67 {
+
+/**
+ * @brief Packet ring configuration
+ */
+struct PacketRingConfig {
+    std::string interface = "eth0";
+    uint32_t block_size = 256 * 1024;   // Bytes per ring block (multiple of the page size)
+    uint32_t block_count = 32;          // Blocks in the ring
+    uint32_t frame_size = 2048;         // Largest captured frame
+    uint32_t block_timeout_ms = 1;      // Retire a partly filled block after this long
+    int cpu = -1;                       // CPU the ring thread is pinned to (-1 = any)
+    int priority = 0;                   // Ring thread SCHED_FIFO priority (0 = default policy)
+};
+
+/**
+ * @brief Packet ring statistics
+ */
+struct PacketRingStatistics {
+    uint64_t blocks = 0;                // Blocks walked
+    uint64_t packets = 0;               // Frames delivered to a subscriber
+    uint64_t unmatched = 0;             // Frames that passed the filter but had no subscriber
+    uint64_t kernel_packets = 0;        // Frames the kernel accepted into the ring
+    uint64_t kernel_drops = 0;          // Frames dropped because the ring was full
+    uint64_t freezes = 0;               // Times the ring filled up
+    uint32_t subscriptions = 0;
+    bool filter_exact = true;           // false if too many subscriptions for an exact filter
+};
+
+/**
+ * @brief Memory-mapped receive ring for many UDP streams
+ *
+ * Opens one AF_PACKET socket with a TPACKET_V3 ring on an interface. A
+ * classic BPF filter, rebuilt on every subscribe/unsubscribe, admits only
+ * IPv4/UDP frames to the subscribed destination address:port pairs. One
+ * thread walks each retired block and hands every payload to its
+ * subscriber straight from the mapped ring, so N streams cost one wakeup
+ * per block instead of one socket read per packet.
+ *
+ * A block is retired when it is full or block_timeout_ms after its first
+ * frame, whichever comes first; the timeout bounds the added latency.
+ *
+ * The ring captures frames but does not join groups: subscribers keep
+ * their own socket for IGMP membership (see AES67Receiver), which also
+ * keeps unicast streams from generating ICMP port unreachable replies.
+ */
+class PacketRing {
+public:
+    /**
+     * @brief Payload handler: UDP payload, length and kernel receive time
+     *
+     * Runs on the ring thread; the data is only valid during the call.
+     */
+    using Handler = std::function<void(const uint8_t* data, size_t size, const timespec& kernel_ts)>;
+    
+    PacketRing();
+    ~PacketRing();
+    
+    // Non-copyable, non-movable
+    PacketRing(const PacketRing&) = delete;
+    PacketRing& operator=(const PacketRing&) = delete;
+    PacketRing(PacketRing&&) = delete;
+    PacketRing& operator=(PacketRing&&) = delete;
+    
+    /**
+     * @brief Create the ring on the interface and start the ring thread
+     * @param config Ring configuration
+     * @return true on success (needs CAP_NET_RAW)
+     */
+    bool start(const PacketRingConfig& config);
+    
+    /**
+     * @brief Stop the ring thread and release the ring
+     */
+    void stop();
+    
+    /**
+     * @brief Check if the ring is running
+     */
+    [[nodiscard]] bool is_running() const;
+    
+    /**
+     * @brief Deliver datagrams sent to address:port to a handler
+     * @param address Destination IPv4 address (multicast group or a local unicast address)
+     * @param port Destination UDP port
+     * @param handler Payload handler
+     * @return false if the address is invalid or the pair is already subscribed
+     */
+    bool subscribe(const std::string& address, uint16_t port, Handler handler);
+    
+    /**
+     * @brief Stop delivering address:port
+     *
+     * When this returns the handler is not running and will not be called
+     * again. Must not be called from a handler.
+     */
+    void unsubscribe(const std::string& address, uint16_t port);
+    
+    /**
+     * @brief Get ring statistics
+     */
+    [[nodiscard]] PacketRingStatistics get_statistics() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace rpi_aes67
@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: MIT
+/*
+ * RPi-AES67 - Professional AES67 Sender/Receiver for Raspberry Pi 5
+ * Copyright (c) 2025 DHPKE
+ *
+ * PCM sample conversion between AES67 wire encodings (L16/L24/L32,
+ * big-endian) and host sample formats (S16/S24/S32 little-endian, F32).
+ * Hot paths are vectorized (NEON, SSE4.1, AVX2) and selected at runtime.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace rpi_aes67 {
+
+/**
+ * @brief AES67 wire encoding (RFC 3190 / RFC 2586, network byte order)
+ */
+enum class PCMEncoding {
+    L16,
+    L24,
+    L32
+};
+
+/**
+ * @brief Host sample format (little-endian, as negotiated with PipeWire)
+ */
+enum class SampleFormat {
+    S16,   // int16_t
+    S24,   // 3-byte packed (SPA_AUDIO_FORMAT_S24_LE)
+    S32,   // int32_t
+    F32    // float, full scale -1.0 .. 1.0
+};
+
+/**
+ * @brief PCM codec kernels
+ *
+ * Decoding maps wire samples to host samples; encoding is the reverse and
+ * clips float input to full scale (NaN encodes as 0). Same-width integer
+ * conversions are pure byte swaps. All functions take a sample count
+ * (frames * channels for interleaved data) and are safe to call from
+ * real-time threads.
+ */
+class PCMCodec {
+public:
+    /**
+     * @brief Instruction set used by the vectorized kernels
+     */
+    enum class Isa {
+        Scalar,
+        SSE4,
+        AVX2,
+        NEON
+    };
+    
+    /**
+     * @brief Kernel set selected for this CPU
+     */
+    [[nodiscard]] static Isa active_isa();
+    
+    /**
+     * @brief Get instruction set as string
+     */
+    [[nodiscard]] static const char* isa_name(Isa isa);
+    
+    /**
+     * @brief Force a kernel set (falls back to scalar if unsupported)
+     * @return The instruction set now in use
+     */
+    static Isa select_isa(Isa isa);
+    
+    /**
+     * @brief Convert interleaved wire samples to host samples
+     * @param src Wire payload
+     * @param encoding Wire encoding
+     * @param dst Host buffer
+     * @param format Host sample format
+     * @param samples Number of samples
+     */
+    static void decode(const uint8_t* src, PCMEncoding encoding,
+                       void* dst, SampleFormat format, size_t samples);
+    
+    /**
+     * @brief Convert interleaved host samples to wire samples
+     * @param src Host buffer
+     * @param format Host sample format
+     * @param dst Wire payload
+     * @param encoding Wire encoding
+     * @param samples Number of samples
+     */
+    static void encode(const void* src, SampleFormat format,
+                       uint8_t* dst, PCMEncoding encoding, size_t samples);
+    
+    /**
+     * @brief Convert interleaved wire samples to one host buffer per channel
+     * @param dst Array of @p channels channel buffers
+     * @param frames Number of frames
+     */
+    static void decode_planar(const uint8_t* src, PCMEncoding encoding,
+                              void* const* dst, SampleFormat format,
+                              size_t frames, uint32_t channels);
+    
+    /**
+     * @brief Convert one host buffer per channel to interleaved wire samples
+     * @param src Array of @p channels channel buffers
+     * @param frames Number of frames
+     */
+    static void encode_planar(const void* const* src, SampleFormat format,
+                              uint8_t* dst, PCMEncoding encoding,
+                              size_t frames, uint32_t channels);
+    
+    /**
+     * @brief Wire encoding for a bit depth (16, 24 or 32)
+     */
+    [[nodiscard]] static PCMEncoding encoding_for(uint8_t bit_depth);
+    
+    /**
+     * @brief Integer host format of the same width as a bit depth
+     */
+    [[nodiscard]] static SampleFormat format_for(uint8_t bit_depth);
+    
+    /**
+     * @brief Bytes per sample
+     */
+    [[nodiscard]] static size_t sample_size(PCMEncoding encoding);
+    [[nodiscard]] static size_t sample_size(SampleFormat format);
+};
+
+}  // namespace rpi_aes67
@@ -41,6 +41,14 @@ struct AudioBuffer {
  */
 using AudioCallback = std::function<void(const AudioBuffer& buffer)>;
 
+/**
+ * @brief Callback that renders playback audio in place
+ *
+ * Called on the PipeWire real-time thread with the mapped output buffer;
+ * must fill all @p frames (silence for gaps) without blocking or allocating.
+ */
+using PullCallback = std::function<void(uint8_t* data, uint32_t frames)>;
+
 /**
  * @brief PipeWire connection state
  */
@@ -186,6 +194,17 @@ public:
      */
     void stop();
     
+    /**
+     * @brief Render playback directly from a callback (pull mode)
+     *
+     * When set, each graph cycle asks the callback for exactly the quantum's
+     * frames, written straight into the PipeWire buffer; write() is unused.
+     * Set before start() and clear after stop().
+     *
+     * @param callback Render callback, or nullptr to return to write()
+     */
+    void set_pull_callback(PullCallback callback);
+    
     /**
      * @brief Write audio data to the output
      * @param buffer Audio data to write
@@ -226,11 +245,31 @@ public:
      */
     void reconnect();
     
+    /**
+     * @brief Set the playback queue latency budget (call before open())
+     *
+     * The lock-free queue between write() and the graph callback holds
+     * twice this many milliseconds of audio.
+     *
+     * @param ms Latency budget in milliseconds
+     */
+    void set_buffer_ms(double ms);
+    
     /**
      * @brief Get available buffer space in frames
      */
     [[nodiscard]] size_t get_available_frames() const;
     
+    /**
+     * @brief Get frames queued for playback
+     */
+    [[nodiscard]] size_t get_buffered_frames() const;
+    
+    /**
+     * @brief Frames dropped by write() because the queue was full
+     */
+    [[nodiscard]] uint64_t get_dropped_frames() const;
+    
     /**
      * @brief List available output devices
      */
@@ -0,0 +1,141 @@
+// SPDX-License-Identifier: MIT
+/*
+ * RPi-AES67 - Professional AES67 Sender/Receiver for Raspberry Pi 5
+ * Copyright (c) 2025 DHPKE
+ *
+ * In-process PTP grandmaster simulator for exercising PTPSync without
+ * PTP hardware (test support; built as the rpi_aes67_ptp_sim library).
+ */
+
+#pragma once
+
+#include <string>
+#include <memory>
+#include <cstdint>
+
+namespace rpi_aes67 {
+
+/**
+ * @brief Grandmaster simulator configuration
+ */
+struct PTPGrandmasterSimConfig {
+    std::string interface = "lo";                   // Loopback or a network namespace veth
+    uint8_t domain = 0;
+    uint16_t event_port = 319;                      // Sync, Delay_Req
+    uint16_t general_port = 320;                    // Announce, Follow_Up, Delay_Resp
+    std::string multicast_address = "224.0.1.129";
+    uint64_t clock_id = 0x0200c0fffe000001ULL;      // Locally administered EUI-64
+    uint8_t priority1 = 128;
+    uint8_t clock_class = 6;                        // Locked to a primary reference
+    int8_t log_sync_interval = -3;                  // 125 ms (AES67 media profile)
+    int8_t log_announce_interval = 0;
+    double frequency_offset_ppm = 0.0;              // Grandmaster rate against CLOCK_MONOTONIC_RAW
+    int64_t initial_time_ns = 0;                    // Grandmaster time at start (0 = system clock)
+    int64_t path_delay_ns = 0;                      // Added one-way delay, both directions
+    int64_t path_delay_jitter_ns = 0;               // Uniform random extra delay per message
+    uint32_t seed = 1;                              // Jitter generator seed (reproducible runs)
+};
+
+/**
+ * @brief Grandmaster simulator counters
+ */
+struct PTPGrandmasterSimStats {
+    uint64_t announces_sent = 0;
+    uint64_t syncs_sent = 0;
+    uint64_t delay_requests = 0;
+    uint64_t delay_responses_sent = 0;
+};
+
+/**
+ * @brief In-process PTP grandmaster
+ *
+ * Runs a two-step, end-to-end master on the UDP/IPv4 mapping on its own
+ * thread: Announce and Sync/Follow_Up on the configured intervals, and a
+ * Delay_Resp for every Delay_Req. Its time scale is a simulated oscillator
+ * over CLOCK_MONOTONIC_RAW, so a follower in the same process can be
+ * compared against time_at() at the same raw instant.
+ *
+ * Path delay and jitter are injected into the reported timestamps rather
+ * than by holding packets: a Sync appears sent earlier and a Delay_Req
+ * received later by the drawn delay, which is what a follower observes
+ * from a longer path. Each direction draws its own jitter.
+ *
+ * Runs on loopback or inside a network namespace; the follower must use
+ * the same interface, domain and ports. Unprivileged ports (e.g.
+ * 31900/32000) avoid needing CAP_NET_BIND_SERVICE.
+ */
+class PTPGrandmasterSim {
+public:
+    PTPGrandmasterSim();
+    ~PTPGrandmasterSim();
+    
+    // Non-copyable, non-movable
+    PTPGrandmasterSim(const PTPGrandmasterSim&) = delete;
+    PTPGrandmasterSim& operator=(const PTPGrandmasterSim&) = delete;
+    PTPGrandmasterSim(PTPGrandmasterSim&&) = delete;
+    PTPGrandmasterSim& operator=(PTPGrandmasterSim&&) = delete;
+    
+    /**
+     * @brief Open the PTP sockets and start the grandmaster thread
+     * @param config Simulator configuration
+     * @return true on success
+     */
+    bool start(const PTPGrandmasterSimConfig& config);
+    
+    /**
+     * @brief Stop the grandmaster thread and close its sockets
+     */
+    void stop();
+    
+    /**
+     * @brief Check if the simulator is running
+     */
+    [[nodiscard]] bool is_running() const;
+    
+    /**
+     * @brief Grandmaster time at a CLOCK_MONOTONIC_RAW instant
+     *
+     * Lock-free; the reference against which a follower's error is measured.
+     */
+    [[nodiscard]] int64_t time_at(int64_t raw_ns) const;
+    
+    /**
+     * @brief Current grandmaster time in nanoseconds
+     */
+    [[nodiscard]] int64_t now() const;
+    
+    /**
+     * @brief Step the grandmaster time (phase step event)
+     * @param offset_ns Step in nanoseconds, positive = forward
+     */
+    void step(int64_t offset_ns);
+    
+    /**
+     * @brief Change the grandmaster frequency offset, continuous in phase
+     * @param ppm Rate against CLOCK_MONOTONIC_RAW in ppm
+     */
+    void set_frequency_offset_ppm(double ppm);
+    
+    /**
+     * @brief Change the injected path delay and jitter
+     */
+    void set_path_delay(int64_t delay_ns, int64_t jitter_ns);
+    
+    /**
+     * @brief Silence or resume the grandmaster (master loss and return)
+     *
+     * The time scale keeps running while silent.
+     */
+    void set_enabled(bool enabled);
+    
+    /**
+     * @brief Get simulator counters
+     */
+    [[nodiscard]] PTPGrandmasterSimStats get_stats() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace rpi_aes67
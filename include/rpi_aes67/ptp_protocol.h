@@ -0,0 +1,175 @@
+// SPDX-License-Identifier: MIT
+/*
+ * RPi-AES67 - Professional AES67 Sender/Receiver for Raspberry Pi 5
+ * Copyright (c) 2025 DHPKE
+ *
+ * IEEE 1588-2019 (PTPv2) message format for the UDP/IPv4 mapping.
+ * Parses and builds the messages an ordinary clock exchanges with its
+ * master, and implements the BMCA data set comparison.
+ */
+
+#pragma once
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+namespace rpi_aes67 {
+
+// UDP ports and primary multicast group (IEEE 1588 Annex C)
+constexpr uint16_t PTP_EVENT_PORT = 319;
+constexpr uint16_t PTP_GENERAL_PORT = 320;
+constexpr const char* PTP_MULTICAST_ADDR = "224.0.1.129";
+
+// flagField bits (octet 0 in the high byte)
+constexpr uint16_t PTP_FLAG_TWO_STEP = 0x0200;
+constexpr uint16_t PTP_FLAG_UNICAST = 0x0400;
+constexpr uint16_t PTP_FLAG_PTP_TIMESCALE = 0x0008;
+
+/**
+ * @brief PTP message types handled by an ordinary clock
+ */
+enum class PTPMessageType : uint8_t {
+    Sync = 0x0,
+    DelayReq = 0x1,
+    FollowUp = 0x8,
+    DelayResp = 0x9,
+    Announce = 0xB,
+    Signaling = 0xC,
+    Management = 0xD
+};
+
+/**
+ * @brief PTP timestamp (48-bit seconds, 32-bit nanoseconds)
+ */
+struct PTPTimestamp {
+    uint64_t seconds = 0;
+    uint32_t nanoseconds = 0;
+    
+    [[nodiscard]] int64_t to_ns() const {
+        return static_cast<int64_t>(seconds) * 1000000000LL + nanoseconds;
+    }
+    
+    static PTPTimestamp from_ns(int64_t ns) {
+        PTPTimestamp ts;
+        ts.seconds = static_cast<uint64_t>(ns / 1000000000LL);
+        ts.nanoseconds = static_cast<uint32_t>(ns % 1000000000LL);
+        return ts;
+    }
+};
+
+/**
+ * @brief Port identity (clock identity + port number)
+ */
+struct PTPPortIdentity {
+    uint64_t clock_id = 0;
+    uint16_t port_number = 0;
+    
+    bool operator==(const PTPPortIdentity& other) const {
+        return clock_id == other.clock_id && port_number == other.port_number;
+    }
+    bool operator!=(const PTPPortIdentity& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief Clock quality as carried in Announce messages
+ */
+struct PTPClockQuality {
+    uint8_t clock_class = 248;
+    uint8_t clock_accuracy = 0xFE;
+    uint16_t offset_scaled_log_variance = 0xFFFF;
+};
+
+/**
+ * @brief Decoded PTP message
+ *
+ * Header fields plus the union of the bodies used by Sync, Delay_Req,
+ * Follow_Up, Delay_Resp and Announce. Fields that a message type does not
+ * carry are left at their defaults.
+ */
+struct PTPMessage {
+    // Common header
+    PTPMessageType type = PTPMessageType::Sync;
+    uint8_t version = 2;
+    uint8_t domain = 0;
+    uint16_t flags = 0;
+    int64_t correction = 0;             // correctionField, nanoseconds * 2^16
+    PTPPortIdentity source_port;
+    uint16_t sequence_id = 0;
+    int8_t log_message_interval = 0x7F;
+    
+    // originTimestamp (Sync, Delay_Req, Announce), preciseOriginTimestamp
+    // (Follow_Up) or receiveTimestamp (Delay_Resp)
+    PTPTimestamp timestamp;
+    
+    // Delay_Resp
+    PTPPortIdentity requesting_port;
+    
+    // Announce
+    int16_t current_utc_offset = 0;
+    uint8_t grandmaster_priority1 = 128;
+    PTPClockQuality grandmaster_clock_quality;
+    uint8_t grandmaster_priority2 = 128;
+    uint64_t grandmaster_identity = 0;
+    uint16_t steps_removed = 0;
+    uint8_t time_source = 0xA0;         // INTERNAL_OSCILLATOR
+    
+    [[nodiscard]] int64_t correction_ns() const { return correction / 65536; }
+    [[nodiscard]] bool two_step() const { return (flags & PTP_FLAG_TWO_STEP) != 0; }
+};
+
+/**
+ * @brief PTPv2 wire format helpers
+ */
+class PTPProtocol {
+public:
+    /**
+     * @brief Decode a PTP message
+     * @param data Datagram payload
+     * @param size Payload size in bytes
+     * @param message Output message
+     * @return true if the datagram is a well-formed PTPv2 message of a supported type
+     */
+    static bool parse(const uint8_t* data, size_t size, PTPMessage& message);
+    
+    /**
+     * @brief Encode a PTP message
+     * @param message Message to encode (messageLength is derived from the type)
+     * @param data Output buffer
+     * @param size Output buffer size
+     * @return Encoded size in bytes, 0 if the buffer is too small or the type unsupported
+     */
+    static size_t serialize(const PTPMessage& message, uint8_t* data, size_t size);
+    
+    /**
+     * @brief Encoded size of a message type (0 if unsupported)
+     */
+    [[nodiscard]] static size_t message_size(PTPMessageType type);
+    
+    /**
+     * @brief BMCA data set comparison of two Announce messages
+     *
+     * Compares grandmaster priority1, clock class, accuracy, variance,
+     * priority2 and identity, then steps removed and sender identity.
+     *
+     * @return Negative if @p a describes the better master, positive if @p b does, 0 if equal
+     */
+    [[nodiscard]] static int compare_announce(const PTPMessage& a, const PTPMessage& b);
+    
+    /**
+     * @brief EUI-64 clock identity from a 48-bit MAC address
+     */
+    [[nodiscard]] static uint64_t clock_identity_from_mac(const uint8_t* mac);
+    
+    /**
+     * @brief Format a clock identity as xx-xx-xx-xx-xx-xx-xx-xx
+     */
+    [[nodiscard]] static std::string clock_identity_to_string(uint64_t clock_id);
+    
+    /**
+     * @brief Message type as string
+     */
+    [[nodiscard]] static const char* type_to_string(PTPMessageType type);
+};
+
+}  // namespace rpi_aes67
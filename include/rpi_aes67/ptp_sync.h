@@ -15,6 +15,7 @@
 #include <chrono>
 #include <functional>
 #include <cstdint>
+#include "rpi_aes67/seqlock.h"
 
 namespace rpi_aes67 {
 
@@ -27,7 +28,8 @@ enum class PTPState {
     Uncalibrated,
     Slave,       // Following master
     Passive,
-    Faulty
+    Faulty,
+    Holdover     // Master lost, projecting time from the last frequency estimate
 };
 
 /**
@@ -41,10 +43,35 @@ struct PTPClockInfo {
     uint8_t clock_accuracy;
     int64_t offset_from_master_ns;
     double path_delay_ns;
+    double frequency_offset_ppb;    // Local oscillator error the servo corrects
+    uint16_t steps_removed;
+    int64_t time_uncertainty_ns;    // Bound on the error of get_current_time()
     PTPState state;
     bool synchronized;
 };
 
+/**
+ * @brief PTP time as a linear function of CLOCK_MONOTONIC_RAW
+ *
+ * ptp = ptp_anchor_ns + (raw - raw_anchor_ns) * (1 + rate). Published by
+ * the PTP servo on every update; interpolating with the rate keeps the
+ * time correct between updates.
+ */
+struct PTPTimeScale {
+    int64_t raw_anchor_ns = 0;
+    int64_t ptp_anchor_ns = 0;
+    double rate = 0.0;              // PTP clock rate relative to CLOCK_MONOTONIC_RAW, minus 1
+    bool valid = false;
+    
+    /**
+     * @brief PTP time at a CLOCK_MONOTONIC_RAW instant
+     */
+    [[nodiscard]] int64_t at(int64_t raw_ns) const {
+        int64_t elapsed = raw_ns - raw_anchor_ns;
+        return ptp_anchor_ns + elapsed + static_cast<int64_t>(static_cast<double>(elapsed) * rate);
+    }
+};
+
 /**
  * @brief PTP synchronization callback interface
  */
@@ -72,6 +99,18 @@ struct PTPConfig {
     bool use_hardware_timestamps = false;
     uint32_t announce_interval_ms = 1000;
     uint32_t sync_interval_ms = 125;
+    uint16_t event_port = 319;                      // Sync, Delay_Req
+    uint16_t general_port = 320;                    // Announce, Follow_Up, Delay_Resp
+    std::string multicast_address = "224.0.1.129";
+    double servo_kp = 0.7;                          // PI proportional gain scale
+    double servo_ki = 0.3;                          // PI integral gain scale
+    int64_t step_threshold_ns = 1000000;            // Offsets beyond this step the time scale
+    uint32_t holdover_timeout_s = 600;              // Holdover length before time is no longer valid
+    double holdover_drift_ppb = 1000.0;             // Assumed oscillator instability in holdover
+    double slew_max_ppm = 100.0;                    // Fastest rate correction when a master returns
+    int64_t slew_max_offset_ns = 10000000;          // Larger corrections step instead of slewing
+    std::string backend = "internal";               // "internal" or "linuxptp"
+    std::string uds_path = "/var/run/ptp4l";        // ptp4l management socket (linuxptp)
 };
 
 /**
@@ -79,6 +118,13 @@ struct PTPConfig {
  * 
  * Provides software-based IEEE 1588-2019 PTP follower functionality.
  * Can operate as a virtual PTP follower for AES67 timing synchronization.
+ *
+ * The follower is an ordinary clock on the UDP/IPv4 mapping: it selects a
+ * master from Announce messages (BMCA), measures offset and mean path
+ * delay with the end-to-end Sync/Follow_Up/Delay_Req/Delay_Resp exchange
+ * using kernel software timestamps, and steers an internal PTP time scale
+ * over CLOCK_MONOTONIC_RAW with a PI servo. The system clock is never
+ * adjusted.
  */
 class PTPSync {
 public:
@@ -126,12 +172,47 @@ public:
      */
     [[nodiscard]] bool is_synchronized() const;
     
+    /**
+     * @brief Check if get_current_time() carries PTP time
+     *
+     * True while synchronized and during holdover (master lost, time
+     * projected from the last frequency estimate) until
+     * holdover_timeout_s expires. Media timelines should follow PTP time
+     * while this holds, so a master loss does not make them jump.
+     */
+    [[nodiscard]] bool has_valid_time() const;
+    
+    /**
+     * @brief Bound on the error of get_current_time()
+     * @return Nanoseconds; grows with time spent in holdover, INT64_MAX without valid time
+     */
+    [[nodiscard]] int64_t get_time_uncertainty_ns() const;
+    
     /**
      * @brief Get current PTP time
+     *
+     * Lock-free and free of system calls other than the vDSO clock read;
+     * safe from real-time threads. Falls back to the system clock until
+     * the first synchronization. Continuous across master loss and
+     * return: corrections are slewed in at no more than slew_max_ppm.
+     *
      * @return PTP timestamp in nanoseconds since epoch
      */
     [[nodiscard]] std::chrono::nanoseconds get_current_time() const;
     
+    /**
+     * @brief Get the current time scale (lock-free)
+     *
+     * Lets a caller convert its own CLOCK_MONOTONIC_RAW stamps (e.g. packet
+     * arrival times) into PTP time. Invalid until the first synchronization.
+     */
+    [[nodiscard]] PTPTimeScale get_time_scale() const;
+    
+    /**
+     * @brief Read CLOCK_MONOTONIC_RAW in nanoseconds (steady_clock elsewhere)
+     */
+    [[nodiscard]] static int64_t monotonic_raw_ns();
+    
     /**
      * @brief Get PTP time as 64-bit timestamp
      * @return PTP timestamp value
@@ -201,6 +282,9 @@ private:
  * @brief Local clock with PTP calibration support
  * 
  * Provides a local monotonic clock that can be calibrated against PTP time.
+ * Calibration copies the PTP time scale, offset and rate, so now() keeps
+ * following PTP between calibrations instead of drifting with the local
+ * oscillator.
  */
 class LocalClock {
 public:
@@ -209,6 +293,9 @@ public:
     
     /**
      * @brief Calibrate local clock against PTP reference
+     *
+     * Calls must come from one thread; now() may be called from any.
+     *
      * @param ptp_sync PTP synchronization reference
      */
     void calibrate(const PTPSync& ptp_sync);
@@ -230,9 +317,7 @@ public:
     [[nodiscard]] uint32_t to_rtp_timestamp(uint32_t sample_rate) const;
     
 private:
-    std::atomic<bool> calibrated_;
-    std::atomic<int64_t> offset_ns_;
-    std::chrono::steady_clock::time_point calibration_time_;
+    SeqLock<PTPTimeScale> scale_;
 };
 
 }  // namespace rpi_aes67
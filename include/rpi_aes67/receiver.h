@@ -12,9 +12,14 @@
 #include "config.h"
 #include "pipewire_io.h"
 #include "ptp_sync.h"
+#include "receiver_engine.h"
+#include "packet_ring.h"
 #include <string>
+#include <string_view>
+#include <vector>
 #include <memory>
 #include <atomic>
+#include <chrono>
 #include <functional>
 #include <cstdint>
 
@@ -41,6 +46,15 @@ struct ReceiverStatistics {
     double bitrate_kbps = 0.0;
     uint64_t overruns = 0;
     uint64_t underruns = 0;
+    uint64_t rx_syscalls = 0;           // Receive-path system calls (poll/recv/recvmmsg/io_uring_enter)
+    uint64_t rx_batches = 0;            // recvmmsg calls that returned data
+    uint64_t rx_ring_rearms = 0;        // io_uring multishot receive resubmissions
+    uint64_t rx_ring_no_buffers = 0;    // io_uring receive stalls with every buffer in use
+    double syscalls_per_packet = 0.0;
+    double batch_occupancy = 0.0;       // 0.0 - 1.0, mean fill of each recvmmsg batch
+    double wakeup_latency_us = 0.0;     // Smoothed kernel-to-user delivery delay
+    double wakeup_latency_max_us = 0.0;
+    uint64_t playout_wakeups = 0;       // Playout thread wakeups (signals and deadlines)
     std::chrono::steady_clock::time_point start_time;
     std::chrono::steady_clock::time_point last_packet_time;
 };
@@ -56,8 +70,63 @@ enum class ReceiverState {
     Error
 };
 
+/**
+ * @brief SDP parse error codes
+ */
+enum class SDPErrorCode {
+    None,
+    MalformedLine,          // Not "<type>=<value>", or too few fields
+    InvalidNumber,          // Numeric field missing, out of range or not a number
+    InvalidAddress,         // Not a dotted-quad IPv4 address
+    UnsupportedAddress,     // Connection address type other than IN IP4
+    InvalidMedia,           // Malformed m= line
+    InvalidAttribute,       // Malformed rtpmap, ptime, framecount or source-filter
+    MissingMedia,           // No audio m= section
+    MissingConnection,      // Audio section without a c= line at either level
+    MissingRtpmap           // Dynamic payload type without a matching rtpmap
+};
+
+/**
+ * @brief First error found while parsing an SDP
+ */
+struct SDPError {
+    SDPErrorCode code = SDPErrorCode::None;
+    uint32_t line = 0;                  // 1-based line number (0 = whole description)
+    std::string message;
+    
+    explicit operator bool() const { return code != SDPErrorCode::None; }
+};
+
+/**
+ * @brief One m= section of an SDP
+ *
+ * Session-level c=, a=ts-refclk, a=mediaclk and a=source-filter apply
+ * unless the section overrides them.
+ */
+struct SDPMedia {
+    std::string media;                  // "audio", "video", ...
+    uint16_t port = 0;
+    uint16_t port_count = 1;            // m=<media> <port>/<count>
+    std::string protocol;               // "RTP/AVP"
+    uint8_t payload_type = 0;           // First format listed
+    std::string encoding;
+    AudioFormat format;
+    uint32_t packet_time_us = 1000;
+    uint32_t framecount = 0;            // a=framecount (0 = not given)
+    std::string connection_address;
+    uint8_t ttl = 0;                    // c= multicast TTL suffix (0 = not given)
+    uint16_t address_count = 1;         // c= address count suffix
+    std::string source_filter;          // a=source-filter mode: "incl", "excl" or empty
+    std::vector<std::string> source_addresses;
+    std::string ptp_clock_id;
+    uint32_t media_clock_offset = 0;
+};
+
 /**
  * @brief Parsed SDP information
+ *
+ * The stream fields describe the first audio section; every section is
+ * listed in media.
  */
 struct SDPInfo {
     std::string session_name;
@@ -70,6 +139,14 @@ struct SDPInfo {
     std::string encoding;
     uint32_t packet_time_us = 1000;  // Packet time in microseconds
     std::string ptp_clock_id;
+    uint32_t media_clock_offset = 0;  // a=mediaclk:direct= (RTP timestamp at PTP epoch)
+    uint32_t framecount = 0;          // a=framecount (0 = not given)
+    uint8_t ttl = 0;                  // c= multicast TTL (0 = not given)
+    uint16_t address_count = 1;       // c= address count
+    std::string source_filter;        // a=source-filter mode: "incl", "excl" or empty
+    std::vector<std::string> source_addresses;
+    std::vector<SDPMedia> media;
+    SDPError error;
     bool is_valid = false;
 };
 
@@ -117,6 +194,29 @@ public:
      */
     void set_ptp_sync(std::shared_ptr<PTPSync> ptp);
     
+    /**
+     * @brief Run on a shared receiver engine instead of own threads
+     *
+     * With a running engine, start() attaches the socket and a playout
+     * timer to one engine worker and starts no threads; stop() detaches
+     * them. Without one the receiver runs its own receive and playout
+     * threads.
+     *
+     * @param engine Shared engine (nullptr = own threads)
+     */
+    void set_engine(std::shared_ptr<ReceiverEngine> engine);
+    
+    /**
+     * @brief Receive from a shared packet ring (receive_mode "packet_ring")
+     *
+     * start() subscribes the stream's address and port and starts no
+     * receive thread; the socket only holds the multicast membership. With
+     * no running ring the receiver reads its socket with recvmmsg.
+     *
+     * @param ring Shared packet ring (nullptr = own socket)
+     */
+    void set_packet_ring(std::shared_ptr<PacketRing> ring);
+    
     /**
      * @brief Initialize the receiver
      * @return true on success
@@ -153,9 +253,58 @@ public:
     
     /**
      * @brief Stop receiving
+     *
+     * Also drops a switch prepared with prepare_switch().
      */
     void stop();
-    
+
+    /**
+     * @brief Prepare a switch to a new stream at a PTP instant
+     *
+     * Does the setup connect() and start() would do now, so that the
+     * switch itself needs no system calls. A running receiver binds and
+     * joins the new stream's socket, allocates its jitter buffer and
+     * receives it alongside the current one, keeping only audio from the
+     * switch instant on; once committed, the data path plays the current
+     * stream up to the RTP timestamp of switch_ns and the new one from
+     * its RTP timestamp of switch_ns. This needs an engine worker, socket
+     * receive, push playout and an unchanged audio format. A stopped
+     * receiver connects and starts at once, holding back the stream's
+     * audio until the switch instant.
+     *
+     * @param sdp SDP description of the new stream
+     * @param switch_ns PTP (TAI) time of the switch in nanoseconds
+     * @return Handle for commit_switch() and cancel_switch(), 0 if the
+     *         receiver has to connect() at the deadline instead
+     */
+    uint64_t prepare_switch(const std::string& sdp, int64_t switch_ns);
+
+    /**
+     * @brief Prepare a switch to a stream given by transport parameters
+     * @see prepare_switch(const std::string&, int64_t)
+     */
+    uint64_t prepare_switch(const std::string& source_ip, uint16_t port,
+                            const AudioFormat& format, int64_t switch_ns);
+
+    /**
+     * @brief Commit a prepared switch
+     *
+     * Only arms the data path, which swaps streams at the prepared RTP
+     * timestamp; call it by the switch instant (a late commit switches at
+     * the next playout block). The stopped-receiver case has already started.
+     * @return true if the switch is committed, false if it was superseded
+     *         or dropped by stop()
+     */
+    bool commit_switch(uint64_t handle);
+
+    /**
+     * @brief Drop a prepared switch that is not committed
+     *
+     * A receiver started by prepare_switch() is stopped and reconnected
+     * to its previous stream, if it had one.
+     */
+    void cancel_switch(uint64_t handle);
+
     /**
      * @brief Check if receiver is running
      */
@@ -245,10 +394,16 @@ class SDPParser {
 public:
     /**
      * @brief Parse SDP string
+     *
+     * Single pass over the text without regular expressions or
+     * exceptions. Unknown lines and attributes are skipped; the first
+     * malformed line of a known type stops the parse and is reported in
+     * SDPInfo::error, with is_valid false.
+     *
      * @param sdp SDP string
      * @return Parsed SDP information
      */
-    static SDPInfo parse(const std::string& sdp);
+    static SDPInfo parse(std::string_view sdp);
     
     /**
      * @brief Validate SDP for AES67 compliance
@@ -267,6 +422,20 @@ public:
 
 /**
  * @brief Jitter buffer for RTP packet reordering and timing
+ *
+ * Sample-domain playout timeline: a preallocated power-of-two ring of
+ * audio frames addressed by RTP timestamp modulo capacity. Packets are
+ * written straight to their timeline position, so reordering, duplicates
+ * and 32-bit timestamp wraparound need no searching or shifting. Frames
+ * that never arrived read back as silence.
+ *
+ * Playout either pops from the buffered position once the target delay
+ * has built up (adaptive) or reads at a timeline position derived from
+ * the media clock (read()).
+ *
+ * push() and pop()/read() form a lock-free single-producer/single-consumer
+ * pair: call push() only from the receive thread and pop()/read() only from
+ * playout.
  */
 class JitterBuffer {
 public:
@@ -276,8 +445,9 @@ public:
     struct Config {
         uint32_t target_delay_ms = 10;
         uint32_t min_delay_ms = 5;
-        uint32_t max_delay_ms = 50;
-        uint32_t max_packets = 1000;
+        uint32_t max_delay_ms = 50;     // Ring capacity (rounded up to a power of two in frames)
+        uint32_t sample_rate = 48000;
+        uint32_t bytes_per_frame = 6;   // channels * bytes per sample
     };
     
     JitterBuffer();
@@ -286,24 +456,74 @@ public:
     
     /**
      * @brief Add a packet to the buffer
-     * @param data Packet data
-     * @param size Packet size
+     * @param data Packet payload (whole frames)
+     * @param size Payload size in bytes
      * @param sequence RTP sequence number
-     * @param timestamp RTP timestamp
-     * @return true if added successfully
+     * @param timestamp RTP timestamp of the first frame
+     * @return true if written, false if late, duplicate or overflowing
      */
     bool push(const uint8_t* data, size_t size, uint16_t sequence, uint32_t timestamp);
     
     /**
-     * @brief Get next packet for playout
+     * @brief Add a packet with a known arrival time
+     * @param arrival Time the packet reached the host (e.g. kernel receive timestamp)
+     */
+    bool push(const uint8_t* data, size_t size, uint16_t sequence, uint32_t timestamp,
+              std::chrono::steady_clock::time_point arrival);
+    
+    /**
+     * @brief Read the next block of frames for playout
      * @param data Output buffer
-     * @param max_size Maximum buffer size
-     * @param size Output: actual size written
-     * @param timestamp Output: RTP timestamp
-     * @return true if packet available
+     * @param max_size Maximum number of bytes to read
+     * @param size Output: actual size written (whole frames)
+     * @param timestamp Output: RTP timestamp of the first frame
+     * @return true if data is available
      */
     bool pop(uint8_t* data, size_t max_size, size_t& size, uint32_t& timestamp);
     
+    /**
+     * @brief Read frames at a fixed timeline position (clock-driven playout)
+     *
+     * Frames that have not arrived read back as silence; packets for
+     * positions before the end of this read are rejected as late afterwards.
+     *
+     * @param timestamp RTP timestamp of the first frame to play
+     * @param data Output buffer, at least frames * bytes_per_frame bytes
+     * @param frames Number of frames to read
+     * @return true if any of the frames held received audio
+     */
+    bool read(uint32_t timestamp, uint8_t* data, uint32_t frames);
+    
+    /**
+     * @brief Block the consumer until push() writes new frames
+     *
+     * The producer only signals while a consumer is waiting, so a batch of
+     * packets costs at most one wakeup.
+     *
+     * @param timeout Longest time to block
+     * @return true if new frames arrived (or wake() was called)
+     */
+    bool wait(std::chrono::milliseconds timeout);
+    
+    /**
+     * @brief Release a consumer blocked in wait()
+     */
+    void wake();
+    
+    /**
+     * @brief Consumer wakeup descriptor, readable after push() while armed
+     *
+     * Lets an event loop wait for received audio instead of blocking in
+     * wait(); -1 if unavailable.
+     */
+    [[nodiscard]] int event_fd() const;
+    
+    /**
+     * @brief Ask push() to signal event_fd() for the next new frames
+     * @return true if new frames already arrived (nothing is armed)
+     */
+    bool arm_wait();
+    
     /**
      * @brief Get current buffer level (0.0 - 1.0)
      */
@@ -311,11 +531,29 @@ public:
     
     /**
      * @brief Get current latency in milliseconds
+     *
+     * Age of the newest buffered frame (from its kernel receive timestamp)
+     * plus the media time queued ahead of it; 0 when the buffer is empty.
      */
     [[nodiscard]] double get_latency_ms() const;
     
     /**
-     * @brief Reset the buffer
+     * @brief Get ring capacity in frames
+     */
+    [[nodiscard]] uint32_t get_capacity_frames() const;
+    
+    /**
+     * @brief Number of packets dropped because the ring was full
+     */
+    [[nodiscard]] uint64_t get_overruns() const;
+    
+    /**
+     * @brief Number of times playout ran out of buffered audio
+     */
+    [[nodiscard]] uint64_t get_underruns() const;
+    
+    /**
+     * @brief Reset the buffer (producer and consumer must be stopped)
      */
     void reset();
     
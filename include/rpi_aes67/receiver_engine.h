@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: MIT
+/*
+ * RPi-AES67 - Professional AES67 Sender/Receiver for Raspberry Pi 5
+ * Copyright (c) 2025 DHPKE
+ *
+ * Shared I/O reactor for receivers: a fixed pool of epoll worker threads
+ * that multiplexes the sockets and playout timers of many streams.
+ */
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <functional>
+#include <cstdint>
+
+namespace rpi_aes67 {
+
+/**
+ * @brief Receiver engine configuration
+ */
+struct ReceiverEngineConfig {
+    uint32_t workers = 0;               // Worker threads (0 = one per CPU core)
+    std::vector<int> worker_cpus;       // CPU of worker i (missing or -1 = any CPU)
+    int worker_priority = 0;            // Worker SCHED_FIFO priority (0 = keep default policy)
+    uint32_t max_events = 64;           // Events handled per epoll_wait
+};
+
+/**
+ * @brief Receiver engine statistics
+ */
+struct ReceiverEngineStatistics {
+    uint32_t workers = 0;
+    uint64_t wakeups = 0;               // epoll_wait returns with events
+    uint64_t events = 0;                // Handler invocations
+    std::vector<uint32_t> attached;     // Attached descriptors per worker
+};
+
+/**
+ * @brief Shared receive/playout reactor
+ *
+ * Owns a fixed number of worker threads, each with its own epoll set.
+ * Receivers attach their socket and playout timer instead of starting
+ * threads, so thread count and context switches stay flat as streams are
+ * added. Descriptors are level-triggered and must be non-blocking; a
+ * handler should do a bounded amount of work and return, the remainder
+ * is reported again on the next wakeup.
+ *
+ * All descriptors a receiver attaches to the same worker are handled by
+ * one thread, so its receive and playout paths never run concurrently.
+ */
+class ReceiverEngine {
+public:
+    /**
+     * @brief Handler for readiness events (EPOLLIN, EPOLLERR, ...)
+     */
+    using Handler = std::function<void(uint32_t events)>;
+    
+    ReceiverEngine();
+    ~ReceiverEngine();
+    
+    // Non-copyable, non-movable
+    ReceiverEngine(const ReceiverEngine&) = delete;
+    ReceiverEngine& operator=(const ReceiverEngine&) = delete;
+    ReceiverEngine(ReceiverEngine&&) = delete;
+    ReceiverEngine& operator=(ReceiverEngine&&) = delete;
+    
+    /**
+     * @brief Create the epoll sets and start the worker threads
+     * @param config Engine configuration
+     * @return true on success
+     */
+    bool start(const ReceiverEngineConfig& config);
+    
+    /**
+     * @brief Stop and join the worker threads
+     *
+     * Descriptors still attached are dropped; their owners keep them open.
+     */
+    void stop();
+    
+    /**
+     * @brief Check if the engine is running
+     */
+    [[nodiscard]] bool is_running() const;
+    
+    /**
+     * @brief Number of worker threads
+     */
+    [[nodiscard]] uint32_t worker_count() const;
+    
+    /**
+     * @brief Attach a non-blocking descriptor
+     * @param fd Descriptor to watch
+     * @param events epoll event mask (usually EPOLLIN)
+     * @param handler Called on the worker thread when the descriptor is ready
+     * @param worker Worker index, or -1 for the least loaded worker
+     * @return Worker index the descriptor was attached to, -1 on failure
+     */
+    int attach(int fd, uint32_t events, Handler handler, int worker = -1);
+    
+    /**
+     * @brief Detach a descriptor
+     *
+     * When this returns the handler is not running and will not be called
+     * again, so the owner may close the descriptor and release the state
+     * the handler uses. May also be called from a handler on the same
+     * worker, including the descriptor's own.
+     */
+    void detach(int fd);
+    
+    /**
+     * @brief Get engine statistics
+     */
+    [[nodiscard]] ReceiverEngineStatistics get_statistics() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace rpi_aes67
@@ -34,6 +34,12 @@ struct SenderStatistics {
     uint32_t rtp_timestamp = 0;
     double bitrate_kbps = 0.0;
     uint64_t underruns = 0;
+    uint64_t tx_syscalls = 0;           // sendmmsg calls
+    uint64_t tx_quanta = 0;             // Audio callbacks that produced packets
+    double syscalls_per_quantum = 0.0;
+    uint64_t tx_dropped = 0;            // Packets dropped because the TX thread fell behind
+    double tx_pacing_error_us = 0.0;    // Smoothed release time error of the TX thread
+    double tx_pacing_error_max_us = 0.0;
     std::chrono::steady_clock::time_point start_time;
     std::chrono::steady_clock::time_point last_packet_time;
 };
@@ -210,6 +216,7 @@ public:
      * @param session_name Session name
      * @param session_id Session ID
      * @param origin_address Origin IP
+     * @param packet_time_us Packet time in microseconds
      * @return SDP string
      */
     static std::string generate(
@@ -219,7 +226,15 @@ public:
         const AudioFormat& format,
         const std::string& session_name,
         uint64_t session_id,
-        const std::string& origin_address);
+        const std::string& origin_address,
+        uint32_t packet_time_us = 1000);
+    
+    /**
+     * @brief Frames per packet for a packet time, rounded to the nearest frame
+     * @param sample_rate Sample rate in Hz
+     * @param packet_time_us Packet time in microseconds
+     */
+    [[nodiscard]] static uint32_t samples_per_packet(uint32_t sample_rate, uint32_t packet_time_us);
 };
 
 }  // namespace rpi_aes67
@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: MIT
+/*
+ * RPi-AES67 - Professional AES67 Sender/Receiver for Raspberry Pi 5
+ * Copyright (c) 2025 DHPKE
+ *
+ * Single-writer sequence lock for small trivially copyable values.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace rpi_aes67 {
+
+/**
+ * @brief Single-writer, multi-reader sequence lock
+ *
+ * Readers never block and never make system calls, so load() is safe from
+ * real-time audio callbacks. A reader that overlaps a store retries. The
+ * value is held in relaxed atomic words, so concurrent access is
+ * race-free without requiring T itself to be atomic.
+ *
+ * Only one thread may call store() at a time.
+ */
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock requires a trivially copyable type");
+
+public:
+    SeqLock() : SeqLock(T{}) {}
+    
+    explicit SeqLock(const T& value) { store(value); }
+    
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+    
+    /**
+     * @brief Publish a new value (single writer)
+     */
+    void store(const T& value) {
+        uint64_t words[WORD_COUNT] = {};
+        std::memcpy(words, &value, sizeof(T));
+        
+        uint32_t seq = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < WORD_COUNT; ++i) {
+            words_[i].store(words[i], std::memory_order_relaxed);
+        }
+        sequence_.store(seq + 2, std::memory_order_release);
+    }
+    
+    /**
+     * @brief Read a consistent snapshot
+     */
+    [[nodiscard]] T load() const {
+        uint64_t words[WORD_COUNT];
+        uint32_t before;
+        uint32_t after;
+        do {
+            before = sequence_.load(std::memory_order_acquire);
+            for (size_t i = 0; i < WORD_COUNT; ++i) {
+                words[i] = words_[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = sequence_.load(std::memory_order_relaxed);
+        } while ((before & 1) != 0 || before != after);
+        
+        T value;
+        std::memcpy(&value, words, sizeof(T));
+        return value;
+    }
+
+private:
+    static constexpr size_t WORD_COUNT = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    
+    std::atomic<uint32_t> sequence_{0};
+    std::atomic<uint64_t> words_[WORD_COUNT];
+};
+
+}  // namespace rpi_aes67
@@ -0,0 +1,149 @@
+// SPDX-License-Identifier: MIT
+/*
+ * RPi-AES67 - Professional AES67 Sender/Receiver for Raspberry Pi 5
+ * Copyright (c) 2025 DHPKE
+ *
+ * Lock-free single-producer/single-consumer ring buffer.
+ * Fixed capacity, no allocation after construction; safe to use from
+ * real-time audio callbacks.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <algorithm>
+
+namespace rpi_aes67 {
+
+/**
+ * @brief Bounded SPSC ring of trivially copyable elements
+ *
+ * Exactly one thread may call write() and exactly one thread may call
+ * read(). Both are wait-free: they copy what fits and return the count.
+ * Read and write positions live on separate cache lines, and each side
+ * keeps a cached copy of the other's position so the shared line is
+ * only touched when the cached view runs out.
+ */
+template <typename T>
+class SPSCRing {
+    static_assert(std::is_trivially_copyable_v<T>, "SPSCRing elements are copied with memcpy");
+
+public:
+    static constexpr size_t CACHE_LINE = 64;
+    
+    SPSCRing() = default;
+    
+    /**
+     * @brief Construct with a minimum capacity
+     * @param min_capacity Elements to hold (rounded up to a power of two)
+     */
+    explicit SPSCRing(size_t min_capacity) { allocate(min_capacity); }
+    
+    SPSCRing(const SPSCRing&) = delete;
+    SPSCRing& operator=(const SPSCRing&) = delete;
+    
+    /**
+     * @brief (Re)allocate storage; neither side may be running
+     * @param min_capacity Elements to hold (rounded up to a power of two)
+     */
+    void allocate(size_t min_capacity) {
+        size_t capacity = 1;
+        while (capacity < min_capacity) {
+            capacity <<= 1;
+        }
+        data_.reset(new T[capacity]());
+        capacity_ = capacity;
+        mask_ = capacity - 1;
+        reset();
+    }
+    
+    /**
+     * @brief Discard all content; neither side may be running
+     */
+    void reset() {
+        head_.store(0, std::memory_order_relaxed);
+        tail_.store(0, std::memory_order_relaxed);
+        cached_tail_ = 0;
+        cached_head_ = 0;
+    }
+    
+    /**
+     * @brief Append up to @p count elements (producer)
+     * @return Number of elements written
+     */
+    size_t write(const T* src, size_t count) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (capacity_ - (head - cached_tail_) < count) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+        }
+        count = std::min(count, capacity_ - (head - cached_tail_));
+        if (count == 0) return 0;
+        
+        size_t index = head & mask_;
+        size_t first = std::min(count, capacity_ - index);
+        std::memcpy(data_.get() + index, src, first * sizeof(T));
+        std::memcpy(data_.get(), src + first, (count - first) * sizeof(T));
+        
+        head_.store(head + count, std::memory_order_release);
+        return count;
+    }
+    
+    /**
+     * @brief Remove up to @p count elements (consumer)
+     * @return Number of elements read
+     */
+    size_t read(T* dst, size_t count) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (cached_head_ - tail < count) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+        }
+        count = std::min(count, cached_head_ - tail);
+        if (count == 0) return 0;
+        
+        size_t index = tail & mask_;
+        size_t first = std::min(count, capacity_ - index);
+        std::memcpy(dst, data_.get() + index, first * sizeof(T));
+        std::memcpy(dst + first, data_.get(), (count - first) * sizeof(T));
+        
+        tail_.store(tail + count, std::memory_order_release);
+        return count;
+    }
+    
+    /**
+     * @brief Elements currently readable (approximate from the producer)
+     */
+    [[nodiscard]] size_t read_available() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+    
+    /**
+     * @brief Free space in elements (approximate from the consumer)
+     */
+    [[nodiscard]] size_t write_available() const {
+        return capacity_ - read_available();
+    }
+    
+    [[nodiscard]] size_t capacity() const { return capacity_; }
+
+private:
+    std::unique_ptr<T[]> data_;
+    size_t capacity_ = 0;
+    size_t mask_ = 0;
+    
+    // Producer line: own position plus cached consumer position
+    alignas(CACHE_LINE) std::atomic<size_t> head_{0};
+    size_t cached_tail_ = 0;
+    
+    // Consumer line: own position plus cached producer position
+    alignas(CACHE_LINE) std::atomic<size_t> tail_{0};
+    size_t cached_head_ = 0;
+    
+    // Keep whatever follows off the consumer's line
+    char padding_[CACHE_LINE - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+};
+
+}  // namespace rpi_aes67
@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: MIT
+/*
+ * RPi-AES67 - Professional AES67 Sender/Receiver for Raspberry Pi 5
+ * Copyright (c) 2025 DHPKE
+ *
+ * io_uring datagram receive ring: one multishot recvmsg per socket fed
+ * from a registered provided-buffer ring.
+ */
+
+#pragma once
+
+#include <memory>
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+
+namespace rpi_aes67 {
+
+/**
+ * @brief Receive ring configuration
+ */
+struct UringReceiveConfig {
+    uint32_t buffers = 256;             // Provided buffers (power of two, up to 32768)
+    uint32_t buffer_size = 2048;        // Bytes per buffer: recvmsg header, control data and datagram
+};
+
+/**
+ * @brief Receive ring counters
+ */
+struct UringReceiveStats {
+    uint64_t completions = 0;           // CQEs reaped
+    uint64_t packets = 0;               // Datagrams handed to the handler
+    uint64_t truncated = 0;             // Datagrams larger than a buffer (dropped)
+    uint64_t no_buffers = 0;            // Multishot stopped because every buffer was in use
+    uint64_t rearms = 0;                // Multishot recvmsg resubmissions
+    uint64_t syscalls = 0;              // io_uring_enter calls (wait and submit)
+};
+
+/**
+ * @brief Multishot recvmsg receive ring for one datagram socket
+ *
+ * One IORING_OP_RECVMSG with IORING_RECV_MULTISHOT stays armed on the
+ * socket and picks a buffer from a registered provided-buffer ring for
+ * each datagram, so steady-state receive posts no new requests: the
+ * kernel writes completions into the shared CQ, process() reads them and
+ * hands each datagram (with its SO_TIMESTAMPNS stamp, if enabled on the
+ * socket) to the handler, then returns the buffer to the ring. Buffers
+ * are only reused after the handler returns.
+ *
+ * io_uring runs the receive on behalf of the submitting thread, so open()
+ * and process() must be called on the thread that consumes the packets.
+ * fd() becomes readable when completions are pending and can be watched
+ * with epoll; process(0) then reaps without a system call.
+ *
+ * Needs Linux 6.0 (multishot recvmsg, provided-buffer rings); open() or
+ * the first process() fails on older kernels or when io_uring is disabled
+ * (kernel.io_uring_disabled), and the caller falls back to recvmmsg.
+ */
+class UringReceiveRing {
+public:
+    /**
+     * @brief Datagram handler: payload, length and kernel receive time (or nullptr)
+     */
+    using PacketHandler = std::function<void(const uint8_t* data, size_t size, const timespec* kernel_ts)>;
+    
+    UringReceiveRing();
+    ~UringReceiveRing();
+    
+    // Non-copyable, non-movable
+    UringReceiveRing(const UringReceiveRing&) = delete;
+    UringReceiveRing& operator=(const UringReceiveRing&) = delete;
+    UringReceiveRing(UringReceiveRing&&) = delete;
+    UringReceiveRing& operator=(UringReceiveRing&&) = delete;
+    
+    /**
+     * @brief Check if this build includes io_uring support
+     */
+    [[nodiscard]] static bool is_available();
+    
+    /**
+     * @brief Create the ring, register the buffers and arm the receive
+     * @param socket_fd Bound datagram socket (the ring does not own it)
+     * @param config Ring configuration
+     * @param handler Called from process() for every datagram
+     * @return true on success
+     */
+    bool open(int socket_fd, const UringReceiveConfig& config, PacketHandler handler);
+    
+    /**
+     * @brief Cancel the receive and release the ring
+     *
+     * Waits until the kernel no longer uses the buffers; safe to call from
+     * any thread once process() is no longer running.
+     */
+    void close();
+    
+    /**
+     * @brief Ring descriptor (-1 when closed), readable while completions are pending
+     */
+    [[nodiscard]] int fd() const;
+    
+    /**
+     * @brief Handle pending completions
+     * @param timeout_ms Wait up to this long for a first completion (0 = don't wait)
+     * @return Datagrams handled, -1 if the ring failed and the caller should fall back
+     */
+    int process(int timeout_ms);
+    
+    /**
+     * @brief Get ring counters
+     */
+    [[nodiscard]] UringReceiveStats get_stats() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace rpi_aes67
@@ -0,0 +1,322 @@
+// SPDX-License-Identifier: MIT
+/*
+ * RPi-AES67 - Professional AES67 Sender/Receiver for Raspberry Pi 5
+ * Copyright (c) 2025 DHPKE
+ *
+ * Activation scheduler implementation.
+ */
+
+#include "rpi_aes67/activation_scheduler.h"
+#include "rpi_aes67/ptp_sync.h"
+#include "rpi_aes67/logger.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <queue>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+
+namespace rpi_aes67 {
+
+namespace {
+
+// Longest single sleep, so PTP corrections are noticed before the deadline
+constexpr int64_t MAX_SLEEP_NS = 100000000;
+
+enum class Stage {
+    Prepare,
+    Fire
+};
+
+struct Event {
+    int64_t time_ns;
+    uint64_t handle;
+    Stage stage;
+    
+    bool operator>(const Event& other) const { return time_ns > other.time_ns; }
+};
+
+}  // namespace
+
+class ActivationScheduler::Impl {
+public:
+    Impl() = default;
+    
+    ~Impl() {
+        stop();
+    }
+    
+    bool start(const ActivationSchedulerConfig& config, std::shared_ptr<PTPSync> ptp) {
+        if (running_) return true;
+        
+        config_ = config;
+        ptp_ = std::move(ptp);
+        running_ = true;
+        thread_ = std::thread([this]() { run(); });
+        
+        LOG_INFO("Activation scheduler started ({} time, {} ms lead)",
+                 ptp_ ? "PTP" : "TAI", config_.prepare_lead_ns / 1000000);
+        return true;
+    }
+    
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!running_) return;
+            running_ = false;
+        }
+        cv_.notify_all();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        
+        // Destroyed after unlocking, as in cancel()
+        std::unordered_map<uint64_t, Entry> entries;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            prepare_cv_.wait(lock, [this]() { return active_prepares_ == 0; });
+            if (!entries_.empty()) {
+                LOG_WARNING("Activation scheduler stopped with {} pending activation(s)", entries_.size());
+            }
+            entries.swap(entries_);
+            heap_ = {};
+        }
+    }
+    
+    bool is_running() const { return running_; }
+    
+    uint64_t schedule(int64_t deadline_ns, Action prepare, Action fire) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) return 0;
+        
+        uint64_t handle = next_handle_++;
+        Entry entry;
+        entry.deadline_ns = deadline_ns;
+        entry.prepare = std::move(prepare);
+        entry.fire = std::move(fire);
+        entry.late = deadline_ns <= now_ns();
+        entries_.emplace(handle, std::move(entry));
+        heap_.push(Event{deadline_ns - config_.prepare_lead_ns, handle, Stage::Prepare});
+        
+        ++stats_.scheduled;
+        if (entries_[handle].late) {
+            ++stats_.late;
+        }
+        cv_.notify_all();
+        return handle;
+    }
+    
+    bool cancel(uint64_t handle) {
+        // Destroyed after unlocking: the actions may own resources to release
+        Entry entry;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = entries_.find(handle);
+            if (it == entries_.end()) return false;
+            entry = std::move(it->second);
+            entries_.erase(it);
+            ++stats_.cancelled;
+        }
+        return true;
+    }
+    
+    int64_t now_ns() const {
+        if (ptp_ && ptp_->has_valid_time()) {
+            return ptp_->get_current_time().count();
+        }
+#ifdef __linux__
+        timespec ts{};
+        clock_gettime(CLOCK_TAI, &ts);
+        return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+#else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+#endif
+    }
+    
+    ActivationSchedulerStatistics get_statistics() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ActivationSchedulerStatistics stats = stats_;
+        stats.pending = static_cast<uint32_t>(entries_.size());
+        return stats;
+    }
+
+private:
+    struct Entry {
+        int64_t deadline_ns = 0;
+        Action prepare;
+        Action fire;
+        Stage stage = Stage::Prepare;
+        bool late = false;
+        bool preparing = false;         // Prepare step running on its own thread
+        bool overrun = false;           // Deadline reached while still preparing
+    };
+    
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (running_) {
+            if (heap_.empty()) {
+                cv_.wait(lock);
+                continue;
+            }
+            
+            const Event next = heap_.top();
+            auto it = entries_.find(next.handle);
+            if (it == entries_.end() || it->second.stage != next.stage) {
+                heap_.pop();   // Cancelled
+                continue;
+            }
+            
+            const int64_t remaining = next.time_ns - now_ns();
+            if (next.stage == Stage::Prepare ? remaining > 0 : remaining > config_.spin_ns) {
+                int64_t sleep = next.stage == Stage::Prepare ? remaining : remaining - config_.spin_ns;
+                cv_.wait_for(lock, std::chrono::nanoseconds(std::min(sleep, MAX_SLEEP_NS)));
+                continue;
+            }
+            heap_.pop();
+            
+            if (next.stage == Stage::Fire && it->second.preparing) {
+                // The prepare thread fires it as soon as the prepare is done
+                it->second.overrun = true;
+                continue;
+            }
+            
+            // Each prepare step gets its own thread: however long one takes,
+            // neither this thread nor another action's prepare waits for it
+            if (next.stage == Stage::Prepare) {
+                it->second.stage = Stage::Fire;
+                heap_.push(Event{it->second.deadline_ns, next.handle, Stage::Fire});
+                if (it->second.prepare) {
+                    it->second.preparing = true;
+                    ++active_prepares_;
+                    std::thread([this, handle = next.handle, prepare = std::move(it->second.prepare)]() mutable {
+                        run_prepare(handle, std::move(prepare));
+                    }).detach();
+                }
+                continue;
+            }
+            
+            Action fire = std::move(it->second.fire);
+            const int64_t deadline = it->second.deadline_ns;
+            const bool late = it->second.late;
+            entries_.erase(it);
+            lock.unlock();
+            
+            // At most spin_ns: sleeping would add timer slack and wakeup latency
+            while (now_ns() < deadline) {
+            }
+            const int64_t error = now_ns() - deadline;
+            if (fire) {
+                fire();
+            }
+            
+            lock.lock();
+            record_fire(error, late);
+        }
+    }
+    
+    // One prepare step; fires the action itself if its deadline passed
+    // meanwhile
+    void run_prepare(uint64_t handle, Action prepare) {
+        prepare();
+        prepare = nullptr;   // Released unlocked, like a cancelled entry
+        
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto it = entries_.find(handle);
+        if (it != entries_.end()) {
+            it->second.preparing = false;
+            if (it->second.overrun && running_) {
+                Action fire = std::move(it->second.fire);
+                const int64_t deadline = it->second.deadline_ns;
+                const bool late = it->second.late;
+                entries_.erase(it);
+                if (!late) {
+                    ++stats_.overrun;
+                }
+                lock.unlock();
+                
+                // Flagged up to spin_ns early: never fire before the deadline
+                while (now_ns() < deadline) {
+                }
+                const int64_t error = now_ns() - deadline;
+                if (!late) {
+                    LOG_WARNING("Activation prepared {} us after its deadline", error / 1000);
+                }
+                if (fire) {
+                    fire();
+                }
+                
+                lock.lock();
+                record_fire(error, late);
+            }
+        }
+        
+        // Last use of this object: stop() waits for the count to drop
+        if (--active_prepares_ == 0) {
+            prepare_cv_.notify_all();
+        }
+    }
+    
+    // mutex_ held
+    void record_fire(int64_t error, bool late) {
+        ++stats_.fired;
+        stats_.last_error_ns = error;
+        if (!late) {
+            stats_.max_error_ns = std::max<int64_t>(stats_.max_error_ns, std::llabs(error));
+        }
+    }
+    
+    ActivationSchedulerConfig config_;
+    std::shared_ptr<PTPSync> ptp_;
+    
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::condition_variable prepare_cv_;
+    uint32_t active_prepares_ = 0;      // Prepare threads still running
+    
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event>> heap_;
+    std::unordered_map<uint64_t, Entry> entries_;
+    uint64_t next_handle_ = 1;
+    ActivationSchedulerStatistics stats_;
+};
+
+// ActivationScheduler public interface
+
+ActivationScheduler::ActivationScheduler() : impl_(std::make_unique<Impl>()) {}
+ActivationScheduler::~ActivationScheduler() = default;
+
+bool ActivationScheduler::start(const ActivationSchedulerConfig& config, std::shared_ptr<PTPSync> ptp) {
+    return impl_->start(config, std::move(ptp));
+}
+
+void ActivationScheduler::stop() {
+    impl_->stop();
+}
+
+bool ActivationScheduler::is_running() const {
+    return impl_->is_running();
+}
+
+uint64_t ActivationScheduler::schedule(int64_t deadline_ns, Action prepare, Action fire) {
+    return impl_->schedule(deadline_ns, std::move(prepare), std::move(fire));
+}
+
+bool ActivationScheduler::cancel(uint64_t handle) {
+    return impl_->cancel(handle);
+}
+
+int64_t ActivationScheduler::now_ns() const {
+    return impl_->now_ns();
+}
+
+ActivationSchedulerStatistics ActivationScheduler::get_statistics() const {
+    return impl_->get_statistics();
+}
+
+}  // namespace rpi_aes67
@@ -126,6 +126,19 @@ bool Config::validate() const {
         if (sender.sample_rate != 44100 && sender.sample_rate != 48000 && sender.sample_rate != 96000) {
             return false;
         }
+        if (sender.packet_time_us != 125 && sender.packet_time_us != 250 && sender.packet_time_us != 333 &&
+            sender.packet_time_us != 1000 && sender.packet_time_us != 4000) {
+            return false;
+        }
+        if (sender.tx_mode != "inline" && sender.tx_mode != "thread") {
+            return false;
+        }
+        if (sender.tx_pacing != "deadline" && sender.tx_pacing != "txtime" && sender.tx_pacing != "etf") {
+            return false;
+        }
+        if (sender.tx_queue_ms == 0 || sender.tx_priority < 0 || sender.tx_priority > 99) {
+            return false;
+        }
     }
     
     // Validate receivers
@@ -133,12 +146,59 @@ bool Config::validate() const {
         if (receiver.id.empty()) {
             return false;
         }
+        if (receiver.receive_mode != "recvmmsg" && receiver.receive_mode != "poll" &&
+            receiver.receive_mode != "io_uring" && receiver.receive_mode != "packet_ring") {
+            return false;
+        }
+        if (receiver.rx_batch_size == 0 || receiver.rx_batch_size > 1024) {
+            return false;
+        }
+        if (receiver.rx_batch_timeout_us == 0) {
+            return false;
+        }
+        if (receiver.rx_ring_buffers < 2 || receiver.rx_ring_buffers > 32768 ||
+            (receiver.rx_ring_buffers & (receiver.rx_ring_buffers - 1)) != 0) {
+            return false;
+        }
     }
     
     // Validate network config
     if (network.interface.empty()) {
         return false;
     }
+    if (network.ptp_backend != "internal" && network.ptp_backend != "linuxptp") {
+        return false;
+    }
+    if (network.ptp_backend == "linuxptp" && network.ptp_uds_path.empty()) {
+        return false;
+    }
+    if (network.http_workers < 1 || network.http_workers > 64) {
+        return false;
+    }
+    if (network.activation_lead_ms > 10000) {
+        return false;
+    }
+    
+    // Validate audio config
+    if (audio.playout_mode != "adaptive" && audio.playout_mode != "ptp") {
+        return false;
+    }
+    if (audio.receiver_threading != "engine" && audio.receiver_threading != "per_receiver") {
+        return false;
+    }
+    if (audio.receiver_worker_priority < 0 || audio.receiver_worker_priority > 99) {
+        return false;
+    }
+    if (audio.packet_ring_block_kb < 4 || audio.packet_ring_block_kb > 4096 ||
+        (audio.packet_ring_block_kb & (audio.packet_ring_block_kb - 1)) != 0) {
+        return false;
+    }
+    if (audio.packet_ring_blocks == 0 || audio.packet_ring_blocks > 1024) {
+        return false;
+    }
+    if (audio.packet_ring_timeout_ms == 0 || audio.packet_ring_timeout_ms > 1000) {
+        return false;
+    }
     
     return true;
 }
@@ -240,7 +300,12 @@ void to_json(nlohmann::json& j, const SenderConfig& c) {
         {"payload_type", c.payload_type},
         {"pipewire_source", c.pipewire_source},
         {"enabled", c.enabled},
-        {"packet_time_us", c.packet_time_us}
+        {"packet_time_us", c.packet_time_us},
+        {"tx_mode", c.tx_mode},
+        {"tx_pacing", c.tx_pacing},
+        {"tx_queue_ms", c.tx_queue_ms},
+        {"tx_cpu", c.tx_cpu},
+        {"tx_priority", c.tx_priority}
     };
 }
 
@@ -257,6 +322,11 @@ void from_json(const nlohmann::json& j, SenderConfig& c) {
     if (j.contains("pipewire_source")) j.at("pipewire_source").get_to(c.pipewire_source);
     if (j.contains("enabled")) j.at("enabled").get_to(c.enabled);
     if (j.contains("packet_time_us")) j.at("packet_time_us").get_to(c.packet_time_us);
+    if (j.contains("tx_mode")) j.at("tx_mode").get_to(c.tx_mode);
+    if (j.contains("tx_pacing")) j.at("tx_pacing").get_to(c.tx_pacing);
+    if (j.contains("tx_queue_ms")) j.at("tx_queue_ms").get_to(c.tx_queue_ms);
+    if (j.contains("tx_cpu")) j.at("tx_cpu").get_to(c.tx_cpu);
+    if (j.contains("tx_priority")) j.at("tx_priority").get_to(c.tx_priority);
 }
 
 void to_json(nlohmann::json& j, const ReceiverConfig& c) {
@@ -268,7 +338,11 @@ void to_json(nlohmann::json& j, const ReceiverConfig& c) {
         {"sample_rates", c.sample_rates},
         {"bit_depths", c.bit_depths},
         {"pipewire_sink", c.pipewire_sink},
-        {"enabled", c.enabled}
+        {"enabled", c.enabled},
+        {"receive_mode", c.receive_mode},
+        {"rx_batch_size", c.rx_batch_size},
+        {"rx_batch_timeout_us", c.rx_batch_timeout_us},
+        {"rx_ring_buffers", c.rx_ring_buffers}
     };
 }
 
@@ -281,27 +355,39 @@ void from_json(const nlohmann::json& j, ReceiverConfig& c) {
     if (j.contains("bit_depths")) j.at("bit_depths").get_to(c.bit_depths);
     if (j.contains("pipewire_sink")) j.at("pipewire_sink").get_to(c.pipewire_sink);
     if (j.contains("enabled")) j.at("enabled").get_to(c.enabled);
+    if (j.contains("receive_mode")) j.at("receive_mode").get_to(c.receive_mode);
+    if (j.contains("rx_batch_size")) j.at("rx_batch_size").get_to(c.rx_batch_size);
+    if (j.contains("rx_batch_timeout_us")) j.at("rx_batch_timeout_us").get_to(c.rx_batch_timeout_us);
+    if (j.contains("rx_ring_buffers")) j.at("rx_ring_buffers").get_to(c.rx_ring_buffers);
 }
 
 void to_json(nlohmann::json& j, const NetworkConfig& c) {
     j = nlohmann::json{
         {"interface", c.interface},
         {"ptp_domain", c.ptp_domain},
+        {"ptp_backend", c.ptp_backend},
+        {"ptp_uds_path", c.ptp_uds_path},
         {"registry_url", c.registry_url},
         {"enable_mdns", c.enable_mdns},
         {"node_port", c.node_port},
-        {"connection_port", c.connection_port}
+        {"connection_port", c.connection_port},
+        {"http_workers", c.http_workers},
+        {"activation_lead_ms", c.activation_lead_ms}
     };
 }
 
 void from_json(const nlohmann::json& j, NetworkConfig& c) {
     if (j.contains("interface")) j.at("interface").get_to(c.interface);
     if (j.contains("ptp_domain")) j.at("ptp_domain").get_to(c.ptp_domain);
+    if (j.contains("ptp_backend")) j.at("ptp_backend").get_to(c.ptp_backend);
+    if (j.contains("ptp_uds_path")) j.at("ptp_uds_path").get_to(c.ptp_uds_path);
     if (j.contains("registry_url")) j.at("registry_url").get_to(c.registry_url);
     if (j.contains("enable_mdns")) j.at("enable_mdns").get_to(c.enable_mdns);
     // Support both old and new config names
     if (j.contains("node_port")) j.at("node_port").get_to(c.node_port);
     if (j.contains("connection_port")) j.at("connection_port").get_to(c.connection_port);
+    if (j.contains("http_workers")) j.at("http_workers").get_to(c.http_workers);
+    if (j.contains("activation_lead_ms")) j.at("activation_lead_ms").get_to(c.activation_lead_ms);
     // Legacy support
     if (j.contains("use_mdns")) j.at("use_mdns").get_to(c.enable_mdns);
 }
@@ -311,7 +397,18 @@ void to_json(nlohmann::json& j, const AudioProcessingConfig& c) {
         {"buffer_size_ms", c.buffer_size_ms},
         {"jitter_buffer_ms", c.jitter_buffer_ms},
         {"buffer_frames", c.buffer_frames},
-        {"enable_sample_rate_conversion", c.enable_sample_rate_conversion}
+        {"enable_sample_rate_conversion", c.enable_sample_rate_conversion},
+        {"playout_mode", c.playout_mode},
+        {"link_offset_samples", c.link_offset_samples},
+        {"pull_playout", c.pull_playout},
+        {"receiver_threading", c.receiver_threading},
+        {"receiver_workers", c.receiver_workers},
+        {"receiver_worker_cpus", c.receiver_worker_cpus},
+        {"receiver_worker_priority", c.receiver_worker_priority},
+        {"packet_ring_block_kb", c.packet_ring_block_kb},
+        {"packet_ring_blocks", c.packet_ring_blocks},
+        {"packet_ring_timeout_ms", c.packet_ring_timeout_ms},
+        {"packet_ring_cpu", c.packet_ring_cpu}
     };
 }
 
@@ -324,6 +421,19 @@ void from_json(const nlohmann::json& j, AudioProcessingConfig& c) {
     if (j.contains("enable_sample_rate_conversion")) {
         j.at("enable_sample_rate_conversion").get_to(c.enable_sample_rate_conversion);
     }
+    if (j.contains("playout_mode")) j.at("playout_mode").get_to(c.playout_mode);
+    if (j.contains("link_offset_samples")) j.at("link_offset_samples").get_to(c.link_offset_samples);
+    if (j.contains("pull_playout")) j.at("pull_playout").get_to(c.pull_playout);
+    if (j.contains("receiver_threading")) j.at("receiver_threading").get_to(c.receiver_threading);
+    if (j.contains("receiver_workers")) j.at("receiver_workers").get_to(c.receiver_workers);
+    if (j.contains("receiver_worker_cpus")) j.at("receiver_worker_cpus").get_to(c.receiver_worker_cpus);
+    if (j.contains("receiver_worker_priority")) {
+        j.at("receiver_worker_priority").get_to(c.receiver_worker_priority);
+    }
+    if (j.contains("packet_ring_block_kb")) j.at("packet_ring_block_kb").get_to(c.packet_ring_block_kb);
+    if (j.contains("packet_ring_blocks")) j.at("packet_ring_blocks").get_to(c.packet_ring_blocks);
+    if (j.contains("packet_ring_timeout_ms")) j.at("packet_ring_timeout_ms").get_to(c.packet_ring_timeout_ms);
+    if (j.contains("packet_ring_cpu")) j.at("packet_ring_cpu").get_to(c.packet_ring_cpu);
     // Legacy support for latency_ms
     if (j.contains("latency_ms")) j.at("latency_ms").get_to(c.buffer_size_ms);
 }
@@ -0,0 +1,823 @@
+// SPDX-License-Identifier: MIT
+/*
+ * RPi-AES67 - Professional AES67 Sender/Receiver for Raspberry Pi 5
+ * Copyright (c) 2025 DHPKE
+ *
+ * HTTP/1.1 server implementation.
+ */
+
+#include "rpi_aes67/http_server.h"
+#include "rpi_aes67/logger.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <unordered_map>
+#include <algorithm>
+#include <charconv>
+#include <exception>
+#include <cstring>
+#include <cerrno>
+
+#ifdef __linux__
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <unistd.h>
+#endif
+
+namespace rpi_aes67 {
+
+namespace {
+
+// epoll ids: the wakeup eventfd, listeners (flagged) and connections (from 1)
+constexpr uint64_t WAKE_ID = 0;
+constexpr uint64_t LISTENER_FLAG = 1ULL << 63;
+constexpr size_t READ_CHUNK = 16 * 1024;
+constexpr size_t MAX_CHUNK_LINE = 1024;
+
+enum class ParseStatus {
+    Incomplete,
+    Complete,
+    Error
+};
+
+std::string to_lower(std::string_view text) {
+    std::string lower(text);
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return lower;
+}
+
+std::string_view trim(std::string_view text) {
+    size_t start = text.find_first_not_of(" \t");
+    if (start == std::string_view::npos) return {};
+    size_t end = text.find_last_not_of(" \t");
+    return text.substr(start, end - start + 1);
+}
+
+bool contains_token(std::string_view value, std::string_view token) {
+    return to_lower(value).find(token) != std::string::npos;
+}
+
+// Progress through a chunked body that is still arriving, so each read
+// only parses the new chunks
+struct ChunkedState {
+    size_t pos = 0;         // Offset of the next chunk-size line
+    std::string body;       // Chunk data decoded so far
+};
+
+// Chunked body from the start of data, resuming at state.pos; error_status
+// is set on Error
+ParseStatus parse_chunked(std::string_view data, size_t max_body, ChunkedState& state,
+                          std::string& body, size_t& consumed, int& error_status) {
+    for (;;) {
+        size_t pos = state.pos;
+        size_t line_end = data.find("\r\n", pos);
+        if (line_end == std::string_view::npos) {
+            if (data.size() - pos > MAX_CHUNK_LINE) {
+                error_status = 400;
+                return ParseStatus::Error;
+            }
+            return ParseStatus::Incomplete;
+        }
+        
+        // <hex size>[;extensions]
+        std::string_view size_text = trim(data.substr(pos, std::min(line_end, data.find(';', pos)) - pos));
+        size_t size = 0;
+        auto [end, ec] = std::from_chars(size_text.data(), size_text.data() + size_text.size(), size, 16);
+        if (size_text.empty() || ec != std::errc() || end != size_text.data() + size_text.size()) {
+            error_status = 400;
+            return ParseStatus::Error;
+        }
+        pos = line_end + 2;
+        
+        if (size == 0) {
+            // Trailer fields (ignored) up to an empty line
+            for (;;) {
+                size_t trailer_end = data.find("\r\n", pos);
+                if (trailer_end == std::string_view::npos) return ParseStatus::Incomplete;
+                bool last = trailer_end == pos;
+                pos = trailer_end + 2;
+                if (last) break;
+            }
+            consumed = pos;
+            body = std::move(state.body);
+            state = ChunkedState{};
+            return ParseStatus::Complete;
+        }
+        
+        if (size > max_body || state.body.size() + size > max_body) {
+            error_status = 413;
+            return ParseStatus::Error;
+        }
+        if (data.size() < pos + size + 2) return ParseStatus::Incomplete;
+        if (data.substr(pos + size, 2) != "\r\n") {
+            error_status = 400;
+            return ParseStatus::Error;
+        }
+        state.body.append(data.substr(pos, size));
+        state.pos = pos + size + 2;
+    }
+}
+
+}  // namespace
+
+std::string_view HttpRequest::header(std::string_view name) const {
+    for (const auto& [key, value] : headers) {
+        if (key == name) return value;
+    }
+    return {};
+}
+
+class HttpServer::Impl {
+public:
+    Impl() = default;
+    
+    ~Impl() {
+        stop();
+    }
+    
+    bool start(const HttpServerConfig& config, Handler handler) {
+        if (running_) return true;
+
+#ifdef __linux__
+        config_ = config;
+        handler_ = std::move(handler);
+        
+        epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+        wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (epoll_fd_ < 0 || wake_fd_ < 0 || !add_to_epoll(wake_fd_, WAKE_ID, EPOLLIN)) {
+            LOG_ERROR("HTTP server: failed to create epoll set: {}", strerror(errno));
+            close_all();
+            return false;
+        }
+        
+        for (uint16_t port : config_.ports) {
+            if (port == 0 || std::find(listen_ports_.begin(), listen_ports_.end(), port) != listen_ports_.end()) {
+                continue;
+            }
+            if (!open_listener(port)) {
+                close_all();
+                return false;
+            }
+        }
+        
+        running_ = true;
+        stopping_ = false;
+        loop_thread_ = std::thread([this]() { event_loop(); });
+        for (uint32_t i = 0; i < std::max<uint32_t>(config_.workers, 1); ++i) {
+            workers_.emplace_back([this]() { worker_loop(); });
+        }
+        
+        LOG_INFO("HTTP server listening on {} port(s) with {} worker(s)",
+                 listen_ports_.size(), workers_.size());
+        return true;
+#else
+        (void)config;
+        (void)handler;
+        return false;
+#endif
+    }
+    
+    void stop() {
+        if (!running_) return;
+        running_ = false;
+
+#ifdef __linux__
+        wake();
+        if (loop_thread_.joinable()) {
+            loop_thread_.join();
+        }
+        {
+            std::lock_guard<std::mutex> lock(jobs_mutex_);
+            stopping_ = true;
+        }
+        jobs_cv_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+        workers_.clear();
+        jobs_.clear();
+        completions_.clear();
+        close_all();
+#endif
+        LOG_INFO("HTTP server stopped");
+    }
+    
+    bool is_running() const { return running_; }
+    
+    HttpServerStatistics get_statistics() const {
+        HttpServerStatistics stats;
+        stats.connections = accepted_.load(std::memory_order_relaxed);
+        stats.requests = requests_.load(std::memory_order_relaxed);
+        stats.reused = reused_.load(std::memory_order_relaxed);
+        stats.rejected = rejected_.load(std::memory_order_relaxed);
+        stats.open_connections = open_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    struct Connection {
+        int fd = -1;
+        uint16_t port = 0;
+        std::string in;
+        std::string out;
+        size_t out_offset = 0;
+        bool busy = false;              // A request is with a worker
+        bool close_after = false;       // Close once the output is flushed
+        bool eof = false;               // Peer finished sending
+        bool continue_sent = false;
+        bool used = false;
+        ChunkedState chunked;           // Partial chunked body of the pending request
+        std::chrono::steady_clock::time_point last_active;
+    };
+    
+    struct Job {
+        uint64_t id;
+        HttpRequest request;
+        bool keep_alive;
+    };
+    
+    struct Completion {
+        uint64_t id;
+        std::string data;
+        bool close;
+    };
+
+#ifdef __linux__
+    bool add_to_epoll(int fd, uint64_t id, uint32_t events) {
+        epoll_event ev{};
+        ev.events = events;
+        ev.data.u64 = id;
+        return epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) == 0;
+    }
+    
+    bool open_listener(uint16_t port) {
+        int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            LOG_ERROR("HTTP server: failed to create socket: {}", strerror(errno));
+            return false;
+        }
+        int opt = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+        
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        addr.sin_addr.s_addr = INADDR_ANY;
+        if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || listen(fd, SOMAXCONN) < 0) {
+            LOG_ERROR("Failed to bind HTTP server to port {}: {}", port, strerror(errno));
+            close(fd);
+            return false;
+        }
+        
+        if (!add_to_epoll(fd, LISTENER_FLAG | listeners_.size(), EPOLLIN)) {
+            close(fd);
+            return false;
+        }
+        listeners_.push_back(fd);
+        listen_ports_.push_back(port);
+        return true;
+    }
+    
+    void wake() {
+        if (wake_fd_ >= 0) {
+            uint64_t one = 1;
+            ssize_t n = ::write(wake_fd_, &one, sizeof(one));
+            (void)n;
+        }
+    }
+    
+    void event_loop() {
+        std::vector<epoll_event> events(64);
+        auto last_sweep = std::chrono::steady_clock::now();
+        
+        while (running_) {
+            int count = epoll_wait(epoll_fd_, events.data(), static_cast<int>(events.size()), 1000);
+            if (count < 0 && errno != EINTR) {
+                LOG_ERROR("HTTP server: epoll_wait failed: {}", strerror(errno));
+                break;
+            }
+            
+            for (int i = 0; i < count; ++i) {
+                const uint64_t id = events[i].data.u64;
+                if (id == WAKE_ID) {
+                    uint64_t value;
+                    ssize_t n = ::read(wake_fd_, &value, sizeof(value));
+                    (void)n;
+                    deliver_completions();
+                } else if (id & LISTENER_FLAG) {
+                    accept_connections(static_cast<size_t>(id & ~LISTENER_FLAG));
+                } else {
+                    on_connection_event(id, events[i].events);
+                }
+            }
+            
+            auto now = std::chrono::steady_clock::now();
+            if (now - last_sweep >= std::chrono::seconds(1)) {
+                close_idle(now);
+                last_sweep = now;
+            }
+        }
+    }
+    
+    void accept_connections(size_t listener) {
+        for (;;) {
+            int fd = accept4(listeners_[listener], nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) return;   // EAGAIN or a transient error
+            
+            if (connections_.size() >= config_.max_connections) {
+                LOG_WARNING("HTTP server: connection limit {} reached", config_.max_connections);
+                close(fd);
+                continue;
+            }
+            
+            // Responses are written in one piece; don't hold back the tail
+            int one = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            
+            uint64_t id = next_id_++;
+            if (!add_to_epoll(fd, id, EPOLLIN | EPOLLRDHUP)) {
+                close(fd);
+                continue;
+            }
+            auto connection = std::make_unique<Connection>();
+            connection->fd = fd;
+            connection->port = listen_ports_[listener];
+            connection->last_active = std::chrono::steady_clock::now();
+            connections_.emplace(id, std::move(connection));
+            accepted_.fetch_add(1, std::memory_order_relaxed);
+            open_.store(static_cast<uint32_t>(connections_.size()), std::memory_order_relaxed);
+        }
+    }
+    
+    void on_connection_event(uint64_t id, uint32_t events) {
+        auto it = connections_.find(id);
+        if (it == connections_.end()) return;
+        Connection& connection = *it->second;
+        connection.last_active = std::chrono::steady_clock::now();
+        
+        // Both directions gone: nothing can be answered any more
+        if (events & (EPOLLERR | EPOLLHUP)) {
+            close_connection(id);
+            return;
+        }
+        if ((events & EPOLLOUT) && !flush(id, connection)) {
+            return;
+        }
+        if (events & (EPOLLIN | EPOLLRDHUP)) {
+            if (!read_input(id, connection)) return;
+            process_input(id, connection);
+        }
+    }
+    
+    // Drain the socket; false if the connection was closed
+    bool read_input(uint64_t id, Connection& connection) {
+        char buffer[READ_CHUNK];
+        for (;;) {
+            ssize_t n = recv(connection.fd, buffer, sizeof(buffer), 0);
+            if (n > 0) {
+                connection.in.append(buffer, static_cast<size_t>(n));
+                if (connection.in.size() > input_limit()) {
+                    break;   // The parser rejects it
+                }
+                continue;
+            }
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return true;
+            if (n < 0 && errno == EINTR) continue;
+            
+            // Peer closed (or reset): answer what is in flight, then close
+            connection.eof = true;
+            if (!connection.busy && connection.out.empty() && n < 0) {
+                close_connection(id);
+                return false;
+            }
+            update_events(id, connection);
+            return true;
+        }
+        return true;
+    }
+    
+    // Most a connection buffers: one request head and body plus a chunk line
+    size_t input_limit() const {
+        return config_.max_header_bytes + config_.max_body_bytes + MAX_CHUNK_LINE;
+    }
+    
+    void process_input(uint64_t id, Connection& connection) {
+        if (connection.busy || connection.close_after) {
+            update_events(id, connection);
+            return;
+        }
+        
+        HttpRequest request;
+        bool keep_alive = true;
+        bool expect_continue = false;
+        size_t consumed = 0;
+        int error_status = 400;
+        ParseStatus status = parse_request(connection.in, connection.chunked, request, keep_alive,
+                                           expect_continue, consumed, error_status);
+        
+        if (status == ParseStatus::Incomplete) {
+            if (connection.eof) {
+                // Nothing more will come; close once the output is flushed
+                connection.close_after = true;
+                flush(id, connection);
+            } else if (expect_continue && !connection.continue_sent) {
+                connection.continue_sent = true;
+                connection.out += "HTTP/1.1 100 Continue\r\n\r\n";
+                flush(id, connection);
+            } else {
+                update_events(id, connection);
+            }
+            return;
+        }
+        
+        if (status == ParseStatus::Error) {
+            rejected_.fetch_add(1, std::memory_order_relaxed);
+            HttpResponse response;
+            response.status = error_status;
+            response.body = std::string("{\"code\": ") + std::to_string(error_status) + ", \"error\": \"" +
+                            HttpServer::reason_phrase(error_status) + "\"}";
+            connection.out += serialize(response, false, false);
+            connection.close_after = true;
+            connection.in.clear();
+            connection.chunked = ChunkedState{};
+            flush(id, connection);
+            return;
+        }
+        
+        connection.in.erase(0, consumed);
+        connection.continue_sent = false;
+        connection.busy = true;
+        if (connection.used) {
+            reused_.fetch_add(1, std::memory_order_relaxed);
+        }
+        connection.used = true;
+        request.port = connection.port;
+        {
+            std::lock_guard<std::mutex> lock(jobs_mutex_);
+            jobs_.push_back(Job{id, std::move(request), keep_alive && !connection.eof});
+        }
+        jobs_cv_.notify_one();
+        update_events(id, connection);
+    }
+    
+    ParseStatus parse_request(std::string_view data, ChunkedState& chunked, HttpRequest& request,
+                              bool& keep_alive, bool& expect_continue, size_t& consumed,
+                              int& error_status) const {
+        // Tolerate empty lines between requests (RFC 9112 2.2)
+        size_t start = 0;
+        while (data.compare(start, 2, "\r\n") == 0) {
+            start += 2;
+        }
+        data.remove_prefix(start);
+        
+        size_t head_end = data.find("\r\n\r\n");
+        if (head_end == std::string_view::npos || head_end > config_.max_header_bytes) {
+            if (head_end != std::string_view::npos || data.size() > config_.max_header_bytes) {
+                error_status = 431;
+                return ParseStatus::Error;
+            }
+            return ParseStatus::Incomplete;
+        }
+        
+        // Request line: <method> <target> HTTP/1.x
+        std::string_view head = data.substr(0, head_end);
+        size_t line_end = std::min(head.find("\r\n"), head.size());
+        std::string_view line = head.substr(0, line_end);
+        size_t sp1 = line.find(' ');
+        size_t sp2 = sp1 == std::string_view::npos ? sp1 : line.find(' ', sp1 + 1);
+        if (sp2 == std::string_view::npos || sp1 == 0 || sp2 == sp1 + 1) {
+            error_status = 400;
+            return ParseStatus::Error;
+        }
+        std::string_view version = line.substr(sp2 + 1);
+        if (version != "HTTP/1.1" && version != "HTTP/1.0") {
+            error_status = version.substr(0, 5) == "HTTP/" ? 505 : 400;
+            return ParseStatus::Error;
+        }
+        request.method = std::string(line.substr(0, sp1));
+        request.target = std::string(line.substr(sp1 + 1, sp2 - sp1 - 1));
+        size_t query = request.target.find('?');
+        request.path = request.target.substr(0, query);
+        request.query = query == std::string::npos ? std::string() : request.target.substr(query + 1);
+        
+        // Header fields
+        request.headers.clear();
+        size_t pos = line_end + 2;
+        while (pos < head.size()) {
+            size_t end = std::min(head.find("\r\n", pos), head.size());
+            std::string_view field = head.substr(pos, end - pos);
+            size_t colon = field.find(':');
+            if (colon == std::string_view::npos || colon == 0 || field[0] == ' ' || field[0] == '\t') {
+                error_status = 400;   // Also rejects obsolete line folding
+                return ParseStatus::Error;
+            }
+            request.headers.emplace_back(to_lower(field.substr(0, colon)),
+                                         std::string(trim(field.substr(colon + 1))));
+            pos = end + 2;
+        }
+        
+        std::string_view connection = request.header("connection");
+        keep_alive = version == "HTTP/1.1" ? !contains_token(connection, "close")
+                                           : contains_token(connection, "keep-alive");
+        expect_continue = contains_token(request.header("expect"), "100-continue");
+        
+        std::string_view body = data.substr(head_end + 4);
+        std::string_view transfer_encoding = request.header("transfer-encoding");
+        if (!transfer_encoding.empty()) {
+            if (to_lower(transfer_encoding) != "chunked") {
+                error_status = 501;
+                return ParseStatus::Error;
+            }
+            size_t body_size = 0;
+            ParseStatus status = parse_chunked(body, config_.max_body_bytes, chunked, request.body,
+                                               body_size, error_status);
+            if (status == ParseStatus::Complete) {
+                consumed = start + head_end + 4 + body_size;
+            }
+            return status;
+        }
+        
+        size_t length = 0;
+        std::string_view length_text = request.header("content-length");
+        if (!length_text.empty()) {
+            auto [end, ec] = std::from_chars(length_text.data(), length_text.data() + length_text.size(), length);
+            if (ec != std::errc() || end != length_text.data() + length_text.size()) {
+                error_status = 400;
+                return ParseStatus::Error;
+            }
+            if (length > config_.max_body_bytes) {
+                error_status = 413;
+                return ParseStatus::Error;
+            }
+        }
+        if (body.size() < length) return ParseStatus::Incomplete;
+        
+        request.body = std::string(body.substr(0, length));
+        consumed = start + head_end + 4 + length;
+        return ParseStatus::Complete;
+    }
+    
+    // Write pending output; false if the connection was closed
+    bool flush(uint64_t id, Connection& connection) {
+        while (connection.out_offset < connection.out.size()) {
+            ssize_t n = send(connection.fd, connection.out.data() + connection.out_offset,
+                             connection.out.size() - connection.out_offset, MSG_NOSIGNAL);
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                update_events(id, connection);
+                return true;
+            }
+            if (n < 0) {
+                close_connection(id);
+                return false;
+            }
+            connection.out_offset += static_cast<size_t>(n);
+        }
+        connection.out.clear();
+        connection.out_offset = 0;
+        
+        if (!connection.busy && (connection.close_after || (connection.eof && connection.in.empty()))) {
+            close_connection(id);
+            return false;
+        }
+        update_events(id, connection);
+        return true;
+    }
+    
+    // Read while the peer may send and no request is with a worker (the
+    // input is level-triggered, so a busy connection would otherwise spin
+    // the event thread and buffer whatever the client sends); write while
+    // output is pending. deliver_completions() re-arms the input
+    void update_events(uint64_t id, Connection& connection) {
+        const bool writing = connection.out_offset < connection.out.size();
+        const bool reading = !connection.eof && !connection.busy && connection.in.size() <= input_limit();
+        uint32_t events = 0;
+        if (reading) events |= EPOLLIN | EPOLLRDHUP;
+        if (writing) events |= EPOLLOUT;
+        epoll_event ev{};
+        ev.events = events;
+        ev.data.u64 = id;
+        epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, connection.fd, &ev);
+    }
+    
+    void deliver_completions() {
+        std::deque<Completion> completions;
+        {
+            std::lock_guard<std::mutex> lock(completions_mutex_);
+            completions.swap(completions_);
+        }
+        
+        for (auto& completion : completions) {
+            auto it = connections_.find(completion.id);
+            if (it == connections_.end()) continue;   // Closed meanwhile
+            Connection& connection = *it->second;
+            connection.busy = false;
+            connection.last_active = std::chrono::steady_clock::now();
+            connection.out += completion.data;
+            if (completion.close) {
+                connection.close_after = true;
+            }
+            if (flush(completion.id, connection)) {
+                // Next pipelined request, if one is buffered
+                process_input(completion.id, connection);
+            }
+        }
+    }
+    
+    void close_idle(std::chrono::steady_clock::time_point now) {
+        const auto timeout = std::chrono::milliseconds(config_.idle_timeout_ms);
+        std::vector<uint64_t> idle;
+        for (const auto& [id, connection] : connections_) {
+            if (!connection->busy && connection->out.empty() && now - connection->last_active > timeout) {
+                idle.push_back(id);
+            }
+        }
+        for (uint64_t id : idle) {
+            close_connection(id);
+        }
+    }
+    
+    void close_connection(uint64_t id) {
+        auto it = connections_.find(id);
+        if (it == connections_.end()) return;
+        epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, it->second->fd, nullptr);
+        close(it->second->fd);
+        connections_.erase(it);
+        open_.store(static_cast<uint32_t>(connections_.size()), std::memory_order_relaxed);
+    }
+    
+    void worker_loop() {
+        for (;;) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(jobs_mutex_);
+                jobs_cv_.wait(lock, [this]() { return stopping_ || !jobs_.empty(); });
+                if (stopping_) return;
+                job = std::move(jobs_.front());
+                jobs_.pop_front();
+            }
+            
+            HttpResponse response;
+            try {
+                response = handler_(job.request);
+            } catch (const std::exception& e) {
+                LOG_ERROR("HTTP {} {} failed: {}", job.request.method, job.request.path, e.what());
+                response = HttpResponse{};
+                response.status = 500;
+                response.body = R"({"code": 500, "error": "Internal Server Error"})";
+            }
+            requests_.fetch_add(1, std::memory_order_relaxed);
+            
+            {
+                std::lock_guard<std::mutex> lock(completions_mutex_);
+                completions_.push_back(Completion{job.id, serialize(response, job.keep_alive, job.request.method == "HEAD"),
+                                                  !job.keep_alive});
+            }
+            wake();
+        }
+    }
+    
+    void close_all() {
+        for (auto& [id, connection] : connections_) {
+            close(connection->fd);
+        }
+        connections_.clear();
+        open_ = 0;
+        for (int fd : listeners_) {
+            close(fd);
+        }
+        listeners_.clear();
+        listen_ports_.clear();
+        if (epoll_fd_ >= 0) {
+            close(epoll_fd_);
+            epoll_fd_ = -1;
+        }
+        if (wake_fd_ >= 0) {
+            close(wake_fd_);
+            wake_fd_ = -1;
+        }
+    }
+#endif
+    
+    static std::string serialize(const HttpResponse& response, bool keep_alive, bool head) {
+        // 1xx, 204 and 304 carry no body and no length
+        const bool bodyless = response.status < 200 || response.status == 204 || response.status == 304;
+        const std::string& body = response.shared_body ? *response.shared_body : response.body;
+        
+        std::string out;
+        out.reserve(160 + body.size());
+        out += "HTTP/1.1 ";
+        out += std::to_string(response.status);
+        out += ' ';
+        out += HttpServer::reason_phrase(response.status);
+        out += "\r\n";
+        if (!bodyless && !response.content_type.empty()) {
+            out += "Content-Type: ";
+            out += response.content_type;
+            out += "\r\n";
+        }
+        for (const auto& [name, value] : response.headers) {
+            out += name;
+            out += ": ";
+            out += value;
+            out += "\r\n";
+        }
+        if (!bodyless) {
+            out += "Content-Length: ";
+            out += std::to_string(body.size());
+            out += "\r\n";
+        }
+        if (!keep_alive) {
+            out += "Connection: close\r\n";
+        }
+        out += "\r\n";
+        if (!bodyless && !head) {
+            out += body;
+        }
+        return out;
+    }
+    
+    HttpServerConfig config_;
+    Handler handler_;
+    std::atomic<bool> running_{false};
+    
+    // Event thread only
+    std::thread loop_thread_;
+    int epoll_fd_ = -1;
+    int wake_fd_ = -1;
+    std::vector<int> listeners_;
+    std::vector<uint16_t> listen_ports_;
+    std::unordered_map<uint64_t, std::unique_ptr<Connection>> connections_;
+    uint64_t next_id_ = 1;
+    
+    // Requests for the workers
+    std::vector<std::thread> workers_;
+    std::mutex jobs_mutex_;
+    std::condition_variable jobs_cv_;
+    std::deque<Job> jobs_;
+    bool stopping_ = false;
+    
+    // Serialized responses back to the event thread
+    std::mutex completions_mutex_;
+    std::deque<Completion> completions_;
+    
+    std::atomic<uint64_t> accepted_{0};
+    std::atomic<uint64_t> requests_{0};
+    std::atomic<uint64_t> reused_{0};
+    std::atomic<uint64_t> rejected_{0};
+    std::atomic<uint32_t> open_{0};
+};
+
+// HttpServer public interface
+
+HttpServer::HttpServer() : impl_(std::make_unique<Impl>()) {}
+HttpServer::~HttpServer() = default;
+
+bool HttpServer::start(const HttpServerConfig& config, Handler handler) {
+    return impl_->start(config, std::move(handler));
+}
+
+void HttpServer::stop() {
+    impl_->stop();
+}
+
+bool HttpServer::is_running() const {
+    return impl_->is_running();
+}
+
+HttpServerStatistics HttpServer::get_statistics() const {
+    return impl_->get_statistics();
+}
+
+const char* HttpServer::reason_phrase(int status) {
+    switch (status) {
+        case 100: return "Continue";
+        case 200: return "OK";
+        case 201: return "Created";
+        case 202: return "Accepted";
+        case 204: return "No Content";
+        case 304: return "Not Modified";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 409: return "Conflict";
+        case 412: return "Precondition Failed";
+        case 413: return "Content Too Large";
+        case 423: return "Locked";
+        case 431: return "Request Header Fields Too Large";
+        case 500: return "Internal Server Error";
+        case 501: return "Not Implemented";
+        case 503: return "Service Unavailable";
+        case 505: return "HTTP Version Not Supported";
+        default: return status < 300 ? "OK" : status < 500 ? "Bad Request" : "Internal Server Error";
+    }
+}
+
+}  // namespace rpi_aes67
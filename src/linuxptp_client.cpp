@@ -0,0 +1,335 @@
+// SPDX-License-Identifier: MIT
+/*
+ * RPi-AES67 - Professional AES67 Sender/Receiver for Raspberry Pi 5
+ * Copyright (c) 2025 DHPKE
+ *
+ * linuxptp management client implementation.
+ */
+
+#include "rpi_aes67/linuxptp_client.h"
+#include "rpi_aes67/logger.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <random>
+
+#ifdef __linux__
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace rpi_aes67 {
+
+namespace {
+
+// Management message layout: PTP header, management header, one TLV
+constexpr size_t HEADER_SIZE = 34;
+constexpr size_t MANAGEMENT_HEADER_SIZE = 48;
+constexpr size_t TLV_OFFSET = MANAGEMENT_HEADER_SIZE;
+constexpr uint8_t MESSAGE_TYPE_MANAGEMENT = 0x0D;
+
+constexpr uint16_t TLV_MANAGEMENT = 0x0001;
+constexpr uint16_t TLV_MANAGEMENT_ERROR_STATUS = 0x0002;
+
+enum Action : uint8_t {
+    ACTION_GET = 0,
+    ACTION_SET = 1,
+    ACTION_RESPONSE = 2
+};
+
+// SUBSCRIBE_EVENTS_NP event bits
+constexpr int NOTIFY_PORT_STATE = 0;
+constexpr int NOTIFY_TIME_SYNC = 1;
+constexpr size_t EVENT_BITMASK_SIZE = 64;
+
+uint16_t get16(const uint8_t* p) {
+    return static_cast<uint16_t>((p[0] << 8) | p[1]);
+}
+
+uint32_t get32(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | p[3];
+}
+
+uint64_t get64(const uint8_t* p) {
+    return (static_cast<uint64_t>(get32(p)) << 32) | get32(p + 4);
+}
+
+void put16(uint8_t* p, uint16_t v) {
+    p[0] = static_cast<uint8_t>(v >> 8);
+    p[1] = static_cast<uint8_t>(v);
+}
+
+void put64(uint8_t* p, uint64_t v) {
+    for (int i = 7; i >= 0; --i) {
+        p[i] = static_cast<uint8_t>(v);
+        v >>= 8;
+    }
+}
+
+// TimeInterval: nanoseconds scaled by 2^16
+double time_interval_ns(const uint8_t* p) {
+    return static_cast<double>(static_cast<int64_t>(get64(p))) / 65536.0;
+}
+
+}  // namespace
+
+// ==================== LinuxPTPClient::Impl ====================
+
+class LinuxPTPClient::Impl {
+public:
+    Impl() {
+        std::random_device rd;
+        clock_id_ = (static_cast<uint64_t>(rd()) << 32) | rd();
+    }
+    
+    ~Impl() { close(); }
+    
+    bool open(const std::string& uds_path, uint8_t domain) {
+        close();
+        domain_ = domain;
+
+#ifdef __linux__
+        fd_ = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        if (fd_ < 0) {
+            LOG_ERROR("linuxptp: failed to create socket: {}", strerror(errno));
+            return false;
+        }
+        
+        // ptp4l replies to the sender's address; bind an abstract name so
+        // nothing is left behind in /var/run
+        static std::atomic<uint32_t> instance{0};
+        sockaddr_un local{};
+        local.sun_family = AF_UNIX;
+        std::string name = "rpi-aes67-pmc." + std::to_string(getpid()) + "." + std::to_string(instance++);
+        std::memcpy(local.sun_path + 1, name.data(), std::min(name.size(), sizeof(local.sun_path) - 2));
+        socklen_t local_len = static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + 1 + name.size());
+        if (bind(fd_, reinterpret_cast<sockaddr*>(&local), local_len) < 0) {
+            LOG_ERROR("linuxptp: failed to bind client socket: {}", strerror(errno));
+            close();
+            return false;
+        }
+        
+        sockaddr_un remote{};
+        if (uds_path.size() >= sizeof(remote.sun_path)) {
+            LOG_ERROR("linuxptp: socket path too long: {}", uds_path);
+            close();
+            return false;
+        }
+        remote.sun_family = AF_UNIX;
+        std::strncpy(remote.sun_path, uds_path.c_str(), sizeof(remote.sun_path) - 1);
+        if (connect(fd_, reinterpret_cast<sockaddr*>(&remote), sizeof(remote)) < 0) {
+            LOG_ERROR("linuxptp: cannot reach ptp4l at {}: {}", uds_path, strerror(errno));
+            close();
+            return false;
+        }
+        
+        LOG_INFO("linuxptp: connected to ptp4l at {} (domain {})", uds_path, static_cast<int>(domain));
+        return true;
+#else
+        (void)uds_path;
+        LOG_ERROR("linuxptp backend requires Linux");
+        return false;
+#endif
+    }
+    
+    void close() {
+#ifdef __linux__
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+#endif
+    }
+    
+    bool is_open() const { return fd_ >= 0; }
+    
+    bool get(uint16_t management_id) {
+        return send(ACTION_GET, management_id, nullptr, 0);
+    }
+    
+    bool subscribe(uint16_t duration_s) {
+        uint8_t data[2 + EVENT_BITMASK_SIZE] = {};
+        put16(data, duration_s);
+        data[2 + NOTIFY_PORT_STATE / 8] |= 1 << (NOTIFY_PORT_STATE % 8);
+        data[2 + NOTIFY_TIME_SYNC / 8] |= 1 << (NOTIFY_TIME_SYNC % 8);
+        return send(ACTION_SET, PMC_SUBSCRIBE_EVENTS_NP, data, sizeof(data));
+    }
+    
+    uint16_t receive(LinuxPTPStatus& status, int timeout_ms) {
+#ifdef __linux__
+        if (fd_ < 0) return 0;
+        
+        pollfd pfd{};
+        pfd.fd = fd_;
+        pfd.events = POLLIN;
+        if (poll(&pfd, 1, timeout_ms) <= 0) return 0;
+        
+        uint8_t buffer[1024];
+        ssize_t n = recv(fd_, buffer, sizeof(buffer), MSG_DONTWAIT);
+        if (n <= 0) return 0;
+        return apply(buffer, static_cast<size_t>(n), status);
+#else
+        (void)status;
+        (void)timeout_ms;
+        return 0;
+#endif
+    }
+
+private:
+    bool send(uint8_t action, uint16_t management_id, const uint8_t* data, size_t size) {
+#ifdef __linux__
+        if (fd_ < 0) return false;
+        
+        uint8_t buffer[MANAGEMENT_HEADER_SIZE + 6 + 128] = {};
+        size_t length = MANAGEMENT_HEADER_SIZE + 6 + size;
+        if (length > sizeof(buffer)) return false;
+        
+        buffer[0] = MESSAGE_TYPE_MANAGEMENT;
+        buffer[1] = 0x02;
+        put16(buffer + 2, static_cast<uint16_t>(length));
+        buffer[4] = domain_;
+        put64(buffer + 20, clock_id_);
+        put16(buffer + 28, static_cast<uint16_t>(getpid()));
+        put16(buffer + 30, sequence_id_++);
+        buffer[32] = 0x04;              // controlField: management
+        buffer[33] = 0x7F;
+        
+        // targetPortIdentity: all clocks, all ports
+        std::memset(buffer + HEADER_SIZE, 0xFF, 10);
+        buffer[46] = action;
+        
+        put16(buffer + TLV_OFFSET, TLV_MANAGEMENT);
+        put16(buffer + TLV_OFFSET + 2, static_cast<uint16_t>(2 + size));
+        put16(buffer + TLV_OFFSET + 4, management_id);
+        if (size > 0) {
+            std::memcpy(buffer + TLV_OFFSET + 6, data, size);
+        }
+        
+        if (::send(fd_, buffer, length, MSG_DONTWAIT) < 0) {
+            LOG_DEBUG("linuxptp: failed to send management request: {}", strerror(errno));
+            return false;
+        }
+        return true;
+#else
+        (void)action;
+        (void)management_id;
+        (void)data;
+        (void)size;
+        return false;
+#endif
+    }
+    
+    uint16_t apply(const uint8_t* buffer, size_t size, LinuxPTPStatus& status) {
+        if (size < TLV_OFFSET + 6) return 0;
+        if ((buffer[0] & 0x0F) != MESSAGE_TYPE_MANAGEMENT) return 0;
+        if ((buffer[46] & 0x0F) != ACTION_RESPONSE) return 0;
+        
+        uint16_t tlv_type = get16(buffer + TLV_OFFSET);
+        size_t tlv_length = get16(buffer + TLV_OFFSET + 2);
+        if (tlv_length < 2 || TLV_OFFSET + 4 + tlv_length > size) return 0;
+        
+        if (tlv_type == TLV_MANAGEMENT_ERROR_STATUS) {
+            LOG_WARNING("linuxptp: management error {} for id 0x{:04x}",
+                        get16(buffer + TLV_OFFSET + 4), get16(buffer + TLV_OFFSET + 6));
+            return 0;
+        }
+        if (tlv_type != TLV_MANAGEMENT) return 0;
+        
+        uint16_t id = get16(buffer + TLV_OFFSET + 4);
+        const uint8_t* p = buffer + TLV_OFFSET + 6;
+        size_t length = tlv_length - 2;
+        
+        switch (id) {
+            case PMC_TIME_STATUS_NP:
+                // master_offset, ingress_time, cumulativeScaledRateOffset,
+                // scaledLastGmPhaseChange, gmTimeBaseIndicator,
+                // lastGmPhaseChange (12), gmPresent, gmIdentity
+                if (length < 50) return 0;
+                status.master_offset_ns = static_cast<int64_t>(get64(p));
+                status.ingress_time_ns = static_cast<int64_t>(get64(p + 8));
+                status.gm_present = get32(p + 38) != 0;
+                status.gm_identity = get64(p + 42);
+                break;
+            
+            case PMC_CURRENT_DATA_SET:
+                if (length < 18) return 0;
+                status.steps_removed = get16(p);
+                status.offset_from_master_ns = static_cast<int64_t>(time_interval_ns(p + 2));
+                status.mean_path_delay_ns = time_interval_ns(p + 10);
+                break;
+            
+            case PMC_PORT_DATA_SET:
+                // portIdentity (10), portState, logMinDelayReqInterval,
+                // peerMeanPathDelay (8), logAnnounceInterval,
+                // announceReceiptTimeout, logSyncInterval
+                if (length < 26) return 0;
+                status.port_state = static_cast<LinuxPTPPortState>(p[10]);
+                status.log_sync_interval = static_cast<int8_t>(p[22]);
+                break;
+            
+            case PMC_TIME_PROPERTIES_DATA_SET:
+                if (length < 4) return 0;
+                status.current_utc_offset = static_cast<int16_t>(get16(p));
+                status.current_utc_offset_valid = (p[2] & 0x04) != 0;
+                break;
+            
+            case PMC_PARENT_DATA_SET:
+                // parentPortIdentity (10), parentStats, reserved,
+                // observedParentOffsetScaledLogVariance (2),
+                // observedParentClockPhaseChangeRate (4), gmPriority1,
+                // gmClockQuality (4), gmPriority2, gmIdentity
+                if (length < 32) return 0;
+                status.gm_priority1 = p[18];
+                status.gm_clock_class = p[19];
+                status.gm_clock_accuracy = p[20];
+                status.gm_priority2 = p[23];
+                status.gm_identity = get64(p + 24);
+                break;
+            
+            case PMC_SUBSCRIBE_EVENTS_NP:
+                break;
+            
+            default:
+                return 0;
+        }
+        return id;
+    }
+    
+    int fd_ = -1;
+    uint8_t domain_ = 0;
+    uint64_t clock_id_ = 0;
+    uint16_t sequence_id_ = 0;
+};
+
+// ==================== LinuxPTPClient ====================
+
+LinuxPTPClient::LinuxPTPClient() : impl_(std::make_unique<Impl>()) {}
+LinuxPTPClient::~LinuxPTPClient() = default;
+
+bool LinuxPTPClient::open(const std::string& uds_path, uint8_t domain) { return impl_->open(uds_path, domain); }
+void LinuxPTPClient::close() { impl_->close(); }
+bool LinuxPTPClient::is_open() const { return impl_->is_open(); }
+bool LinuxPTPClient::get(uint16_t management_id) { return impl_->get(management_id); }
+bool LinuxPTPClient::subscribe(uint16_t duration_s) { return impl_->subscribe(duration_s); }
+uint16_t LinuxPTPClient::receive(LinuxPTPStatus& status, int timeout_ms) { return impl_->receive(status, timeout_ms); }
+
+const char* LinuxPTPClient::port_state_to_string(LinuxPTPPortState state) {
+    switch (state) {
+        case LinuxPTPPortState::Initializing: return "INITIALIZING";
+        case LinuxPTPPortState::Faulty: return "FAULTY";
+        case LinuxPTPPortState::Disabled: return "DISABLED";
+        case LinuxPTPPortState::Listening: return "LISTENING";
+        case LinuxPTPPortState::PreMaster: return "PRE_MASTER";
+        case LinuxPTPPortState::Master: return "MASTER";
+        case LinuxPTPPortState::Passive: return "PASSIVE";
+        case LinuxPTPPortState::Uncalibrated: return "UNCALIBRATED";
+        case LinuxPTPPortState::Slave: return "SLAVE";
+        default: return "UNKNOWN";
+    }
+}
+
+}  // namespace rpi_aes67
@@ -18,8 +18,10 @@
 #include "rpi_aes67/logger.h"
 #include "rpi_aes67/ptp_sync.h"
 #include "rpi_aes67/pipewire_io.h"
+#include "rpi_aes67/pcm_codec.h"
 #include "rpi_aes67/sender.h"
 #include "rpi_aes67/receiver.h"
+#include "rpi_aes67/packet_ring.h"
 #include "rpi_aes67/nmos_node.h"
 
 using namespace rpi_aes67;
@@ -104,6 +106,7 @@ int main(int argc, char* argv[]) {
         LOG_INFO("Starting RPi-AES67 - Professional AES67 Sender/Receiver");
         LOG_INFO("Mode: {}", mode == OperationMode::Sender ? "Sender" :
                             mode == OperationMode::Receiver ? "Receiver" : "Bidirectional");
+        LOG_INFO("PCM codec kernels: {}", PCMCodec::isa_name(PCMCodec::active_isa()));
         
         // Load configuration
         Config config;
@@ -133,7 +136,12 @@ int main(int argc, char* argv[]) {
         
         // Initialize PTP synchronization
         auto ptp_sync = std::make_shared<PTPSync>();
-        if (!ptp_sync->initialize(config.network.interface, config.network.ptp_domain)) {
+        PTPConfig ptp_config;
+        ptp_config.interface = config.network.interface;
+        ptp_config.domain = config.network.ptp_domain;
+        ptp_config.backend = config.network.ptp_backend;
+        ptp_config.uds_path = config.network.ptp_uds_path;
+        if (!ptp_sync->initialize(ptp_config)) {
             LOG_WARNING("PTP initialization failed, using local clock");
         } else {
             ptp_sync->start();
@@ -147,6 +155,8 @@ int main(int argc, char* argv[]) {
             LOG_ERROR("Failed to initialize NMOS node");
             return 1;
         }
+        // Scheduled IS-05 activations run on PTP time
+        nmos_node->set_ptp_sync(ptp_sync);
         
         // Start NMOS node
         if (!nmos_node->start()) {
@@ -204,7 +214,42 @@ int main(int argc, char* argv[]) {
         
         // Initialize receivers
         std::vector<std::shared_ptr<AES67Receiver>> receivers;
+        std::shared_ptr<ReceiverEngine> receiver_engine;
+        std::shared_ptr<PacketRing> packet_ring;
         if (mode == OperationMode::Receiver || mode == OperationMode::Bidirectional) {
+            // One shared set of worker threads for all receivers
+            if (config.audio.receiver_threading == "engine") {
+                ReceiverEngineConfig engine_config;
+                engine_config.workers = config.audio.receiver_workers;
+                engine_config.worker_cpus = config.audio.receiver_worker_cpus;
+                engine_config.worker_priority = config.audio.receiver_worker_priority;
+                receiver_engine = std::make_shared<ReceiverEngine>();
+                if (!receiver_engine->start(engine_config)) {
+                    LOG_WARNING("Receiver engine unavailable, receivers use their own threads");
+                    receiver_engine.reset();
+                }
+            }
+            
+            // One capture ring for every receiver in packet_ring mode
+            bool use_packet_ring = false;
+            for (const auto& receiver_config : config.receivers) {
+                use_packet_ring |= receiver_config.enabled && receiver_config.receive_mode == "packet_ring";
+            }
+            if (use_packet_ring) {
+                PacketRingConfig ring_config;
+                ring_config.interface = config.network.interface;
+                ring_config.block_size = config.audio.packet_ring_block_kb * 1024;
+                ring_config.block_count = config.audio.packet_ring_blocks;
+                ring_config.block_timeout_ms = config.audio.packet_ring_timeout_ms;
+                ring_config.cpu = config.audio.packet_ring_cpu;
+                ring_config.priority = config.audio.receiver_worker_priority;
+                packet_ring = std::make_shared<PacketRing>();
+                if (!packet_ring->start(ring_config)) {
+                    LOG_WARNING("Packet ring unavailable, packet_ring receivers use recvmmsg");
+                    packet_ring.reset();
+                }
+            }
+            
             for (const auto& receiver_config : config.receivers) {
                 if (!receiver_config.enabled) continue;
                 
@@ -224,6 +269,8 @@ int main(int argc, char* argv[]) {
                 }
                 
                 receiver->set_ptp_sync(ptp_sync);
+                receiver->set_engine(receiver_engine);
+                receiver->set_packet_ring(packet_ring);
                 
                 if (!receiver->initialize()) {
                     LOG_ERROR("Failed to initialize receiver {}", receiver_config.id);
@@ -289,6 +336,12 @@ int main(int argc, char* argv[]) {
             receiver->disconnect();
         }
         receivers.clear();
+        if (packet_ring) {
+            packet_ring->stop();
+        }
+        if (receiver_engine) {
+            receiver_engine->stop();
+        }
         
         // Stop NMOS node
         nmos_node->stop();
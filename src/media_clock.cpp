@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: MIT
+/*
+ * RPi-AES67 - Professional AES67 Sender/Receiver for Raspberry Pi 5
+ * Copyright (c) 2025 DHPKE
+ *
+ * Media clock implementation.
+ */
+
+#include "rpi_aes67/media_clock.h"
+#include <charconv>
+
+namespace rpi_aes67 {
+
+MediaClock::MediaClock(uint32_t sample_rate, uint32_t offset)
+    : rate_(rate_for(sample_rate))
+    , offset_(offset) {}
+
+MediaClockRate MediaClock::rate_for(uint32_t sample_rate) {
+    switch (sample_rate) {
+        case 44100: return MEDIA_CLOCK_44100;
+        case 48000: return MEDIA_CLOCK_48000;
+        case 96000: return MEDIA_CLOCK_96000;
+        default: return MediaClockRate::make(sample_rate);
+    }
+}
+
+uint64_t MediaClock::ptp_time(uint32_t rtp_timestamp, uint64_t reference_ptp_ns) const {
+    // Sample count of the reference, then the signed 32-bit distance to
+    // the timestamp picks the nearest unfolding
+    uint64_t reference_samples = rate_.samples_at(reference_ptp_ns);
+    uint32_t reference_rtp = static_cast<uint32_t>(reference_samples) + offset_;
+    int32_t delta = static_cast<int32_t>(rtp_timestamp - reference_rtp);
+    
+    if (delta < 0 && static_cast<uint64_t>(-static_cast<int64_t>(delta)) > reference_samples) {
+        return 0;   // Before the PTP epoch
+    }
+    return rate_.ns_at(reference_samples + static_cast<int64_t>(delta));
+}
+
+bool MediaClock::parse_mediaclk(std::string_view attribute, uint32_t& offset) {
+    constexpr std::string_view prefix = "a=mediaclk:";
+    constexpr std::string_view direct = "direct=";
+    
+    if (attribute.substr(0, prefix.size()) == prefix) {
+        attribute.remove_prefix(prefix.size());
+    }
+    if (attribute.substr(0, direct.size()) != direct) {
+        return false;
+    }
+    attribute.remove_prefix(direct.size());
+    
+    // Offsets are unsigned 32-bit; anything after whitespace is a further parameter
+    uint64_t value = 0;
+    auto [end, ec] = std::from_chars(attribute.data(), attribute.data() + attribute.size(), value);
+    if (ec != std::errc() || end == attribute.data() || value > UINT32_MAX) {
+        return false;
+    }
+    if (end != attribute.data() + attribute.size() && *end != ' ' && *end != '\t' && *end != '\r') {
+        return false;
+    }
+    offset = static_cast<uint32_t>(value);
+    return true;
+}
+
+}  // namespace rpi_aes67
@@ -7,6 +7,10 @@
  */
 
 #include "rpi_aes67/nmos_node.h"
+#include "rpi_aes67/http_server.h"
+#include "rpi_aes67/activation_scheduler.h"
+#include "rpi_aes67/ptp_sync.h"
+#include "rpi_aes67/media_clock.h"
 #include "rpi_aes67/sender.h"
 #include "rpi_aes67/receiver.h"
 #include "rpi_aes67/logger.h"
@@ -17,16 +21,17 @@
 #include <iomanip>
 #include <random>
 #include <map>
-
-// Simple HTTP server using Boost.Beast would be ideal, but for simplicity
-// we'll use a basic socket-based implementation for now
+#include <set>
+#include <optional>
+#include <charconv>
+#include <utility>
+#include <nlohmann/json.hpp>
 
 #ifdef __linux__
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <unistd.h>
-#include <poll.h>
 #endif
 
 namespace rpi_aes67 {
@@ -74,6 +79,357 @@ bool UUIDGenerator::is_valid(const std::string& uuid) {
 
 // ==================== NMOSNode::Impl ====================
 
+namespace {
+
+/**
+ * @brief Serialized resource document with its strong ETag
+ */
+struct CachedDocument {
+    std::shared_ptr<const std::string> body;
+    std::string etag;
+};
+
+/**
+ * @brief Immutable Node API documents for one resource version
+ */
+struct ResourceSnapshot {
+    uint64_t version = 0;
+    CachedDocument self;
+    CachedDocument senders;
+    CachedDocument receivers;
+    std::map<std::string, CachedDocument> sender_docs;
+    std::map<std::string, CachedDocument> receiver_docs;
+};
+
+/**
+ * @brief IS-05 staged and active parameters of one sender or receiver
+ */
+struct ConnectionState {
+    ConnectionRequest staged;
+    ConnectionRequest active;
+    std::string activation_time;        // TAI "<seconds>:<nanoseconds>" of the last activation
+    std::string scheduled_time;         // When the pending scheduled activation fires
+    uint64_t pending = 0;               // Scheduler handle of that activation (0 = none)
+};
+
+/**
+ * @brief One activation, applied without resources_mutex_
+ */
+struct Activation {
+    std::string id;
+    bool is_sender = false;
+    std::shared_ptr<AES67Sender> sender;
+    std::shared_ptr<AES67Receiver> receiver;
+    ConnectionRequest request;
+    bool success = false;
+    std::string error;
+    std::string activation_time;
+    int64_t deadline_ns = 0;            // Scheduled activations: TAI sample boundary to switch at
+    uint64_t switch_handle = 0;         // Receiver switch prepared ahead of the deadline (0 = none)
+};
+
+/**
+ * @brief Stream an enabled receiver activation connects to
+ */
+struct ReceiverTarget {
+    std::string source;
+    uint16_t port = 5004;
+    SDPInfo info;                       // Parsed transport file (invalid if none)
+    bool use_sdp = false;               // Connect with the transport file itself
+};
+
+/**
+ * @brief Scheduled activations sharing one deadline
+ */
+struct ScheduledGroup {
+    std::vector<Activation> activations;
+    std::vector<int> prejoin_fds;       // Memberships of receivers that reconnect at the deadline
+    uint64_t handle = 0;                // Scheduler handle
+    
+    ScheduledGroup() = default;
+    ScheduledGroup(const ScheduledGroup&) = delete;
+    ScheduledGroup& operator=(const ScheduledGroup&) = delete;
+    
+    // Cancelled, dropped, or left over after firing
+    ~ScheduledGroup() {
+        for (const auto& activation : activations) {
+            if (activation.switch_handle != 0) {
+                activation.receiver->cancel_switch(activation.switch_handle);
+            }
+        }
+#ifdef __linux__
+        for (int fd : prejoin_fds) {
+            close(fd);
+        }
+#endif
+    }
+};
+
+const std::string CONNECTION_API = "/x-nmos/connection/v1.1";
+
+bool is_ipv4_address(const std::string& text) {
+    const char* p = text.data();
+    const char* end = p + text.size();
+    for (int part = 0; part < 4; ++part) {
+        if (part > 0) {
+            if (p == end || *p != '.') return false;
+            ++p;
+        }
+        unsigned value = 0;
+        auto [next, ec] = std::from_chars(p, end, value);
+        if (ec != std::errc() || next == p || next - p > 3 || value > 255) return false;
+        p = next;
+    }
+    return p == end;
+}
+
+// "<seconds>:<nanoseconds>" as used by IS-05 requested_time
+bool parse_tai_time(const std::string& text, int64_t& ns) {
+    size_t colon = text.find(':');
+    if (colon == 0 || colon == std::string::npos || colon + 1 == text.size()) return false;
+    uint64_t seconds = 0;
+    uint32_t nanoseconds = 0;
+    auto [s_end, s_ec] = std::from_chars(text.data(), text.data() + colon, seconds);
+    auto [n_end, n_ec] = std::from_chars(text.data() + colon + 1, text.data() + text.size(), nanoseconds);
+    if (s_ec != std::errc() || s_end != text.data() + colon || n_ec != std::errc() ||
+        n_end != text.data() + text.size() || nanoseconds >= 1000000000 || seconds > 9000000000ULL) {
+        return false;
+    }
+    ns = static_cast<int64_t>(seconds) * 1000000000 + nanoseconds;
+    return true;
+}
+
+std::string format_tai_time(int64_t ns) {
+    return std::to_string(ns / 1000000000) + ":" + std::to_string(ns % 1000000000);
+}
+
+// First sample boundary of the stream's media clock at or after ns
+int64_t sample_boundary(int64_t ns, uint32_t sample_rate) {
+    if (ns <= 0 || sample_rate == 0) return ns;
+    const MediaClockRate rate = MediaClock::rate_for(sample_rate);
+    uint64_t samples = rate.samples_at(static_cast<uint64_t>(ns));
+    uint64_t boundary = rate.ns_at(samples);
+    if (boundary < static_cast<uint64_t>(ns)) {
+        boundary = rate.ns_at(samples + 1);
+    }
+    return static_cast<int64_t>(boundary);
+}
+
+// null and "auto" both mean "let the node choose"
+bool parse_address(const nlohmann::json& value, std::string& out) {
+    if (value.is_null() || value == "auto") {
+        out.clear();
+        return true;
+    }
+    if (!value.is_string() || !is_ipv4_address(value.get<std::string>())) return false;
+    out = value.get<std::string>();
+    return true;
+}
+
+bool parse_port(const nlohmann::json& value, uint16_t& out) {
+    if (value == "auto") {
+        out = 0;
+        return true;
+    }
+    if (!value.is_number_integer() || value.get<int64_t>() < 1 || value.get<int64_t>() > 65535) return false;
+    out = static_cast<uint16_t>(value.get<int64_t>());
+    return true;
+}
+
+bool parse_transport_params(const nlohmann::json& legs, bool is_sender, TransportParams& params,
+                            std::string& error) {
+    if (!legs.is_array() || legs.size() != 1 || !legs[0].is_object()) {
+        error = "transport_params must be an array with one leg";
+        return false;
+    }
+    for (const auto& [key, value] : legs[0].items()) {
+        bool ok;
+        if (key == "source_ip") {
+            ok = parse_address(value, params.source_ip);
+        } else if (key == (is_sender ? "destination_ip" : "multicast_ip")) {
+            ok = parse_address(value, params.multicast_ip);
+        } else if (key == "interface_ip" && !is_sender) {
+            ok = parse_address(value, params.interface_ip);
+        } else if (key == "destination_port") {
+            ok = parse_port(value, params.destination_port);
+        } else if (key == "source_port" && is_sender) {
+            ok = parse_port(value, params.source_port);
+        } else if (key == "rtp_enabled") {
+            ok = value.is_boolean();
+            if (ok) params.rtp_enabled = value.get<bool>();
+        } else {
+            error = "Unknown transport parameter: " + key;
+            return false;
+        }
+        if (!ok) {
+            error = "Invalid value for transport parameter " + key;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool parse_transport_file(const nlohmann::json& file, ConnectionRequest& staged, std::string& error) {
+    if (!file.is_object()) {
+        error = "transport_file must be an object";
+        return false;
+    }
+    const nlohmann::json data = file.value("data", nlohmann::json());
+    const nlohmann::json type = file.value("type", nlohmann::json());
+    if (data.is_null()) {
+        staged.transport_file.clear();
+        return true;
+    }
+    if (!data.is_string() || !(type.is_null() || type == "application/sdp")) {
+        error = "transport_file must carry application/sdp data";
+        return false;
+    }
+    
+    SDPInfo info = SDPParser::parse(data.get_ref<const std::string&>());
+    if (!info.is_valid) {
+        error = "transport_file: " + (info.error ? "line " + std::to_string(info.error.line) + ": " + info.error.message
+                                                 : std::string("invalid SDP"));
+        return false;
+    }
+    staged.transport_file = data.get<std::string>();
+    staged.transport_file_type = "application/sdp";
+    staged.transport_params.multicast_ip = info.source_ip;
+    staged.transport_params.source_ip = info.source_addresses.empty() ? std::string() : info.source_addresses.front();
+    staged.transport_params.destination_port = info.port;
+    return true;
+}
+
+// Merge a staged PATCH into staged; on error staged may be partly updated
+bool apply_staged_patch(const nlohmann::json& patch, bool is_sender, ConnectionRequest& staged,
+                        std::string& error) {
+    if (!patch.is_object()) {
+        error = "Staged parameters must be a JSON object";
+        return false;
+    }
+    
+    // A transport file is applied first so transport_params in the same
+    // request override it
+    if (!is_sender && patch.contains("transport_file") &&
+        !parse_transport_file(patch["transport_file"], staged, error)) {
+        return false;
+    }
+    
+    const char* peer_key = is_sender ? "receiver_id" : "sender_id";
+    std::string& peer = is_sender ? staged.receiver_id : staged.sender_id;
+    for (const auto& [key, value] : patch.items()) {
+        if (key == peer_key) {
+            if (!value.is_null() && !value.is_string()) {
+                error = std::string(peer_key) + " must be a string or null";
+                return false;
+            }
+            peer = value.is_null() ? std::string() : value.get<std::string>();
+        } else if (key == "master_enable") {
+            if (!value.is_boolean()) {
+                error = "master_enable must be a boolean";
+                return false;
+            }
+            staged.master_enable = value.get<bool>();
+        } else if (key == "activation") {
+            if (!value.is_object()) {
+                error = "activation must be an object";
+                return false;
+            }
+            for (const auto& [field, setting] : value.items()) {
+                if (field == "mode" && setting.is_null()) {
+                    staged.activation_mode.clear();
+                } else if (field == "mode" && (setting == "activate_immediate" ||
+                                               setting == "activate_scheduled_absolute" ||
+                                               setting == "activate_scheduled_relative")) {
+                    staged.activation_mode = setting.get<std::string>();
+                } else if (field == "requested_time" && setting.is_null()) {
+                    staged.requested_time.clear();
+                } else if (int64_t ns; field == "requested_time" && setting.is_string() &&
+                           parse_tai_time(setting.get<std::string>(), ns)) {
+                    staged.requested_time = setting.get<std::string>();
+                } else {
+                    error = "Invalid activation " + field;
+                    return false;
+                }
+            }
+            if (staged.activation_mode.rfind("activate_scheduled", 0) == 0 && staged.requested_time.empty()) {
+                error = "Scheduled activation requires requested_time";
+                return false;
+            }
+        } else if (key == "transport_params") {
+            if (!parse_transport_params(value, is_sender, staged.transport_params, error)) {
+                return false;
+            }
+        } else if (key != "transport_file" || is_sender) {
+            error = "Unknown staged parameter: " + key;
+            return false;
+        }
+    }
+    return true;
+}
+
+nlohmann::json string_or_null(const std::string& text) {
+    return text.empty() ? nlohmann::json(nullptr) : nlohmann::json(text);
+}
+
+nlohmann::json string_or_auto(const std::string& text) {
+    return text.empty() ? nlohmann::json("auto") : nlohmann::json(text);
+}
+
+nlohmann::json port_or_auto(uint16_t port) {
+    return port == 0 ? nlohmann::json("auto") : nlohmann::json(port);
+}
+
+nlohmann::json connection_json(const ConnectionRequest& request, bool is_sender,
+                               const std::string& activation_time) {
+    const TransportParams& params = request.transport_params;
+    nlohmann::json json;
+    json[is_sender ? "receiver_id" : "sender_id"] = string_or_null(is_sender ? request.receiver_id : request.sender_id);
+    json["master_enable"] = request.master_enable;
+    json["activation"] = {
+        {"mode", string_or_null(request.activation_mode)},
+        {"requested_time", string_or_null(request.requested_time)},
+        {"activation_time", string_or_null(activation_time)}
+    };
+    
+    nlohmann::json leg;
+    if (is_sender) {
+        leg = {
+            {"source_ip", string_or_auto(params.source_ip)},
+            {"destination_ip", string_or_auto(params.multicast_ip)},
+            {"source_port", port_or_auto(params.source_port)},
+            {"destination_port", port_or_auto(params.destination_port)},
+            {"rtp_enabled", params.rtp_enabled}
+        };
+    } else {
+        leg = {
+            {"source_ip", string_or_null(params.source_ip)},
+            {"multicast_ip", string_or_null(params.multicast_ip)},
+            {"interface_ip", string_or_auto(params.interface_ip)},
+            {"destination_port", port_or_auto(params.destination_port)},
+            {"rtp_enabled", params.rtp_enabled}
+        };
+        json["transport_file"] = {
+            {"data", string_or_null(request.transport_file)},
+            {"type", request.transport_file.empty() ? nlohmann::json(nullptr) : nlohmann::json(request.transport_file_type)}
+        };
+    }
+    json["transport_params"] = nlohmann::json::array({leg});
+    return json;
+}
+
+HttpResponse json_response(int status, const nlohmann::json& body) {
+    HttpResponse response;
+    response.status = status;
+    response.body = body.dump();
+    return response;
+}
+
+HttpResponse error_response(int status, const std::string& error) {
+    return json_response(status, {{"code", status}, {"error", error}, {"debug", nullptr}});
+}
+
+}  // namespace
+
 class NMOSNode::Impl {
 public:
     Impl() = default;
@@ -95,6 +451,11 @@ public:
         LOG_INFO("Node ID: {}", node_id_);
         LOG_INFO("Device ID: {}", device_id_);
         
+        {
+            std::lock_guard<std::mutex> lock(resources_mutex_);
+            publish_snapshot();
+        }
+        
         initialized_ = true;
         return true;
     }
@@ -102,9 +463,14 @@ public:
     bool start() {
         if (state_ == NMOSNodeState::Running) return true;
         
+        ActivationSchedulerConfig scheduler_config;
+        scheduler_config.prepare_lead_ns = static_cast<int64_t>(network_config_.activation_lead_ms) * 1000000;
+        scheduler_.start(scheduler_config, ptp_sync_);
+        
         // Start HTTP server
         if (!start_http_server()) {
             LOG_ERROR("Failed to start HTTP server");
+            scheduler_.stop();
             return false;
         }
         
@@ -132,6 +498,7 @@ public:
         
         // Stop HTTP server
         stop_http_server();
+        scheduler_.stop();
         
         state_ = NMOSNodeState::Stopped;
         LOG_INFO("NMOS Node stopped");
@@ -158,6 +525,14 @@ public:
         senders_[id] = nmos_sender;
         sender_objects_[id] = sender;
         
+        // A sender streams to its configured destination from the start
+        ConnectionState& state = connections_[id];
+        state.staged.master_enable = sender->is_running();
+        state.staged.transport_params.multicast_ip = sender->get_multicast_ip();
+        state.staged.transport_params.destination_port = sender->get_port();
+        state.active = state.staged;
+        publish_snapshot();
+        
         LOG_INFO("Registered sender: {} ({})", nmos_sender.label, id);
         return id;
     }
@@ -167,6 +542,8 @@ public:
         
         senders_.erase(sender_id);
         sender_objects_.erase(sender_id);
+        connections_.erase(sender_id);
+        publish_snapshot();
         
         LOG_INFO("Unregistered sender: {}", sender_id);
     }
@@ -187,6 +564,10 @@ public:
         
         receivers_[id] = nmos_receiver;
         receiver_objects_[id] = receiver;
+        ConnectionState& state = connections_[id];
+        state.staged.master_enable = false;
+        state.active.master_enable = false;
+        publish_snapshot();
         
         LOG_INFO("Registered receiver: {} ({})", nmos_receiver.label, id);
         return id;
@@ -197,6 +578,8 @@ public:
         
         receivers_.erase(receiver_id);
         receiver_objects_.erase(receiver_id);
+        connections_.erase(receiver_id);
+        publish_snapshot();
         
         LOG_INFO("Unregistered receiver: {}", receiver_id);
     }
@@ -257,104 +640,73 @@ public:
         connection_callback_ = std::move(callback);
     }
     
-    ConnectionResponse connect_to_sender(const std::string& /*sender_id*/,
+    void set_ptp_sync(std::shared_ptr<PTPSync> ptp) {
+        ptp_sync_ = std::move(ptp);
+    }
+    
+    ConnectionResponse connect_to_sender(const std::string& sender_id,
                                          const std::string& receiver_id,
                                          const TransportParams& params) {
-        std::lock_guard<std::mutex> lock(resources_mutex_);
-        
-        ConnectionResponse response;
-        
-        auto it = receiver_objects_.find(receiver_id);
-        if (it == receiver_objects_.end()) {
-            response.error_message = "Receiver not found";
-            return response;
-        }
-        
-        auto& receiver = it->second;
-        
-        // Connect using transport params
-        std::string source = params.multicast_ip.empty() ? params.source_ip : params.multicast_ip;
-        if (receiver->connect(source, params.destination_port)) {
-            receiver->start();
-            response.success = true;
-            response.state = NMOSConnectionState::Active;
-            response.active_params = params;
-        } else {
-            response.error_message = "Failed to connect";
-        }
-        
-        return response;
+        ConnectionRequest request;
+        request.sender_id = sender_id;
+        request.receiver_id = receiver_id;
+        request.master_enable = true;
+        request.transport_params = params;
+        return activate_requests({request}).front();
     }
     
     bool disconnect_receiver(const std::string& receiver_id) {
-        std::lock_guard<std::mutex> lock(resources_mutex_);
-        
-        auto it = receiver_objects_.find(receiver_id);
-        if (it == receiver_objects_.end()) {
-            return false;
-        }
-        
-        it->second->disconnect();
-        return true;
+        ConnectionRequest request;
+        request.receiver_id = receiver_id;
+        request.master_enable = false;
+        return activate_requests({request}).front().success;
     }
     
     TransportParams get_staged_params(const std::string& receiver_id) const {
         std::lock_guard<std::mutex> lock(resources_mutex_);
-        auto it = staged_params_.find(receiver_id);
-        if (it != staged_params_.end()) {
-            return it->second;
+        auto it = connections_.find(receiver_id);
+        if (it != connections_.end()) {
+            return it->second.staged.transport_params;
         }
         return TransportParams{};
     }
     
     TransportParams get_active_params(const std::string& receiver_id) const {
         std::lock_guard<std::mutex> lock(resources_mutex_);
-        auto it = active_params_.find(receiver_id);
-        if (it != active_params_.end()) {
-            return it->second;
+        auto it = connections_.find(receiver_id);
+        if (it != connections_.end()) {
+            return it->second.active.transport_params;
         }
         return TransportParams{};
     }
     
     bool stage_connection(const std::string& receiver_id, const TransportParams& params) {
         std::lock_guard<std::mutex> lock(resources_mutex_);
-        staged_params_[receiver_id] = params;
+        auto it = connections_.find(receiver_id);
+        if (it == connections_.end() || receiver_objects_.count(receiver_id) == 0) {
+            return false;
+        }
+        it->second.staged.transport_params = params;
+        it->second.staged.master_enable = true;
         return true;
     }
     
     ConnectionResponse activate_connection(const std::string& receiver_id) {
-        ConnectionResponse response;
-        
-        std::lock_guard<std::mutex> lock(resources_mutex_);
-        
-        auto staged_it = staged_params_.find(receiver_id);
-        if (staged_it == staged_params_.end()) {
-            response.error_message = "No staged parameters";
-            return response;
-        }
-        
-        auto receiver_it = receiver_objects_.find(receiver_id);
-        if (receiver_it == receiver_objects_.end()) {
-            response.error_message = "Receiver not found";
-            return response;
-        }
-        
-        auto& receiver = receiver_it->second;
-        const auto& params = staged_it->second;
-        
-        // Connect
-        std::string source = params.multicast_ip.empty() ? params.source_ip : params.multicast_ip;
-        if (receiver->connect(source, params.destination_port)) {
-            receiver->start();
-            active_params_[receiver_id] = params;
-            response.success = true;
-            response.state = NMOSConnectionState::Active;
-            response.active_params = params;
-        } else {
-            response.error_message = "Failed to activate connection";
+        return activate_connections({receiver_id}).front();
+    }
+    
+    std::vector<ConnectionResponse> activate_connections(const std::vector<std::string>& receiver_ids) {
+        std::vector<ConnectionRequest> requests;
+        {
+            std::lock_guard<std::mutex> lock(resources_mutex_);
+            for (const auto& id : receiver_ids) {
+                auto it = connections_.find(id);
+                ConnectionRequest request = it != connections_.end() ? it->second.staged : ConnectionRequest{};
+                request.receiver_id = id;
+                requests.push_back(std::move(request));
+            }
         }
-        
-        return response;
+        return activate_requests(requests);
     }
     
     std::string get_node_id() const { return node_id_; }
@@ -381,166 +733,814 @@ public:
 
 private:
     bool start_http_server() {
-#ifdef __linux__
-        server_fd_ = socket(AF_INET, SOCK_STREAM, 0);
-        if (server_fd_ < 0) {
-            LOG_ERROR("Failed to create HTTP server socket");
+        // The Node and Connection APIs share one server; both are routed on
+        // the path, so either port answers either API
+        HttpServerConfig config;
+        config.ports = {network_config_.node_port, network_config_.connection_port};
+        config.workers = network_config_.http_workers;
+        
+        running_ = true;
+        if (!http_server_.start(config, [this](const HttpRequest& request) { return handle_request(request); })) {
+            running_ = false;
             return false;
         }
+        return true;
+    }
+    
+    void stop_http_server() {
+        http_server_.stop();
+    }
+    
+    HttpResponse handle_request(const HttpRequest& request) {
+        LOG_DEBUG("HTTP {} {}", request.method, request.path);
         
-        int opt = 1;
-        setsockopt(server_fd_, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
-        
-        sockaddr_in addr{};
-        addr.sin_family = AF_INET;
-        addr.sin_port = htons(network_config_.node_port);
-        addr.sin_addr.s_addr = INADDR_ANY;
+        if (request.path.find("/x-nmos/node/v1.3") == 0) {
+            return handle_node_api(request);
+        }
+        if (request.path.find("/x-nmos/connection/v1.1") == 0) {
+            return handle_connection_api(request);
+        }
+        return not_found();
+    }
+    
+    static HttpResponse not_found() {
+        HttpResponse response;
+        response.status = 404;
+        response.content_type.clear();
+        return response;
+    }
+    
+    HttpResponse handle_node_api(const HttpRequest& request) {
+        static const std::string root = "/x-nmos/node/v1.3";
+        const std::string& path = request.path;
         
-        if (bind(server_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
-            LOG_ERROR("Failed to bind HTTP server to port {}", network_config_.node_port);
-            close(server_fd_);
-            server_fd_ = -1;
-            return false;
+        if (path == root || path == root + "/") {
+            HttpResponse response;
+            response.body = R"(["self/", "senders/", "receivers/", "devices/", "sources/", "flows/"])";
+            return response;
         }
         
-        if (listen(server_fd_, 10) < 0) {
-            LOG_ERROR("Failed to listen on HTTP server socket");
-            close(server_fd_);
-            server_fd_ = -1;
-            return false;
+        // Served from the published snapshot without touching resources_mutex_
+        auto snapshot = std::atomic_load(&snapshot_);
+        if (!snapshot) {
+            return not_found();
         }
         
-        running_ = true;
-        server_thread_ = std::thread([this]() { http_server_loop(); });
-#endif
-        return true;
+        if (path == root + "/self" || path == root + "/self/") {
+            return cached_response(snapshot->self, request);
+        }
+        if (auto document = find_document(path, root + "/senders", snapshot->senders, snapshot->sender_docs)) {
+            return cached_response(*document, request);
+        }
+        if (auto document = find_document(path, root + "/receivers", snapshot->receivers, snapshot->receiver_docs)) {
+            return cached_response(*document, request);
+        }
+        return not_found();
     }
     
-    void stop_http_server() {
-#ifdef __linux__
-        if (server_fd_ >= 0) {
-            shutdown(server_fd_, SHUT_RDWR);
-            close(server_fd_);
-            server_fd_ = -1;
+    // Collection at prefix, or a single resource at prefix/{id}
+    static const CachedDocument* find_document(const std::string& path, const std::string& prefix,
+                                               const CachedDocument& collection,
+                                               const std::map<std::string, CachedDocument>& resources) {
+        if (path.compare(0, prefix.size(), prefix) != 0) return nullptr;
+        if (path.size() == prefix.size() || path.size() == prefix.size() + 1) {
+            return path.size() == prefix.size() || path.back() == '/' ? &collection : nullptr;
         }
-#endif
+        if (path[prefix.size()] != '/') return nullptr;
         
-        if (server_thread_.joinable()) {
-            server_thread_.join();
+        std::string id = path.substr(prefix.size() + 1);
+        if (!id.empty() && id.back() == '/') {
+            id.pop_back();
         }
+        auto it = resources.find(id);
+        return it != resources.end() ? &it->second : nullptr;
     }
     
-    void http_server_loop() {
-#ifdef __linux__
-        while (running_) {
-            pollfd pfd{};
-            pfd.fd = server_fd_;
-            pfd.events = POLLIN;
-            
-            int ret = poll(&pfd, 1, 1000);  // 1s timeout
-            if (ret <= 0) continue;
-            
-            sockaddr_in client_addr{};
-            socklen_t client_len = sizeof(client_addr);
-            
-            int client_fd = accept(server_fd_, 
-                                   reinterpret_cast<sockaddr*>(&client_addr),
-                                   &client_len);
-            if (client_fd < 0) continue;
-            
-            // Handle request in a simple blocking way
-            handle_http_request(client_fd);
+    static HttpResponse cached_response(const CachedDocument& document, const HttpRequest& request) {
+        HttpResponse response;
+        response.headers.emplace_back("ETag", document.etag);
+        if (etag_matches(request.header("if-none-match"), document.etag)) {
+            response.status = 304;
+        } else {
+            response.shared_body = document.body;
+        }
+        return response;
+    }
+    
+    // If-None-Match uses weak comparison (RFC 9110 13.1.2)
+    static bool etag_matches(std::string_view header, const std::string& etag) {
+        while (!header.empty()) {
+            size_t comma = header.find(',');
+            std::string_view tag = header.substr(0, comma);
+            header = comma == std::string_view::npos ? std::string_view() : header.substr(comma + 1);
             
-            close(client_fd);
+            size_t start = tag.find_first_not_of(" \t");
+            if (start == std::string_view::npos) continue;
+            tag = tag.substr(start, tag.find_last_not_of(" \t") - start + 1);
+            if (tag == "*") return true;
+            if (tag.substr(0, 2) == "W/") {
+                tag.remove_prefix(2);
+            }
+            if (tag == etag) return true;
         }
-#endif
+        return false;
     }
     
-    void handle_http_request(int client_fd) {
-        char buffer[4096];
-        ssize_t received = recv(client_fd, buffer, sizeof(buffer) - 1, 0);
-        if (received <= 0) return;
+    HttpResponse handle_connection_api(const HttpRequest& request) {
+        // Path segments below the API root, ignoring a trailing slash
+        std::vector<std::string> segments;
+        std::istringstream path(request.path.substr(CONNECTION_API.size()));
+        for (std::string segment; std::getline(path, segment, '/');) {
+            if (!segment.empty()) segments.push_back(segment);
+        }
         
-        buffer[received] = '\0';
-        std::string request(buffer);
+        if (segments.empty()) {
+            return json_response(200, nlohmann::json::array({"bulk/", "single/"}));
+        }
+        if ((segments[0] != "bulk" && segments[0] != "single") ||
+            (segments.size() > 1 && segments[1] != "senders" && segments[1] != "receivers")) {
+            return not_found();
+        }
+        if (segments.size() == 1) {
+            return json_response(200, nlohmann::json::array({"senders/", "receivers/"}));
+        }
         
-        // Parse request line
-        std::string method, path;
-        std::istringstream iss(request);
-        iss >> method >> path;
+        const bool is_sender = segments[1] == "senders";
+        if (segments[0] == "bulk") {
+            if (segments.size() > 2) return not_found();
+            if (request.method != "POST") return error_response(405, "Bulk requests must use POST");
+            return handle_bulk(request.body, is_sender);
+        }
         
-        LOG_DEBUG("HTTP {} {}", method, path);
+        if (segments.size() == 2) {
+            std::lock_guard<std::mutex> lock(resources_mutex_);
+            nlohmann::json ids = nlohmann::json::array();
+            if (is_sender) {
+                for (const auto& [id, sender] : senders_) ids.push_back(id + "/");
+            } else {
+                for (const auto& [id, receiver] : receivers_) ids.push_back(id + "/");
+            }
+            return json_response(200, ids);
+        }
         
-        std::string response;
+        const std::string& id = segments[2];
+        if (segments.size() == 4 && segments[3] == "staged" && request.method == "PATCH") {
+            return patch_staged(id, is_sender, request.body);
+        }
         
-        if (path.find("/x-nmos/node/v1.3") == 0) {
-            response = handle_node_api(method, path);
-        } else if (path.find("/x-nmos/connection/v1.1") == 0) {
-            response = handle_connection_api(method, path, request);
-        } else {
-            response = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n";
+        std::lock_guard<std::mutex> lock(resources_mutex_);
+        auto state = connections_.find(id);
+        if (state == connections_.end() || (is_sender ? senders_.count(id) : receivers_.count(id)) == 0) {
+            return error_response(404, is_sender ? "Sender not found" : "Receiver not found");
+        }
+        if (segments.size() == 3) {
+            nlohmann::json children = nlohmann::json::array({"constraints/", "staged/", "active/", "transporttype/"});
+            if (is_sender) children.push_back("transportfile/");
+            return json_response(200, children);
         }
+        if (segments.size() > 4) return not_found();
         
-        send(client_fd, response.c_str(), response.length(), 0);
+        const std::string& leaf = segments[3];
+        if (leaf == "staged") {
+            return json_response(200, connection_json(state->second.staged, is_sender, state->second.scheduled_time));
+        }
+        if (leaf == "active") {
+            return json_response(200, connection_json(state->second.active, is_sender, state->second.activation_time));
+        }
+        if (leaf == "constraints") {
+            return json_response(200, nlohmann::json::array({nlohmann::json::object()}));
+        }
+        if (leaf == "transporttype") {
+            return json_response(200, "urn:x-nmos:transport:rtp");
+        }
+        if (leaf == "transportfile" && is_sender) {
+            HttpResponse response;
+            response.content_type = "application/sdp";
+            response.body = sender_objects_[id]->generate_sdp();
+            return response;
+        }
+        return not_found();
     }
     
-    std::string handle_node_api(const std::string& /*method*/, const std::string& path) {
-        std::ostringstream response;
-        std::string body;
+    // Validate a PATCH and merge it into the staged parameters. A requested
+    // activation is returned for the caller to apply (immediate, 200) or
+    // schedule (202). Relative times count from now_ns. resources_mutex_ held
+    int stage_patch(const std::string& id, bool is_sender, const nlohmann::json& patch, int64_t now_ns,
+                    std::string& error, std::optional<Activation>& activation) {
+        auto state = connections_.find(id);
+        auto sender = sender_objects_.find(id);
+        auto receiver = receiver_objects_.find(id);
+        if (state == connections_.end() || (is_sender ? sender == sender_objects_.end()
+                                                      : receiver == receiver_objects_.end())) {
+            error = is_sender ? "Sender not found" : "Receiver not found";
+            return 404;
+        }
+        
+        ConnectionRequest staged = state->second.staged;
+        if (!apply_staged_patch(patch, is_sender, staged, error)) {
+            return 400;
+        }
         
-        if (path == "/x-nmos/node/v1.3" || path == "/x-nmos/node/v1.3/") {
-            body = R"(["self/", "senders/", "receivers/", "devices/", "sources/", "flows/"])";
-        } else if (path == "/x-nmos/node/v1.3/self") {
-            body = generate_self_json();
-        } else if (path.find("/x-nmos/node/v1.3/senders") == 0) {
-            body = generate_senders_json();
-        } else if (path.find("/x-nmos/node/v1.3/receivers") == 0) {
-            body = generate_receivers_json();
+        // While an activation is scheduled the only change allowed is
+        // cancelling it (activation mode null)
+        if (state->second.pending != 0 && !staged.activation_mode.empty()) {
+            error = "A scheduled activation is pending";
+            return 423;
+        }
+        if (is_sender) {
+            // Senders stream to a fixed destination; only enable/disable applies
+            const TransportParams& params = staged.transport_params;
+            if ((!params.multicast_ip.empty() && params.multicast_ip != sender->second->get_multicast_ip()) ||
+                (params.destination_port != 0 && params.destination_port != sender->second->get_port())) {
+                error = "Sender destination cannot be changed at runtime";
+                return 400;
+            }
+        }
+        
+        // Accepted: only now may a pending activation be cancelled
+        if (state->second.pending != 0) {
+            cancel_scheduled(state->second);
+        }
+        
+        if (staged.activation_mode.empty()) {
+            state->second.staged = std::move(staged);
+            return 200;
+        }
+        
+        Activation next;
+        next.id = id;
+        next.is_sender = is_sender;
+        if (is_sender) {
+            next.sender = sender->second;
         } else {
-            response << "HTTP/1.1 404 Not Found\r\n";
-            response << "Content-Length: 0\r\n\r\n";
-            return response.str();
+            next.receiver = receiver->second;
         }
+        next.request = staged;
         
-        response << "HTTP/1.1 200 OK\r\n";
-        response << "Content-Type: application/json\r\n";
-        response << "Content-Length: " << body.length() << "\r\n";
-        response << "\r\n";
-        response << body;
+        int status = 200;
+        if (staged.activation_mode == "activate_immediate") {
+            // Immediate activations are not left staged
+            staged.activation_mode.clear();
+            staged.requested_time.clear();
+        } else {
+            int64_t requested = 0;
+            parse_tai_time(staged.requested_time, requested);
+            int64_t deadline = staged.activation_mode == "activate_scheduled_relative"
+                                   ? now_ns + requested : requested;
+            next.deadline_ns = sample_boundary(deadline, stream_rate(next));
+            status = 202;
+        }
+        activation = std::move(next);
+        state->second.staged = std::move(staged);
+        return status;
+    }
+    
+    // Media clock rate used to align a scheduled switch to a sample boundary
+    static uint32_t stream_rate(const Activation& activation) {
+        if (activation.is_sender) {
+            return activation.sender->get_audio_format().sample_rate;
+        }
+        if (!activation.request.transport_file.empty()) {
+            SDPInfo info = SDPParser::parse(activation.request.transport_file);
+            if (info.is_valid && info.format.sample_rate != 0) {
+                return info.format.sample_rate;
+            }
+        }
+        uint32_t rate = activation.receiver->get_sdp_info().format.sample_rate;
+        return rate != 0 ? rate : 48000;
+    }
+    
+    // Hand scheduled activations to the scheduler, one entry per distinct
+    // deadline so a salvo for one instant switches in parallel. Returns the
+    // resources the scheduler refused, with their staged activation
+    // withdrawn. resources_mutex_ held
+    std::set<std::string> schedule_activations(std::vector<Activation> activations) {
+        std::set<std::string> dropped;
+        std::map<int64_t, std::shared_ptr<ScheduledGroup>> groups;
+        for (auto& activation : activations) {
+            auto& group = groups[activation.deadline_ns];
+            if (!group) {
+                group = std::make_shared<ScheduledGroup>();
+            }
+            group->activations.push_back(std::move(activation));
+        }
         
-        return response.str();
+        for (auto& [deadline, group] : groups) {
+            group->handle = scheduler_.schedule(deadline,
+                                                [this, group]() { prepare_scheduled(*group); },
+                                                [this, group]() { fire_scheduled(*group); });
+            if (group->handle == 0) {
+                LOG_WARNING("Activation scheduler not running; {} activation(s) dropped",
+                            group->activations.size());
+                for (const auto& activation : group->activations) {
+                    ConnectionRequest& staged = connections_[activation.id].staged;
+                    staged.activation_mode.clear();
+                    staged.requested_time.clear();
+                    dropped.insert(activation.id);
+                }
+                continue;
+            }
+            for (const auto& activation : group->activations) {
+                ConnectionState& state = connections_[activation.id];
+                state.pending = group->handle;
+                state.scheduled_time = format_tai_time(deadline);
+            }
+            LOG_INFO("Scheduled {} activation(s) at {}", group->activations.size(), format_tai_time(deadline));
+        }
+        return dropped;
     }
     
-    std::string handle_connection_api(const std::string& method, 
-                                      const std::string& path,
-                                      const std::string& request) {
-        std::ostringstream response;
-        std::string body;
+    // resources_mutex_ held
+    void cancel_scheduled(ConnectionState& state) {
+        const uint64_t handle = state.pending;
+        state.pending = 0;
+        state.scheduled_time.clear();
         
-        if (method == "PATCH" && path.find("/staged") != std::string::npos) {
-            // Handle connection staging
-            // Extract receiver ID from path
-            // Parse JSON body and stage connection
+        // The scheduler entry may still carry other resources of the salvo
+        for (const auto& [id, other] : connections_) {
+            if (other.pending == handle) return;
+        }
+        scheduler_.cancel(handle);
+    }
+    
+    // Prepare stage, on a scheduler prepare thread: each receiver
+    // builds its new stream now (socket bound and joined, jitter buffer,
+    // media clock; a stopped one also opens its sink), all in parallel as
+    // in run_activations, so firing only commits. The rest have their
+    // multicast groups joined ahead
+    void prepare_scheduled(ScheduledGroup& group) {
+        std::set<std::string> pending;
+        {
+            std::lock_guard<std::mutex> lock(resources_mutex_);
+            for (const auto& activation : group.activations) {
+                auto it = connections_.find(activation.id);
+                if (it != connections_.end() && it->second.pending == group.handle) {
+                    pending.insert(activation.id);
+                }
+            }
+        }
+        
+        std::vector<Activation*> switches;
+        for (auto& activation : group.activations) {
+            const ConnectionRequest& request = activation.request;
+            if (!activation.is_sender && !connection_callback_ && pending.count(activation.id) != 0 &&
+                request.master_enable && request.transport_params.rtp_enabled) {
+                switches.push_back(&activation);
+            }
+        }
+        
+        std::vector<std::thread> threads;
+        threads.reserve(switches.size());
+        for (size_t i = 1; i < switches.size(); ++i) {
+            threads.emplace_back([activation = switches[i]]() { prepare_switch(*activation); });
+        }
+        if (!switches.empty()) {
+            prepare_switch(*switches.front());
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        prejoin(group);
+    }
+    
+    static void prepare_switch(Activation& activation) {
+        const ConnectionRequest& request = activation.request;
+        ReceiverTarget target;
+        if (!receiver_target(request, target)) return;
+        activation.switch_handle = target.use_sdp
+            ? activation.receiver->prepare_switch(request.transport_file, activation.deadline_ns)
+            : activation.receiver->prepare_switch(target.source, target.port, target.info.format,
+                                                  activation.deadline_ns);
+    }
+    
+    // Join the multicast groups of receivers that reconnect at the
+    // deadline, so the network is already forwarding their streams
+    void prejoin(ScheduledGroup& group) {
+#ifdef __linux__
+        for (const auto& activation : group.activations) {
+            const TransportParams& params = activation.request.transport_params;
+            in_addr group_addr{};
+            if (activation.is_sender || activation.switch_handle != 0 || !activation.request.master_enable ||
+                !params.rtp_enabled || inet_pton(AF_INET, params.multicast_ip.c_str(), &group_addr) != 1 ||
+                !IN_MULTICAST(ntohl(group_addr.s_addr))) {
+                continue;
+            }
             
-            // Find JSON body
-            size_t body_start = request.find("\r\n\r\n");
-            if (body_start != std::string::npos) {
-                std::string json_body = request.substr(body_start + 4);
-                // TODO: Parse JSON and stage connection
+            int fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+            if (fd < 0) continue;
+            ip_mreq mreq{};
+            mreq.imr_multiaddr = group_addr;
+            mreq.imr_interface.s_addr = INADDR_ANY;
+            if (!params.interface_ip.empty()) {
+                inet_pton(AF_INET, params.interface_ip.c_str(), &mreq.imr_interface);
+            }
+            // Unbound, so the socket itself never queues any traffic
+            if (setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0) {
+                LOG_WARNING("Pre-join of {} failed: {}", params.multicast_ip, strerror(errno));
+                close(fd);
+                continue;
+            }
+            group.prejoin_fds.push_back(fd);
+        }
+#else
+        (void)group;
+#endif
+    }
+    
+    // Fire stage. Prepared receivers commit inline, which only arms the
+    // swap their data path makes at the deadline's RTP timestamp; the rest
+    // reconnect now. No activation_mutex_: a salvo never waits for an
+    // unrelated request, and its resources refuse other activations while
+    // they are pending
+    void fire_scheduled(ScheduledGroup& group) {
+        std::vector<Activation*> due;
+        {
+            // Skip resources cancelled or removed since scheduling
+            std::lock_guard<std::mutex> lock(resources_mutex_);
+            for (auto& activation : group.activations) {
+                auto it = connections_.find(activation.id);
+                if (it != connections_.end() && it->second.pending == group.handle) {
+                    due.push_back(&activation);
+                }
+            }
+        }
+        
+        std::vector<Activation> switched;
+        std::vector<Activation> reconnect;
+        for (Activation* activation : due) {
+            const uint64_t handle = std::exchange(activation->switch_handle, 0);
+            if (handle != 0 && activation->receiver->commit_switch(handle)) {
+                activation->success = true;
+                switched.push_back(std::move(*activation));
+            } else {
+                reconnect.push_back(std::move(*activation));
+            }
+        }
+        
+        run_activations(reconnect);
+        for (auto& activation : reconnect) {
+            if (!activation.success) {
+                LOG_ERROR("Scheduled activation of {} failed: {}", activation.id, activation.error);
+            }
+            switched.push_back(std::move(activation));
+        }
+        for (auto& activation : switched) {
+            activation.activation_time = format_tai_time(activation.deadline_ns);
+        }
+        commit_activations(switched);
+
+#ifdef __linux__
+        for (int fd : group.prejoin_fds) {
+            close(fd);
+        }
+#endif
+        group.prejoin_fds.clear();
+    }
+    
+    HttpResponse patch_staged(const std::string& id, bool is_sender, const std::string& body) {
+        nlohmann::json patch = nlohmann::json::parse(body, nullptr, false);
+        if (patch.is_discarded()) {
+            return error_response(400, "Request body is not valid JSON");
+        }
+        
+        std::lock_guard<std::mutex> activation_lock(activation_mutex_);
+        std::optional<Activation> activation;
+        std::string error;
+        ConnectionRequest staged;
+        std::string scheduled_time;
+        int status;
+        {
+            std::lock_guard<std::mutex> lock(resources_mutex_);
+            status = stage_patch(id, is_sender, patch, scheduler_.now_ns(), error, activation);
+            if (status != 200 && status != 202) {
+                return error_response(status, error);
+            }
+            if (activation && activation->deadline_ns != 0) {
+                std::vector<Activation> scheduled;
+                scheduled.push_back(std::move(*activation));
+                activation.reset();
+                if (!schedule_activations(std::move(scheduled)).empty()) {
+                    return error_response(500, "Activation scheduler not running");
+                }
+            }
+            staged = connections_[id].staged;
+            scheduled_time = connections_[id].scheduled_time;
+        }
+        if (!activation) {
+            return json_response(status, connection_json(staged, is_sender, scheduled_time));
+        }
+        
+        std::vector<Activation> activations;
+        activations.push_back(std::move(*activation));
+        run_activations(activations);
+        commit_activations(activations);
+        const Activation& result = activations.front();
+        if (!result.success) {
+            return error_response(500, result.error);
+        }
+        return json_response(200, connection_json(result.request, is_sender, result.activation_time));
+    }
+    
+    // IS-05 bulk: [{"id": ..., "params": {...}}, ...] answered with one
+    // {"id", "code"[, "error"]} per entry, in request order
+    HttpResponse handle_bulk(const std::string& body, bool is_sender) {
+        nlohmann::json entries = nlohmann::json::parse(body, nullptr, false);
+        if (entries.is_discarded() || !entries.is_array()) {
+            return error_response(400, "Bulk request must be a JSON array");
+        }
+        
+        std::lock_guard<std::mutex> activation_lock(activation_mutex_);
+        nlohmann::json results = nlohmann::json::array();
+        std::vector<Activation> activations;
+        std::vector<int> slots(entries.size(), -1);
+        // One reference time, so relative requests in a salvo share a deadline
+        const int64_t now_ns = scheduler_.now_ns();
+        
+        // Validate and stage everything in one pass under the lock
+        {
+            std::lock_guard<std::mutex> lock(resources_mutex_);
+            for (size_t i = 0; i < entries.size(); ++i) {
+                const nlohmann::json& entry = entries[i];
+                nlohmann::json result;
+                if (!entry.is_object() || !entry.contains("id") || !entry["id"].is_string() ||
+                    !entry.contains("params")) {
+                    result = {{"id", entry.is_object() ? entry.value("id", nlohmann::json()) : nlohmann::json()},
+                              {"code", 400}, {"error", "Entries need an id and params"}};
+                    results.push_back(std::move(result));
+                    continue;
+                }
+                
+                const std::string id = entry["id"].get<std::string>();
+                std::optional<Activation> activation;
+                std::string error;
+                int status = stage_patch(id, is_sender, entry["params"], now_ns, error, activation);
+                result = {{"id", id}, {"code", status}};
+                if (status != 200 && status != 202) {
+                    result["error"] = error;
+                }
+                results.push_back(std::move(result));
+                if (activation) {
+                    slots[i] = add_activation(activations, std::move(*activation));
+                }
             }
             
-            body = R"({"master_enable": true})";
+            // Scheduled entries leave for the scheduler; the rest run now
+            std::vector<Activation> scheduled;
+            std::vector<Activation> immediate;
+            std::vector<int> moved(activations.size(), -1);
+            for (size_t k = 0; k < activations.size(); ++k) {
+                if (activations[k].deadline_ns != 0) {
+                    scheduled.push_back(std::move(activations[k]));
+                } else {
+                    moved[k] = static_cast<int>(immediate.size());
+                    immediate.push_back(std::move(activations[k]));
+                }
+            }
+            for (auto& slot : slots) {
+                slot = slot < 0 ? -1 : moved[static_cast<size_t>(slot)];
+            }
+            activations = std::move(immediate);
+            std::set<std::string> dropped = schedule_activations(std::move(scheduled));
+            for (auto& result : results) {
+                if (result["code"] == 202 && dropped.count(result["id"].get<std::string>()) != 0) {
+                    result["code"] = 500;
+                    result["error"] = "Activation scheduler not running";
+                }
+            }
+        }
+        
+        run_activations(activations);
+        commit_activations(activations);
+        
+        for (size_t i = 0; i < slots.size(); ++i) {
+            if (slots[i] < 0) continue;
+            const Activation& activation = activations[static_cast<size_t>(slots[i])];
+            if (!activation.success) {
+                results[i]["code"] = 500;
+                results[i]["error"] = activation.error;
+            }
+        }
+        return json_response(200, results);
+    }
+    
+    // Later requests for the same resource replace earlier ones, so one
+    // resource is never activated twice at once
+    static int add_activation(std::vector<Activation>& activations, Activation activation) {
+        for (size_t i = 0; i < activations.size(); ++i) {
+            if (activations[i].id == activation.id) {
+                activations[i] = std::move(activation);
+                return static_cast<int>(i);
+            }
+        }
+        activations.push_back(std::move(activation));
+        return static_cast<int>(activations.size() - 1);
+    }
+    
+    // Receiver activations through the public API; the request's
+    // receiver_id selects the receiver
+    std::vector<ConnectionResponse> activate_requests(const std::vector<ConnectionRequest>& requests) {
+        std::lock_guard<std::mutex> activation_lock(activation_mutex_);
+        std::vector<ConnectionResponse> responses(requests.size());
+        std::vector<Activation> activations;
+        std::vector<int> slots(requests.size(), -1);
+        {
+            std::lock_guard<std::mutex> lock(resources_mutex_);
+            for (size_t i = 0; i < requests.size(); ++i) {
+                auto it = receiver_objects_.find(requests[i].receiver_id);
+                if (it == receiver_objects_.end()) {
+                    responses[i].error_message = "Receiver not found";
+                    continue;
+                }
+                auto state = connections_.find(it->first);
+                if (state != connections_.end() && state->second.pending != 0) {
+                    // Its scheduled activation fires without activation_mutex_
+                    responses[i].error_message = "A scheduled activation is pending";
+                    continue;
+                }
+                Activation activation;
+                activation.id = it->first;
+                activation.receiver = it->second;
+                activation.request = requests[i];
+                activation.request.activation_mode = "activate_immediate";
+                activation.request.requested_time.clear();
+                slots[i] = add_activation(activations, std::move(activation));
+            }
+        }
+        
+        run_activations(activations);
+        commit_activations(activations);
+        
+        for (size_t i = 0; i < requests.size(); ++i) {
+            if (slots[i] < 0) continue;
+            const Activation& activation = activations[static_cast<size_t>(slots[i])];
+            responses[i].success = activation.success;
+            responses[i].error_message = activation.error;
+            if (activation.success) {
+                responses[i].active_params = activation.request.transport_params;
+                if (activation.request.master_enable) {
+                    responses[i].state = NMOSConnectionState::Active;
+                }
+            }
+        }
+        return responses;
+    }
+    
+    // Each activation mostly waits on its own socket (multicast rejoin,
+    // buffer setup), so a salvo runs them side by side and takes as long
+    // as the slowest one. resources_mutex_ not held
+    void run_activations(std::vector<Activation>& activations) const {
+        std::vector<std::thread> threads;
+        threads.reserve(activations.size());
+        for (size_t i = 1; i < activations.size(); ++i) {
+            threads.emplace_back([this, &activation = activations[i]]() { apply_activation(activation); });
+        }
+        if (!activations.empty()) {
+            apply_activation(activations.front());
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+    
+    // Where an enabled receiver activation connects; false if no source is staged
+    static bool receiver_target(const ConnectionRequest& request, ReceiverTarget& target) {
+        const TransportParams& params = request.transport_params;
+        target.source = params.multicast_ip.empty() ? params.source_ip : params.multicast_ip;
+        target.port = params.destination_port != 0 ? params.destination_port : 5004;
+        if (target.source.empty()) return false;
+        
+        // The full SDP keeps the media clock and packet time, unless
+        // transport_params redirected the stream
+        if (!request.transport_file.empty()) {
+            target.info = SDPParser::parse(request.transport_file);
+        }
+        target.use_sdp = target.info.is_valid && target.info.source_ip == target.source &&
+                         target.info.port == target.port;
+        return true;
+    }
+    
+    void apply_activation(Activation& activation) const {
+        const ConnectionRequest& request = activation.request;
+        const TransportParams& params = request.transport_params;
+        const bool enable = request.master_enable && params.rtp_enabled;
+        
+        if (activation.is_sender) {
+            if (enable) {
+                activation.success = activation.sender->is_running() || activation.sender->start();
+            } else {
+                activation.sender->stop();
+                activation.success = true;
+            }
+        } else if (connection_callback_) {
+            ConnectionResponse response = connection_callback_(request);
+            activation.success = response.success;
+            activation.error = response.error_message;
+        } else if (!enable) {
+            activation.receiver->disconnect();
+            activation.success = true;
         } else {
-            body = "{}";
+            ReceiverTarget target;
+            if (!receiver_target(request, target)) {
+                activation.error = "No source address staged";
+            } else {
+                bool connected = target.use_sdp
+                                     ? activation.receiver->connect(request.transport_file)
+                                     : activation.receiver->connect(target.source, target.port, target.info.format);
+                activation.success = connected && activation.receiver->start();
+            }
+        }
+        
+        if (!activation.success && activation.error.empty()) {
+            activation.error = "Failed to activate connection";
+        }
+        activation.activation_time = format_tai_time(scheduler_.now_ns());
+    }
+    
+    void commit_activations(const std::vector<Activation>& activations) {
+        std::lock_guard<std::mutex> lock(resources_mutex_);
+        bool changed = false;
+        for (const auto& activation : activations) {
+            auto it = connections_.find(activation.id);
+            if (it == connections_.end()) continue;
+            
+            // A scheduled activation is spent either way; a failed one must
+            // not leave the resource locked behind a pending schedule
+            if (activation.deadline_ns != 0) {
+                it->second.pending = 0;
+                it->second.scheduled_time.clear();
+                it->second.staged.activation_mode.clear();
+                it->second.staged.requested_time.clear();
+                changed = true;
+            }
+            if (!activation.success) continue;
+            it->second.active = activation.request;
+            it->second.activation_time = activation.activation_time;
+            update_subscription(activation);
+            changed = true;
+        }
+        if (changed) {
+            publish_snapshot();
+        }
+    }
+    
+    static CachedDocument make_document(std::string body) {
+        // FNV-1a of the representation: equal bodies share a strong ETag, so
+        // an unchanged resource stays valid across unrelated updates
+        uint64_t hash = 0xcbf29ce484222325ULL;
+        for (unsigned char c : body) {
+            hash = (hash ^ c) * 0x100000001b3ULL;
         }
+        std::ostringstream etag;
+        etag << '"' << std::hex << std::setw(16) << std::setfill('0') << hash << '"';
         
-        response << "HTTP/1.1 200 OK\r\n";
-        response << "Content-Type: application/json\r\n";
-        response << "Content-Length: " << body.length() << "\r\n";
-        response << "\r\n";
-        response << body;
+        CachedDocument document;
+        document.body = std::make_shared<const std::string>(std::move(body));
+        document.etag = etag.str();
+        return document;
+    }
+    
+    // Serialize every resource once and publish the result; resources_mutex_ held
+    void publish_snapshot() {
+        auto snapshot = std::make_shared<ResourceSnapshot>();
+        snapshot->version = ++version_;
+        snapshot->self = make_document(generate_self_json());
         
-        return response.str();
+        std::string collection = "[";
+        for (const auto& [id, sender] : senders_) {
+            CachedDocument document = make_document(generate_sender_json(sender));
+            if (collection.size() > 1) collection += ",";
+            collection += *document.body;
+            snapshot->sender_docs.emplace(id, std::move(document));
+        }
+        snapshot->senders = make_document(collection + "]");
+        
+        collection = "[";
+        for (const auto& [id, receiver] : receivers_) {
+            CachedDocument document = make_document(generate_receiver_json(receiver));
+            if (collection.size() > 1) collection += ",";
+            collection += *document.body;
+            snapshot->receiver_docs.emplace(id, std::move(document));
+        }
+        snapshot->receivers = make_document(collection + "]");
+        
+        std::atomic_store(&snapshot_, std::shared_ptr<const ResourceSnapshot>(std::move(snapshot)));
+    }
+    
+    // Record the peer of an activated resource; resources_mutex_ held
+    void update_subscription(const Activation& activation) {
+        const bool active = activation.request.master_enable && activation.request.transport_params.rtp_enabled;
+        if (activation.is_sender) {
+            auto it = senders_.find(activation.id);
+            if (it == senders_.end()) return;
+            it->second.subscription_receiver_id = activation.request.receiver_id;
+            it->second.subscription_active = active;
+        } else {
+            auto it = receivers_.find(activation.id);
+            if (it == receivers_.end()) return;
+            it->second.subscription_sender_id = activation.request.sender_id;
+            it->second.subscription_active = active;
+            it->second.connection_state = active ? NMOSConnectionState::Active : NMOSConnectionState::Disconnected;
+        }
     }
     
     std::string generate_self_json() const {
@@ -559,49 +1559,32 @@ private:
         return json.str();
     }
     
-    std::string generate_senders_json() const {
-        std::lock_guard<std::mutex> lock(resources_mutex_);
-        
+    static std::string generate_sender_json(const NMOSSender& sender) {
         std::ostringstream json;
-        json << "[";
-        
-        bool first = true;
-        for (const auto& [id, sender] : senders_) {
-            if (!first) json << ",";
-            first = false;
-            
-            json << "{";
-            json << "\"id\": \"" << sender.id << "\",";
-            json << "\"label\": \"" << sender.label << "\",";
-            json << "\"device_id\": \"" << sender.device_id << "\",";
-            json << "\"transport\": \"" << sender.transport << "\"";
-            json << "}";
-        }
-        
-        json << "]";
+        json << "{";
+        json << "\"id\": \"" << sender.id << "\",";
+        json << "\"label\": \"" << sender.label << "\",";
+        json << "\"device_id\": \"" << sender.device_id << "\",";
+        json << "\"transport\": \"" << sender.transport << "\"";
+        json << "}";
         return json.str();
     }
     
-    std::string generate_receivers_json() const {
-        std::lock_guard<std::mutex> lock(resources_mutex_);
-        
+    static std::string generate_receiver_json(const NMOSReceiver& receiver) {
         std::ostringstream json;
-        json << "[";
-        
-        bool first = true;
-        for (const auto& [id, receiver] : receivers_) {
-            if (!first) json << ",";
-            first = false;
-            
-            json << "{";
-            json << "\"id\": \"" << receiver.id << "\",";
-            json << "\"label\": \"" << receiver.label << "\",";
-            json << "\"device_id\": \"" << receiver.device_id << "\",";
-            json << "\"transport\": \"" << receiver.transport << "\"";
-            json << "}";
+        json << "{";
+        json << "\"id\": \"" << receiver.id << "\",";
+        json << "\"label\": \"" << receiver.label << "\",";
+        json << "\"device_id\": \"" << receiver.device_id << "\",";
+        json << "\"transport\": \"" << receiver.transport << "\",";
+        json << "\"subscription\": {\"sender_id\": ";
+        if (receiver.subscription_sender_id.empty()) {
+            json << "null";
+        } else {
+            json << "\"" << receiver.subscription_sender_id << "\"";
         }
-        
-        json << "]";
+        json << ", \"active\": " << (receiver.subscription_active ? "true" : "false") << "}";
+        json << "}";
         return json.str();
     }
     
@@ -657,15 +1640,18 @@ private:
     std::map<std::string, std::shared_ptr<AES67Sender>> sender_objects_;
     std::map<std::string, std::shared_ptr<AES67Receiver>> receiver_objects_;
     
+    // Serialized Node API documents, republished on every change
+    uint64_t version_ = 0;
+    std::shared_ptr<const ResourceSnapshot> snapshot_;
+    
     // Connection state
-    std::map<std::string, TransportParams> staged_params_;
-    std::map<std::string, TransportParams> active_params_;
+    std::map<std::string, ConnectionState> connections_;
+    std::mutex activation_mutex_;       // Serializes immediate activations; taken before resources_mutex_
+    std::shared_ptr<PTPSync> ptp_sync_;
+    ActivationScheduler scheduler_;     // Pending scheduled activations
     
     // HTTP server
-#ifdef __linux__
-    int server_fd_ = -1;
-#endif
-    std::thread server_thread_;
+    HttpServer http_server_;
     
     // Callbacks
     ConnectionCallback connection_callback_;
@@ -750,6 +1736,14 @@ ConnectionResponse NMOSNode::activate_connection(const std::string& receiver_id)
     return impl_->activate_connection(receiver_id);
 }
 
+void NMOSNode::set_ptp_sync(std::shared_ptr<PTPSync> ptp) {
+    impl_->set_ptp_sync(std::move(ptp));
+}
+
+std::vector<ConnectionResponse> NMOSNode::activate_connections(const std::vector<std::string>& receiver_ids) {
+    return impl_->activate_connections(receiver_ids);
+}
+
 std::string NMOSNode::get_node_id() const { return impl_->get_node_id(); }
 std::string NMOSNode::get_device_id() const { return impl_->get_device_id(); }
 NodeConfig NMOSNode::get_node_config() const { return impl_->get_node_config(); }
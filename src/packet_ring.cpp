@@ -0,0 +1,464 @@
+// SPDX-License-Identifier: MIT
+/*
+ * RPi-AES67 - Professional AES67 Sender/Receiver for Raspberry Pi 5
+ * Copyright (c) 2025 DHPKE
+ *
+ * TPACKET_V3 capture ring implementation.
+ */
+
+#include "rpi_aes67/packet_ring.h"
+#include "rpi_aes67/logger.h"
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+
+#ifdef __linux__
+#include <sys/socket.h>
+#include <sys/mman.h>
+#include <sys/eventfd.h>
+#include <linux/if_packet.h>
+#include <linux/if_ether.h>
+#include <linux/filter.h>
+#include <net/if.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+namespace rpi_aes67 {
+
+namespace {
+
+// Offsets into an Ethernet II / IPv4 frame
+constexpr uint32_t ETH_TYPE_OFFSET = 12;
+constexpr uint32_t IP_OFFSET = 14;
+constexpr uint32_t IP_FRAG_OFFSET = IP_OFFSET + 6;
+constexpr uint32_t IP_PROTO_OFFSET = IP_OFFSET + 9;
+constexpr uint32_t IP_DST_OFFSET = IP_OFFSET + 16;
+constexpr uint32_t UDP_HEADER_SIZE = 8;
+
+// Classic BPF: 12 fixed instructions plus 5 per pair, within BPF_MAXINSNS
+constexpr size_t MAX_EXACT_SUBSCRIPTIONS = 800;
+constexpr uint32_t FILTER_ACCEPT = 0x40000;
+
+uint64_t subscription_key(uint32_t address, uint16_t port) {
+    return (static_cast<uint64_t>(address) << 16) | port;
+}
+
+uint16_t load_be16(const uint8_t* p) {
+    return static_cast<uint16_t>((p[0] << 8) | p[1]);
+}
+
+uint32_t load_be32(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | p[3];
+}
+
+}  // namespace
+
+class PacketRing::Impl {
+public:
+    Impl() = default;
+    
+    ~Impl() {
+        stop();
+    }
+    
+    bool start(const PacketRingConfig& config) {
+        if (running_) return true;
+
+#ifdef __linux__
+        config_ = config;
+        const uint32_t page = static_cast<uint32_t>(sysconf(_SC_PAGESIZE));
+        if (config_.block_size == 0 || config_.block_size % page != 0 ||
+            config_.frame_size < TPACKET_ALIGNMENT || config_.frame_size % TPACKET_ALIGNMENT != 0 ||
+            config_.block_size < config_.frame_size || config_.block_count == 0) {
+            LOG_ERROR("Packet ring: block size {} must be a multiple of the page size and hold a {} byte frame",
+                      config_.block_size, config_.frame_size);
+            return false;
+        }
+        
+        unsigned int ifindex = if_nametoindex(config_.interface.c_str());
+        if (ifindex == 0) {
+            LOG_ERROR("Packet ring: unknown interface {}", config_.interface);
+            return false;
+        }
+        
+        // Protocol 0 captures nothing until bind(), after the ring and filter exist
+        fd_ = socket(AF_PACKET, SOCK_RAW, 0);
+        if (fd_ < 0) {
+            LOG_ERROR("Packet ring: AF_PACKET socket failed: {} (needs CAP_NET_RAW)", strerror(errno));
+            return false;
+        }
+        
+        int version = TPACKET_V3;
+        if (setsockopt(fd_, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0) {
+            LOG_ERROR("Packet ring: TPACKET_V3 unsupported: {}", strerror(errno));
+            close_ring();
+            return false;
+        }
+        
+        tpacket_req3 req{};
+        req.tp_block_size = config_.block_size;
+        req.tp_block_nr = config_.block_count;
+        req.tp_frame_size = config_.frame_size;
+        req.tp_frame_nr = (config_.block_size / config_.frame_size) * config_.block_count;
+        req.tp_retire_blk_tov = std::max<uint32_t>(config_.block_timeout_ms, 1);
+        if (setsockopt(fd_, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req)) < 0) {
+            LOG_ERROR("Packet ring: PACKET_RX_RING failed: {}", strerror(errno));
+            close_ring();
+            return false;
+        }
+        
+        ring_size_ = static_cast<size_t>(config_.block_size) * config_.block_count;
+        void* ring = mmap(nullptr, ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, 0);
+        if (ring == MAP_FAILED) {
+            LOG_ERROR("Packet ring: mmap of {} bytes failed: {}", ring_size_, strerror(errno));
+            close_ring();
+            return false;
+        }
+        ring_ = static_cast<uint8_t*>(ring);
+        
+        // Our own transmissions on this interface are not receive traffic
+        int ignore = 1;
+        if (setsockopt(fd_, SOL_PACKET, PACKET_IGNORE_OUTGOING, &ignore, sizeof(ignore)) < 0) {
+            LOG_WARNING("Packet ring: PACKET_IGNORE_OUTGOING unsupported, outgoing frames are captured too");
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!apply_filter()) {
+                close_ring();
+                return false;
+            }
+        }
+        
+        sockaddr_ll addr{};
+        addr.sll_family = AF_PACKET;
+        addr.sll_protocol = htons(ETH_P_IP);
+        addr.sll_ifindex = static_cast<int>(ifindex);
+        if (bind(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+            LOG_ERROR("Packet ring: bind to {} failed: {}", config_.interface, strerror(errno));
+            close_ring();
+            return false;
+        }
+        
+        wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        running_ = true;
+        thread_ = std::thread([this]() { ring_loop(); });
+        
+        LOG_INFO("Packet ring on {}: {} x {} KiB blocks, {} ms block timeout",
+                 config_.interface, config_.block_count, config_.block_size / 1024, req.tp_retire_blk_tov);
+        return true;
+#else
+        (void)config;
+        LOG_ERROR("Packet ring requires Linux");
+        return false;
+#endif
+    }
+    
+    void stop() {
+        if (!running_) return;
+        running_ = false;
+
+#ifdef __linux__
+        if (wake_fd_ >= 0) {
+            uint64_t one = 1;
+            ssize_t n = ::write(wake_fd_, &one, sizeof(one));
+            (void)n;
+        }
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        read_kernel_statistics();
+        close_ring();
+#endif
+        LOG_INFO("Packet ring stopped");
+    }
+    
+    bool is_running() const { return running_; }
+    
+    bool subscribe(const std::string& address, uint16_t port, Handler handler) {
+#ifdef __linux__
+        in_addr addr{};
+        if (!handler || inet_pton(AF_INET, address.c_str(), &addr) != 1) {
+            LOG_ERROR("Packet ring: invalid subscription {}:{}", address, port);
+            return false;
+        }
+        
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint64_t key = subscription_key(ntohl(addr.s_addr), port);
+        if (!subscriptions_.emplace(key, std::move(handler)).second) {
+            LOG_ERROR("Packet ring: {}:{} is already subscribed", address, port);
+            return false;
+        }
+        if (fd_ >= 0) {
+            apply_filter();
+        }
+        return true;
+#else
+        (void)address;
+        (void)port;
+        (void)handler;
+        return false;
+#endif
+    }
+    
+    void unsubscribe(const std::string& address, uint16_t port) {
+#ifdef __linux__
+        in_addr addr{};
+        if (inet_pton(AF_INET, address.c_str(), &addr) != 1) return;
+        
+        // The ring thread holds the lock while walking a block
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (subscriptions_.erase(subscription_key(ntohl(addr.s_addr), port)) > 0 && fd_ >= 0) {
+            apply_filter();
+        }
+#else
+        (void)address;
+        (void)port;
+#endif
+    }
+    
+    PacketRingStatistics get_statistics() const {
+        PacketRingStatistics stats;
+        stats.blocks = blocks_.load(std::memory_order_relaxed);
+        stats.packets = packets_.load(std::memory_order_relaxed);
+        stats.unmatched = unmatched_.load(std::memory_order_relaxed);
+        
+        std::lock_guard<std::mutex> lock(mutex_);
+        read_kernel_statistics();
+        stats.kernel_packets = kernel_packets_;
+        stats.kernel_drops = kernel_drops_;
+        stats.freezes = freezes_;
+        stats.subscriptions = static_cast<uint32_t>(subscriptions_.size());
+        stats.filter_exact = subscriptions_.size() <= MAX_EXACT_SUBSCRIPTIONS;
+        return stats;
+    }
+
+private:
+#ifdef __linux__
+    void ring_loop() {
+        apply_thread_policy();
+        
+        uint32_t index = 0;
+        while (running_) {
+            auto* block = reinterpret_cast<tpacket_block_desc*>(ring_ + static_cast<size_t>(index) * config_.block_size);
+            if ((__atomic_load_n(&block->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER) == 0) {
+                pollfd pfds[2]{};
+                pfds[0].fd = fd_;
+                pfds[0].events = POLLIN | POLLERR;
+                pfds[1].fd = wake_fd_;
+                pfds[1].events = POLLIN;
+                poll(pfds, wake_fd_ >= 0 ? 2 : 1, 100);
+                continue;
+            }
+            
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                walk_block(*block);
+            }
+            blocks_.fetch_add(1, std::memory_order_relaxed);
+            
+            // Hand the block back to the kernel
+            __atomic_store_n(&block->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+            index = (index + 1) % config_.block_count;
+        }
+    }
+    
+    void walk_block(const tpacket_block_desc& block) {
+        const uint8_t* base = reinterpret_cast<const uint8_t*>(&block);
+        const uint32_t count = block.hdr.bh1.num_pkts;
+        uint32_t offset = block.hdr.bh1.offset_to_first_pkt;
+        
+        for (uint32_t i = 0; i < count && offset != 0; ++i) {
+            const auto* hdr = reinterpret_cast<const tpacket3_hdr*>(base + offset);
+            deliver(base + offset + hdr->tp_mac, hdr->tp_snaplen, hdr->tp_sec, hdr->tp_nsec);
+            offset += hdr->tp_next_offset;
+        }
+    }
+    
+    // Demultiplex one frame by destination address and port
+    void deliver(const uint8_t* frame, uint32_t length, uint32_t sec, uint32_t nsec) {
+        if (length < IP_OFFSET + 20 + UDP_HEADER_SIZE ||
+            load_be16(frame + ETH_TYPE_OFFSET) != ETH_P_IP) {
+            unmatched_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        const uint8_t* ip = frame + IP_OFFSET;
+        const uint32_t ihl = (ip[0] & 0x0F) * 4u;
+        const uint8_t* udp = ip + ihl;
+        const uint8_t* end = frame + length;
+        if ((ip[0] >> 4) != 4 || ihl < 20 || ip[9] != IPPROTO_UDP || udp + UDP_HEADER_SIZE > end) {
+            unmatched_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        
+        auto it = subscriptions_.find(subscription_key(load_be32(frame + IP_DST_OFFSET), load_be16(udp + 2)));
+        if (it == subscriptions_.end()) {
+            unmatched_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        
+        const uint8_t* payload = udp + UDP_HEADER_SIZE;
+        size_t size = std::min<size_t>(std::max<uint16_t>(load_be16(udp + 4), UDP_HEADER_SIZE) - UDP_HEADER_SIZE,
+                                       static_cast<size_t>(end - payload));
+        timespec ts{};
+        ts.tv_sec = static_cast<time_t>(sec);
+        ts.tv_nsec = static_cast<long>(nsec);
+        it->second(payload, size, ts);
+        packets_.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    // Rebuild the socket filter from the subscriptions (mutex_ held)
+    bool apply_filter() {
+        std::vector<sock_filter> program;
+        auto op = [&program](uint16_t code, uint32_t k, uint8_t jt = 0, uint8_t jf = 0) {
+            program.push_back(sock_filter{code, jt, jf, k});
+        };
+        
+        if (!subscriptions_.empty()) {
+            // IPv4, UDP, not a trailing fragment; each test falls through
+            // on a match and otherwise hits the "ret #0" right after it
+            op(BPF_LD | BPF_H | BPF_ABS, ETH_TYPE_OFFSET);
+            op(BPF_JMP | BPF_JEQ | BPF_K, ETH_P_IP, 1, 0);
+            op(BPF_RET | BPF_K, 0);
+            op(BPF_LD | BPF_B | BPF_ABS, IP_PROTO_OFFSET);
+            op(BPF_JMP | BPF_JEQ | BPF_K, IPPROTO_UDP, 1, 0);
+            op(BPF_RET | BPF_K, 0);
+            op(BPF_LD | BPF_H | BPF_ABS, IP_FRAG_OFFSET);
+            op(BPF_JMP | BPF_JSET | BPF_K, 0x1FFF, 0, 1);
+            op(BPF_RET | BPF_K, 0);
+            op(BPF_LDX | BPF_B | BPF_MSH, IP_OFFSET);   // X = IP header length
+            
+            if (subscriptions_.size() <= MAX_EXACT_SUBSCRIPTIONS) {
+                for (const auto& entry : subscriptions_) {
+                    uint32_t address = static_cast<uint32_t>(entry.first >> 16);
+                    uint16_t port = static_cast<uint16_t>(entry.first & 0xFFFF);
+                    op(BPF_LD | BPF_W | BPF_ABS, IP_DST_OFFSET);
+                    op(BPF_JMP | BPF_JEQ | BPF_K, address, 0, 3);
+                    op(BPF_LD | BPF_H | BPF_IND, IP_OFFSET + 2);    // UDP destination port
+                    op(BPF_JMP | BPF_JEQ | BPF_K, port, 0, 1);
+                    op(BPF_RET | BPF_K, FILTER_ACCEPT);
+                }
+            } else {
+                // Too many pairs for one program: admit all UDP, demux drops the rest
+                op(BPF_RET | BPF_K, FILTER_ACCEPT);
+            }
+        }
+        op(BPF_RET | BPF_K, 0);
+        
+        sock_fprog fprog{};
+        fprog.len = static_cast<unsigned short>(program.size());
+        fprog.filter = program.data();
+        if (setsockopt(fd_, SOL_SOCKET, SO_ATTACH_FILTER, &fprog, sizeof(fprog)) < 0) {
+            LOG_ERROR("Packet ring: failed to attach filter: {}", strerror(errno));
+            return false;
+        }
+        return true;
+    }
+    
+    // PACKET_STATISTICS resets on read, so accumulate (mutex_ held)
+    void read_kernel_statistics() const {
+        if (fd_ < 0) return;
+        tpacket_stats_v3 stats{};
+        socklen_t len = sizeof(stats);
+        if (getsockopt(fd_, SOL_PACKET, PACKET_STATISTICS, &stats, &len) == 0) {
+            kernel_packets_ += stats.tp_packets;
+            kernel_drops_ += stats.tp_drops;
+            freezes_ += stats.tp_freeze_q_cnt;
+        }
+    }
+    
+    void apply_thread_policy() {
+        if (config_.cpu >= 0) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(config_.cpu, &cpus);
+            if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) != 0) {
+                LOG_WARNING("Packet ring: failed to pin thread to CPU {}", config_.cpu);
+            }
+        }
+        if (config_.priority > 0) {
+            sched_param param{};
+            param.sched_priority = config_.priority;
+            if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0) {
+                LOG_WARNING("Packet ring: SCHED_FIFO priority {} not permitted (needs CAP_SYS_NICE or rtprio limit)",
+                           config_.priority);
+            }
+        }
+    }
+    
+    void close_ring() {
+        if (ring_ != nullptr) {
+            munmap(ring_, ring_size_);
+            ring_ = nullptr;
+        }
+        if (fd_ >= 0) {
+            close(fd_);
+            fd_ = -1;
+        }
+        if (wake_fd_ >= 0) {
+            close(wake_fd_);
+            wake_fd_ = -1;
+        }
+    }
+#endif
+    
+    PacketRingConfig config_;
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+    int fd_ = -1;
+    int wake_fd_ = -1;
+    uint8_t* ring_ = nullptr;
+    size_t ring_size_ = 0;
+    
+    // Held by the ring thread for a whole block walk
+    mutable std::mutex mutex_;
+    std::unordered_map<uint64_t, Handler> subscriptions_;
+    
+    std::atomic<uint64_t> blocks_{0};
+    std::atomic<uint64_t> packets_{0};
+    std::atomic<uint64_t> unmatched_{0};
+    mutable uint64_t kernel_packets_ = 0;
+    mutable uint64_t kernel_drops_ = 0;
+    mutable uint64_t freezes_ = 0;
+};
+
+// PacketRing public interface
+
+PacketRing::PacketRing() : impl_(std::make_unique<Impl>()) {}
+PacketRing::~PacketRing() = default;
+
+bool PacketRing::start(const PacketRingConfig& config) {
+    return impl_->start(config);
+}
+
+void PacketRing::stop() {
+    impl_->stop();
+}
+
+bool PacketRing::is_running() const {
+    return impl_->is_running();
+}
+
+bool PacketRing::subscribe(const std::string& address, uint16_t port, Handler handler) {
+    return impl_->subscribe(address, port, std::move(handler));
+}
+
+void PacketRing::unsubscribe(const std::string& address, uint16_t port) {
+    impl_->unsubscribe(address, port);
+}
+
+PacketRingStatistics PacketRing::get_statistics() const {
+    return impl_->get_statistics();
+}
+
+}  // namespace rpi_aes67
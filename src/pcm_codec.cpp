@@ -0,0 +1,858 @@
+// SPDX-License-Identifier: MIT
+/*
+ * RPi-AES67 - Professional AES67 Sender/Receiver for Raspberry Pi 5
+ * Copyright (c) 2025 DHPKE
+ *
+ * PCM codec implementation.
+ * Scalar reference kernels plus SSE4.1/AVX2 (x86) and NEON (AArch64)
+ * variants. Every vector kernel hands its tail to the scalar kernel, so
+ * all kernel sets produce bit-identical output.
+ */
+
+#include "rpi_aes67/pcm_codec.h"
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define RPI_AES67_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__)
+#define RPI_AES67_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace rpi_aes67 {
+
+namespace {
+
+// Full-scale factors; 24-bit values are converted left-justified in 32 bits
+constexpr float INV_2_15 = 1.0f / 32768.0f;
+constexpr float INV_2_31 = 1.0f / 2147483648.0f;
+constexpr float SCALE_16 = 32768.0f;
+constexpr float SCALE_24 = 8388608.0f;
+constexpr float SCALE_32 = 2147483648.0f;
+constexpr float MAX_32 = 2147483520.0f;  // Largest float below 2^31
+
+// ==================== Scalar kernels ====================
+
+void swap16_scalar(const uint8_t* src, uint8_t* dst, size_t n) {
+    for (size_t i = 0; i < n; ++i, src += 2, dst += 2) {
+        dst[0] = src[1];
+        dst[1] = src[0];
+    }
+}
+
+void swap24_scalar(const uint8_t* src, uint8_t* dst, size_t n) {
+    for (size_t i = 0; i < n; ++i, src += 3, dst += 3) {
+        dst[0] = src[2];
+        dst[1] = src[1];
+        dst[2] = src[0];
+    }
+}
+
+void swap32_scalar(const uint8_t* src, uint8_t* dst, size_t n) {
+    for (size_t i = 0; i < n; ++i, src += 4, dst += 4) {
+        dst[0] = src[3];
+        dst[1] = src[2];
+        dst[2] = src[1];
+        dst[3] = src[0];
+    }
+}
+
+void l16_to_f32_scalar(const uint8_t* src, float* dst, size_t n) {
+    for (size_t i = 0; i < n; ++i, src += 2) {
+        auto v = static_cast<int16_t>((src[0] << 8) | src[1]);
+        dst[i] = static_cast<float>(v) * INV_2_15;
+    }
+}
+
+void l24_to_f32_scalar(const uint8_t* src, float* dst, size_t n) {
+    for (size_t i = 0; i < n; ++i, src += 3) {
+        auto v = static_cast<int32_t>((static_cast<uint32_t>(src[0]) << 24) |
+                                      (static_cast<uint32_t>(src[1]) << 16) |
+                                      (static_cast<uint32_t>(src[2]) << 8));
+        dst[i] = static_cast<float>(v) * INV_2_31;
+    }
+}
+
+void l32_to_f32_scalar(const uint8_t* src, float* dst, size_t n) {
+    for (size_t i = 0; i < n; ++i, src += 4) {
+        auto v = static_cast<int32_t>((static_cast<uint32_t>(src[0]) << 24) |
+                                      (static_cast<uint32_t>(src[1]) << 16) |
+                                      (static_cast<uint32_t>(src[2]) << 8) |
+                                      static_cast<uint32_t>(src[3]));
+        dst[i] = static_cast<float>(v) * INV_2_31;
+    }
+}
+
+// Scale, clip to full scale, round to nearest even (matches cvtps/vcvtn).
+// NaN is silence in every kernel: min/max and the conversion disagree on it
+inline int32_t quantize(float x, float scale, float lo, float hi) {
+    float v = x * scale;
+    if (std::isnan(v)) return 0;
+    v = std::min(std::max(v, lo), hi);
+    return static_cast<int32_t>(std::lrintf(v));
+}
+
+void f32_to_l16_scalar(const float* src, uint8_t* dst, size_t n) {
+    for (size_t i = 0; i < n; ++i, dst += 2) {
+        int32_t v = quantize(src[i], SCALE_16, -SCALE_16, SCALE_16 - 1.0f);
+        dst[0] = static_cast<uint8_t>(v >> 8);
+        dst[1] = static_cast<uint8_t>(v);
+    }
+}
+
+void f32_to_l24_scalar(const float* src, uint8_t* dst, size_t n) {
+    for (size_t i = 0; i < n; ++i, dst += 3) {
+        int32_t v = quantize(src[i], SCALE_24, -SCALE_24, SCALE_24 - 1.0f);
+        dst[0] = static_cast<uint8_t>(v >> 16);
+        dst[1] = static_cast<uint8_t>(v >> 8);
+        dst[2] = static_cast<uint8_t>(v);
+    }
+}
+
+void f32_to_l32_scalar(const float* src, uint8_t* dst, size_t n) {
+    for (size_t i = 0; i < n; ++i, dst += 4) {
+        int32_t v = quantize(src[i], SCALE_32, -SCALE_32, MAX_32);
+        dst[0] = static_cast<uint8_t>(v >> 24);
+        dst[1] = static_cast<uint8_t>(v >> 16);
+        dst[2] = static_cast<uint8_t>(v >> 8);
+        dst[3] = static_cast<uint8_t>(v);
+    }
+}
+
+// ==================== SSE4.1 / AVX2 kernels ====================
+
+#ifdef RPI_AES67_X86
+
+// Shuffle masks (-1 zeroes the byte)
+#define SWAP16_MASK 14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1
+#define SWAP32_MASK 12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3
+#define SWAP24_MASK -1, -1, -1, -1, 9, 10, 11, 6, 7, 8, 3, 4, 5, 0, 1, 2
+#define L24_TO_S32_MASK 9, 10, 11, -1, 6, 7, 8, -1, 3, 4, 5, -1, 0, 1, 2, -1
+#define S32_TO_L16_MASK -1, -1, -1, -1, -1, -1, -1, -1, 12, 13, 8, 9, 4, 5, 0, 1
+#define S32_TO_L24_MASK -1, -1, -1, -1, 12, 13, 14, 8, 9, 10, 4, 5, 6, 0, 1, 2
+
+// _mm_set_epi8 takes bytes high to low; the masks above are written that way
+#define SSE_MASK(m) _mm_set_epi8(m)
+
+__attribute__((target("sse4.1")))
+void swap16_sse4(const uint8_t* src, uint8_t* dst, size_t n) {
+    const __m128i mask = SSE_MASK(SWAP16_MASK);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2), _mm_shuffle_epi8(v, mask));
+    }
+    swap16_scalar(src + i * 2, dst + i * 2, n - i);
+}
+
+__attribute__((target("sse4.1")))
+void swap24_sse4(const uint8_t* src, uint8_t* dst, size_t n) {
+    // 4 samples (12 bytes) per step; the 16-byte load/store overhang is
+    // rewritten by the next step or the scalar tail
+    const __m128i mask = SSE_MASK(SWAP24_MASK);
+    size_t i = 0;
+    for (; (i + 4) * 3 + 4 <= n * 3; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 3), _mm_shuffle_epi8(v, mask));
+    }
+    swap24_scalar(src + i * 3, dst + i * 3, n - i);
+}
+
+__attribute__((target("sse4.1")))
+void swap32_sse4(const uint8_t* src, uint8_t* dst, size_t n) {
+    const __m128i mask = SSE_MASK(SWAP32_MASK);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_shuffle_epi8(v, mask));
+    }
+    swap32_scalar(src + i * 4, dst + i * 4, n - i);
+}
+
+__attribute__((target("sse4.1")))
+void l16_to_f32_sse4(const uint8_t* src, float* dst, size_t n) {
+    const __m128i mask = SSE_MASK(SWAP16_MASK);
+    const __m128 scale = _mm_set1_ps(INV_2_15);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i v = _mm_shuffle_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2)), mask);
+        __m128i lo = _mm_cvtepi16_epi32(v);
+        __m128i hi = _mm_cvtepi16_epi32(_mm_srli_si128(v, 8));
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+        _mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+    }
+    l16_to_f32_scalar(src + i * 2, dst + i, n - i);
+}
+
+__attribute__((target("sse4.1")))
+void l24_to_f32_sse4(const uint8_t* src, float* dst, size_t n) {
+    const __m128i mask = SSE_MASK(L24_TO_S32_MASK);
+    const __m128 scale = _mm_set1_ps(INV_2_31);
+    size_t i = 0;
+    for (; (i + 4) * 3 + 4 <= n * 3; i += 4) {
+        // Each sample lands left-justified in an int32, low byte zero
+        __m128i v = _mm_shuffle_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 3)), mask);
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(v), scale));
+    }
+    l24_to_f32_scalar(src + i * 3, dst + i, n - i);
+}
+
+__attribute__((target("sse4.1")))
+void l32_to_f32_sse4(const uint8_t* src, float* dst, size_t n) {
+    const __m128i mask = SSE_MASK(SWAP32_MASK);
+    const __m128 scale = _mm_set1_ps(INV_2_31);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_shuffle_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4)), mask);
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(v), scale));
+    }
+    l32_to_f32_scalar(src + i * 4, dst + i, n - i);
+}
+
+__attribute__((target("sse4.1")))
+inline __m128i quantize_sse4(const float* src, float scale, float lo, float hi) {
+    __m128 v = _mm_mul_ps(_mm_loadu_ps(src), _mm_set1_ps(scale));
+    v = _mm_and_ps(v, _mm_cmpord_ps(v, v));     // NaN -> 0
+    v = _mm_min_ps(_mm_max_ps(v, _mm_set1_ps(lo)), _mm_set1_ps(hi));
+    return _mm_cvtps_epi32(v);
+}
+
+__attribute__((target("sse4.1")))
+void f32_to_l16_sse4(const float* src, uint8_t* dst, size_t n) {
+    const __m128i mask = SSE_MASK(S32_TO_L16_MASK);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = quantize_sse4(src + i, SCALE_16, -SCALE_16, SCALE_16 - 1.0f);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i * 2), _mm_shuffle_epi8(v, mask));
+    }
+    f32_to_l16_scalar(src + i, dst + i * 2, n - i);
+}
+
+__attribute__((target("sse4.1")))
+void f32_to_l24_sse4(const float* src, uint8_t* dst, size_t n) {
+    const __m128i mask = SSE_MASK(S32_TO_L24_MASK);
+    size_t i = 0;
+    for (; (i + 4) * 3 + 4 <= n * 3; i += 4) {
+        __m128i v = quantize_sse4(src + i, SCALE_24, -SCALE_24, SCALE_24 - 1.0f);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 3), _mm_shuffle_epi8(v, mask));
+    }
+    f32_to_l24_scalar(src + i, dst + i * 3, n - i);
+}
+
+__attribute__((target("sse4.1")))
+void f32_to_l32_sse4(const float* src, uint8_t* dst, size_t n) {
+    const __m128i mask = SSE_MASK(SWAP32_MASK);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = quantize_sse4(src + i, SCALE_32, -SCALE_32, MAX_32);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_shuffle_epi8(v, mask));
+    }
+    f32_to_l32_scalar(src + i, dst + i * 4, n - i);
+}
+
+// AVX2 byte shuffles work per 128-bit lane, so each mask is repeated
+#define AVX_MASK(m) _mm256_broadcastsi128_si256(_mm_set_epi8(m))
+
+// Two 12-byte groups (8 x 24-bit samples) into the two 128-bit lanes
+__attribute__((target("avx2")))
+inline __m256i load_24x8(const uint8_t* src) {
+    __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 12));
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+}
+
+__attribute__((target("avx2")))
+inline void store_24x8(uint8_t* dst, __m256i v) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm256_castsi256_si128(v));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 12), _mm256_extracti128_si256(v, 1));
+}
+
+__attribute__((target("avx2")))
+void swap16_avx2(const uint8_t* src, uint8_t* dst, size_t n) {
+    const __m256i mask = AVX_MASK(SWAP16_MASK);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 2));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 2), _mm256_shuffle_epi8(v, mask));
+    }
+    swap16_sse4(src + i * 2, dst + i * 2, n - i);
+}
+
+__attribute__((target("avx2")))
+void swap24_avx2(const uint8_t* src, uint8_t* dst, size_t n) {
+    const __m256i mask = AVX_MASK(SWAP24_MASK);
+    size_t i = 0;
+    for (; (i + 8) * 3 + 4 <= n * 3; i += 8) {
+        store_24x8(dst + i * 3, _mm256_shuffle_epi8(load_24x8(src + i * 3), mask));
+    }
+    swap24_sse4(src + i * 3, dst + i * 3, n - i);
+}
+
+__attribute__((target("avx2")))
+void swap32_avx2(const uint8_t* src, uint8_t* dst, size_t n) {
+    const __m256i mask = AVX_MASK(SWAP32_MASK);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), _mm256_shuffle_epi8(v, mask));
+    }
+    swap32_sse4(src + i * 4, dst + i * 4, n - i);
+}
+
+__attribute__((target("avx2")))
+void l16_to_f32_avx2(const uint8_t* src, float* dst, size_t n) {
+    const __m128i mask = SSE_MASK(SWAP16_MASK);
+    const __m256 scale = _mm256_set1_ps(INV_2_15);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i v = _mm_shuffle_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2)), mask);
+        __m256i s = _mm256_cvtepi16_epi32(v);
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(s), scale));
+    }
+    l16_to_f32_scalar(src + i * 2, dst + i, n - i);
+}
+
+__attribute__((target("avx2")))
+void l24_to_f32_avx2(const uint8_t* src, float* dst, size_t n) {
+    const __m256i mask = AVX_MASK(L24_TO_S32_MASK);
+    const __m256 scale = _mm256_set1_ps(INV_2_31);
+    size_t i = 0;
+    for (; (i + 8) * 3 + 4 <= n * 3; i += 8) {
+        __m256i v = _mm256_shuffle_epi8(load_24x8(src + i * 3), mask);
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), scale));
+    }
+    l24_to_f32_sse4(src + i * 3, dst + i, n - i);
+}
+
+__attribute__((target("avx2")))
+void l32_to_f32_avx2(const uint8_t* src, float* dst, size_t n) {
+    const __m256i mask = AVX_MASK(SWAP32_MASK);
+    const __m256 scale = _mm256_set1_ps(INV_2_31);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_shuffle_epi8(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4)), mask);
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), scale));
+    }
+    l32_to_f32_scalar(src + i * 4, dst + i, n - i);
+}
+
+__attribute__((target("avx2")))
+inline __m256i quantize_avx2(const float* src, float scale, float lo, float hi) {
+    __m256 v = _mm256_mul_ps(_mm256_loadu_ps(src), _mm256_set1_ps(scale));
+    v = _mm256_and_ps(v, _mm256_cmp_ps(v, v, _CMP_ORD_Q));     // NaN -> 0
+    v = _mm256_min_ps(_mm256_max_ps(v, _mm256_set1_ps(lo)), _mm256_set1_ps(hi));
+    return _mm256_cvtps_epi32(v);
+}
+
+__attribute__((target("avx2")))
+void f32_to_l16_avx2(const float* src, uint8_t* dst, size_t n) {
+    const __m256i mask = AVX_MASK(S32_TO_L16_MASK);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_shuffle_epi8(
+            quantize_avx2(src + i, SCALE_16, -SCALE_16, SCALE_16 - 1.0f), mask);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i * 2), _mm256_castsi256_si128(v));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i * 2 + 8), _mm256_extracti128_si256(v, 1));
+    }
+    f32_to_l16_scalar(src + i, dst + i * 2, n - i);
+}
+
+__attribute__((target("avx2")))
+void f32_to_l24_avx2(const float* src, uint8_t* dst, size_t n) {
+    const __m256i mask = AVX_MASK(S32_TO_L24_MASK);
+    size_t i = 0;
+    for (; (i + 8) * 3 + 4 <= n * 3; i += 8) {
+        store_24x8(dst + i * 3, _mm256_shuffle_epi8(
+            quantize_avx2(src + i, SCALE_24, -SCALE_24, SCALE_24 - 1.0f), mask));
+    }
+    f32_to_l24_sse4(src + i, dst + i * 3, n - i);
+}
+
+__attribute__((target("avx2")))
+void f32_to_l32_avx2(const float* src, uint8_t* dst, size_t n) {
+    const __m256i mask = AVX_MASK(SWAP32_MASK);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_shuffle_epi8(quantize_avx2(src + i, SCALE_32, -SCALE_32, MAX_32), mask);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), v);
+    }
+    f32_to_l32_scalar(src + i, dst + i * 4, n - i);
+}
+
+#endif  // RPI_AES67_X86
+
+// ==================== NEON kernels ====================
+
+#ifdef RPI_AES67_NEON
+
+// Table lookups: index 0xFF yields zero
+alignas(16) constexpr uint8_t L24_TO_S32_TBL[16] = {
+    0xFF, 2, 1, 0, 0xFF, 5, 4, 3, 0xFF, 8, 7, 6, 0xFF, 11, 10, 9
+};
+alignas(16) constexpr uint8_t S32_TO_L24_TBL[16] = {
+    2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
+void swap16_neon(const uint8_t* src, uint8_t* dst, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        vst1q_u8(dst + i * 2, vrev16q_u8(vld1q_u8(src + i * 2)));
+    }
+    swap16_scalar(src + i * 2, dst + i * 2, n - i);
+}
+
+void swap24_neon(const uint8_t* src, uint8_t* dst, size_t n) {
+    // De-interleave 16 samples into byte planes and swap the outer planes
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        uint8x16x3_t v = vld3q_u8(src + i * 3);
+        uint8x16_t t = v.val[0];
+        v.val[0] = v.val[2];
+        v.val[2] = t;
+        vst3q_u8(dst + i * 3, v);
+    }
+    swap24_scalar(src + i * 3, dst + i * 3, n - i);
+}
+
+void swap32_neon(const uint8_t* src, uint8_t* dst, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        vst1q_u8(dst + i * 4, vrev32q_u8(vld1q_u8(src + i * 4)));
+    }
+    swap32_scalar(src + i * 4, dst + i * 4, n - i);
+}
+
+void l16_to_f32_neon(const uint8_t* src, float* dst, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        int16x8_t v = vreinterpretq_s16_u8(vrev16q_u8(vld1q_u8(src + i * 2)));
+        float32x4_t lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(v)));
+        float32x4_t hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(v)));
+        vst1q_f32(dst + i, vmulq_n_f32(lo, INV_2_15));
+        vst1q_f32(dst + i + 4, vmulq_n_f32(hi, INV_2_15));
+    }
+    l16_to_f32_scalar(src + i * 2, dst + i, n - i);
+}
+
+void l24_to_f32_neon(const uint8_t* src, float* dst, size_t n) {
+    const uint8x16_t tbl = vld1q_u8(L24_TO_S32_TBL);
+    size_t i = 0;
+    for (; (i + 4) * 3 + 4 <= n * 3; i += 4) {
+        int32x4_t v = vreinterpretq_s32_u8(vqtbl1q_u8(vld1q_u8(src + i * 3), tbl));
+        vst1q_f32(dst + i, vmulq_n_f32(vcvtq_f32_s32(v), INV_2_31));
+    }
+    l24_to_f32_scalar(src + i * 3, dst + i, n - i);
+}
+
+void l32_to_f32_neon(const uint8_t* src, float* dst, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        int32x4_t v = vreinterpretq_s32_u8(vrev32q_u8(vld1q_u8(src + i * 4)));
+        vst1q_f32(dst + i, vmulq_n_f32(vcvtq_f32_s32(v), INV_2_31));
+    }
+    l32_to_f32_scalar(src + i * 4, dst + i, n - i);
+}
+
+inline int32x4_t quantize_neon(const float* src, float scale, float lo, float hi) {
+    float32x4_t v = vmulq_n_f32(vld1q_f32(src), scale);
+    v = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(v), vceqq_f32(v, v)));   // NaN -> 0
+    v = vminq_f32(vmaxq_f32(v, vdupq_n_f32(lo)), vdupq_n_f32(hi));
+    return vcvtnq_s32_f32(v);
+}
+
+void f32_to_l16_neon(const float* src, uint8_t* dst, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        int16x4_t lo = vmovn_s32(quantize_neon(src + i, SCALE_16, -SCALE_16, SCALE_16 - 1.0f));
+        int16x4_t hi = vmovn_s32(quantize_neon(src + i + 4, SCALE_16, -SCALE_16, SCALE_16 - 1.0f));
+        vst1q_u8(dst + i * 2, vrev16q_u8(vreinterpretq_u8_s16(vcombine_s16(lo, hi))));
+    }
+    f32_to_l16_scalar(src + i, dst + i * 2, n - i);
+}
+
+void f32_to_l24_neon(const float* src, uint8_t* dst, size_t n) {
+    const uint8x16_t tbl = vld1q_u8(S32_TO_L24_TBL);
+    size_t i = 0;
+    for (; (i + 4) * 3 + 4 <= n * 3; i += 4) {
+        int32x4_t v = quantize_neon(src + i, SCALE_24, -SCALE_24, SCALE_24 - 1.0f);
+        vst1q_u8(dst + i * 3, vqtbl1q_u8(vreinterpretq_u8_s32(v), tbl));
+    }
+    f32_to_l24_scalar(src + i, dst + i * 3, n - i);
+}
+
+void f32_to_l32_neon(const float* src, uint8_t* dst, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        int32x4_t v = quantize_neon(src + i, SCALE_32, -SCALE_32, MAX_32);
+        vst1q_u8(dst + i * 4, vrev32q_u8(vreinterpretq_u8_s32(v)));
+    }
+    f32_to_l32_scalar(src + i, dst + i * 4, n - i);
+}
+
+#endif  // RPI_AES67_NEON
+
+// ==================== Dispatch ====================
+
+using SwapFn = void (*)(const uint8_t*, uint8_t*, size_t);
+using ToFloatFn = void (*)(const uint8_t*, float*, size_t);
+using FromFloatFn = void (*)(const float*, uint8_t*, size_t);
+
+// Indexed by PCMEncoding
+struct Kernels {
+    PCMCodec::Isa isa;
+    SwapFn swap[3];
+    ToFloatFn to_f32[3];
+    FromFloatFn from_f32[3];
+};
+
+constexpr Kernels SCALAR_KERNELS = {
+    PCMCodec::Isa::Scalar,
+    {swap16_scalar, swap24_scalar, swap32_scalar},
+    {l16_to_f32_scalar, l24_to_f32_scalar, l32_to_f32_scalar},
+    {f32_to_l16_scalar, f32_to_l24_scalar, f32_to_l32_scalar}
+};
+
+#ifdef RPI_AES67_X86
+constexpr Kernels SSE4_KERNELS = {
+    PCMCodec::Isa::SSE4,
+    {swap16_sse4, swap24_sse4, swap32_sse4},
+    {l16_to_f32_sse4, l24_to_f32_sse4, l32_to_f32_sse4},
+    {f32_to_l16_sse4, f32_to_l24_sse4, f32_to_l32_sse4}
+};
+
+constexpr Kernels AVX2_KERNELS = {
+    PCMCodec::Isa::AVX2,
+    {swap16_avx2, swap24_avx2, swap32_avx2},
+    {l16_to_f32_avx2, l24_to_f32_avx2, l32_to_f32_avx2},
+    {f32_to_l16_avx2, f32_to_l24_avx2, f32_to_l32_avx2}
+};
+#endif
+
+#ifdef RPI_AES67_NEON
+constexpr Kernels NEON_KERNELS = {
+    PCMCodec::Isa::NEON,
+    {swap16_neon, swap24_neon, swap32_neon},
+    {l16_to_f32_neon, l24_to_f32_neon, l32_to_f32_neon},
+    {f32_to_l16_neon, f32_to_l24_neon, f32_to_l32_neon}
+};
+#endif
+
+bool isa_supported(PCMCodec::Isa isa) {
+    switch (isa) {
+        case PCMCodec::Isa::Scalar: return true;
+#ifdef RPI_AES67_X86
+        case PCMCodec::Isa::SSE4: return __builtin_cpu_supports("sse4.1");
+        case PCMCodec::Isa::AVX2: return __builtin_cpu_supports("avx2");
+#endif
+#ifdef RPI_AES67_NEON
+        case PCMCodec::Isa::NEON: return true;  // Mandatory on AArch64
+#endif
+        default: return false;
+    }
+}
+
+const Kernels* kernels_for(PCMCodec::Isa isa) {
+    if (!isa_supported(isa)) return &SCALAR_KERNELS;
+    switch (isa) {
+#ifdef RPI_AES67_X86
+        case PCMCodec::Isa::SSE4: return &SSE4_KERNELS;
+        case PCMCodec::Isa::AVX2: return &AVX2_KERNELS;
+#endif
+#ifdef RPI_AES67_NEON
+        case PCMCodec::Isa::NEON: return &NEON_KERNELS;
+#endif
+        default: return &SCALAR_KERNELS;
+    }
+}
+
+const Kernels* best_kernels() {
+#ifdef RPI_AES67_X86
+    __builtin_cpu_init();
+#endif
+    for (auto isa : {PCMCodec::Isa::AVX2, PCMCodec::Isa::NEON, PCMCodec::Isa::SSE4}) {
+        if (isa_supported(isa)) return kernels_for(isa);
+    }
+    return &SCALAR_KERNELS;
+}
+
+std::atomic<const Kernels*>& active_kernels() {
+    static std::atomic<const Kernels*> kernels{best_kernels()};
+    return kernels;
+}
+
+size_t index_of(PCMEncoding encoding) {
+    return static_cast<size_t>(encoding);
+}
+
+// ==================== Mixed-width integer fallback ====================
+
+// Wire sample as a left-justified int32
+int32_t read_wire(const uint8_t* p, PCMEncoding encoding) {
+    switch (encoding) {
+        case PCMEncoding::L16:
+            return static_cast<int32_t>((static_cast<uint32_t>(p[0]) << 24) |
+                                        (static_cast<uint32_t>(p[1]) << 16));
+        case PCMEncoding::L24:
+            return static_cast<int32_t>((static_cast<uint32_t>(p[0]) << 24) |
+                                        (static_cast<uint32_t>(p[1]) << 16) |
+                                        (static_cast<uint32_t>(p[2]) << 8));
+        case PCMEncoding::L32:
+        default:
+            return static_cast<int32_t>((static_cast<uint32_t>(p[0]) << 24) |
+                                        (static_cast<uint32_t>(p[1]) << 16) |
+                                        (static_cast<uint32_t>(p[2]) << 8) |
+                                        static_cast<uint32_t>(p[3]));
+    }
+}
+
+void write_wire(uint8_t* p, PCMEncoding encoding, int32_t v) {
+    auto u = static_cast<uint32_t>(v);
+    p[0] = static_cast<uint8_t>(u >> 24);
+    if (encoding == PCMEncoding::L16) {
+        p[1] = static_cast<uint8_t>(u >> 16);
+        return;
+    }
+    p[1] = static_cast<uint8_t>(u >> 16);
+    p[2] = static_cast<uint8_t>(u >> 8);
+    if (encoding == PCMEncoding::L32) {
+        p[3] = static_cast<uint8_t>(u);
+    }
+}
+
+int32_t read_host(const uint8_t* p, SampleFormat format) {
+    switch (format) {
+        case SampleFormat::S16:
+            return static_cast<int32_t>((static_cast<uint32_t>(p[1]) << 24) |
+                                        (static_cast<uint32_t>(p[0]) << 16));
+        case SampleFormat::S24:
+            return static_cast<int32_t>((static_cast<uint32_t>(p[2]) << 24) |
+                                        (static_cast<uint32_t>(p[1]) << 16) |
+                                        (static_cast<uint32_t>(p[0]) << 8));
+        case SampleFormat::S32:
+        default: {
+            int32_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+    }
+}
+
+void write_host(uint8_t* p, SampleFormat format, int32_t v) {
+    auto u = static_cast<uint32_t>(v);
+    switch (format) {
+        case SampleFormat::S16:
+            p[0] = static_cast<uint8_t>(u >> 16);
+            p[1] = static_cast<uint8_t>(u >> 24);
+            break;
+        case SampleFormat::S24:
+            p[0] = static_cast<uint8_t>(u >> 8);
+            p[1] = static_cast<uint8_t>(u >> 16);
+            p[2] = static_cast<uint8_t>(u >> 24);
+            break;
+        case SampleFormat::S32:
+        default:
+            std::memcpy(p, &v, sizeof(v));
+            break;
+    }
+}
+
+bool same_width(PCMEncoding encoding, SampleFormat format) {
+    return (encoding == PCMEncoding::L16 && format == SampleFormat::S16) ||
+           (encoding == PCMEncoding::L24 && format == SampleFormat::S24) ||
+           (encoding == PCMEncoding::L32 && format == SampleFormat::S32);
+}
+
+// Planar conversion works through a stack tile of interleaved host samples
+constexpr size_t TILE_BYTES = 4096;
+
+template <size_t N>
+void gather(uint8_t* dst, const uint8_t* src, size_t count, size_t stride) {
+    for (size_t i = 0; i < count; ++i) {
+        std::memcpy(dst + i * N, src + i * stride, N);
+    }
+}
+
+template <size_t N>
+void scatter(uint8_t* dst, const uint8_t* src, size_t count, size_t stride) {
+    for (size_t i = 0; i < count; ++i) {
+        std::memcpy(dst + i * stride, src + i * N, N);
+    }
+}
+
+void gather_samples(uint8_t* dst, const uint8_t* src, size_t count, size_t stride, size_t size) {
+    switch (size) {
+        case 2: gather<2>(dst, src, count, stride); break;
+        case 3: gather<3>(dst, src, count, stride); break;
+        default: gather<4>(dst, src, count, stride); break;
+    }
+}
+
+void scatter_samples(uint8_t* dst, const uint8_t* src, size_t count, size_t stride, size_t size) {
+    switch (size) {
+        case 2: scatter<2>(dst, src, count, stride); break;
+        case 3: scatter<3>(dst, src, count, stride); break;
+        default: scatter<4>(dst, src, count, stride); break;
+    }
+}
+
+}  // namespace
+
+// ==================== PCMCodec ====================
+
+PCMCodec::Isa PCMCodec::active_isa() {
+    return active_kernels().load(std::memory_order_relaxed)->isa;
+}
+
+const char* PCMCodec::isa_name(Isa isa) {
+    switch (isa) {
+        case Isa::Scalar: return "scalar";
+        case Isa::SSE4: return "sse4.1";
+        case Isa::AVX2: return "avx2";
+        case Isa::NEON: return "neon";
+        default: return "unknown";
+    }
+}
+
+PCMCodec::Isa PCMCodec::select_isa(Isa isa) {
+    const Kernels* kernels = kernels_for(isa);
+    active_kernels().store(kernels, std::memory_order_relaxed);
+    return kernels->isa;
+}
+
+void PCMCodec::decode(const uint8_t* src, PCMEncoding encoding,
+                      void* dst, SampleFormat format, size_t samples) {
+    const Kernels* k = active_kernels().load(std::memory_order_relaxed);
+    auto* out = static_cast<uint8_t*>(dst);
+    
+    if (format == SampleFormat::F32) {
+        k->to_f32[index_of(encoding)](src, static_cast<float*>(dst), samples);
+    } else if (same_width(encoding, format)) {
+        k->swap[index_of(encoding)](src, out, samples);
+    } else {
+        const size_t in_size = sample_size(encoding);
+        const size_t out_size = sample_size(format);
+        for (size_t i = 0; i < samples; ++i) {
+            write_host(out + i * out_size, format, read_wire(src + i * in_size, encoding));
+        }
+    }
+}
+
+void PCMCodec::encode(const void* src, SampleFormat format,
+                      uint8_t* dst, PCMEncoding encoding, size_t samples) {
+    const Kernels* k = active_kernels().load(std::memory_order_relaxed);
+    const auto* in = static_cast<const uint8_t*>(src);
+    
+    if (format == SampleFormat::F32) {
+        k->from_f32[index_of(encoding)](static_cast<const float*>(src), dst, samples);
+    } else if (same_width(encoding, format)) {
+        k->swap[index_of(encoding)](in, dst, samples);
+    } else {
+        const size_t in_size = sample_size(format);
+        const size_t out_size = sample_size(encoding);
+        for (size_t i = 0; i < samples; ++i) {
+            write_wire(dst + i * out_size, encoding, read_host(in + i * in_size, format));
+        }
+    }
+}
+
+void PCMCodec::decode_planar(const uint8_t* src, PCMEncoding encoding,
+                             void* const* dst, SampleFormat format,
+                             size_t frames, uint32_t channels) {
+    if (channels == 0) return;
+    alignas(64) uint8_t tile[TILE_BYTES];
+    const size_t in_frame = sample_size(encoding) * channels;
+    const size_t out_size = sample_size(format);
+    const size_t tile_frames = std::max<size_t>(TILE_BYTES / (out_size * channels), 1);
+    
+    for (size_t f = 0; f < frames;) {
+        if (out_size * channels > TILE_BYTES) {
+            // Very wide frames: one channel at a time
+            for (uint32_t c = 0; c < channels; ++c) {
+                decode(src + f * in_frame + c * sample_size(encoding), encoding,
+                       static_cast<uint8_t*>(dst[c]) + f * out_size, format, 1);
+            }
+            ++f;
+            continue;
+        }
+        size_t count = std::min(tile_frames, frames - f);
+        decode(src + f * in_frame, encoding, tile, format, count * channels);
+        for (uint32_t c = 0; c < channels; ++c) {
+            gather_samples(static_cast<uint8_t*>(dst[c]) + f * out_size, tile + c * out_size,
+                           count, out_size * channels, out_size);
+        }
+        f += count;
+    }
+}
+
+void PCMCodec::encode_planar(const void* const* src, SampleFormat format,
+                             uint8_t* dst, PCMEncoding encoding,
+                             size_t frames, uint32_t channels) {
+    if (channels == 0) return;
+    alignas(64) uint8_t tile[TILE_BYTES];
+    const size_t out_frame = sample_size(encoding) * channels;
+    const size_t in_size = sample_size(format);
+    const size_t tile_frames = std::max<size_t>(TILE_BYTES / (in_size * channels), 1);
+    
+    for (size_t f = 0; f < frames;) {
+        if (in_size * channels > TILE_BYTES) {
+            for (uint32_t c = 0; c < channels; ++c) {
+                encode(static_cast<const uint8_t*>(src[c]) + f * in_size, format,
+                       dst + f * out_frame + c * sample_size(encoding), encoding, 1);
+            }
+            ++f;
+            continue;
+        }
+        size_t count = std::min(tile_frames, frames - f);
+        for (uint32_t c = 0; c < channels; ++c) {
+            scatter_samples(tile + c * in_size, static_cast<const uint8_t*>(src[c]) + f * in_size,
+                            count, in_size * channels, in_size);
+        }
+        encode(tile, format, dst + f * out_frame, encoding, count * channels);
+        f += count;
+    }
+}
+
+PCMEncoding PCMCodec::encoding_for(uint8_t bit_depth) {
+    switch (bit_depth) {
+        case 16: return PCMEncoding::L16;
+        case 32: return PCMEncoding::L32;
+        default: return PCMEncoding::L24;
+    }
+}
+
+SampleFormat PCMCodec::format_for(uint8_t bit_depth) {
+    switch (bit_depth) {
+        case 16: return SampleFormat::S16;
+        case 32: return SampleFormat::S32;
+        default: return SampleFormat::S24;
+    }
+}
+
+size_t PCMCodec::sample_size(PCMEncoding encoding) {
+    switch (encoding) {
+        case PCMEncoding::L16: return 2;
+        case PCMEncoding::L24: return 3;
+        default: return 4;
+    }
+}
+
+size_t PCMCodec::sample_size(SampleFormat format) {
+    switch (format) {
+        case SampleFormat::S16: return 2;
+        case SampleFormat::S24: return 3;
+        default: return 4;
+    }
+}
+
+}  // namespace rpi_aes67
@@ -8,11 +8,13 @@
 
 #include "rpi_aes67/pipewire_io.h"
 #include "rpi_aes67/logger.h"
+#include "rpi_aes67/spsc_ring.h"
 #include <thread>
 #include <mutex>
 #include <condition_variable>
 #include <queue>
 #include <cstring>
+#include <algorithm>
 
 #ifdef HAVE_PIPEWIRE
 #include <pipewire/pipewire.h>
@@ -291,6 +293,10 @@ public:
         device_name_ = device_name;
         format_ = format;
         
+        // Fixed-size playback ring; twice the latency budget absorbs burst writes
+        size_t frames = static_cast<size_t>(buffer_ms_ * 2.0 * format_.sample_rate / 1000.0);
+        ring_.allocate(std::max<size_t>(frames, 1024) * std::max<size_t>(format_.bytes_per_frame(), 1));
+
 #ifdef HAVE_PIPEWIRE
         // Create main loop
         loop_ = pw_thread_loop_new("pipewire-output", nullptr);
@@ -435,10 +441,25 @@ public:
     
     void stop() {
         running_ = false;
+        
+        // The graph callback may be mid-cycle on the RT thread
+        while (in_process_) {
+            std::this_thread::yield();
+        }
+        ring_.reset();
+        
         state_ = PipeWireState::Connected;
         LOG_INFO("PipeWire output stopped");
     }
     
+    void set_pull_callback(PullCallback callback) {
+        pull_callback_ = std::move(callback);
+    }
+    
+    void set_buffer_ms(double ms) {
+        if (ms > 0.0) buffer_ms_ = ms;
+    }
+    
     size_t write(const AudioBuffer& buffer) {
         return write(buffer.data, buffer.size);
     }
@@ -446,15 +467,19 @@ public:
     size_t write(const void* data, size_t size) {
         if (!running_) return 0;
         
-        std::lock_guard<std::mutex> lock(write_mutex_);
-        
 #ifdef HAVE_PIPEWIRE
-        // Queue data for PipeWire callback
-        const uint8_t* src = static_cast<const uint8_t*>(data);
-        write_buffer_.insert(write_buffer_.end(), src, src + size);
-#endif
-        
+        // Queue whole frames for the PipeWire callback; excess is dropped
+        const size_t bpf = std::max<size_t>(format_.bytes_per_frame(), 1);
+        size_t space = ring_.write_available() / bpf * bpf;
+        size_t accepted = std::min(size, space) / bpf * bpf;
+        ring_.write(static_cast<const uint8_t*>(data), accepted);
+        if (accepted < size) {
+            dropped_frames_.fetch_add((size - accepted) / bpf, std::memory_order_relaxed);
+        }
+        return accepted;
+#else
         return size;
+#endif
     }
     
     bool is_running() const { return running_; }
@@ -471,13 +496,17 @@ public:
     }
     
     size_t get_available_frames() const {
-        // Return available buffer space
-        constexpr size_t MAX_BUFFER = 8192;
-        std::lock_guard<std::mutex> lock(write_mutex_);
-        size_t used = write_buffer_.size() / format_.bytes_per_frame();
-        return MAX_BUFFER > used ? MAX_BUFFER - used : 0;
+        size_t bpf = format_.bytes_per_frame();
+        return bpf > 0 ? ring_.write_available() / bpf : 0;
+    }
+    
+    size_t get_buffered_frames() const {
+        size_t bpf = format_.bytes_per_frame();
+        return bpf > 0 ? ring_.read_available() / bpf : 0;
     }
     
+    uint64_t get_dropped_frames() const { return dropped_frames_.load(std::memory_order_relaxed); }
+    
 private:
 #ifdef HAVE_PIPEWIRE
     static void on_state_changed_wrapper(void* data, enum pw_stream_state old,
@@ -503,36 +532,55 @@ private:
     }
     
     void on_process() {
-        if (!running_) return;
+        in_process_ = true;
+        if (!running_) {
+            in_process_ = false;
+            return;
+        }
         
         struct pw_buffer* b = pw_stream_dequeue_buffer(stream_);
-        if (!b) return;
+        if (!b) {
+            in_process_ = false;
+            return;
+        }
         
         struct spa_buffer* buf = b->buffer;
         uint8_t* data = static_cast<uint8_t*>(buf->datas[0].data);
         
-        if (data) {
-            std::lock_guard<std::mutex> lock(write_mutex_);
+        if (data && pull_callback_) {
+            // Render the quantum straight into the mapped buffer
+            const uint32_t stride = static_cast<uint32_t>(format_.bytes_per_frame());
+            uint32_t frames = buf->datas[0].maxsize / stride;
+            if (b->requested > 0 && b->requested < frames) {
+                frames = static_cast<uint32_t>(b->requested);
+            }
+            
+            pull_callback_(data, frames);
             
-            size_t max_size = buf->datas[0].maxsize;
-            size_t copy_size = std::min(max_size, write_buffer_.size());
+            buf->datas[0].chunk->offset = 0;
+            buf->datas[0].chunk->stride = stride;
+            buf->datas[0].chunk->size = frames * stride;
+        } else if (data) {
+            const uint32_t stride = static_cast<uint32_t>(format_.bytes_per_frame());
+            uint32_t frames = buf->datas[0].maxsize / stride;
+            if (b->requested > 0 && b->requested < frames) {
+                frames = static_cast<uint32_t>(b->requested);
+            }
+            size_t size = static_cast<size_t>(frames) * stride;
             
-            if (copy_size > 0) {
-                std::memcpy(data, write_buffer_.data(), copy_size);
-                write_buffer_.erase(write_buffer_.begin(), 
-                                   write_buffer_.begin() + copy_size);
-            } else {
-                // Output silence
-                std::memset(data, 0, max_size);
-                copy_size = max_size;
+            // Lock-free drain; pad the quantum with silence on underrun
+            size_t copied = ring_.read(data, size);
+            if (copied < size) {
+                std::memset(data + copied, 0, size - copied);
             }
             
             buf->datas[0].chunk->offset = 0;
-            buf->datas[0].chunk->stride = format_.bytes_per_frame();
-            buf->datas[0].chunk->size = copy_size;
+            buf->datas[0].chunk->stride = stride;
+            buf->datas[0].chunk->size = size;
         }
         
         pw_stream_queue_buffer(stream_, b);
+        in_process_ = false;
     }
     
     pw_thread_loop* loop_ = nullptr;
@@ -545,12 +593,17 @@ private:
     bool initialized_ = false;
     std::atomic<bool> running_{false};
     std::atomic<bool> connected_{false};
+    std::atomic<bool> in_process_{false};
     PipeWireState state_ = PipeWireState::Disconnected;
     AudioFormat format_;
     std::string device_name_;
     
-    mutable std::mutex write_mutex_;
-    std::vector<uint8_t> write_buffer_;
+    PullCallback pull_callback_;
+    
+    // Playback queue: write() is the producer, on_process() the consumer
+    double buffer_ms_ = 20.0;
+    SPSCRing<uint8_t> ring_;
+    std::atomic<uint64_t> dropped_frames_{0};
 };
 
 // ==================== PipeWireInput ====================
@@ -590,6 +643,7 @@ bool PipeWireOutput::open(const std::string& device_name, const AudioFormat& for
 void PipeWireOutput::close() { impl_->close(); }
 bool PipeWireOutput::start() { return impl_->start(); }
 void PipeWireOutput::stop() { impl_->stop(); }
+void PipeWireOutput::set_pull_callback(PullCallback callback) { impl_->set_pull_callback(std::move(callback)); }
 size_t PipeWireOutput::write(const AudioBuffer& buffer) { return impl_->write(buffer); }
 size_t PipeWireOutput::write(const void* data, size_t size) { return impl_->write(data, size); }
 bool PipeWireOutput::is_running() const { return impl_->is_running(); }
@@ -598,6 +652,9 @@ AudioFormat PipeWireOutput::get_format() const { return impl_->get_format(); }
 bool PipeWireOutput::is_connected() const { return impl_->is_connected(); }
 void PipeWireOutput::reconnect() { impl_->reconnect(); }
 size_t PipeWireOutput::get_available_frames() const { return impl_->get_available_frames(); }
+size_t PipeWireOutput::get_buffered_frames() const { return impl_->get_buffered_frames(); }
+uint64_t PipeWireOutput::get_dropped_frames() const { return impl_->get_dropped_frames(); }
+void PipeWireOutput::set_buffer_ms(double ms) { impl_->set_buffer_ms(ms); }
 
 std::vector<PipeWireDevice> PipeWireOutput::list_devices() {
     // NOTE: Device enumeration requires a running PipeWire context
@@ -0,0 +1,508 @@
+// SPDX-License-Identifier: MIT
+/*
+ * RPi-AES67 - Professional AES67 Sender/Receiver for Raspberry Pi 5
+ * Copyright (c) 2025 DHPKE
+ *
+ * In-process PTP grandmaster simulator implementation.
+ */
+
+#include "rpi_aes67/ptp_grandmaster_sim.h"
+#include "rpi_aes67/ptp_protocol.h"
+#include "rpi_aes67/ptp_sync.h"
+#include "rpi_aes67/seqlock.h"
+#include "rpi_aes67/logger.h"
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <random>
+#include <chrono>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+
+#ifdef __linux__
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <net/if.h>
+#include <unistd.h>
+#include <poll.h>
+#include <time.h>
+#include <linux/net_tstamp.h>
+#endif
+
+namespace rpi_aes67 {
+
+#ifdef __linux__
+namespace {
+
+int64_t clock_ns(clockid_t clock) {
+    timespec ts{};
+    clock_gettime(clock, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+// Kernel software timestamp from SCM_TIMESTAMPING, mapped into CLOCK_MONOTONIC_RAW
+bool software_timestamp_raw(msghdr& msg, int64_t& raw_ns) {
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SO_TIMESTAMPING) {
+            timespec stamps[3];
+            std::memcpy(stamps, CMSG_DATA(cmsg), sizeof(stamps));
+            if (stamps[0].tv_sec == 0 && stamps[0].tv_nsec == 0) return false;
+            int64_t realtime_ns = static_cast<int64_t>(stamps[0].tv_sec) * 1000000000LL + stamps[0].tv_nsec;
+            raw_ns = clock_ns(CLOCK_MONOTONIC_RAW) - (clock_ns(CLOCK_REALTIME) - realtime_ns);
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace
+#endif
+
+class PTPGrandmasterSim::Impl {
+public:
+    Impl() = default;
+    
+    ~Impl() {
+        stop();
+    }
+    
+    bool start(const PTPGrandmasterSimConfig& config) {
+        if (running_) return true;
+
+#ifdef __linux__
+        config_ = config;
+        if (!open_sockets()) {
+            close_sockets();
+            return false;
+        }
+        
+        int64_t now_raw = PTPSync::monotonic_raw_ns();
+        PTPTimeScale scale;
+        scale.raw_anchor_ns = now_raw;
+        scale.ptp_anchor_ns = config_.initial_time_ns;
+        if (scale.ptp_anchor_ns == 0) {
+            scale.ptp_anchor_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+        }
+        scale.rate = config_.frequency_offset_ppm / 1e6;
+        scale.valid = true;
+        scale_.store(scale);
+        
+        delay_ns_ = config_.path_delay_ns;
+        jitter_ns_ = config_.path_delay_jitter_ns;
+        rng_.seed(config_.seed);
+        enabled_ = true;
+        stats_ = {};
+        
+        running_ = true;
+        thread_ = std::thread(&Impl::master_loop, this);
+        
+        LOG_INFO("PTP simulator: grandmaster {} on {}, domain {}, {} ppm",
+                 PTPProtocol::clock_identity_to_string(config_.clock_id), config_.interface,
+                 static_cast<int>(config_.domain), config_.frequency_offset_ppm);
+        return true;
+#else
+        (void)config;
+        LOG_ERROR("PTP simulator requires Linux");
+        return false;
+#endif
+    }
+    
+    void stop() {
+        if (!running_) return;
+        running_ = false;
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+#ifdef __linux__
+        close_sockets();
+#endif
+    }
+    
+    bool is_running() const { return running_; }
+    
+    int64_t time_at(int64_t raw_ns) const {
+        return scale_.load().at(raw_ns);
+    }
+    
+    void step(int64_t offset_ns) {
+        std::lock_guard<std::mutex> lock(scale_mutex_);
+        PTPTimeScale scale = scale_.load();
+        scale.ptp_anchor_ns += offset_ns;
+        scale_.store(scale);
+        LOG_INFO("PTP simulator: stepped by {} ns", offset_ns);
+    }
+    
+    void set_frequency_offset_ppm(double ppm) {
+        // Re-anchor at the current instant so the change is continuous in phase
+        std::lock_guard<std::mutex> lock(scale_mutex_);
+        int64_t now_raw = PTPSync::monotonic_raw_ns();
+        PTPTimeScale scale = scale_.load();
+        scale.ptp_anchor_ns = scale.at(now_raw);
+        scale.raw_anchor_ns = now_raw;
+        scale.rate = ppm / 1e6;
+        scale_.store(scale);
+    }
+    
+    void set_path_delay(int64_t delay_ns, int64_t jitter_ns) {
+        delay_ns_ = std::max<int64_t>(delay_ns, 0);
+        jitter_ns_ = std::max<int64_t>(jitter_ns, 0);
+    }
+    
+    void set_enabled(bool enabled) { enabled_ = enabled; }
+    
+    PTPGrandmasterSimStats get_stats() const {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        return stats_;
+    }
+
+private:
+#ifdef __linux__
+    bool open_sockets() {
+        if (inet_pton(AF_INET, config_.multicast_address.c_str(), &group_) != 1) {
+            LOG_ERROR("PTP simulator: invalid multicast address {}", config_.multicast_address);
+            return false;
+        }
+        
+        unsigned int ifindex = if_nametoindex(config_.interface.c_str());
+        if (ifindex == 0) {
+            LOG_ERROR("PTP simulator: unknown interface {}", config_.interface);
+            return false;
+        }
+        
+        event_fd_ = open_socket(config_.event_port, ifindex);
+        general_fd_ = open_socket(config_.general_port, ifindex);
+        return event_fd_ >= 0 && general_fd_ >= 0;
+    }
+    
+    int open_socket(uint16_t port, unsigned int ifindex) {
+        int fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            LOG_ERROR("PTP simulator: failed to create socket: {}", strerror(errno));
+            return -1;
+        }
+        
+        // Shares the ports with a follower in the same process
+        int reuse = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        addr.sin_addr.s_addr = htonl(INADDR_ANY);
+        if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+            LOG_ERROR("PTP simulator: failed to bind UDP port {}: {}", port, strerror(errno));
+            close(fd);
+            return -1;
+        }
+        
+        ip_mreqn mreq{};
+        mreq.imr_multiaddr = group_;
+        mreq.imr_ifindex = static_cast<int>(ifindex);
+        if (setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0) {
+            LOG_ERROR("PTP simulator: failed to join {} on {}: {}", config_.multicast_address,
+                      config_.interface, strerror(errno));
+            close(fd);
+            return -1;
+        }
+        setsockopt(fd, IPPROTO_IP, IP_MULTICAST_IF, &mreq, sizeof(mreq));
+        
+        int ttl = 1;
+        int loop = 1;
+        setsockopt(fd, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl));
+        setsockopt(fd, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop));
+        
+        // Kernel stamps keep scheduling delay out of the reported times,
+        // as they do on the follower side
+        int flags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_TX_SOFTWARE |
+                    SOF_TIMESTAMPING_SOFTWARE | SOF_TIMESTAMPING_OPT_TSONLY;
+        setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags));
+        return fd;
+    }
+    
+    void close_sockets() {
+        if (event_fd_ >= 0) {
+            close(event_fd_);
+            event_fd_ = -1;
+        }
+        if (general_fd_ >= 0) {
+            close(general_fd_);
+            general_fd_ = -1;
+        }
+    }
+    
+    void master_loop() {
+        const int64_t sync_interval_ns = static_cast<int64_t>(std::ldexp(1e9, config_.log_sync_interval));
+        const int64_t announce_interval_ns = static_cast<int64_t>(std::ldexp(1e9, config_.log_announce_interval));
+        int64_t next_sync = PTPSync::monotonic_raw_ns();
+        int64_t next_announce = next_sync;
+        
+        pollfd fds[2] = {};
+        fds[0].fd = event_fd_;
+        fds[0].events = POLLIN;
+        fds[1].fd = general_fd_;
+        fds[1].events = POLLIN;
+        
+        while (running_) {
+            int64_t now_raw = PTPSync::monotonic_raw_ns();
+            if (!enabled_) {
+                // Silent: start over one interval after being re-enabled
+                next_sync = next_announce = now_raw + sync_interval_ns;
+                drain(event_fd_);
+                drain(general_fd_);
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                continue;
+            }
+            
+            if (now_raw >= next_announce) {
+                send_announce();
+                next_announce += announce_interval_ns;
+            }
+            if (now_raw >= next_sync) {
+                send_sync();
+                next_sync += sync_interval_ns;
+                // Do not burst to catch up after a stall
+                if (next_sync < now_raw) next_sync = now_raw + sync_interval_ns;
+            }
+            
+            int64_t wait_ns = std::min(next_sync, next_announce) - PTPSync::monotonic_raw_ns();
+            int timeout_ms = static_cast<int>(std::clamp<int64_t>((wait_ns + 999999) / 1000000, 0, 100));
+            if (poll(fds, 2, timeout_ms) > 0) {
+                if (fds[0].revents & POLLIN) receive_delay_requests();
+                // Only looped-back Announce/Follow_Up/Delay_Resp arrive here
+                if (fds[1].revents & POLLIN) drain(general_fd_);
+            }
+        }
+    }
+    
+    void drain(int fd) {
+        uint8_t buffer[256];
+        while (recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT) > 0) {
+        }
+    }
+    
+    // One-way delay for the next message: base plus uniform jitter
+    int64_t draw_delay() {
+        int64_t jitter = jitter_ns_;
+        int64_t delay = delay_ns_;
+        if (jitter > 0) {
+            delay += std::uniform_int_distribution<int64_t>(0, jitter)(rng_);
+        }
+        return delay;
+    }
+    
+    PTPMessage make_message(PTPMessageType type, uint16_t sequence_id, int8_t log_interval) const {
+        PTPMessage message;
+        message.type = type;
+        message.domain = config_.domain;
+        message.source_port.clock_id = config_.clock_id;
+        message.source_port.port_number = 1;
+        message.sequence_id = sequence_id;
+        message.log_message_interval = log_interval;
+        return message;
+    }
+    
+    void send_announce() {
+        PTPMessage announce = make_message(PTPMessageType::Announce, announce_sequence_++,
+                                           config_.log_announce_interval);
+        announce.flags = PTP_FLAG_PTP_TIMESCALE;
+        announce.timestamp = PTPTimestamp::from_ns(time_at(PTPSync::monotonic_raw_ns()));
+        announce.current_utc_offset = 37;
+        announce.grandmaster_priority1 = config_.priority1;
+        announce.grandmaster_clock_quality.clock_class = config_.clock_class;
+        announce.grandmaster_clock_quality.clock_accuracy = 0x21;     // Within 100 ns
+        announce.grandmaster_clock_quality.offset_scaled_log_variance = 0x4E5D;
+        announce.grandmaster_priority2 = 128;
+        announce.grandmaster_identity = config_.clock_id;
+        announce.steps_removed = 0;
+        announce.time_source = 0x20;                                  // GPS
+        
+        if (send(general_fd_, config_.general_port, announce)) {
+            std::lock_guard<std::mutex> lock(stats_mutex_);
+            stats_.announces_sent++;
+        }
+    }
+    
+    void send_sync() {
+        uint16_t sequence_id = sync_sequence_++;
+        PTPMessage sync = make_message(PTPMessageType::Sync, sequence_id, config_.log_sync_interval);
+        sync.flags = PTP_FLAG_TWO_STEP | PTP_FLAG_PTP_TIMESCALE;
+        
+        drain_tx_timestamps(0);
+        int64_t send_raw = PTPSync::monotonic_raw_ns();
+        if (!send(event_fd_, config_.event_port, sync)) return;
+        int64_t tx_raw = drain_tx_timestamps(10);
+        
+        // Origin moved back by the injected delay so the follower sees a longer path
+        int64_t origin = time_at(tx_raw != 0 ? tx_raw : send_raw) - draw_delay();
+        
+        PTPMessage follow_up = make_message(PTPMessageType::FollowUp, sequence_id, config_.log_sync_interval);
+        follow_up.flags = PTP_FLAG_PTP_TIMESCALE;
+        follow_up.timestamp = PTPTimestamp::from_ns(origin);
+        if (send(general_fd_, config_.general_port, follow_up)) {
+            std::lock_guard<std::mutex> lock(stats_mutex_);
+            stats_.syncs_sent++;
+        }
+    }
+    
+    void receive_delay_requests() {
+        uint8_t buffer[256];
+        alignas(cmsghdr) uint8_t control[256];
+        while (true) {
+            iovec iov{buffer, sizeof(buffer)};
+            msghdr msg{};
+            msg.msg_iov = &iov;
+            msg.msg_iovlen = 1;
+            msg.msg_control = control;
+            msg.msg_controllen = sizeof(control);
+            ssize_t size = recvmsg(event_fd_, &msg, MSG_DONTWAIT);
+            if (size <= 0) break;
+            
+            int64_t rx_raw;
+            if (!software_timestamp_raw(msg, rx_raw)) {
+                rx_raw = PTPSync::monotonic_raw_ns();
+            }
+            int64_t receive_time = time_at(rx_raw);
+            
+            // Own Sync messages loop back too
+            PTPMessage request;
+            if (!PTPProtocol::parse(buffer, static_cast<size_t>(size), request)) continue;
+            if (request.type != PTPMessageType::DelayReq || request.domain != config_.domain) continue;
+            
+            {
+                std::lock_guard<std::mutex> lock(stats_mutex_);
+                stats_.delay_requests++;
+            }
+            
+            PTPMessage response = make_message(PTPMessageType::DelayResp, request.sequence_id,
+                                               config_.log_sync_interval);
+            response.flags = PTP_FLAG_PTP_TIMESCALE;
+            response.correction = request.correction;
+            response.timestamp = PTPTimestamp::from_ns(receive_time + draw_delay());
+            response.requesting_port = request.source_port;
+            if (send(general_fd_, config_.general_port, response)) {
+                std::lock_guard<std::mutex> lock(stats_mutex_);
+                stats_.delay_responses_sent++;
+            }
+        }
+    }
+    
+    // Read transmit timestamps from the error queue; returns the last one (raw), 0 if none
+    int64_t drain_tx_timestamps(int timeout_ms) {
+        int64_t tx_raw = 0;
+        pollfd pfd{};
+        pfd.fd = event_fd_;
+        pfd.events = POLLPRI;
+        
+        while (poll(&pfd, 1, tx_raw == 0 ? timeout_ms : 0) > 0 && (pfd.revents & POLLERR)) {
+            uint8_t data[64];
+            alignas(cmsghdr) uint8_t control[256];
+            iovec iov{data, sizeof(data)};
+            msghdr msg{};
+            msg.msg_iov = &iov;
+            msg.msg_iovlen = 1;
+            msg.msg_control = control;
+            msg.msg_controllen = sizeof(control);
+            if (recvmsg(event_fd_, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) break;
+            
+            int64_t raw_ns;
+            if (software_timestamp_raw(msg, raw_ns)) {
+                tx_raw = raw_ns;
+            }
+        }
+        return tx_raw;
+    }
+    
+    bool send(int fd, uint16_t port, const PTPMessage& message) {
+        uint8_t buffer[128];
+        size_t size = PTPProtocol::serialize(message, buffer, sizeof(buffer));
+        if (size == 0) return false;
+        
+        sockaddr_in destination{};
+        destination.sin_family = AF_INET;
+        destination.sin_port = htons(port);
+        destination.sin_addr = group_;
+        ssize_t sent = sendto(fd, buffer, size, 0, reinterpret_cast<sockaddr*>(&destination),
+                              sizeof(destination));
+        if (sent < 0) {
+            LOG_WARNING("PTP simulator: failed to send {}: {}",
+                        PTPProtocol::type_to_string(message.type), strerror(errno));
+            return false;
+        }
+        return true;
+    }
+    
+    in_addr group_{};
+    int event_fd_ = -1;
+    int general_fd_ = -1;
+#endif
+    
+    PTPGrandmasterSimConfig config_;
+    
+    std::atomic<bool> running_{false};
+    std::atomic<bool> enabled_{true};
+    std::thread thread_;
+    
+    // Grandmaster oscillator; written under scale_mutex_, read lock-free
+    SeqLock<PTPTimeScale> scale_;
+    std::mutex scale_mutex_;
+    
+    std::atomic<int64_t> delay_ns_{0};
+    std::atomic<int64_t> jitter_ns_{0};
+    std::mt19937_64 rng_;
+    
+    uint16_t sync_sequence_ = 0;
+    uint16_t announce_sequence_ = 0;
+    
+    mutable std::mutex stats_mutex_;
+    PTPGrandmasterSimStats stats_;
+};
+
+// PTPGrandmasterSim public interface
+
+PTPGrandmasterSim::PTPGrandmasterSim() : impl_(std::make_unique<Impl>()) {}
+PTPGrandmasterSim::~PTPGrandmasterSim() = default;
+
+bool PTPGrandmasterSim::start(const PTPGrandmasterSimConfig& config) {
+    return impl_->start(config);
+}
+
+void PTPGrandmasterSim::stop() {
+    impl_->stop();
+}
+
+bool PTPGrandmasterSim::is_running() const {
+    return impl_->is_running();
+}
+
+int64_t PTPGrandmasterSim::time_at(int64_t raw_ns) const {
+    return impl_->time_at(raw_ns);
+}
+
+int64_t PTPGrandmasterSim::now() const {
+    return impl_->time_at(PTPSync::monotonic_raw_ns());
+}
+
+void PTPGrandmasterSim::step(int64_t offset_ns) {
+    impl_->step(offset_ns);
+}
+
+void PTPGrandmasterSim::set_frequency_offset_ppm(double ppm) {
+    impl_->set_frequency_offset_ppm(ppm);
+}
+
+void PTPGrandmasterSim::set_path_delay(int64_t delay_ns, int64_t jitter_ns) {
+    impl_->set_path_delay(delay_ns, jitter_ns);
+}
+
+void PTPGrandmasterSim::set_enabled(bool enabled) {
+    impl_->set_enabled(enabled);
+}
+
+PTPGrandmasterSimStats PTPGrandmasterSim::get_stats() const {
+    return impl_->get_stats();
+}
+
+}  // namespace rpi_aes67
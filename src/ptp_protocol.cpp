@@ -0,0 +1,237 @@
+// SPDX-License-Identifier: MIT
+/*
+ * RPi-AES67 - Professional AES67 Sender/Receiver for Raspberry Pi 5
+ * Copyright (c) 2025 DHPKE
+ *
+ * PTPv2 message encoding and BMCA comparison.
+ */
+
+#include "rpi_aes67/ptp_protocol.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace rpi_aes67 {
+
+namespace {
+
+constexpr size_t HEADER_SIZE = 34;
+
+// Big-endian field access
+uint16_t get16(const uint8_t* p) {
+    return static_cast<uint16_t>((p[0] << 8) | p[1]);
+}
+
+uint32_t get32(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | p[3];
+}
+
+uint64_t get64(const uint8_t* p) {
+    return (static_cast<uint64_t>(get32(p)) << 32) | get32(p + 4);
+}
+
+void put16(uint8_t* p, uint16_t v) {
+    p[0] = static_cast<uint8_t>(v >> 8);
+    p[1] = static_cast<uint8_t>(v);
+}
+
+void put32(uint8_t* p, uint32_t v) {
+    put16(p, static_cast<uint16_t>(v >> 16));
+    put16(p + 2, static_cast<uint16_t>(v));
+}
+
+void put64(uint8_t* p, uint64_t v) {
+    put32(p, static_cast<uint32_t>(v >> 32));
+    put32(p + 4, static_cast<uint32_t>(v));
+}
+
+PTPTimestamp get_timestamp(const uint8_t* p) {
+    PTPTimestamp ts;
+    ts.seconds = (static_cast<uint64_t>(get16(p)) << 32) | get32(p + 2);
+    ts.nanoseconds = get32(p + 6);
+    return ts;
+}
+
+void put_timestamp(uint8_t* p, const PTPTimestamp& ts) {
+    put16(p, static_cast<uint16_t>(ts.seconds >> 32));
+    put32(p + 2, static_cast<uint32_t>(ts.seconds));
+    put32(p + 6, ts.nanoseconds);
+}
+
+PTPPortIdentity get_port_identity(const uint8_t* p) {
+    PTPPortIdentity id;
+    id.clock_id = get64(p);
+    id.port_number = get16(p + 8);
+    return id;
+}
+
+void put_port_identity(uint8_t* p, const PTPPortIdentity& id) {
+    put64(p, id.clock_id);
+    put16(p + 8, id.port_number);
+}
+
+// controlField values (IEEE 1588-2019 Table 42, kept for PTPv1 hardware)
+uint8_t control_field(PTPMessageType type) {
+    switch (type) {
+        case PTPMessageType::Sync: return 0;
+        case PTPMessageType::DelayReq: return 1;
+        case PTPMessageType::FollowUp: return 2;
+        case PTPMessageType::DelayResp: return 3;
+        default: return 5;
+    }
+}
+
+}  // namespace
+
+size_t PTPProtocol::message_size(PTPMessageType type) {
+    switch (type) {
+        case PTPMessageType::Sync:
+        case PTPMessageType::DelayReq:
+        case PTPMessageType::FollowUp:
+            return 44;
+        case PTPMessageType::DelayResp:
+            return 54;
+        case PTPMessageType::Announce:
+            return 64;
+        default:
+            return 0;
+    }
+}
+
+bool PTPProtocol::parse(const uint8_t* data, size_t size, PTPMessage& message) {
+    if (size < HEADER_SIZE) return false;
+    
+    message = PTPMessage{};
+    message.type = static_cast<PTPMessageType>(data[0] & 0x0F);
+    message.version = data[1] & 0x0F;
+    if (message.version != 2) return false;
+    
+    size_t length = get16(data + 2);
+    size_t expected = message_size(message.type);
+    if (expected == 0 || length < expected || size < expected) return false;
+    
+    message.domain = data[4];
+    message.flags = get16(data + 6);
+    message.correction = static_cast<int64_t>(get64(data + 8));
+    message.source_port = get_port_identity(data + 20);
+    message.sequence_id = get16(data + 30);
+    message.log_message_interval = static_cast<int8_t>(data[33]);
+    
+    const uint8_t* body = data + HEADER_SIZE;
+    message.timestamp = get_timestamp(body);
+    
+    switch (message.type) {
+        case PTPMessageType::DelayResp:
+            message.requesting_port = get_port_identity(body + 10);
+            break;
+        case PTPMessageType::Announce:
+            message.current_utc_offset = static_cast<int16_t>(get16(body + 10));
+            message.grandmaster_priority1 = body[13];
+            message.grandmaster_clock_quality.clock_class = body[14];
+            message.grandmaster_clock_quality.clock_accuracy = body[15];
+            message.grandmaster_clock_quality.offset_scaled_log_variance = get16(body + 16);
+            message.grandmaster_priority2 = body[18];
+            message.grandmaster_identity = get64(body + 19);
+            message.steps_removed = get16(body + 27);
+            message.time_source = body[29];
+            break;
+        default:
+            break;
+    }
+    return true;
+}
+
+size_t PTPProtocol::serialize(const PTPMessage& message, uint8_t* data, size_t size) {
+    size_t length = message_size(message.type);
+    if (length == 0 || size < length) return 0;
+    
+    std::fill(data, data + length, 0);
+    data[0] = static_cast<uint8_t>(message.type) & 0x0F;
+    data[1] = 0x12;                     // minorVersionPTP 1, versionPTP 2
+    put16(data + 2, static_cast<uint16_t>(length));
+    data[4] = message.domain;
+    put16(data + 6, message.flags);
+    put64(data + 8, static_cast<uint64_t>(message.correction));
+    put_port_identity(data + 20, message.source_port);
+    put16(data + 30, message.sequence_id);
+    data[32] = control_field(message.type);
+    data[33] = static_cast<uint8_t>(message.log_message_interval);
+    
+    uint8_t* body = data + HEADER_SIZE;
+    put_timestamp(body, message.timestamp);
+    
+    switch (message.type) {
+        case PTPMessageType::DelayResp:
+            put_port_identity(body + 10, message.requesting_port);
+            break;
+        case PTPMessageType::Announce:
+            put16(body + 10, static_cast<uint16_t>(message.current_utc_offset));
+            body[13] = message.grandmaster_priority1;
+            body[14] = message.grandmaster_clock_quality.clock_class;
+            body[15] = message.grandmaster_clock_quality.clock_accuracy;
+            put16(body + 16, message.grandmaster_clock_quality.offset_scaled_log_variance);
+            body[18] = message.grandmaster_priority2;
+            put64(body + 19, message.grandmaster_identity);
+            put16(body + 27, message.steps_removed);
+            body[29] = message.time_source;
+            break;
+        default:
+            break;
+    }
+    return length;
+}
+
+int PTPProtocol::compare_announce(const PTPMessage& a, const PTPMessage& b) {
+    auto compare = [](auto x, auto y) { return x < y ? -1 : (x > y ? 1 : 0); };
+    
+    // Different grandmasters: compare their data sets
+    if (a.grandmaster_identity != b.grandmaster_identity) {
+        const auto& qa = a.grandmaster_clock_quality;
+        const auto& qb = b.grandmaster_clock_quality;
+        if (int c = compare(a.grandmaster_priority1, b.grandmaster_priority1)) return c;
+        if (int c = compare(qa.clock_class, qb.clock_class)) return c;
+        if (int c = compare(qa.clock_accuracy, qb.clock_accuracy)) return c;
+        if (int c = compare(qa.offset_scaled_log_variance, qb.offset_scaled_log_variance)) return c;
+        if (int c = compare(a.grandmaster_priority2, b.grandmaster_priority2)) return c;
+        return compare(a.grandmaster_identity, b.grandmaster_identity);
+    }
+    
+    // Same grandmaster via different paths: fewer hops, then sender identity
+    if (int c = compare(a.steps_removed, b.steps_removed)) return c;
+    if (int c = compare(a.source_port.clock_id, b.source_port.clock_id)) return c;
+    return compare(a.source_port.port_number, b.source_port.port_number);
+}
+
+uint64_t PTPProtocol::clock_identity_from_mac(const uint8_t* mac) {
+    uint64_t id = 0;
+    const uint8_t eui64[8] = {mac[0], mac[1], mac[2], 0xFF, 0xFE, mac[3], mac[4], mac[5]};
+    for (uint8_t byte : eui64) {
+        id = (id << 8) | byte;
+    }
+    return id;
+}
+
+std::string PTPProtocol::clock_identity_to_string(uint64_t clock_id) {
+    char buf[24];
+    std::snprintf(buf, sizeof(buf), "%02x-%02x-%02x-%02x-%02x-%02x-%02x-%02x",
+                  static_cast<unsigned>((clock_id >> 56) & 0xFF), static_cast<unsigned>((clock_id >> 48) & 0xFF),
+                  static_cast<unsigned>((clock_id >> 40) & 0xFF), static_cast<unsigned>((clock_id >> 32) & 0xFF),
+                  static_cast<unsigned>((clock_id >> 24) & 0xFF), static_cast<unsigned>((clock_id >> 16) & 0xFF),
+                  static_cast<unsigned>((clock_id >> 8) & 0xFF), static_cast<unsigned>(clock_id & 0xFF));
+    return buf;
+}
+
+const char* PTPProtocol::type_to_string(PTPMessageType type) {
+    switch (type) {
+        case PTPMessageType::Sync: return "Sync";
+        case PTPMessageType::DelayReq: return "Delay_Req";
+        case PTPMessageType::FollowUp: return "Follow_Up";
+        case PTPMessageType::DelayResp: return "Delay_Resp";
+        case PTPMessageType::Announce: return "Announce";
+        case PTPMessageType::Signaling: return "Signaling";
+        case PTPMessageType::Management: return "Management";
+        default: return "Unknown";
+    }
+}
+
+}  // namespace rpi_aes67
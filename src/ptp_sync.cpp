@@ -8,12 +8,19 @@
  */
 
 #include "rpi_aes67/ptp_sync.h"
+#include "rpi_aes67/ptp_protocol.h"
+#include "rpi_aes67/linuxptp_client.h"
+#include "rpi_aes67/media_clock.h"
 #include "rpi_aes67/logger.h"
 #include <thread>
 #include <vector>
 #include <mutex>
 #include <condition_variable>
 #include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <random>
+#include <array>
 
 #ifdef __linux__
 #include <sys/socket.h>
@@ -24,31 +31,234 @@
 #include <sys/ioctl.h>
 #include <linux/if_packet.h>
 #include <linux/if_ether.h>
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
+#include <linux/ethtool.h>
+#include <linux/sockios.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
 #endif
 
 namespace rpi_aes67 {
 
-// PTP constants
-constexpr uint16_t PTP_EVENT_PORT = 319;
-constexpr uint16_t PTP_GENERAL_PORT = 320;
-constexpr const char* PTP_MULTICAST_ADDR = "224.0.1.129";
+// Announce intervals without a message before the master is considered lost
+constexpr int ANNOUNCE_RECEIPT_TIMEOUT = 3;
+// Announce intervals in which a foreign master must be heard twice to qualify
+constexpr int FOREIGN_MASTER_WINDOW = 4;
+// Path delay measurements in the moving median
+constexpr size_t DELAY_FILTER_LENGTH = 9;
+// Frequency correction limit
+constexpr double SERVO_MAX_PPB = 500000.0;
+// ptp4l notification subscription lifetime (renewed at half)
+constexpr uint16_t LINUXPTP_SUBSCRIBE_S = 60;
+// CURRENT_DATA_SET poll and clock sample interval (linuxptp backend)
+constexpr int64_t LINUXPTP_SAMPLE_INTERVAL_NS = 1000000000LL;
+// ptp4l silence before the management socket is reopened
+constexpr int64_t LINUXPTP_TIMEOUT_NS = 3000000000LL;
+
+namespace {
+
+// 2^log_interval seconds in nanoseconds; 0x7F and out-of-range values use the default
+int64_t log_interval_ns(int8_t log_interval, int64_t default_ns) {
+    if (log_interval < -7 || log_interval > 6) return default_ns;
+    return static_cast<int64_t>(std::ldexp(1e9, log_interval));
+}
+
+/**
+ * PI clock servo (linuxptp-style).
+ *
+ * The first sample sets the phase, the second estimates the frequency
+ * error from the drift between them, and from then on the servo runs a
+ * PI loop. Gains are normalized to the sync interval. Output is the
+ * frequency error of the local clock in ppb (positive = local runs fast).
+ */
+class PIServo {
+public:
+    enum class Action {
+        Step,       // Set the phase to the master and apply the frequency
+        Adjust      // Apply the frequency only
+    };
+    
+    void configure(double kp_scale, double ki_scale, int64_t step_threshold_ns) {
+        kp_scale_ = kp_scale;
+        ki_scale_ = ki_scale;
+        step_threshold_ns_ = step_threshold_ns;
+    }
+    
+    // Restart the lock sequence; the frequency estimate is kept
+    void reset() { samples_ = 0; }
+    
+    [[nodiscard]] bool locked() const { return samples_ >= 2; }
+    [[nodiscard]] double frequency_ppb() const { return ppb_; }
+    // Integral term only: the oscillator estimate to hold over on
+    [[nodiscard]] double drift_ppb() const { return drift_ppb_; }
+    
+    Action sample(int64_t offset_ns, int64_t local_ns, double interval_s) {
+        if (samples_ >= 2 && step_threshold_ns_ > 0 && std::llabs(offset_ns) > step_threshold_ns_) {
+            samples_ = 0;
+        }
+        
+        switch (samples_) {
+            case 0:
+                last_local_ns_ = local_ns;
+                samples_ = 1;
+                ppb_ = drift_ppb_;
+                return Action::Step;
+            
+            case 1: {
+                // Offset accumulated since the phase step is the frequency error
+                double elapsed_s = static_cast<double>(local_ns - last_local_ns_) / 1e9;
+                if (elapsed_s > 0.0) {
+                    drift_ppb_ = std::clamp(drift_ppb_ + static_cast<double>(offset_ns) / elapsed_s,
+                                            -SERVO_MAX_PPB, SERVO_MAX_PPB);
+                }
+                samples_ = 2;
+                ppb_ = drift_ppb_;
+                return Action::Step;
+            }
+            
+            default: {
+                interval_s = std::max(interval_s, 1e-3);
+                double kp = std::min(kp_scale_ * std::pow(interval_s, -0.3), 0.7 / interval_s);
+                double ki = std::min(ki_scale_ * std::pow(interval_s, 0.4), 0.3 / interval_s);
+                double ki_term = ki * static_cast<double>(offset_ns);
+                double ppb = kp * static_cast<double>(offset_ns) + drift_ppb_ + ki_term;
+                if (ppb > SERVO_MAX_PPB || ppb < -SERVO_MAX_PPB) {
+                    ppb = std::clamp(ppb, -SERVO_MAX_PPB, SERVO_MAX_PPB);
+                } else {
+                    drift_ppb_ += ki_term;
+                }
+                ppb_ = ppb;
+                return Action::Adjust;
+            }
+        }
+    }
+
+private:
+    double kp_scale_ = 0.7;
+    double ki_scale_ = 0.3;
+    int64_t step_threshold_ns_ = 0;
+    int samples_ = 0;
+    int64_t last_local_ns_ = 0;
+    double drift_ppb_ = 0.0;
+    double ppb_ = 0.0;
+};
+
+#ifdef __linux__
+int64_t clock_ns(clockid_t clock) {
+    timespec ts{};
+    clock_gettime(clock, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+int64_t timespec_ns(const timespec& ts) {
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+// Software timestamp (CLOCK_REALTIME) from SCM_TIMESTAMPING ancillary data
+bool software_timestamp(msghdr& msg, int64_t& realtime_ns) {
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SO_TIMESTAMPING) {
+            timespec stamps[3];
+            std::memcpy(stamps, CMSG_DATA(cmsg), sizeof(stamps));
+            if (stamps[0].tv_sec == 0 && stamps[0].tv_nsec == 0) return false;
+            realtime_ns = timespec_ns(stamps[0]);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Map a CLOCK_REALTIME kernel stamp into CLOCK_MONOTONIC_RAW
+int64_t realtime_to_raw(int64_t realtime_ns) {
+    int64_t raw_now = clock_ns(CLOCK_MONOTONIC_RAW);
+    int64_t realtime_now = clock_ns(CLOCK_REALTIME);
+    return raw_now - (realtime_now - realtime_ns);
+}
+
+// PTP hardware clock index of an interface, -1 if it has none
+int phc_index(const std::string& interface) {
+    int fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    
+    ethtool_ts_info info{};
+    info.cmd = ETHTOOL_GET_TS_INFO;
+    ifreq ifr{};
+    std::strncpy(ifr.ifr_name, interface.c_str(), IFNAMSIZ - 1);
+    ifr.ifr_data = reinterpret_cast<char*>(&info);
+    int result = ioctl(fd, SIOCETHTOOL, &ifr);
+    close(fd);
+    return result == 0 ? info.phc_index : -1;
+}
+
+// Dynamic POSIX clock of an open /dev/ptpN
+clockid_t fd_to_clockid(int fd) {
+    return static_cast<clockid_t>((~static_cast<unsigned int>(fd) << 3) | 3);
+}
+#endif
+
+PTPState state_from_port_state(LinuxPTPPortState port_state) {
+    switch (port_state) {
+        case LinuxPTPPortState::Slave: return PTPState::Slave;
+        case LinuxPTPPortState::Uncalibrated: return PTPState::Uncalibrated;
+        case LinuxPTPPortState::Faulty:
+        case LinuxPTPPortState::Disabled: return PTPState::Faulty;
+        case LinuxPTPPortState::PreMaster:
+        case LinuxPTPPortState::Master:
+        case LinuxPTPPortState::Passive: return PTPState::Passive;
+        default: return PTPState::Listening;
+    }
+}
+
+}  // namespace
 
 // ==================== PTPSync::Impl ====================
 
 class PTPSync::Impl {
 public:
     Impl() = default;
-    ~Impl() { stop(); }
+    ~Impl() {
+        stop();
+        close_sockets();
+#ifdef __linux__
+        if (phc_fd_ >= 0) close(phc_fd_);
+#endif
+    }
     
     bool initialize(const PTPConfig& config) {
         config_ = config;
+        servo_.configure(config_.servo_kp, config_.servo_ki, config_.step_threshold_ns);
         
-        // Initialize socket for PTP communication
-        // In this implementation, we rely on linuxptp running externally
-        // and read its state through shared memory or system calls
+        use_linuxptp_ = config_.backend == "linuxptp";
+        if (use_linuxptp_) {
+            if (!linuxptp_.open(config_.uds_path, config_.domain)) {
+                return false;
+            }
+#ifdef __linux__
+            open_ptp_clock();
+#endif
+            LOG_INFO("PTP initialized with linuxptp backend ({}), domain {}",
+                     config_.uds_path, static_cast<int>(config_.domain));
+            initialized_ = true;
+            return true;
+        }
         
-        LOG_INFO("PTP initialized on interface {}, domain {}", 
-                 config_.interface, static_cast<int>(config_.domain));
+        if (config_.use_hardware_timestamps) {
+            LOG_WARNING("PTP: hardware timestamping is not supported by the built-in follower, "
+                        "using software timestamps");
+        }
+        
+#ifdef __linux__
+        if (!open_sockets()) {
+            close_sockets();
+            return false;
+        }
+#endif
+        
+        LOG_INFO("PTP initialized on interface {}, domain {}, clock identity {}", 
+                 config_.interface, static_cast<int>(config_.domain),
+                 PTPProtocol::clock_identity_to_string(own_port_.clock_id));
         
         initialized_ = true;
         return true;
@@ -56,13 +266,21 @@ public:
     
     void start() {
         if (running_) return;
+        if (!initialized_) {
+            LOG_ERROR("PTP not initialized");
+            return;
+        }
         
         running_ = true;
-        state_ = PTPState::Listening;
+        set_state(PTPState::Listening);
         
-        // Start monitoring thread
+        // Start protocol thread
         monitor_thread_ = std::thread([this]() {
-            monitor_loop();
+            if (use_linuxptp_) {
+                linuxptp_loop();
+            } else {
+                monitor_loop();
+            }
         });
         
         LOG_INFO("PTP synchronization started");
@@ -72,28 +290,50 @@ public:
         if (!running_) return;
         
         running_ = false;
-        state_ = PTPState::Initializing;
         
         if (monitor_thread_.joinable()) {
             monitor_thread_.join();
         }
         
+        foreign_masters_.clear();
+        parent_ = PTPPortIdentity{};
+        servo_.reset();
+        holdover_start_raw_ = 0;
+        set_state(PTPState::Initializing);
+        
         LOG_INFO("PTP synchronization stopped");
     }
     
     bool is_running() const { return running_; }
     bool is_synchronized() const { return state_ == PTPState::Slave; }
+    bool has_valid_time() const { return has_valid_time(PTPSync::monotonic_raw_ns()); }
+    
+    int64_t get_time_uncertainty_ns() const {
+        int64_t now_raw = PTPSync::monotonic_raw_ns();
+        if (state_ == PTPState::Slave) {
+            return std::llabs(offset_from_master_.load()) + slew_error_ns_.load();
+        }
+        int64_t start = holdover_start_raw_;
+        if (start != 0 && has_valid_time(now_raw)) {
+            double drift = static_cast<double>(now_raw - start) * config_.holdover_drift_ppb / 1e9;
+            return holdover_offset_ns_.load() + slew_error_ns_.load() + static_cast<int64_t>(drift);
+        }
+        return INT64_MAX;
+    }
     
     std::chrono::nanoseconds get_current_time() const {
-        // Use system clock as base and apply PTP offset
-        auto now = std::chrono::system_clock::now();
-        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
-            now.time_since_epoch());
+        PTPTimeScale scale = scale_.load();
+        if (scale.valid) {
+            return std::chrono::nanoseconds(scale.at(PTPSync::monotonic_raw_ns()));
+        }
         
-        // Apply offset from master
-        return std::chrono::nanoseconds(ns.count() - offset_from_master_);
+        // Not yet synchronized: system clock
+        auto now = std::chrono::system_clock::now();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch());
     }
     
+    PTPTimeScale get_time_scale() const { return scale_.load(); }
+    
     uint64_t get_ptp_timestamp() const {
         return static_cast<uint64_t>(get_current_time().count());
     }
@@ -103,10 +343,8 @@ public:
     }
     
     static uint32_t ptp_to_rtp_timestamp(uint64_t ptp_ns, uint32_t sample_rate) {
-        // RTP timestamp = (PTP_time_ns * sample_rate) / 1e9
-        // Use 64-bit arithmetic to avoid overflow
-        uint64_t timestamp = (ptp_ns * sample_rate) / 1000000000ULL;
-        return static_cast<uint32_t>(timestamp);  // 32-bit wrapping
+        // Exact: the full product ptp_ns * sample_rate overflows 64 bits
+        return static_cast<uint32_t>(MediaClock::rate_for(sample_rate).samples_at(ptp_ns));
     }
     
     int64_t get_offset_from_master() const { return offset_from_master_; }
@@ -114,14 +352,18 @@ public:
     PTPState get_state() const { return state_; }
     
     PTPClockInfo get_clock_info() const {
+        std::lock_guard<std::mutex> lock(parent_mutex_);
         PTPClockInfo info;
-        info.clock_id = clock_id_;
-        info.priority1 = priority1_;
-        info.priority2 = priority2_;
-        info.clock_class = clock_class_;
-        info.clock_accuracy = clock_accuracy_;
+        info.clock_id = parent_announce_.grandmaster_identity;
+        info.priority1 = parent_announce_.grandmaster_priority1;
+        info.priority2 = parent_announce_.grandmaster_priority2;
+        info.clock_class = parent_announce_.grandmaster_clock_quality.clock_class;
+        info.clock_accuracy = parent_announce_.grandmaster_clock_quality.clock_accuracy;
         info.offset_from_master_ns = offset_from_master_;
         info.path_delay_ns = path_delay_;
+        info.frequency_offset_ppb = frequency_ppb_;
+        info.steps_removed = parent_announce_.steps_removed;
+        info.time_uncertainty_ns = get_time_uncertainty_ns();
         info.state = state_;
         info.synchronized = is_synchronized();
         return info;
@@ -140,47 +382,656 @@ public:
     }
 
 private:
+    struct ForeignMaster {
+        PTPMessage announce;
+        int64_t previous_raw = 0;       // Arrival of the announce before last
+        int64_t last_raw = 0;
+        int64_t interval_ns = 1000000000LL;
+    };
+
+#ifdef __linux__
+    bool open_sockets() {
+        close_sockets();
+        
+        in_addr group{};
+        if (inet_pton(AF_INET, config_.multicast_address.c_str(), &group) != 1) {
+            LOG_ERROR("PTP: invalid multicast address {}", config_.multicast_address);
+            return false;
+        }
+        destination_.sin_family = AF_INET;
+        destination_.sin_addr = group;
+        multicast_ = IN_MULTICAST(ntohl(group.s_addr));
+        
+        unsigned int ifindex = if_nametoindex(config_.interface.c_str());
+        if (ifindex == 0) {
+            LOG_ERROR("PTP: unknown interface {}", config_.interface);
+            return false;
+        }
+        
+        event_fd_ = open_socket(config_.event_port, ifindex, group);
+        general_fd_ = open_socket(config_.general_port, ifindex, group);
+        if (event_fd_ < 0 || general_fd_ < 0) return false;
+        
+        own_port_.clock_id = interface_clock_identity();
+        own_port_.port_number = 1;
+        return true;
+    }
+    
+    int open_socket(uint16_t port, unsigned int ifindex, in_addr group) {
+        int fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            LOG_ERROR("PTP: failed to create socket: {}", strerror(errno));
+            return -1;
+        }
+        
+        int reuse = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        addr.sin_addr.s_addr = htonl(INADDR_ANY);
+        if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+            LOG_ERROR("PTP: failed to bind UDP port {}: {}", port, strerror(errno));
+            close(fd);
+            return -1;
+        }
+        
+        if (multicast_) {
+            ip_mreqn mreq{};
+            mreq.imr_multiaddr = group;
+            mreq.imr_ifindex = static_cast<int>(ifindex);
+            if (setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0) {
+                LOG_ERROR("PTP: failed to join {} on {}: {}", config_.multicast_address,
+                          config_.interface, strerror(errno));
+                close(fd);
+                return -1;
+            }
+            setsockopt(fd, IPPROTO_IP, IP_MULTICAST_IF, &mreq, sizeof(mreq));
+            
+            // PTP multicast stays on the link; loop lets a local grandmaster
+            // (or simulator) share the host
+            int ttl = 1;
+            int loop = 1;
+            setsockopt(fd, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl));
+            setsockopt(fd, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop));
+        }
+        
+        // Kernel software timestamps on receive and transmit
+        int flags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_TX_SOFTWARE |
+                    SOF_TIMESTAMPING_SOFTWARE | SOF_TIMESTAMPING_OPT_TSONLY;
+        if (setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)) < 0) {
+            LOG_WARNING("PTP: SO_TIMESTAMPING unavailable on port {}, using user-space timestamps", port);
+        }
+        return fd;
+    }
+    
+    void close_sockets() {
+        if (event_fd_ >= 0) {
+            close(event_fd_);
+            event_fd_ = -1;
+        }
+        if (general_fd_ >= 0) {
+            close(general_fd_);
+            general_fd_ = -1;
+        }
+    }
+    
+    // EUI-64 from the interface MAC; random if it has none (loopback)
+    uint64_t interface_clock_identity() const {
+        ifreq ifr{};
+        std::strncpy(ifr.ifr_name, config_.interface.c_str(), IFNAMSIZ - 1);
+        if (ioctl(event_fd_, SIOCGIFHWADDR, &ifr) == 0) {
+            const auto* mac = reinterpret_cast<const uint8_t*>(ifr.ifr_hwaddr.sa_data);
+            if (std::any_of(mac, mac + 6, [](uint8_t b) { return b != 0; })) {
+                return PTPProtocol::clock_identity_from_mac(mac);
+            }
+        }
+        std::random_device rd;
+        return (static_cast<uint64_t>(rd()) << 32) | rd();
+    }
+#endif
+    
     void monitor_loop() {
+#ifdef __linux__
+        pollfd fds[2] = {};
+        fds[0].fd = event_fd_;
+        fds[0].events = POLLIN;
+        fds[1].fd = general_fd_;
+        fds[1].events = POLLIN;
+        
+        while (running_) {
+            // Wake for messages, the next Delay_Req, or at least every 100 ms
+            int timeout_ms = 100;
+            if (parent_.clock_id != 0) {
+                int64_t until_delay_req = (next_delay_req_raw_ - clock_ns(CLOCK_MONOTONIC_RAW)) / 1000000;
+                timeout_ms = static_cast<int>(std::clamp<int64_t>(until_delay_req, 0, 100));
+            }
+            
+            if (poll(fds, 2, timeout_ms) > 0) {
+                if (fds[0].revents & POLLIN) receive_messages(event_fd_);
+                if (fds[1].revents & POLLIN) receive_messages(general_fd_);
+            }
+            
+            int64_t now_raw = clock_ns(CLOCK_MONOTONIC_RAW);
+            check_master(now_raw);
+            check_holdover(now_raw);
+        }
+#endif
+    }
+
+    // linuxptp backend: follow ptp4l's state through its management socket
+    void linuxptp_loop() {
+#ifdef __linux__
+        int64_t now = clock_ns(CLOCK_MONOTONIC_RAW);
+        int64_t next_subscribe = now;
+        int64_t next_poll = now;
+        int64_t last_response = now;
+        bool responding = true;
+        
+        while (running_) {
+            now = clock_ns(CLOCK_MONOTONIC_RAW);
+            check_holdover(now);
+            
+            // ptp4l restarted or died: a new instance binds a new socket
+            if (now - last_response > LINUXPTP_TIMEOUT_NS) {
+                if (responding) {
+                    LOG_WARNING("PTP: no response from ptp4l at {}, reconnecting", config_.uds_path);
+                    responding = false;
+                    if (!enter_holdover(now)) set_state(PTPState::Faulty);
+                }
+                linuxptp_.open(config_.uds_path, config_.domain);
+                last_response = now;
+                next_subscribe = now;
+            }
+            
+            if (now >= next_subscribe) {
+                linuxptp_.subscribe(LINUXPTP_SUBSCRIBE_S);
+                linuxptp_.get(PMC_PORT_DATA_SET);
+                linuxptp_.get(PMC_PARENT_DATA_SET);
+                linuxptp_.get(PMC_TIME_PROPERTIES_DATA_SET);
+                linuxptp_.get(PMC_TIME_STATUS_NP);
+                next_subscribe = now + LINUXPTP_SUBSCRIBE_S * 1000000000LL / 2;
+            }
+            
+            // Path delay is not part of the notifications; the clock sample
+            // keeps the time scale's rate current
+            if (now >= next_poll) {
+                linuxptp_.get(PMC_CURRENT_DATA_SET);
+                sample_ptp_clock();
+                next_poll = now + LINUXPTP_SAMPLE_INTERVAL_NS;
+            }
+            
+            int timeout_ms = static_cast<int>(std::clamp<int64_t>((next_poll - now) / 1000000, 0, 100));
+            uint16_t id = linuxptp_.receive(linuxptp_status_, timeout_ms);
+            if (id != 0) {
+                last_response = clock_ns(CLOCK_MONOTONIC_RAW);
+                if (!responding) {
+                    LOG_INFO("PTP: ptp4l at {} is responding again", config_.uds_path);
+                    responding = true;
+                }
+                apply_linuxptp_status(id);
+            }
+        }
+#endif
+    }
+
+#ifdef __linux__
+    // Use the clock ptp4l disciplines: the interface PHC, else CLOCK_REALTIME
+    void open_ptp_clock() {
+        int index = phc_index(config_.interface);
+        if (index >= 0) {
+            std::string device = "/dev/ptp" + std::to_string(index);
+            phc_fd_ = open(device.c_str(), O_RDONLY | O_CLOEXEC);
+            if (phc_fd_ >= 0) {
+                ptp_clock_ = fd_to_clockid(phc_fd_);
+                LOG_INFO("PTP: reading time from {} ({})", device, config_.interface);
+                return;
+            }
+            LOG_WARNING("PTP: cannot open {}: {}, using CLOCK_REALTIME", device, strerror(errno));
+        }
+        ptp_clock_ = CLOCK_REALTIME;
+    }
+    
+    void apply_linuxptp_status(uint16_t id) {
+        const LinuxPTPStatus& status = linuxptp_status_;
+        
+        {
+            std::lock_guard<std::mutex> lock(parent_mutex_);
+            if (status.gm_identity != parent_announce_.grandmaster_identity && status.gm_identity != 0) {
+                LOG_INFO("PTP: grandmaster {} (via ptp4l)",
+                         PTPProtocol::clock_identity_to_string(status.gm_identity));
+            }
+            parent_announce_.grandmaster_identity = status.gm_identity;
+            parent_announce_.grandmaster_priority1 = status.gm_priority1;
+            parent_announce_.grandmaster_priority2 = status.gm_priority2;
+            parent_announce_.grandmaster_clock_quality.clock_class = status.gm_clock_class;
+            parent_announce_.grandmaster_clock_quality.clock_accuracy = status.gm_clock_accuracy;
+            parent_announce_.steps_removed = status.steps_removed;
+            parent_announce_.current_utc_offset = status.current_utc_offset;
+        }
+        
+        switch (id) {
+            case PMC_PORT_DATA_SET: {
+                PTPState state = state_from_port_state(status.port_state);
+                int64_t now_raw = clock_ns(CLOCK_MONOTONIC_RAW);
+                if (state == PTPState::Slave) {
+                    leave_holdover(now_raw);
+                    set_state(state);
+                    sample_ptp_clock();
+                } else if (!enter_holdover(now_raw)) {
+                    set_state(state);
+                }
+                break;
+            }
+            case PMC_TIME_STATUS_NP:
+                offset_from_master_ = status.master_offset_ns;
+                if (status.gm_present) notify_offset(status.master_offset_ns, path_delay_);
+                break;
+            case PMC_CURRENT_DATA_SET:
+                path_delay_ = status.mean_path_delay_ns;
+                break;
+            default:
+                break;
+        }
+    }
+    
+    // Sandwich-read the disciplined clock against CLOCK_MONOTONIC_RAW and
+    // re-anchor the time scale, with the rate from the previous sample
+    void sample_ptp_clock() {
+        int64_t raw_before = clock_ns(CLOCK_MONOTONIC_RAW);
+        int64_t clock = clock_ns(ptp_clock_);
+        int64_t raw_after = clock_ns(CLOCK_MONOTONIC_RAW);
+        
+        int64_t raw = raw_before + (raw_after - raw_before) / 2;
+        int64_t ptp = clock;
+        if (ptp_clock_ == CLOCK_REALTIME) {
+            // ptp4l keeps the system clock on UTC
+            ptp += static_cast<int64_t>(linuxptp_status_.current_utc_offset) * 1000000000LL;
+        }
+        
+        if (clock_sample_raw_ != 0 && raw > clock_sample_raw_) {
+            double measured = static_cast<double>(ptp - clock_sample_ptp_) /
+                              static_cast<double>(raw - clock_sample_raw_) - 1.0;
+            // A clock step between samples is not a rate
+            if (std::fabs(measured) <= SERVO_MAX_PPB / 1e9) clock_rate_ = measured;
+        }
+        clock_sample_raw_ = raw;
+        clock_sample_ptp_ = ptp;
+        
+        // Until ptp4l locks the clock may not carry PTP time; in holdover
+        // the projection continues on the last rate
+        if (state_ != PTPState::Slave) return;
+        
+        servo_scale_.raw_anchor_ns = raw;
+        servo_scale_.ptp_anchor_ns = ptp;
+        servo_scale_.rate = clock_rate_;
+        servo_scale_.valid = true;
+        holdover_rate_ = clock_rate_;
+        publish_scale(servo_scale_, raw, LINUXPTP_SAMPLE_INTERVAL_NS);
+        frequency_ppb_ = -clock_rate_ * 1e9;
+    }
+    
+    void receive_messages(int fd) {
+        uint8_t buffer[256];
+        alignas(cmsghdr) uint8_t control[256];
+        
         while (running_) {
-            // Poll PTP status (from linuxptp via pmc or shared memory)
-            update_ptp_status();
+            iovec iov{buffer, sizeof(buffer)};
+            msghdr msg{};
+            msg.msg_iov = &iov;
+            msg.msg_iovlen = 1;
+            msg.msg_control = control;
+            msg.msg_controllen = sizeof(control);
+            
+            ssize_t n = recvmsg(fd, &msg, MSG_DONTWAIT);
+            if (n <= 0) return;
+            
+            int64_t rx_raw;
+            int64_t realtime_ns;
+            if (software_timestamp(msg, realtime_ns)) {
+                rx_raw = realtime_to_raw(realtime_ns);
+            } else {
+                rx_raw = clock_ns(CLOCK_MONOTONIC_RAW);
+            }
             
-            // Notify listeners of any changes
-            notify_listeners();
+            PTPMessage message;
+            if (!PTPProtocol::parse(buffer, static_cast<size_t>(n), message)) continue;
+            if (message.domain != config_.domain || message.source_port.clock_id == own_port_.clock_id) continue;
             
-            // Sleep for monitoring interval
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            switch (message.type) {
+                case PTPMessageType::Announce: handle_announce(message, rx_raw); break;
+                case PTPMessageType::Sync: handle_sync(message, rx_raw); break;
+                case PTPMessageType::FollowUp: handle_follow_up(message); break;
+                case PTPMessageType::DelayResp: handle_delay_resp(message); break;
+                default: break;
+            }
+        }
+    }
+    
+    void handle_announce(const PTPMessage& announce, int64_t rx_raw) {
+        auto it = std::find_if(foreign_masters_.begin(), foreign_masters_.end(),
+            [&](const ForeignMaster& fm) { return fm.announce.source_port == announce.source_port; });
+        if (it == foreign_masters_.end()) {
+            foreign_masters_.push_back(ForeignMaster{});
+            it = foreign_masters_.end() - 1;
+        }
+        it->announce = announce;
+        it->previous_raw = it->last_raw;
+        it->last_raw = rx_raw;
+        it->interval_ns = log_interval_ns(announce.log_message_interval,
+                                          static_cast<int64_t>(config_.announce_interval_ms) * 1000000LL);
+        
+        if (announce.source_port == parent_) {
+            std::lock_guard<std::mutex> lock(parent_mutex_);
+            parent_announce_ = announce;
+        }
+        select_master(rx_raw);
+    }
+    
+    // BMCA over qualified foreign masters (heard twice within the window)
+    void select_master(int64_t now_raw) {
+        const ForeignMaster* best = nullptr;
+        for (const auto& fm : foreign_masters_) {
+            int64_t window = FOREIGN_MASTER_WINDOW * fm.interval_ns;
+            bool qualified = fm.previous_raw != 0 && now_raw - fm.previous_raw <= window;
+            if (qualified && (!best || PTPProtocol::compare_announce(fm.announce, best->announce) < 0)) {
+                best = &fm;
+            }
+        }
+        if (!best || best->announce.source_port == parent_) return;
+        
+        LOG_INFO("PTP: master {} (grandmaster {}, class {}, {} steps removed)",
+                 PTPProtocol::clock_identity_to_string(best->announce.source_port.clock_id),
+                 PTPProtocol::clock_identity_to_string(best->announce.grandmaster_identity),
+                 static_cast<int>(best->announce.grandmaster_clock_quality.clock_class),
+                 best->announce.steps_removed);
+        
+        {
+            std::lock_guard<std::mutex> lock(parent_mutex_);
+            parent_ = best->announce.source_port;
+            parent_announce_ = best->announce;
         }
+        servo_.reset();
+        pending_sync_valid_ = false;
+        sync_valid_ = false;
+        delay_valid_ = false;
+        delay_count_ = 0;
+        next_delay_req_raw_ = now_raw;
+        set_state(holdover_start_raw_ != 0 ? PTPState::Holdover : PTPState::Uncalibrated);
     }
     
-    void update_ptp_status() {
-        // In a full implementation, this would:
-        // 1. Read from linuxptp shared memory
-        // 2. Or use pmc tool to query status
-        // 3. Or implement full PTP protocol
+    // Announce receipt timeout and Delay_Req scheduling
+    void check_master(int64_t now_raw) {
+        foreign_masters_.erase(std::remove_if(foreign_masters_.begin(), foreign_masters_.end(),
+            [&](const ForeignMaster& fm) {
+                return now_raw - fm.last_raw > FOREIGN_MASTER_WINDOW * fm.interval_ns;
+            }), foreign_masters_.end());
+        
+        if (parent_.clock_id == 0) return;
+        
+        auto it = std::find_if(foreign_masters_.begin(), foreign_masters_.end(),
+            [&](const ForeignMaster& fm) { return fm.announce.source_port == parent_; });
+        if (it == foreign_masters_.end() ||
+            now_raw - it->last_raw > ANNOUNCE_RECEIPT_TIMEOUT * it->interval_ns) {
+            LOG_WARNING("PTP: announce timeout from master {}",
+                        PTPProtocol::clock_identity_to_string(parent_.clock_id));
+            if (it != foreign_masters_.end()) foreign_masters_.erase(it);
+            {
+                std::lock_guard<std::mutex> lock(parent_mutex_);
+                parent_ = PTPPortIdentity{};
+            }
+            servo_.reset();
+            if (!enter_holdover(now_raw)) set_state(PTPState::Listening);
+            select_master(now_raw);
+            return;
+        }
         
-        // For now, simulate synchronized state after a delay
-        static auto start_time = std::chrono::steady_clock::now();
-        auto elapsed = std::chrono::steady_clock::now() - start_time;
+        if (now_raw >= next_delay_req_raw_) {
+            send_delay_req();
+            next_delay_req_raw_ = now_raw + delay_req_interval_ns_;
+        }
+    }
+    
+    void handle_sync(const PTPMessage& sync, int64_t rx_raw) {
+        if (sync.source_port != parent_) return;
+        sync_interval_ns_ = log_interval_ns(sync.log_message_interval,
+                                            static_cast<int64_t>(config_.sync_interval_ms) * 1000000LL);
+        
+        if (sync.two_step()) {
+            pending_sync_ = sync;
+            pending_sync_raw_ = rx_raw;
+            pending_sync_valid_ = true;
+        } else {
+            process_sync(sync.timestamp.to_ns() + sync.correction_ns(), rx_raw);
+        }
+    }
+    
+    void handle_follow_up(const PTPMessage& follow_up) {
+        if (!pending_sync_valid_ || follow_up.source_port != parent_ ||
+            follow_up.sequence_id != pending_sync_.sequence_id) {
+            return;
+        }
+        pending_sync_valid_ = false;
+        process_sync(follow_up.timestamp.to_ns() + pending_sync_.correction_ns() + follow_up.correction_ns(),
+                     pending_sync_raw_);
+    }
+    
+    void send_delay_req() {
+        PTPMessage request;
+        request.type = PTPMessageType::DelayReq;
+        request.domain = config_.domain;
+        request.source_port = own_port_;
+        request.sequence_id = ++delay_req_sequence_;
+        request.log_message_interval = 0x7F;
+        
+        uint8_t buffer[64];
+        size_t size = PTPProtocol::serialize(request, buffer, sizeof(buffer));
+        
+        // Discard stale transmit timestamps
+        drain_tx_timestamps(0);
+        
+        sockaddr_in destination = destination_;
+        destination.sin_port = htons(config_.event_port);
+        int64_t send_raw = clock_ns(CLOCK_MONOTONIC_RAW);
+        if (sendto(event_fd_, buffer, size, 0, reinterpret_cast<sockaddr*>(&destination),
+                   sizeof(destination)) < 0) {
+            LOG_WARNING("PTP: failed to send Delay_Req: {}", strerror(errno));
+            return;
+        }
+        
+        int64_t tx_raw = drain_tx_timestamps(10);
+        delay_req_raw_ = tx_raw != 0 ? tx_raw : send_raw;
+        delay_req_pending_ = true;
+    }
+    
+    // Read transmit timestamps from the error queue; returns the last one (raw), 0 if none
+    int64_t drain_tx_timestamps(int timeout_ms) {
+        int64_t tx_raw = 0;
+        pollfd pfd{};
+        pfd.fd = event_fd_;
+        pfd.events = POLLPRI;
         
-        if (elapsed > std::chrono::seconds(5) && state_ != PTPState::Slave) {
-            PTPState old_state = state_;
-            state_ = PTPState::Slave;
-            offset_from_master_ = 0;  // Simulated perfect sync
-            path_delay_ = 100.0;  // Simulated path delay in ns
+        while (poll(&pfd, 1, tx_raw == 0 ? timeout_ms : 0) > 0 && (pfd.revents & POLLERR)) {
+            uint8_t data[64];
+            alignas(cmsghdr) uint8_t control[256];
+            iovec iov{data, sizeof(data)};
+            msghdr msg{};
+            msg.msg_iov = &iov;
+            msg.msg_iovlen = 1;
+            msg.msg_control = control;
+            msg.msg_controllen = sizeof(control);
+            if (recvmsg(event_fd_, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) break;
             
-            if (old_state != state_) {
-                LOG_INFO("PTP state changed: {} -> {}", 
-                        state_to_string(old_state), state_to_string(state_));
+            int64_t realtime_ns;
+            if (software_timestamp(msg, realtime_ns)) {
+                tx_raw = realtime_to_raw(realtime_ns);
             }
         }
+        return tx_raw;
     }
     
-    void notify_listeners() {
+    void handle_delay_resp(const PTPMessage& response) {
+        if (!delay_req_pending_ || response.source_port != parent_ ||
+            response.requesting_port != own_port_ || response.sequence_id != delay_req_sequence_) {
+            return;
+        }
+        delay_req_pending_ = false;
+        delay_req_interval_ns_ = log_interval_ns(response.log_message_interval, 1000000000LL);
+        if (!sync_valid_) return;
+        
+        // meanPathDelay = ((t2 - t1) + (t4 - t3)) / 2, with the local interval
+        // t3 - t2 measured on the steered time scale
+        int64_t t4 = response.timestamp.to_ns() - response.correction_ns();
+        int64_t local_interval = local_time(delay_req_raw_) - local_time(sync_t2_raw_);
+        double delay = static_cast<double>((t4 - sync_t1_) - local_interval) / 2.0;
+        
+        delay_history_[delay_count_ % DELAY_FILTER_LENGTH] = delay;
+        delay_count_++;
+        size_t count = std::min(delay_count_, DELAY_FILTER_LENGTH);
+        std::array<double, DELAY_FILTER_LENGTH> sorted{};
+        std::copy(delay_history_.begin(), delay_history_.begin() + count, sorted.begin());
+        std::nth_element(sorted.begin(), sorted.begin() + count / 2, sorted.begin() + count);
+        path_delay_ = std::max(sorted[count / 2], 0.0);
+        delay_valid_ = true;
+    }
+    
+    void process_sync(int64_t t1, int64_t t2_raw) {
+        sync_t1_ = t1;
+        sync_t2_raw_ = t2_raw;
+        sync_valid_ = true;
+        if (!delay_valid_) return;
+        
+        int64_t delay = std::llround(path_delay_.load());
+        int64_t master_time = t1 + delay;
+        int64_t offset = 0;
+        if (servo_scale_.valid) {
+            offset = servo_scale_.at(t2_raw) - master_time;
+        }
+        
+        auto action = servo_.sample(offset, t2_raw, static_cast<double>(sync_interval_ns_) / 1e9);
+        int64_t now_raw = clock_ns(CLOCK_MONOTONIC_RAW);
+        double rate = -servo_.frequency_ppb() / 1e9;
+        if (action == PIServo::Action::Step) {
+            servo_scale_.raw_anchor_ns = t2_raw;
+            servo_scale_.ptp_anchor_ns = master_time;
+        } else {
+            servo_scale_.ptp_anchor_ns = servo_scale_.at(now_raw);
+            servo_scale_.raw_anchor_ns = now_raw;
+        }
+        servo_scale_.rate = rate;
+        servo_scale_.valid = true;
+        holdover_rate_ = -servo_.drift_ppb() / 1e9;
+        
+        offset_from_master_ = offset;
+        frequency_ppb_ = servo_.frequency_ppb();
+        
+        if (action == PIServo::Action::Step) {
+            LOG_DEBUG("PTP: servo stepped by {} ns, frequency {} ppb", -offset,
+                      std::llround(frequency_ppb_.load()));
+            set_state(holdover_start_raw_ != 0 ? PTPState::Holdover : PTPState::Uncalibrated);
+        } else {
+            leave_holdover(now_raw);
+            set_state(PTPState::Slave);
+        }
+        publish_scale(servo_scale_, now_raw, sync_interval_ns_);
+        notify_offset(offset, path_delay_);
+    }
+    
+    int64_t local_time(int64_t raw_ns) const {
+        return servo_scale_.valid ? servo_scale_.at(raw_ns) : raw_ns;
+    }
+#endif
+    
+    bool has_valid_time(int64_t now_raw) const {
+        if (state_ == PTPState::Slave) return true;
+        int64_t start = holdover_start_raw_;
+        return start != 0 &&
+               now_raw - start <= static_cast<int64_t>(config_.holdover_timeout_s) * 1000000000LL;
+    }
+    
+    // Publish the servo's time scale. Once time is valid the published
+    // scale stays continuous: differences are slewed in over the next
+    // update at no more than slew_max_ppm, and stepped only beyond
+    // slew_max_offset_ns.
+    void publish_scale(const PTPTimeScale& target, int64_t now_raw, int64_t horizon_ns) {
+        PTPTimeScale current = scale_.load();
+        if (current.valid && has_valid_time(now_raw)) {
+            int64_t error = target.at(now_raw) - current.at(now_raw);
+            if (std::llabs(error) <= config_.slew_max_offset_ns) {
+                double max_slew = config_.slew_max_ppm / 1e6;
+                double correction = static_cast<double>(error) / static_cast<double>(std::max<int64_t>(horizon_ns, 1));
+                PTPTimeScale scale;
+                scale.raw_anchor_ns = now_raw;
+                scale.ptp_anchor_ns = current.at(now_raw);
+                scale.rate = target.rate + std::clamp(correction, -max_slew, max_slew);
+                scale.valid = true;
+                scale_.store(scale);
+                slew_error_ns_ = std::llabs(error);
+                return;
+            }
+            LOG_WARNING("PTP: time is {} ns from the master, beyond the slew limit; stepping", error);
+        }
+        scale_.store(target);
+        slew_error_ns_ = 0;
+    }
+    
+    // Master lost while time was valid: keep projecting on the servo's
+    // frequency. Returns false if there is no valid time to hold.
+    bool enter_holdover(int64_t now_raw) {
+        if (holdover_start_raw_ != 0) return true;
+        if (state_ != PTPState::Slave) return false;
+        
+        // Drop any slew in progress and the servo's proportional term
+        PTPTimeScale current = scale_.load();
+        PTPTimeScale scale;
+        scale.raw_anchor_ns = now_raw;
+        scale.ptp_anchor_ns = current.at(now_raw);
+        scale.rate = holdover_rate_;
+        scale.valid = true;
+        scale_.store(scale);
+        
+        holdover_offset_ns_ = std::llabs(offset_from_master_.load()) + slew_error_ns_;
+        holdover_start_raw_ = now_raw;
+        LOG_WARNING("PTP: master lost, holding over at {} ppb", std::llround(-holdover_rate_ * 1e9));
+        set_state(PTPState::Holdover);
+        return true;
+    }
+    
+    void leave_holdover(int64_t now_raw) {
+        int64_t start = holdover_start_raw_.exchange(0);
+        if (start == 0) return;
+        
+        PTPTimeScale current = scale_.load();
+        int64_t error = servo_scale_.at(now_raw) - current.at(now_raw);
+        LOG_INFO("PTP: holdover ended after {} ms, {} ns to slew", (now_raw - start) / 1000000, error);
+    }
+    
+    void check_holdover(int64_t now_raw) {
+        if (holdover_start_raw_ != 0 && !has_valid_time(now_raw)) {
+            LOG_WARNING("PTP: holdover expired after {} s", config_.holdover_timeout_s);
+            holdover_start_raw_ = 0;
+            set_state(PTPState::Listening);
+        }
+    }
+    
+    void set_state(PTPState state) {
+        PTPState old_state = state_.exchange(state);
+        if (old_state == state) return;
+        
+        LOG_INFO("PTP state changed: {} -> {}", 
+                state_to_string(old_state), state_to_string(state));
+        
         std::lock_guard<std::mutex> lock(listeners_mutex_);
         for (auto* listener : listeners_) {
-            listener->on_ptp_state_changed(state_);
-            listener->on_ptp_offset_update(offset_from_master_, path_delay_);
+            listener->on_ptp_state_changed(state);
+        }
+    }
+    
+    void notify_offset(int64_t offset_ns, double path_delay_ns) {
+        std::lock_guard<std::mutex> lock(listeners_mutex_);
+        for (auto* listener : listeners_) {
+            listener->on_ptp_offset_update(offset_ns, path_delay_ns);
         }
     }
     
@@ -195,14 +1046,65 @@ private:
     
     std::thread monitor_thread_;
     
+#ifdef __linux__
+    int event_fd_ = -1;
+    int general_fd_ = -1;
+    sockaddr_in destination_{};
+    bool multicast_ = true;
+#endif
+    PTPPortIdentity own_port_;
+    
+    // linuxptp backend (protocol thread only)
+    bool use_linuxptp_ = false;
+    LinuxPTPClient linuxptp_;
+    LinuxPTPStatus linuxptp_status_;
+#ifdef __linux__
+    int phc_fd_ = -1;
+    clockid_t ptp_clock_ = CLOCK_REALTIME;
+#endif
+    int64_t clock_sample_raw_ = 0;
+    int64_t clock_sample_ptp_ = 0;
+    double clock_rate_ = 0.0;
+    
+    // Master selection (protocol thread; parent data also read by get_clock_info)
+    std::vector<ForeignMaster> foreign_masters_;
+    mutable std::mutex parent_mutex_;
+    PTPPortIdentity parent_;
+    PTPMessage parent_announce_;
+    
+    // Sync / delay measurement (protocol thread only)
+    PTPMessage pending_sync_;
+    int64_t pending_sync_raw_ = 0;
+    bool pending_sync_valid_ = false;
+    int64_t sync_t1_ = 0;
+    int64_t sync_t2_raw_ = 0;
+    bool sync_valid_ = false;
+    int64_t sync_interval_ns_ = 125000000;
+    uint16_t delay_req_sequence_ = 0;
+    int64_t delay_req_raw_ = 0;
+    bool delay_req_pending_ = false;
+    int64_t next_delay_req_raw_ = 0;
+    int64_t delay_req_interval_ns_ = 1000000000LL;
+    std::array<double, DELAY_FILTER_LENGTH> delay_history_{};
+    size_t delay_count_ = 0;
+    bool delay_valid_ = false;
+    
+    // Servo and the time scale it steers (protocol thread only), and the
+    // continuous scale published from it, read lock-free from any thread
+    PIServo servo_;
+    PTPTimeScale servo_scale_;
+    SeqLock<PTPTimeScale> scale_;
+    std::atomic<int64_t> slew_error_ns_{0};
+    
+    // Holdover: raw time the master was lost (0 = not in holdover)
+    std::atomic<int64_t> holdover_start_raw_{0};
+    std::atomic<int64_t> holdover_offset_ns_{0};    // Stored before holdover_start_raw_
+    double holdover_rate_ = 0.0;
+    
     // PTP state
     std::atomic<int64_t> offset_from_master_{0};
     std::atomic<double> path_delay_{0.0};
-    uint64_t clock_id_ = 0;
-    uint8_t priority1_ = 128;
-    uint8_t priority2_ = 128;
-    uint8_t clock_class_ = 248;
-    uint8_t clock_accuracy_ = 0xFE;
+    std::atomic<double> frequency_ppb_{0.0};
     
     // Listeners
     std::mutex listeners_mutex_;
@@ -229,11 +1131,26 @@ void PTPSync::start() { impl_->start(); }
 void PTPSync::stop() { impl_->stop(); }
 bool PTPSync::is_running() const { return impl_->is_running(); }
 bool PTPSync::is_synchronized() const { return impl_->is_synchronized(); }
+bool PTPSync::has_valid_time() const { return impl_->has_valid_time(); }
+int64_t PTPSync::get_time_uncertainty_ns() const { return impl_->get_time_uncertainty_ns(); }
 
 std::chrono::nanoseconds PTPSync::get_current_time() const {
     return impl_->get_current_time();
 }
 
+PTPTimeScale PTPSync::get_time_scale() const {
+    return impl_->get_time_scale();
+}
+
+int64_t PTPSync::monotonic_raw_ns() {
+#ifdef __linux__
+    return clock_ns(CLOCK_MONOTONIC_RAW);
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
 uint64_t PTPSync::get_ptp_timestamp() const {
     return impl_->get_ptp_timestamp();
 }
@@ -278,44 +1195,35 @@ std::string PTPSync::state_to_string(PTPState state) {
         case PTPState::Slave: return "Slave";
         case PTPState::Passive: return "Passive";
         case PTPState::Faulty: return "Faulty";
+        case PTPState::Holdover: return "Holdover";
         default: return "Unknown";
     }
 }
 
 // ==================== LocalClock ====================
 
-LocalClock::LocalClock() 
-    : calibrated_(false)
-    , offset_ns_(0)
-    , calibration_time_() {}
-
+LocalClock::LocalClock() = default;
 LocalClock::~LocalClock() = default;
 
 void LocalClock::calibrate(const PTPSync& ptp_sync) {
-    if (!ptp_sync.is_synchronized()) {
+    if (!ptp_sync.has_valid_time()) {
         return;
     }
     
-    auto ptp_time = ptp_sync.get_current_time();
-    auto local_time = std::chrono::steady_clock::now();
-    auto local_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
-        local_time.time_since_epoch());
-    
-    offset_ns_ = ptp_time.count() - local_ns.count();
-    calibration_time_ = local_time;
-    calibrated_ = true;
+    PTPTimeScale scale = ptp_sync.get_time_scale();
+    if (scale.valid) {
+        scale_.store(scale);
+    }
 }
 
 bool LocalClock::is_calibrated() const {
-    return calibrated_;
+    return scale_.load().valid;
 }
 
 std::chrono::nanoseconds LocalClock::now() const {
-    auto local_time = std::chrono::steady_clock::now();
-    auto local_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
-        local_time.time_since_epoch());
-    
-    return std::chrono::nanoseconds(local_ns.count() + offset_ns_);
+    int64_t raw_ns = PTPSync::monotonic_raw_ns();
+    PTPTimeScale scale = scale_.load();
+    return std::chrono::nanoseconds(scale.valid ? scale.at(raw_ns) : raw_ns);
 }
 
 uint32_t LocalClock::to_rtp_timestamp(uint32_t sample_rate) const {
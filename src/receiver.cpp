@@ -8,14 +8,20 @@
 
 #include "rpi_aes67/receiver.h"
 #include "rpi_aes67/logger.h"
+#include "rpi_aes67/media_clock.h"
+#include "rpi_aes67/pcm_codec.h"
+#include "rpi_aes67/receiver_engine.h"
+#include "rpi_aes67/uring_receive_ring.h"
+#include "rpi_aes67/packet_ring.h"
 #include <thread>
 #include <mutex>
 #include <condition_variable>
-#include <sstream>
-#include <regex>
 #include <cstring>
 #include <queue>
 #include <map>
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
 
 #ifdef __linux__
 #include <sys/socket.h>
@@ -23,6 +29,14 @@
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <sys/epoll.h>
+#include <sys/uio.h>
+#include <linux/filter.h>
+#include <fcntl.h>
+#include <sys/time.h>
+#include <time.h>
 #endif
 
 namespace rpi_aes67 {
@@ -40,94 +54,407 @@ struct RTPHeader {
     uint32_t ssrc;
 };
 
+// Receive slot size: one Ethernet MTU datagram with headroom
+constexpr size_t RX_SLOT_SIZE = 2048;
+// Receive calls per engine wakeup before yielding to other streams on the worker
+constexpr int ENGINE_RX_CALLS = 4;
+// Playout blocks per engine wakeup before yielding
+constexpr int ENGINE_PLAYOUT_STEPS = 16;
+
+#ifdef __linux__
+// Ancillary data space per datagram (SCM_TIMESTAMPNS)
+constexpr size_t RX_CONTROL_SIZE = CMSG_SPACE(sizeof(timespec));
+
+/**
+ * Maps kernel receive timestamps (CLOCK_REALTIME) onto steady_clock.
+ * Both clocks are sampled once per wakeup; the difference between the
+ * realtime sample and a packet's kernel timestamp is how long the packet
+ * waited in the socket before user space saw it.
+ */
+struct ArrivalClock {
+    timespec realtime_now;
+    std::chrono::steady_clock::time_point steady_now;
+    
+    static ArrivalClock sample() {
+        ArrivalClock clock{};
+        clock_gettime(CLOCK_REALTIME, &clock.realtime_now);
+        clock.steady_now = std::chrono::steady_clock::now();
+        return clock;
+    }
+    
+    [[nodiscard]] int64_t delay_ns(const timespec& kernel_ts) const {
+        return (static_cast<int64_t>(realtime_now.tv_sec) - kernel_ts.tv_sec) * 1000000000LL +
+               (static_cast<int64_t>(realtime_now.tv_nsec) - kernel_ts.tv_nsec);
+    }
+    
+    [[nodiscard]] double delay_us(const timespec& kernel_ts) const {
+        return static_cast<double>(delay_ns(kernel_ts)) / 1000.0;
+    }
+    
+    [[nodiscard]] std::chrono::steady_clock::time_point to_steady(const timespec& kernel_ts) const {
+        return steady_now - std::chrono::nanoseconds(std::max<int64_t>(delay_ns(kernel_ts), 0));
+    }
+};
+#endif
+
 // ==================== JitterBuffer::Impl ====================
 
 class JitterBuffer::Impl {
 public:
-    Impl() = default;
-    explicit Impl(const Config& config) : config_(config) {}
+    Impl() : Impl(Config{}) {}
     
-    bool push(const uint8_t* data, size_t size, uint16_t sequence, uint32_t timestamp) {
-        std::lock_guard<std::mutex> lock(mutex_);
+    explicit Impl(const Config& config) : config_(config) {
+        if (config_.sample_rate == 0) config_.sample_rate = 48000;
+        if (config_.bytes_per_frame == 0) config_.bytes_per_frame = 1;
         
-        if (packets_.size() >= config_.max_packets) {
-            // Buffer full, drop oldest
-            packets_.erase(packets_.begin());
+        // Capacity is bounded in time, not packets
+        uint32_t max_ms = std::max(config_.max_delay_ms, config_.target_delay_ms * 2);
+        uint64_t frames = static_cast<uint64_t>(config_.sample_rate) * max_ms / 1000;
+        capacity_ = 64;
+        while (capacity_ < frames && capacity_ < (1u << 24)) {
+            capacity_ <<= 1;
         }
+        mask_ = capacity_ - 1;
+        target_frames_ = std::min<uint32_t>(
+            static_cast<uint32_t>(static_cast<uint64_t>(config_.sample_rate) *
+                                  config_.target_delay_ms / 1000),
+            capacity_ / 2);
+        
+        samples_.reset(new uint8_t[static_cast<size_t>(capacity_) * config_.bytes_per_frame]());
+        tags_.reset(new std::atomic<uint32_t>[capacity_]);
+        clear_tags();
+
+#ifdef __linux__
+        event_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+#endif
+    }
+    
+    ~Impl() {
+#ifdef __linux__
+        if (event_fd_ >= 0) {
+            close(event_fd_);
+        }
+#endif
+    }
+    
+    bool push(const uint8_t* data, size_t size, uint16_t /*sequence*/, uint32_t timestamp,
+              std::chrono::steady_clock::time_point arrival) {
+        const uint32_t bpf = config_.bytes_per_frame;
+        uint32_t frames = static_cast<uint32_t>(size / bpf);
+        if (frames == 0 || frames > capacity_) return false;
+        
+        // First packet (or a timeline discontinuity) anchors the playout position
+        uint32_t epoch = epoch_.load(std::memory_order_relaxed);
+        if (epoch == 0) {
+            anchor(timestamp);
+            epoch = epoch_.load(std::memory_order_relaxed);
+        }
+        uint32_t base = adopted_epoch_.load(std::memory_order_acquire) == epoch
+                            ? read_ts_.load(std::memory_order_acquire)
+                            : anchor_ts_.load(std::memory_order_relaxed);
+        
+        int32_t offset = static_cast<int32_t>(timestamp - base);
+        int64_t end = static_cast<int64_t>(offset) + frames;
+        if (end > static_cast<int64_t>(capacity_) * 2 ||
+            offset < -static_cast<int32_t>(capacity_) * 2) {
+            // Far outside the window: sender restarted or jumped, re-anchor
+            anchor(timestamp);
+            offset = 0;
+            end = frames;
+        } else if (end <= 0) {
+            return false;  // Entirely late, its playout time has passed
+        } else if (end > static_cast<int64_t>(capacity_)) {
+            overruns_.fetch_add(1, std::memory_order_relaxed);
+            return false;  // Would overwrite frames not yet played
+        }
+        
+        // Skip the part of a straddling packet that is already late
+        uint32_t skip = offset < 0 ? static_cast<uint32_t>(-offset) : 0;
+        uint32_t ts = timestamp + skip;
+        uint32_t count = frames - skip;
+        data += static_cast<size_t>(skip) * bpf;
         
-        Packet pkt;
-        pkt.data.assign(data, data + size);
-        pkt.sequence = sequence;
-        pkt.timestamp = timestamp;
-        pkt.arrival_time = std::chrono::steady_clock::now();
+        // Duplicates carry identical samples, no need to rewrite them
+        if (tags_[ts & mask_].load(std::memory_order_relaxed) == ts &&
+            tags_[(ts + count - 1) & mask_].load(std::memory_order_relaxed) == ts + count - 1) {
+            return false;
+        }
         
-        // Insert in order by timestamp
-        auto it = packets_.begin();
-        while (it != packets_.end() && it->timestamp < timestamp) {
-            ++it;
+        // Copy straight to the timeline position, splitting at the ring end
+        uint32_t slot = ts & mask_;
+        uint32_t first = std::min(count, capacity_ - slot);
+        std::memcpy(samples_.get() + static_cast<size_t>(slot) * bpf, data,
+                    static_cast<size_t>(first) * bpf);
+        if (first < count) {
+            std::memcpy(samples_.get(), data + static_cast<size_t>(first) * bpf,
+                        static_cast<size_t>(count - first) * bpf);
+        }
+        for (uint32_t i = 0; i < count; ++i) {
+            tags_[(ts + i) & mask_].store(ts + i, std::memory_order_release);
         }
-        packets_.insert(it, std::move(pkt));
         
+        // Advance the newest written position (wrap-aware maximum)
+        uint32_t write_end = ts + count;
+        uint32_t current = write_ts_.load(std::memory_order_relaxed);
+        if (static_cast<int32_t>(write_end - current) > 0) {
+            last_arrival_ns_.store(arrival.time_since_epoch().count(), std::memory_order_relaxed);
+            write_ts_.store(write_end, std::memory_order_release);
+            
+            // Pairs with the fence in wait(): either the consumer sees the new
+            // write position or we see it waiting
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (waiting_.load(std::memory_order_relaxed) &&
+                waiting_.exchange(false, std::memory_order_relaxed)) {
+                signal();
+            }
+        }
         return true;
     }
     
+    bool wait(std::chrono::milliseconds timeout) {
+        if (arm_wait()) return true;
+
+#ifdef __linux__
+        if (event_fd_ >= 0) {
+            pollfd pfd{};
+            pfd.fd = event_fd_;
+            pfd.events = POLLIN;
+            int result = ::poll(&pfd, 1, static_cast<int>(timeout.count()));
+            waiting_.store(false, std::memory_order_relaxed);
+            if (result > 0) {
+                uint64_t value;
+                ssize_t n = ::read(event_fd_, &value, sizeof(value));
+                (void)n;
+            }
+            return consume_progress() || result > 0;
+        }
+#endif
+        std::this_thread::sleep_for(timeout);
+        waiting_.store(false, std::memory_order_relaxed);
+        return consume_progress();
+    }
+    
+    void wake() { signal(); }
+    
+    int event_fd() const {
+#ifdef __linux__
+        return event_fd_;
+#else
+        return -1;
+#endif
+    }
+    
+    bool arm_wait() {
+        waiting_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        
+        if (consume_progress()) {
+            waiting_.store(false, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+    
     bool pop(uint8_t* data, size_t max_size, size_t& size, uint32_t& timestamp) {
-        std::lock_guard<std::mutex> lock(mutex_);
+        size = 0;
+        if (!adopt_anchor()) return false;
         
-        if (packets_.empty()) {
+        uint32_t read_ts = read_ts_.load(std::memory_order_relaxed);
+        int32_t available = static_cast<int32_t>(
+            write_ts_.load(std::memory_order_acquire) - read_ts);
+        
+        // Build up the target delay before starting (or restarting) playout
+        if (!primed_) {
+            if (available < static_cast<int32_t>(target_frames_)) return false;
+            primed_ = true;
+        }
+        
+        if (available <= 0) {
+            // Caught up with the producer; only a stall longer than the
+            // target delay has drained the output and needs re-priming
+            std::chrono::steady_clock::time_point newest{std::chrono::steady_clock::duration(
+                last_arrival_ns_.load(std::memory_order_relaxed))};
+            if (std::chrono::steady_clock::now() - newest >
+                std::chrono::milliseconds(config_.target_delay_ms)) {
+                primed_ = false;
+                underruns_.fetch_add(1, std::memory_order_relaxed);
+            }
             return false;
         }
         
-        // Check if we should wait for more packets (jitter buffer delay)
-        auto now = std::chrono::steady_clock::now();
-        auto first_arrival = packets_.front().arrival_time;
-        auto delay = std::chrono::duration_cast<std::chrono::milliseconds>(
-            now - first_arrival).count();
+        uint32_t frames = std::min(static_cast<uint32_t>(available),
+                                   static_cast<uint32_t>(max_size / config_.bytes_per_frame));
+        if (frames == 0) return false;
+        
+        read_frames(read_ts, data, frames);
+        read_ts_.store(read_ts + frames, std::memory_order_release);
         
-        if (delay < config_.target_delay_ms && packets_.size() < 3) {
-            return false;  // Wait for more buffering
+        size = static_cast<size_t>(frames) * config_.bytes_per_frame;
+        timestamp = read_ts;
+        return true;
+    }
+    
+    bool read(uint32_t timestamp, uint8_t* data, uint32_t frames) {
+        if (!adopt_anchor()) {
+            std::memset(data, 0, static_cast<size_t>(frames) * config_.bytes_per_frame);
+            return false;
         }
         
-        const auto& pkt = packets_.front();
-        size = std::min(max_size, pkt.data.size());
-        std::memcpy(data, pkt.data.data(), size);
-        timestamp = pkt.timestamp;
+        // Tags identify each frame exactly, so any position can be read
+        read_frames(timestamp, data, frames);
+        bool present = false;
+        for (uint32_t i = 0; i < frames && !present; ++i) {
+            present = tags_[(timestamp + i) & mask_].load(std::memory_order_relaxed) == timestamp + i;
+        }
+        read_ts_.store(timestamp + frames, std::memory_order_release);
         
-        packets_.erase(packets_.begin());
-        return true;
+        if (present) {
+            primed_ = true;
+        } else if (primed_) {
+            primed_ = false;
+            underruns_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return present;
     }
     
     double get_level() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return static_cast<double>(packets_.size()) / config_.max_packets;
+        return static_cast<double>(buffered_frames()) / capacity_;
     }
     
     double get_latency_ms() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (packets_.empty()) return 0.0;
+        uint32_t buffered = buffered_frames();
+        if (buffered == 0) return 0.0;
         
-        auto now = std::chrono::steady_clock::now();
-        auto delay = std::chrono::duration_cast<std::chrono::milliseconds>(
-            now - packets_.front().arrival_time).count();
-        return static_cast<double>(delay);
+        // Age of the newest frame plus the media time queued ahead of it
+        std::chrono::steady_clock::time_point newest{std::chrono::steady_clock::duration(
+            last_arrival_ns_.load(std::memory_order_relaxed))};
+        double age_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - newest).count();
+        return std::max(age_ms, 0.0) + static_cast<double>(buffered) * 1000.0 / config_.sample_rate;
     }
     
+    uint32_t get_capacity_frames() const { return capacity_; }
+    uint64_t get_overruns() const { return overruns_.load(std::memory_order_relaxed); }
+    uint64_t get_underruns() const { return underruns_.load(std::memory_order_relaxed); }
+    
     void reset() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        packets_.clear();
+        clear_tags();
+        std::memset(samples_.get(), 0, static_cast<size_t>(capacity_) * config_.bytes_per_frame);
+        epoch_.store(0, std::memory_order_relaxed);
+        adopted_epoch_.store(0, std::memory_order_relaxed);
+        read_ts_.store(0, std::memory_order_relaxed);
+        write_ts_.store(0, std::memory_order_relaxed);
+        primed_ = false;
     }
     
 private:
-    struct Packet {
-        std::vector<uint8_t> data;
-        uint16_t sequence;
-        uint32_t timestamp;
-        std::chrono::steady_clock::time_point arrival_time;
-    };
+    // Producer side: publish a new timeline origin for the consumer to adopt
+    void anchor(uint32_t timestamp) {
+        anchor_ts_.store(timestamp, std::memory_order_relaxed);
+        write_ts_.store(timestamp, std::memory_order_relaxed);
+        uint32_t next = epoch_.load(std::memory_order_relaxed) + 1;
+        epoch_.store(next == 0 ? 1 : next, std::memory_order_release);
+    }
+    
+    // Consumer side: follow the producer onto a new timeline
+    bool adopt_anchor() {
+        uint32_t epoch = epoch_.load(std::memory_order_acquire);
+        if (epoch == 0) return false;
+        if (epoch != adopted_epoch_.load(std::memory_order_relaxed)) {
+            read_ts_.store(anchor_ts_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            primed_ = false;
+            adopted_epoch_.store(epoch, std::memory_order_release);
+        }
+        return true;
+    }
+    
+    // Copy frames [ts, ts + frames), substituting silence for frames not received
+    void read_frames(uint32_t ts, uint8_t* out, uint32_t frames) const {
+        const uint32_t bpf = config_.bytes_per_frame;
+        uint32_t i = 0;
+        while (i < frames) {
+            bool valid = tags_[(ts + i) & mask_].load(std::memory_order_acquire) == ts + i;
+            uint32_t run = 1;
+            while (i + run < frames && ((ts + i + run) & mask_) != 0 &&
+                   (tags_[(ts + i + run) & mask_].load(std::memory_order_acquire) == ts + i + run) == valid) {
+                ++run;
+            }
+            uint8_t* dst = out + static_cast<size_t>(i) * bpf;
+            if (valid) {
+                std::memcpy(dst, samples_.get() + static_cast<size_t>((ts + i) & mask_) * bpf,
+                            static_cast<size_t>(run) * bpf);
+            } else {
+                std::memset(dst, 0, static_cast<size_t>(run) * bpf);
+            }
+            i += run;
+        }
+    }
+    
+    // Consumer side: has push() advanced since the last wait()?
+    bool consume_progress() {
+        uint32_t write_ts = write_ts_.load(std::memory_order_acquire);
+        uint32_t epoch = epoch_.load(std::memory_order_acquire);
+        if (write_ts == seen_write_ts_ && epoch == seen_epoch_) return false;
+        seen_write_ts_ = write_ts;
+        seen_epoch_ = epoch;
+        return true;
+    }
+    
+    void signal() {
+#ifdef __linux__
+        if (event_fd_ >= 0) {
+            uint64_t one = 1;
+            ssize_t n = ::write(event_fd_, &one, sizeof(one));
+            (void)n;
+        }
+#endif
+    }
+    
+    uint32_t buffered_frames() const {
+        if (epoch_.load(std::memory_order_acquire) == 0) return 0;
+        int32_t buffered = static_cast<int32_t>(write_ts_.load(std::memory_order_acquire) -
+                                                read_ts_.load(std::memory_order_acquire));
+        if (buffered <= 0) return 0;
+        return std::min(static_cast<uint32_t>(buffered), capacity_);
+    }
+    
+    void clear_tags() {
+        // A slot only ever holds timestamps congruent to its index, so
+        // index + 1 can never match a real frame
+        for (uint32_t i = 0; i < capacity_; ++i) {
+            tags_[i].store(i + 1, std::memory_order_relaxed);
+        }
+    }
     
     Config config_;
-    mutable std::mutex mutex_;
-    std::vector<Packet> packets_;
+    uint32_t capacity_ = 0;
+    uint32_t mask_ = 0;
+    uint32_t target_frames_ = 0;
+    
+    std::unique_ptr<uint8_t[]> samples_;
+    std::unique_ptr<std::atomic<uint32_t>[]> tags_;  // RTP timestamp held by each slot
+    
+    // Timeline anchoring (written by producer, adopted by consumer)
+    std::atomic<uint32_t> epoch_{0};
+    std::atomic<uint32_t> adopted_epoch_{0};
+    std::atomic<uint32_t> anchor_ts_{0};
+    
+    alignas(64) std::atomic<uint32_t> write_ts_{0};  // Producer: one past newest frame
+    alignas(64) std::atomic<uint32_t> read_ts_{0};   // Consumer: next frame to play
+    bool primed_ = false;                           // Consumer only
+    
+    // Consumer wakeup: producer signals the eventfd only while waiting_ is set
+    alignas(64) std::atomic<bool> waiting_{false};
+    uint32_t seen_write_ts_ = 0;                    // Consumer only
+    uint32_t seen_epoch_ = 0;                       // Consumer only
+#ifdef __linux__
+    int event_fd_ = -1;
+#endif
+    
+    std::atomic<int64_t> last_arrival_ns_{0};        // Arrival of the newest frame
+    
+    std::atomic<uint64_t> overruns_{0};
+    std::atomic<uint64_t> underruns_{0};
 };
 
 // ==================== JitterBuffer ====================
@@ -137,133 +464,33 @@ JitterBuffer::JitterBuffer(const Config& config) : impl_(std::make_unique<Impl>(
 JitterBuffer::~JitterBuffer() = default;
 
 bool JitterBuffer::push(const uint8_t* data, size_t size, uint16_t sequence, uint32_t timestamp) {
-    return impl_->push(data, size, sequence, timestamp);
+    return impl_->push(data, size, sequence, timestamp, std::chrono::steady_clock::now());
+}
+
+bool JitterBuffer::push(const uint8_t* data, size_t size, uint16_t sequence, uint32_t timestamp,
+                        std::chrono::steady_clock::time_point arrival) {
+    return impl_->push(data, size, sequence, timestamp, arrival);
 }
 
 bool JitterBuffer::pop(uint8_t* data, size_t max_size, size_t& size, uint32_t& timestamp) {
     return impl_->pop(data, max_size, size, timestamp);
 }
 
-double JitterBuffer::get_level() const { return impl_->get_level(); }
-double JitterBuffer::get_latency_ms() const { return impl_->get_latency_ms(); }
-void JitterBuffer::reset() { impl_->reset(); }
-
-// ==================== SDPParser ====================
-
-SDPInfo SDPParser::parse(const std::string& sdp) {
-    SDPInfo info;
-    std::istringstream stream(sdp);
-    std::string line;
-    
-    while (std::getline(stream, line)) {
-        // Remove carriage return if present
-        if (!line.empty() && line.back() == '\r') {
-            line.pop_back();
-        }
-        
-        if (line.empty()) continue;
-        
-        // Session name
-        if (line.substr(0, 2) == "s=") {
-            info.session_name = line.substr(2);
-        }
-        // Origin
-        else if (line.substr(0, 2) == "o=") {
-            // o=<username> <session-id> <session-version> IN IP4 <address>
-            std::regex origin_regex(R"(o=\S+\s+(\d+)\s+\d+\s+IN\s+IP4\s+(\S+))");
-            std::smatch matches;
-            if (std::regex_search(line, matches, origin_regex)) {
-                info.session_id = matches[1];
-                info.origin_address = matches[2];
-            }
-        }
-        // Connection information
-        else if (line.substr(0, 2) == "c=") {
-            std::regex conn_regex(R"(c=IN\s+IP4\s+([0-9.]+))");
-            std::smatch matches;
-            if (std::regex_search(line, matches, conn_regex)) {
-                info.source_ip = matches[1];
-            }
-        }
-        // Media description
-        else if (line.substr(0, 2) == "m=") {
-            std::regex media_regex(R"(m=audio\s+(\d+)\s+RTP/AVP\s+(\d+))");
-            std::smatch matches;
-            if (std::regex_search(line, matches, media_regex)) {
-                info.port = static_cast<uint16_t>(std::stoi(matches[1]));
-                info.payload_type = static_cast<uint8_t>(std::stoi(matches[2]));
-            }
-        }
-        // RTP map
-        else if (line.substr(0, 9) == "a=rtpmap:") {
-            std::regex rtpmap_regex(R"(a=rtpmap:(\d+)\s+(\w+)/(\d+)/(\d+))");
-            std::smatch matches;
-            if (std::regex_search(line, matches, rtpmap_regex)) {
-                info.encoding = matches[2];
-                info.format.sample_rate = static_cast<uint32_t>(std::stoi(matches[3]));
-                info.format.channels = static_cast<uint8_t>(std::stoi(matches[4]));
-                
-                // Determine bit depth from encoding
-                if (info.encoding == "L16") {
-                    info.format.bit_depth = 16;
-                } else if (info.encoding == "L24") {
-                    info.format.bit_depth = 24;
-                } else if (info.encoding == "L32") {
-                    info.format.bit_depth = 32;
-                }
-            }
-        }
-        // Packet time
-        else if (line.substr(0, 8) == "a=ptime:") {
-            double ptime = std::stod(line.substr(8));
-            info.packet_time_us = static_cast<uint32_t>(ptime * 1000);
-        }
-        // PTP clock reference
-        else if (line.substr(0, 12) == "a=ts-refclk:") {
-            if (line.find("ptp=IEEE1588") != std::string::npos) {
-                // Extract PTP clock ID if present
-                std::regex ptp_regex(R"(ptp=IEEE1588-\d+:([0-9A-Fa-f:-]+))");
-                std::smatch matches;
-                if (std::regex_search(line, matches, ptp_regex)) {
-                    info.ptp_clock_id = matches[1];
-                }
-            }
-        }
-    }
-    
-    // Validate
-    info.is_valid = !info.source_ip.empty() && info.port > 0 && 
-                    info.format.sample_rate > 0 && info.format.channels > 0;
-    
-    return info;
+bool JitterBuffer::read(uint32_t timestamp, uint8_t* data, uint32_t frames) {
+    return impl_->read(timestamp, data, frames);
 }
 
-bool SDPParser::validate_aes67(const SDPInfo& info) {
-    if (!info.is_valid) return false;
-    
-    // AES67 requirements:
-    // - Sample rate: 48000 Hz (mandatory), 96000 Hz, 44100 Hz also allowed
-    // - Bit depth: 16, 24, or 32 bit linear PCM
-    // - Packet time: 1ms (mandatory), 125µs, 250µs, 333µs, 4ms also allowed
-    
-    bool valid_sample_rate = info.format.sample_rate == 44100 ||
-                            info.format.sample_rate == 48000 ||
-                            info.format.sample_rate == 96000;
-    
-    bool valid_bit_depth = info.format.bit_depth == 16 ||
-                          info.format.bit_depth == 24 ||
-                          info.format.bit_depth == 32;
-    
-    bool valid_encoding = info.encoding == "L16" ||
-                         info.encoding == "L24" ||
-                         info.encoding == "L32";
-    
-    return valid_sample_rate && valid_bit_depth && valid_encoding;
-}
+bool JitterBuffer::wait(std::chrono::milliseconds timeout) { return impl_->wait(timeout); }
+void JitterBuffer::wake() { impl_->wake(); }
+int JitterBuffer::event_fd() const { return impl_->event_fd(); }
+bool JitterBuffer::arm_wait() { return impl_->arm_wait(); }
 
-AudioFormat SDPParser::extract_format(const SDPInfo& info) {
-    return info.format;
-}
+double JitterBuffer::get_level() const { return impl_->get_level(); }
+double JitterBuffer::get_latency_ms() const { return impl_->get_latency_ms(); }
+uint32_t JitterBuffer::get_capacity_frames() const { return impl_->get_capacity_frames(); }
+uint64_t JitterBuffer::get_overruns() const { return impl_->get_overruns(); }
+uint64_t JitterBuffer::get_underruns() const { return impl_->get_underruns(); }
+void JitterBuffer::reset() { impl_->reset(); }
 
 // ==================== AES67Receiver::Impl ====================
 
@@ -282,12 +509,10 @@ public:
         config_ = config;
         audio_config_ = audio_config;
         
-        // Configure jitter buffer
-        JitterBuffer::Config jb_config;
-        jb_config.target_delay_ms = static_cast<uint32_t>(audio_config.jitter_buffer_ms);
-        jb_config.min_delay_ms = static_cast<uint32_t>(audio_config.buffer_size_ms);
-        jb_config.max_delay_ms = jb_config.target_delay_ms * 5;
-        jitter_buffer_ = std::make_unique<JitterBuffer>(jb_config);
+        // Configure jitter buffer (sized for the stream format on connect)
+        jitter_config_.target_delay_ms = static_cast<uint32_t>(audio_config.jitter_buffer_ms);
+        jitter_config_.min_delay_ms = static_cast<uint32_t>(audio_config.buffer_size_ms);
+        jitter_config_.max_delay_ms = jitter_config_.target_delay_ms * 5;
         
         LOG_INFO("Receiver {} configured with jitter buffer {}ms", 
                  config_.id, audio_config.jitter_buffer_ms);
@@ -302,14 +527,17 @@ public:
         ptp_sync_ = std::move(ptp);
     }
     
+    void set_engine(std::shared_ptr<ReceiverEngine> engine) {
+        engine_ = std::move(engine);
+    }
+    
+    void set_packet_ring(std::shared_ptr<PacketRing> ring) {
+        packet_ring_ = std::move(ring);
+    }
+    
     bool initialize() {
         if (initialized_) return true;
         
-        // Initialize jitter buffer if not configured
-        if (!jitter_buffer_) {
-            jitter_buffer_ = std::make_unique<JitterBuffer>();
-        }
-        
         // Initialize audio sink if provided
         if (audio_sink_) {
             if (!audio_sink_->initialize()) {
@@ -325,26 +553,24 @@ public:
     }
     
     bool connect(const std::string& sdp) {
-        sdp_info_ = SDPParser::parse(sdp);
+        if (state_ == ReceiverState::Receiving) {
+            stop();
+        }
+        close_socket();
         
-        if (!sdp_info_.is_valid) {
-            LOG_ERROR("Invalid SDP");
+        if (!parse_stream(sdp, sdp_info_)) {
             return false;
         }
-        
-        LOG_INFO("Parsed SDP: {}:{} {}ch {}Hz", 
-                 sdp_info_.source_ip, sdp_info_.port,
-                 sdp_info_.format.channels, sdp_info_.format.sample_rate);
-        
         return connect_internal();
     }
     
     bool connect(const std::string& source_ip, uint16_t port, const AudioFormat& format) {
-        sdp_info_.source_ip = source_ip;
-        sdp_info_.port = port;
-        sdp_info_.format = format.is_valid() ? format : AudioFormat{};
-        sdp_info_.is_valid = true;
+        if (state_ == ReceiverState::Receiving) {
+            stop();
+        }
+        close_socket();
         
+        sdp_info_ = transport_info(source_ip, port, format);
         return connect_internal();
     }
     
@@ -353,12 +579,7 @@ public:
             stop();
         }
         
-#ifdef __linux__
-        if (socket_fd_ >= 0) {
-            close(socket_fd_);
-            socket_fd_ = -1;
-        }
-#endif
+        close_socket();
         
         connected_ = false;
         state_ = ReceiverState::Stopped;
@@ -373,21 +594,46 @@ public:
         
         if (state_ == ReceiverState::Receiving) return true;
         
+        media_clock_ = MediaClock(sdp_info_.format.sample_rate, sdp_info_.media_clock_offset);
+        
         // Open audio sink
+        const bool pull = audio_config_.pull_playout && audio_sink_;
         if (audio_sink_ && sdp_info_.format.is_valid()) {
+            audio_sink_->set_buffer_ms(audio_config_.buffer_size_ms + audio_config_.jitter_buffer_ms);
             if (!audio_sink_->open(config_.pipewire_sink, sdp_info_.format)) {
                 LOG_ERROR("Failed to open audio sink");
                 return false;
             }
+            if (pull) {
+                pull_locked_ = false;
+                audio_sink_->set_pull_callback([this](uint8_t* data, uint32_t frames) {
+                    pull_playout(data, frames);
+                });
+            }
             audio_sink_->start();
         }
         
-        // Start receive thread
-        running_ = true;
-        receive_thread_ = std::thread([this]() { receive_loop(); });
+#ifdef __linux__
+        if (config_.receive_mode != "poll") {
+            prepare_rx_batch();
+        } else {
+            rx_buffer_.assign(65536, 0);
+        }
+#endif
+        prepare_playout();
         
-        // Start playout thread
-        playout_thread_ = std::thread([this]() { playout_loop(); });
+        running_ = true;
+        packet_ring_rx_ = subscribe_packet_ring();
+        if (!attach_to_engine(pull)) {
+            // Own receive thread unless the packet ring delivers, and a
+            // playout thread unless the PipeWire graph pulls the audio
+            if (!packet_ring_rx_) {
+                receive_thread_ = std::thread([this]() { receive_loop(); });
+            }
+            if (!pull) {
+                playout_thread_ = std::thread([this]() { playout_loop(); });
+            }
+        }
         
         state_ = ReceiverState::Receiving;
         stats_.start_time = std::chrono::steady_clock::now();
@@ -398,27 +644,51 @@ public:
     }
     
     void stop() {
-        if (state_ != ReceiverState::Receiving) return;
-        
-        running_ = false;
-        
-        if (receive_thread_.joinable()) {
-            receive_thread_.join();
+        std::lock_guard<std::mutex> lock(switch_mutex_);
+        stop_receiving();
+        release_standby();
+    }
+    
+    uint64_t prepare_switch(const std::string& sdp, int64_t switch_ns) {
+        SDPInfo info;
+        if (!parse_stream(sdp, info)) {
+            return 0;
         }
-        
-        if (playout_thread_.joinable()) {
-            playout_thread_.join();
+        return prepare_stream(std::move(info), switch_ns);
+    }
+    
+    uint64_t prepare_switch(const std::string& source_ip, uint16_t port, const AudioFormat& format,
+                            int64_t switch_ns) {
+        return prepare_stream(transport_info(source_ip, port, format), switch_ns);
+    }
+    
+    bool commit_switch(uint64_t handle) {
+        std::lock_guard<std::mutex> lock(switch_mutex_);
+        if (handle == 0 || handle != switch_handle_ ||
+            switch_state_.load(std::memory_order_acquire) != SwitchState::Prepared) {
+            return false;
         }
         
-        if (audio_sink_) {
-            audio_sink_->stop();
+        if (standby_.restart) {
+            // Already running, holding the stream back until the switch
+            LOG_INFO("Receiver {} switch to {}:{} committed", config_.id, sdp_info_.source_ip, sdp_info_.port);
+            release_standby();
+        } else {
+            // The worker takes over the stream description at the swap
+            LOG_INFO("Receiver {} switch to {}:{} committed", config_.id,
+                     standby_.sdp_info.source_ip, standby_.sdp_info.port);
+            switch_state_.store(SwitchState::Committed, std::memory_order_release);
+        }
+        return true;
+    }
+    
+    void cancel_switch(uint64_t handle) {
+        std::lock_guard<std::mutex> lock(switch_mutex_);
+        if (handle != 0 && handle == switch_handle_ &&
+            switch_state_.load(std::memory_order_acquire) == SwitchState::Prepared) {
+            LOG_INFO("Receiver {} switch cancelled", config_.id);
+            drop_switch();
         }
-        
-        jitter_buffer_->reset();
-        
-        state_ = ReceiverState::Listening;
-        LOG_INFO("Receiver {} stopped", config_.id);
-        notify_state_change();
     }
     
     bool is_running() const { return state_ == ReceiverState::Receiving; }
@@ -429,8 +699,13 @@ public:
     std::string get_label() const { return config_.label; }
     ReceiverConfig get_config() const { return config_; }
     ReceiverStatistics get_statistics() const { return stats_; }
-    AudioFormat get_audio_format() const { return sdp_info_.format; }
-    SDPInfo get_sdp_info() const { return sdp_info_; }
+    AudioFormat get_audio_format() const { return get_sdp_info().format; }
+    
+    // The engine worker replaces the description at a committed switch
+    SDPInfo get_sdp_info() const {
+        std::lock_guard<std::mutex> lock(ring_mutex_);
+        return sdp_info_;
+    }
     std::string get_sender_id() const { return sender_id_; }
     
     void set_state_callback(std::function<void(ReceiverState)> callback) {
@@ -455,112 +730,612 @@ public:
     }
     
 private:
-    bool connect_internal() {
-#ifdef __linux__
-        // Create UDP socket
-        socket_fd_ = socket(AF_INET, SOCK_DGRAM, 0);
-        if (socket_fd_ < 0) {
-            LOG_ERROR("Failed to create socket");
-            return false;
-        }
+    // Stop without touching a prepared switch; switch_mutex_ held
+    void stop_receiving() {
+        if (state_ != ReceiverState::Receiving) return;
         
-        // Allow address reuse
-        int reuse = 1;
-        setsockopt(socket_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        running_ = false;
         
-        // Bind to port
-        sockaddr_in addr{};
-        addr.sin_family = AF_INET;
-        addr.sin_port = htons(sdp_info_.port);
-        addr.sin_addr.s_addr = INADDR_ANY;
+        unsubscribe_packet_ring();
+        detach_from_engine();
+        if (receive_thread_.joinable()) {
+            receive_thread_.join();
+        }
         
-        if (bind(socket_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
-            LOG_ERROR("Failed to bind socket to port {}", sdp_info_.port);
-            close(socket_fd_);
-            socket_fd_ = -1;
-            return false;
+        if (jitter_buffer_) {
+            jitter_buffer_->wake();
+        }
+        if (playout_thread_.joinable()) {
+            playout_thread_.join();
         }
         
-        // Join multicast group if multicast address
-        unsigned long ip = ntohl(inet_addr(sdp_info_.source_ip.c_str()));
-        if ((ip & 0xF0000000) == 0xE0000000) {  // 224.0.0.0 - 239.255.255.255
-            struct ip_mreq mreq{};
-            inet_pton(AF_INET, sdp_info_.source_ip.c_str(), &mreq.imr_multiaddr);
-            mreq.imr_interface.s_addr = INADDR_ANY;
-            
-            if (setsockopt(socket_fd_, IPPROTO_IP, IP_ADD_MEMBERSHIP, 
-                          &mreq, sizeof(mreq)) < 0) {
-                LOG_WARNING("Failed to join multicast group {}", sdp_info_.source_ip);
-            }
+        if (audio_sink_) {
+            audio_sink_->stop();
+            audio_sink_->set_pull_callback(nullptr);
         }
         
-        // Set receive buffer size
-        int bufsize = 2 * 1024 * 1024;  // 2MB
-        setsockopt(socket_fd_, SOL_SOCKET, SO_RCVBUF, &bufsize, sizeof(bufsize));
-#endif
+        if (jitter_buffer_) {
+            jitter_buffer_->reset();
+        }
+        start_gated_ = false;
         
-        connected_ = true;
         state_ = ReceiverState::Listening;
-        LOG_INFO("Receiver {} connected to {}:{}", 
-                 config_.id, sdp_info_.source_ip, sdp_info_.port);
-        return true;
+        LOG_INFO("Receiver {} stopped", config_.id);
+        notify_state_change();
     }
     
-    void receive_loop() {
-        std::vector<uint8_t> buffer(65536);
+    // Parse and log an SDP description
+    static bool parse_stream(const std::string& sdp, SDPInfo& info) {
+        info = SDPParser::parse(sdp);
         
-        while (running_) {
-#ifdef __linux__
-            pollfd pfd{};
-            pfd.fd = socket_fd_;
-            pfd.events = POLLIN;
-            
-            int ret = poll(&pfd, 1, 100);  // 100ms timeout
-            if (ret <= 0) continue;
-            
-            ssize_t received = recv(socket_fd_, buffer.data(), buffer.size(), 0);
-            if (received <= 0) continue;
-            
-            process_rtp_packet(buffer.data(), received);
-#endif
+        if (!info.is_valid) {
+            if (info.error) {
+                LOG_ERROR("Invalid SDP (line {}): {}", info.error.line, info.error.message);
+            } else {
+                LOG_ERROR("Invalid SDP");
+            }
+            return false;
         }
+        
+        LOG_INFO("Parsed SDP: {}:{} {}ch {}Hz", 
+                 info.source_ip, info.port,
+                 info.format.channels, info.format.sample_rate);
+        return true;
+    }
+    
+    // Stream given by transport parameters; the rest of the description is kept
+    SDPInfo transport_info(const std::string& source_ip, uint16_t port, const AudioFormat& format) const {
+        SDPInfo info = get_sdp_info();
+        info.source_ip = source_ip;
+        info.port = port;
+        info.format = format.is_valid() ? format : AudioFormat{};
+        info.media_clock_offset = 0;
+        info.is_valid = true;
+        return info;
     }
     
-    void process_rtp_packet(const uint8_t* data, size_t size) {
-        if (size < sizeof(RTPHeader)) return;
+    uint64_t prepare_stream(SDPInfo info, int64_t switch_ns) {
+        std::lock_guard<std::mutex> lock(switch_mutex_);
+        if (!drop_switch()) {
+            LOG_WARNING("Receiver {}: previous switch still pending", config_.id);
+            return 0;
+        }
+        
+        const MediaClock clock(info.format.sample_rate, info.media_clock_offset);
+        const uint32_t gate = clock.rtp_timestamp(static_cast<uint64_t>(std::max<int64_t>(switch_ns, 0)));
+        if (state_ != ReceiverState::Receiving) {
+            return start_gated(std::move(info), gate);
+        }
+        
+#ifdef __linux__
+        // The swap happens on the engine worker that receives and plays
+        // this stream, into a sink opened for the same format
+        const AudioFormat& format = sdp_info_.format;
+        if (engine_worker_ < 0 || packet_ring_rx_ || playout_timer_fd_ < 0 ||
+            info.format.sample_rate != format.sample_rate || info.format.channels != format.channels ||
+            info.format.bit_depth != format.bit_depth) {
+            LOG_INFO("Receiver {}: switch to {}:{} needs a reconnect", config_.id, info.source_ip, info.port);
+            return 0;
+        }
+        
+        int fd = open_socket(info);
+        if (fd < 0) {
+            return 0;
+        }
+        int flags = fcntl(fd, F_GETFL, 0);
+        fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+        
+        standby_.format = info.format;
+        standby_.media_clock = clock;
+        standby_.jitter_buffer = make_jitter_buffer(info.format);
+        standby_.socket_fd = fd;
+        standby_.gate_ts = gate;
+        standby_.retire_ts = media_clock_.rtp_timestamp(static_cast<uint64_t>(std::max<int64_t>(switch_ns, 0)));
+        standby_.sdp_info = std::move(info);
+        switch_state_.store(SwitchState::Prepared, std::memory_order_release);
+        
+        // From here on the worker receives the new stream alongside the current one
+        if (engine_->attach(fd, EPOLLIN, [this](uint32_t) { on_standby_ready(); }, engine_worker_) < 0) {
+            LOG_WARNING("Receiver {}: engine attach of the new stream failed", config_.id);
+            release_standby();
+            return 0;
+        }
+        
+        switch_handle_ = next_switch_handle_++;
+        LOG_INFO("Receiver {} prepared switch to {}:{} at RTP {} (current stream until {})",
+                 config_.id, standby_.sdp_info.source_ip, standby_.sdp_info.port,
+                 standby_.gate_ts, standby_.retire_ts);
+        return switch_handle_;
+#else
+        return 0;
+#endif
+    }
+    
+    // Stopped receiver: connect and start now, keeping audio before the
+    // gate out of the jitter buffer. switch_mutex_ held
+    uint64_t start_gated(SDPInfo info, uint32_t gate) {
+        standby_.restart = true;
+        standby_.reconnect = connected_;
+        standby_.sdp_info = sdp_info_;
+        
+        close_socket();
+        sdp_info_ = std::move(info);
+        start_gate_ts_ = gate;
+        start_gated_ = true;
+        if (!connect_internal() || !start()) {
+            restore_previous();
+            release_standby();
+            return 0;
+        }
+        
+        switch_state_.store(SwitchState::Prepared, std::memory_order_release);
+        switch_handle_ = next_switch_handle_++;
+        LOG_INFO("Receiver {} started for a switch at RTP {}", config_.id, gate);
+        return switch_handle_;
+    }
+    
+    // Undo start_gated(): stopped, and connected to the previous stream if it was
+    void restore_previous() {
+        stop_receiving();
+        close_socket();
+        start_gated_ = false;
+        sdp_info_ = standby_.sdp_info;
+        connected_ = false;
+        state_ = ReceiverState::Stopped;
+        if (standby_.reconnect) {
+            connect_internal();
+        }
+    }
+    
+    // Drop a switch that is not committed and release one that took
+    // over; false while a committed switch is waiting for its timestamp.
+    // switch_mutex_ held
+    bool drop_switch() {
+        const SwitchState state = switch_state_.load(std::memory_order_acquire);
+        if (state == SwitchState::Committed) return false;
+        if (state == SwitchState::Prepared) {
+            if (standby_.restart) {
+                restore_previous();
+            } else {
+#ifdef __linux__
+                // Waits out a receive of the new stream in progress
+                engine_->detach(standby_.socket_fd);
+#endif
+            }
+        }
+        release_standby();
+        return true;
+    }
+    
+    // Close the new stream's socket (or the old one's jitter buffer after
+    // a swap); the worker no longer uses either. switch_mutex_ held
+    void release_standby() {
+#ifdef __linux__
+        if (standby_.socket_fd >= 0) {
+            close(standby_.socket_fd);
+        }
+#endif
+        standby_ = StandbyStream{};
+        switch_handle_ = 0;
+        switch_state_.store(SwitchState::Idle, std::memory_order_relaxed);
+    }
+    
+    void close_socket() {
+#ifdef __linux__
+        if (socket_fd_ >= 0) {
+            close(socket_fd_);
+            socket_fd_ = -1;
+        }
+#endif
+    }
+    
+    bool connect_internal() {
+        jitter_buffer_ = make_jitter_buffer(sdp_info_.format);
+        decode_buffer_.assign(65536, 0);
+        
+        // A new stream: neither loss nor jitter carries over from the last one
+        last_sequence_valid_ = false;
+        last_transit_valid_ = false;
+
+#ifdef __linux__
+        socket_fd_ = open_socket(sdp_info_);
+        if (socket_fd_ < 0) {
+            return false;
+        }
+#endif
+        
+        connected_ = true;
+        state_ = ReceiverState::Listening;
+        LOG_INFO("Receiver {} connected to {}:{}", 
+                 config_.id, sdp_info_.source_ip, sdp_info_.port);
+        return true;
+    }
+    
+    // Size the playout timeline for the stream format
+    std::unique_ptr<JitterBuffer> make_jitter_buffer(const AudioFormat& format) const {
+        JitterBuffer::Config jb_config = jitter_config_;
+        jb_config.sample_rate = format.sample_rate;
+        jb_config.bytes_per_frame = format.bytes_per_frame();
+        if (audio_config_.playout_mode == "ptp" && jb_config.sample_rate > 0) {
+            // Early packets wait a full link offset, leave room for twice that
+            uint32_t offset_ms = static_cast<uint32_t>(
+                static_cast<uint64_t>(audio_config_.link_offset_samples) * 1000 / jb_config.sample_rate);
+            jb_config.max_delay_ms = std::max(jb_config.max_delay_ms, offset_ms * 2 + 1);
+        }
+        return std::make_unique<JitterBuffer>(jb_config);
+    }
+
+#ifdef __linux__
+    // Bound UDP socket for a stream, joined to its group; -1 on failure
+    int open_socket(const SDPInfo& info) const {
+        // Create UDP socket
+        int fd = socket(AF_INET, SOCK_DGRAM, 0);
+        if (fd < 0) {
+            LOG_ERROR("Failed to create socket");
+            return -1;
+        }
+        
+        // Allow address reuse
+        int reuse = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        
+        // Bind to port
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(info.port);
+        addr.sin_addr.s_addr = INADDR_ANY;
+        
+        if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+            LOG_ERROR("Failed to bind socket to port {}", info.port);
+            close(fd);
+            return -1;
+        }
+        
+        // Join multicast group if multicast address
+        unsigned long ip = ntohl(inet_addr(info.source_ip.c_str()));
+        if ((ip & 0xF0000000) == 0xE0000000) {  // 224.0.0.0 - 239.255.255.255
+            struct ip_mreq mreq{};
+            inet_pton(AF_INET, info.source_ip.c_str(), &mreq.imr_multiaddr);
+            mreq.imr_interface.s_addr = INADDR_ANY;
+            
+            if (setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, 
+                          &mreq, sizeof(mreq)) < 0) {
+                LOG_WARNING("Failed to join multicast group {}", info.source_ip);
+            }
+        }
+        
+        // Set receive buffer size
+        int bufsize = 2 * 1024 * 1024;  // 2MB
+        setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &bufsize, sizeof(bufsize));
+        
+        // Kernel software receive timestamps, delivered as cmsg
+        int timestamps = 1;
+        if (setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPNS, &timestamps, sizeof(timestamps)) < 0) {
+            LOG_WARNING("Kernel receive timestamps unavailable, using user-space arrival times");
+        }
+        return fd;
+    }
+#endif
+    
+    void receive_loop() {
+#ifdef __linux__
+        if (config_.receive_mode == "poll") {
+            receive_loop_poll();
+        } else if (config_.receive_mode == "io_uring") {
+            receive_loop_ring();
+        } else {
+            receive_loop_batched();
+        }
+#endif
+    }
+
+#ifdef __linux__
+    void receive_loop_poll() {
+        int timeout_ms = static_cast<int>(std::max<uint32_t>(config_.rx_batch_timeout_us / 1000, 1));
+        
+        while (running_) {
+            pollfd pfd{};
+            pfd.fd = socket_fd_;
+            pfd.events = POLLIN;
+            
+            int ret = poll(&pfd, 1, timeout_ms);
+            stats_.rx_syscalls++;
+            if (ret <= 0) continue;
+            
+            if (receive_single(0)) {
+                update_rx_statistics();
+            }
+        }
+    }
+    
+    void receive_loop_batched() {
+        // Block in recvmmsg itself; the receive timeout keeps stop() responsive.
+        // A zero SO_RCVTIMEO would block forever, so clamp like poll mode does.
+        const uint32_t timeout_us = std::max<uint32_t>(config_.rx_batch_timeout_us, 1);
+        timeval tv{};
+        tv.tv_sec = timeout_us / 1000000;
+        tv.tv_usec = timeout_us % 1000000;
+        setsockopt(socket_fd_, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        
+        while (running_) {
+            if (receive_batch(MSG_WAITFORONE) > 0) {
+                update_rx_statistics();
+            }
+        }
+    }
+    
+    void receive_loop_ring() {
+        int timeout_ms = static_cast<int>(std::max<uint32_t>(config_.rx_batch_timeout_us / 1000, 1));
+        
+        if (open_ring()) {
+            while (running_ && receive_ring(timeout_ms) >= 0) {
+                update_rx_statistics();
+            }
+            const bool failed = running_;
+            ring_.reset();
+            if (!failed) return;
+            ring_failed_ = true;
+            LOG_WARNING("Receiver {}: io_uring receive failed, falling back to recvmmsg", config_.id);
+        }
+        receive_loop_batched();
+    }
+    
+    // Create the receive ring; must run on the thread that will process it
+    bool open_ring() {
+        if (ring_failed_) return false;
+        
+        UringReceiveConfig ring_config;
+        ring_config.buffers = config_.rx_ring_buffers;
+        ring_config.buffer_size = static_cast<uint32_t>(RX_SLOT_SIZE);
+        ring_ = std::make_unique<UringReceiveRing>();
+        ring_stats_ = {};
+        if (!ring_->open(socket_fd_, ring_config,
+                         [this](const uint8_t* data, size_t size, const timespec* kernel_ts) {
+                             on_ring_packet(data, size, kernel_ts);
+                         })) {
+            ring_.reset();
+            ring_failed_ = true;
+            LOG_WARNING("Receiver {}: io_uring receive unavailable, using recvmmsg", config_.id);
+            return false;
+        }
+        LOG_INFO("Receiver {} using io_uring multishot receive ({} buffers)",
+                 config_.id, config_.rx_ring_buffers);
+        return true;
+    }
+    
+    // Reap ring completions; returns the datagram count, -1 if the ring failed
+    int receive_ring(int timeout_ms) {
+        ring_clock_valid_ = false;
+        int count = ring_->process(timeout_ms);
+        
+        UringReceiveStats ring_stats = ring_->get_stats();
+        stats_.rx_syscalls += ring_stats.syscalls - ring_stats_.syscalls;
+        stats_.rx_ring_rearms += ring_stats.rearms - ring_stats_.rearms;
+        stats_.rx_ring_no_buffers += ring_stats.no_buffers - ring_stats_.no_buffers;
+        ring_stats_ = ring_stats;
+        return count;
+    }
+    
+    void on_ring_packet(const uint8_t* data, size_t size, const timespec* kernel_ts) {
+        // One clock sample per completion batch, as for recvmmsg
+        if (!ring_clock_valid_) {
+            ring_clock_ = ArrivalClock::sample();
+            ring_clock_valid_ = true;
+            if (kernel_ts != nullptr) {
+                update_wakeup_latency(ring_clock_.delay_us(*kernel_ts));
+            }
+        }
+        process_rtp_packet(data, size,
+                           kernel_ts != nullptr ? ring_clock_.to_steady(*kernel_ts) : ring_clock_.steady_now);
+    }
+    
+    // One recvmsg (from the prepared stream's socket if standby); false if
+    // nothing was received
+    bool receive_single(int flags, bool standby = false) {
+        alignas(cmsghdr) uint8_t control[RX_CONTROL_SIZE];
+        iovec iov{rx_buffer_.data(), rx_buffer_.size()};
+        msghdr msg{};
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        ssize_t received = recvmsg(standby ? standby_.socket_fd : socket_fd_, &msg, flags);
+        stats_.rx_syscalls++;
+        if (received <= 0) return false;
+        
+        ArrivalClock clock = ArrivalClock::sample();
+        timespec kernel_ts{};
+        bool have_ts = read_kernel_timestamp(msg, kernel_ts);
+        auto arrival = have_ts ? clock.to_steady(kernel_ts) : clock.steady_now;
+        if (standby) {
+            process_standby_packet(rx_buffer_.data(), static_cast<size_t>(received), arrival);
+            return true;
+        }
+        if (have_ts) {
+            update_wakeup_latency(clock.delay_us(kernel_ts));
+        }
+        
+        process_rtp_packet(rx_buffer_.data(), static_cast<size_t>(received), arrival);
+        return true;
+    }
+    
+    // One recvmmsg into the preallocated batch (from the prepared stream's
+    // socket if standby); returns the datagram count
+    int receive_batch(int flags, bool standby = false) {
+        for (auto& msg : rx_msgs_) {
+            msg.msg_hdr.msg_controllen = RX_CONTROL_SIZE;
+        }
+        
+        int count = recvmmsg(standby ? standby_.socket_fd : socket_fd_, rx_msgs_.data(),
+                             static_cast<unsigned int>(rx_msgs_.size()), flags, nullptr);
+        stats_.rx_syscalls++;
+        if (count <= 0) return 0;
+        
+        // One clock sample per batch; each datagram carries its own kernel time
+        ArrivalClock clock = ArrivalClock::sample();
+        stats_.rx_batches++;
+        for (int i = 0; i < count; ++i) {
+            const mmsghdr& msg = rx_msgs_[i];
+            if (msg.msg_hdr.msg_flags & MSG_TRUNC) continue;
+            
+            timespec kernel_ts{};
+            bool have_ts = read_kernel_timestamp(msg.msg_hdr, kernel_ts);
+            const auto* data = static_cast<const uint8_t*>(msg.msg_hdr.msg_iov->iov_base);
+            auto arrival = have_ts ? clock.to_steady(kernel_ts) : clock.steady_now;
+            if (standby) {
+                process_standby_packet(data, msg.msg_len, arrival);
+                continue;
+            }
+            if (have_ts && i == 0) {
+                // The first datagram is the one that woke us up
+                update_wakeup_latency(clock.delay_us(kernel_ts));
+            }
+            
+            process_rtp_packet(data, msg.msg_len, arrival);
+        }
+        return count;
+    }
+    
+    // Preallocate the batch so the receive path never allocates
+    void prepare_rx_batch() {
+        size_t batch = std::clamp<uint32_t>(config_.rx_batch_size, 1, 1024);
+        rx_slots_.assign(batch * RX_SLOT_SIZE, 0);
+        rx_control_.assign(batch * RX_CONTROL_SIZE, 0);
+        rx_iovecs_.assign(batch, iovec{});
+        rx_msgs_.assign(batch, mmsghdr{});
+        
+        for (size_t i = 0; i < batch; ++i) {
+            rx_iovecs_[i].iov_base = rx_slots_.data() + i * RX_SLOT_SIZE;
+            rx_iovecs_[i].iov_len = RX_SLOT_SIZE;
+            rx_msgs_[i].msg_hdr.msg_iov = &rx_iovecs_[i];
+            rx_msgs_[i].msg_hdr.msg_iovlen = 1;
+            rx_msgs_[i].msg_hdr.msg_control = rx_control_.data() + i * RX_CONTROL_SIZE;
+            rx_msgs_[i].msg_hdr.msg_controllen = RX_CONTROL_SIZE;
+        }
+    }
+    
+    static bool read_kernel_timestamp(const msghdr& msg, timespec& ts) {
+        for (const cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr;
+             cmsg = CMSG_NXTHDR(const_cast<msghdr*>(&msg), const_cast<cmsghdr*>(cmsg))) {
+            if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+                std::memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    void update_wakeup_latency(double delay_us) {
+        if (delay_us < 0.0) return;
+        stats_.wakeup_latency_us += (delay_us - stats_.wakeup_latency_us) / 16.0;
+        stats_.wakeup_latency_max_us = std::max(stats_.wakeup_latency_max_us, delay_us);
+    }
+    
+    void update_rx_statistics() {
+        if (stats_.packets_received > 0) {
+            stats_.syscalls_per_packet = static_cast<double>(stats_.rx_syscalls) /
+                                         static_cast<double>(stats_.packets_received);
+        }
+        if (stats_.rx_batches > 0 && !rx_msgs_.empty()) {
+            stats_.batch_occupancy = static_cast<double>(stats_.packets_received) /
+                                     (static_cast<double>(stats_.rx_batches) * rx_msgs_.size());
+        }
+    }
+#endif
+    
+    // RTP fields and payload of a datagram; false if it is not RTP
+    static bool parse_rtp(const uint8_t* data, size_t size, uint16_t& sequence, uint32_t& timestamp,
+                          const uint8_t*& payload, size_t& payload_size) {
+        if (size < sizeof(RTPHeader)) return false;
         
         const RTPHeader* header = reinterpret_cast<const RTPHeader*>(data);
         
         // Verify RTP version
-        if (header->v != 2) return;
+        if (header->v != 2) return false;
         
-        uint16_t sequence = ntohs(header->seq);
-        uint32_t timestamp = ntohl(header->ts);
+        sequence = ntohs(header->seq);
+        timestamp = ntohl(header->ts);
         
         // Extract payload
         size_t header_size = sizeof(RTPHeader) + (header->cc * 4);
         if (header->x) {
             // Handle extension header
-            if (size < header_size + 4) return;
+            if (size < header_size + 4) return false;
             uint16_t ext_length = ntohs(*reinterpret_cast<const uint16_t*>(data + header_size + 2));
             header_size += 4 + ext_length * 4;
         }
         
-        if (size <= header_size) return;
+        if (size <= header_size) return false;
         
-        const uint8_t* payload = data + header_size;
-        size_t payload_size = size - header_size;
+        payload = data + header_size;
+        payload_size = size - header_size;
+        return true;
+    }
+    
+    // Network byte order L16/L24/L32 to the sink's S16/S24/S32 LE in
+    // decode_buffer_; returns the decoded size
+    size_t decode_payload(const uint8_t* payload, size_t payload_size, const AudioFormat& format) {
+        payload_size = std::min(payload_size, decode_buffer_.size());
+        PCMCodec::decode(payload, PCMCodec::encoding_for(format.bit_depth),
+                         decode_buffer_.data(), PCMCodec::format_for(format.bit_depth),
+                         payload_size / std::max<uint32_t>(format.bytes_per_sample(), 1));
+        return payload_size;
+    }
+    
+    // Frames of a packet at timestamp that come before gate (all of them
+    // if it ends before the gate)
+    static uint32_t frames_before(uint32_t timestamp, uint32_t frames, uint32_t gate) {
+        int32_t before = static_cast<int32_t>(gate - timestamp);
+        return before <= 0 ? 0 : std::min(static_cast<uint32_t>(before), frames);
+    }
+    
+    void process_rtp_packet(const uint8_t* data, size_t size,
+                            std::chrono::steady_clock::time_point arrival) {
+        uint16_t sequence;
+        uint32_t timestamp;
+        const uint8_t* payload;
+        size_t payload_size;
+        if (!parse_rtp(data, size, sequence, timestamp, payload, payload_size)) return;
+        payload_size = decode_payload(payload, payload_size, sdp_info_.format);
+        
+        // Started by prepare_switch(): nothing before the switch instant
+        uint32_t skip = 0;
+        const uint32_t bpf = std::max<uint32_t>(sdp_info_.format.bytes_per_frame(), 1);
+        if (start_gated_) {
+            const uint32_t frames = static_cast<uint32_t>(payload_size / bpf);
+            skip = frames_before(timestamp, frames, start_gate_ts_);
+            if (skip == frames) return;
+            start_gated_ = false;
+        }
         
         // Add to jitter buffer
-        jitter_buffer_->push(payload, payload_size, sequence, timestamp);
+        jitter_buffer_->push(decode_buffer_.data() + static_cast<size_t>(skip) * bpf,
+                             payload_size - static_cast<size_t>(skip) * bpf,
+                             sequence, timestamp + skip, arrival);
+        
+        // Interarrival jitter (RFC 3550 6.4.1) from arrival vs. media time
+        double transit = std::chrono::duration<double>(arrival.time_since_epoch()).count() -
+                         static_cast<double>(timestamp) / sdp_info_.format.sample_rate;
+        if (last_transit_valid_) {
+            double d = transit - last_transit_;
+            // Compensate 32-bit RTP timestamp wraparound
+            double wrap = 4294967296.0 / sdp_info_.format.sample_rate;
+            if (d > wrap / 2) d -= wrap;
+            if (d < -wrap / 2) d += wrap;
+            stats_.jitter_ms += (std::abs(d) * 1000.0 - stats_.jitter_ms) / 16.0;
+        }
+        last_transit_ = transit;
+        last_transit_valid_ = true;
         
         // Update statistics
         stats_.packets_received++;
         stats_.bytes_received += size;
         stats_.last_sequence_number = sequence;
         stats_.last_rtp_timestamp = timestamp;
-        stats_.last_packet_time = std::chrono::steady_clock::now();
+        stats_.last_packet_time = arrival;
         stats_.buffer_level = jitter_buffer_->get_level();
+        stats_.latency_ms = jitter_buffer_->get_latency_ms();
+        stats_.overruns = jitter_buffer_->get_overruns();
         
         // Check for packet loss
         if (last_sequence_valid_) {
@@ -575,23 +1350,498 @@ private:
         last_sequence_valid_ = true;
     }
     
-    void playout_loop() {
-        std::vector<uint8_t> buffer(8192);
+    // The prepared stream, received on the engine worker ahead of the
+    // switch; audio before the switch instant is dropped
+    void process_standby_packet(const uint8_t* data, size_t size,
+                                std::chrono::steady_clock::time_point arrival) {
+        uint16_t sequence;
+        uint32_t timestamp;
+        const uint8_t* payload;
+        size_t payload_size;
+        if (!parse_rtp(data, size, sequence, timestamp, payload, payload_size)) return;
+        payload_size = decode_payload(payload, payload_size, standby_.format);
         
+        const uint32_t bpf = std::max<uint32_t>(standby_.format.bytes_per_frame(), 1);
+        const uint32_t frames = static_cast<uint32_t>(payload_size / bpf);
+        const uint32_t skip = frames_before(timestamp, frames, standby_.gate_ts);
+        if (skip == frames) return;
+        standby_.jitter_buffer->push(decode_buffer_.data() + static_cast<size_t>(skip) * bpf,
+                                     payload_size - static_cast<size_t>(skip) * bpf,
+                                     sequence, timestamp + skip, arrival);
+    }
+    
+    enum class PlayoutStep {
+        Continue,   // Played a block, run again
+        Sleep,      // Next block is due at the returned deadline
+        WaitData    // Jitter buffer is empty, wait for received audio
+    };
+    
+    void prepare_playout() {
+        const uint32_t rate = sdp_info_.format.sample_rate;
+        const uint32_t bpf = sdp_info_.format.bytes_per_frame();
+        playout_ptp_mode_ = audio_config_.playout_mode == "ptp" && rate > 0 && bpf > 0;
+        
+        // PTP playout block: one packet time, at least 1ms
+        playout_block_ = std::max<uint32_t>(
+            static_cast<uint32_t>(static_cast<uint64_t>(sdp_info_.packet_time_us) * rate / 1000000),
+            rate / 1000);
+        playout_buffer_.assign(std::max<size_t>(8192, static_cast<size_t>(playout_block_) * bpf), 0);
+        playout_next_ts_ = 0;
+        playout_ptp_locked_ = false;
+    }
+    
+    void playout_loop() {
         while (running_) {
-            size_t size;
-            uint32_t timestamp;
+            std::chrono::steady_clock::time_point wake_at;
+            switch (playout_step(wake_at)) {
+                case PlayoutStep::Continue:
+                    break;
+                case PlayoutStep::Sleep:
+                    sleep_until(wake_at);
+                    break;
+                case PlayoutStep::WaitData:
+                    // Block until the receive thread writes more audio
+                    jitter_buffer_->wait(std::chrono::milliseconds(100));
+                    break;
+            }
+        }
+    }
+    
+    // One playout iteration, shared by the playout thread and the engine timer
+    PlayoutStep playout_step(std::chrono::steady_clock::time_point& wake_at) {
+        const uint32_t rate = sdp_info_.format.sample_rate;
+        const uint32_t bpf = sdp_info_.format.bytes_per_frame();
+        const uint32_t block = playout_block_;
+        uint8_t* buffer = playout_buffer_.data();
+        stats_.playout_wakeups++;
+        
+        if (playout_ptp_mode_ && ptp_sync_ && ptp_sync_->has_valid_time()) {
+            // Position that should be at the output right now
+            uint64_t now_ptp = ptp_sync_->get_ptp_timestamp();
+            uint32_t due = media_clock_.rtp_timestamp(now_ptp) - audio_config_.link_offset_samples;
+            int32_t ahead = static_cast<int32_t>(due - playout_next_ts_);
+            if (!playout_ptp_locked_ || ahead < 0 || ahead > static_cast<int32_t>(rate / 10)) {
+                // (Re)align to the media clock after start, a step or a stall
+                playout_next_ts_ = due - block;
+                playout_ptp_locked_ = true;
+                ahead = static_cast<int32_t>(block);
+            }
             
-            if (jitter_buffer_->pop(buffer.data(), buffer.size(), size, timestamp)) {
-                // Send to audio output
-                if (audio_sink_) {
-                    audio_sink_->write(buffer.data(), size);
+            if (ahead < static_cast<int32_t>(block)) {
+                // The instant the next block becomes fully due
+                uint64_t due_ptp = media_clock_.ptp_time(
+                    playout_next_ts_ + block + audio_config_.link_offset_samples, now_ptp);
+                auto wait = std::chrono::nanoseconds(due_ptp > now_ptp ? due_ptp - now_ptp : 0);
+                wake_at = std::chrono::steady_clock::now() + wait;
+                return PlayoutStep::Sleep;
+            }
+            
+            // A committed switch takes over at its first sample, mid-block if need be
+            const uint32_t head = frames_before_switch(playout_next_ts_, block);
+            bool complete = head == 0 || jitter_buffer_->read(playout_next_ts_, buffer, head);
+            if (head < block) {
+                swap_to_standby();
+                complete = jitter_buffer_->read(playout_next_ts_ + head, buffer + static_cast<size_t>(head) * bpf,
+                                                block - head) && complete;
+            }
+            if (!complete) {
+                stats_.underruns = jitter_buffer_->get_underruns();
+            }
+            playout_next_ts_ += block;
+            if (audio_sink_) {
+                audio_sink_->write(buffer, static_cast<size_t>(block) * bpf);
+            }
+            return PlayoutStep::Continue;
+        }
+        playout_ptp_locked_ = false;
+        
+        size_t size;
+        uint32_t timestamp;
+        if (jitter_buffer_->pop(buffer, playout_buffer_.size(), size, timestamp)) {
+            // Audio from the switch instant on belongs to the new stream
+            const uint32_t frames = static_cast<uint32_t>(size / std::max<uint32_t>(bpf, 1));
+            const uint32_t head = frames_before_switch(timestamp, frames);
+            if (head < frames) {
+                size = static_cast<size_t>(head) * bpf;
+                swap_to_standby();
+            }
+            
+            // Send to audio output
+            if (audio_sink_ && size > 0) {
+                audio_sink_->write(buffer, size);
+            }
+            return PlayoutStep::Continue;
+        }
+        if (switch_state_.load(std::memory_order_acquire) == SwitchState::Committed) {
+            // The current stream ran dry before the switch instant
+            swap_to_standby();
+            return PlayoutStep::Continue;
+        }
+        stats_.underruns = jitter_buffer_->get_underruns();
+        return PlayoutStep::WaitData;
+    }
+    
+    // Hand the stream to the shared packet ring; false to receive on the socket
+    bool subscribe_packet_ring() {
+#ifdef __linux__
+        if (config_.receive_mode != "packet_ring") return false;
+        if (!packet_ring_ || !packet_ring_->is_running()) {
+            LOG_WARNING("Receiver {}: no packet ring running, using recvmmsg", config_.id);
+            return false;
+        }
+        
+        bool subscribed = packet_ring_->subscribe(sdp_info_.source_ip, sdp_info_.port,
+            [this](const uint8_t* data, size_t size, const timespec& kernel_ts) {
+                ArrivalClock clock = ArrivalClock::sample();
+                update_wakeup_latency(clock.delay_us(kernel_ts));
+                process_rtp_packet(data, size, clock.to_steady(kernel_ts));
+            });
+        if (!subscribed) {
+            LOG_WARNING("Receiver {}: packet ring subscription failed, using recvmmsg", config_.id);
+            return false;
+        }
+        
+        // The socket only holds the membership; drop what it would queue
+        sock_filter drop_all{BPF_RET | BPF_K, 0, 0, 0};
+        sock_fprog program{1, &drop_all};
+        if (setsockopt(socket_fd_, SOL_SOCKET, SO_ATTACH_FILTER, &program, sizeof(program)) == 0) {
+            while (recv(socket_fd_, nullptr, 0, MSG_DONTWAIT | MSG_TRUNC) >= 0) {
+            }
+        }
+        LOG_INFO("Receiver {} receiving {}:{} from the packet ring",
+                 config_.id, sdp_info_.source_ip, sdp_info_.port);
+        return true;
+#else
+        return false;
+#endif
+    }
+    
+    void unsubscribe_packet_ring() {
+#ifdef __linux__
+        if (!packet_ring_rx_) return;
+        packet_ring_->unsubscribe(sdp_info_.source_ip, sdp_info_.port);
+        setsockopt(socket_fd_, SOL_SOCKET, SO_DETACH_FILTER, nullptr, 0);
+#endif
+    }
+    
+    // Attach the socket (and a playout timer unless pulled) to the engine;
+    // false if there is no running engine and the receiver needs threads
+    bool attach_to_engine(bool pull) {
+#ifdef __linux__
+        if (!engine_ || !engine_->is_running()) return false;
+        
+        // The playout timer goes first: once the socket is attached its
+        // handler may run, so nothing after that can fail
+        int worker = -1;
+        if (!pull) {
+            playout_timer_fd_ = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+            if (playout_timer_fd_ >= 0) {
+                playout_timer_deadline_ = {};
+                playout_waiting_ = false;
+                worker = engine_->attach(playout_timer_fd_, EPOLLIN, [this](uint32_t) { on_playout_timer(); });
+            }
+            if (worker < 0) {
+                LOG_WARNING("Receiver {}: engine playout timer failed, using own threads", config_.id);
+                close_playout_timer();
+                return false;
+            }
+        }
+        
+        if (packet_ring_rx_) {
+            // The ring thread receives; the worker only plays out, woken
+            // by the jitter buffer when audio arrives after it ran dry
+            if (!pull) {
+                engine_worker_ = engine_->attach(jitter_buffer_->event_fd(), EPOLLIN,
+                                                 [this](uint32_t) { on_audio_ready(); }, worker);
+                if (engine_worker_ < 0) {
+                    LOG_WARNING("Receiver {}: engine attach failed, using own threads", config_.id);
+                    close_playout_timer();
+                    return false;
                 }
-            } else {
-                // No data available, sleep briefly
-                std::this_thread::sleep_for(std::chrono::microseconds(500));
+                arm_playout_timer(std::chrono::steady_clock::now());
+                LOG_INFO("Receiver {} playout on engine worker {}", config_.id, engine_worker_);
             }
+            return true;
         }
+        
+        int flags = fcntl(socket_fd_, F_GETFL, 0);
+        fcntl(socket_fd_, F_SETFL, flags | O_NONBLOCK);
+        
+        // Same worker as the timer, so receive and playout never overlap
+        engine_worker_ = engine_->attach(socket_fd_, EPOLLIN, [this](uint32_t) { on_socket_ready(); }, worker);
+        if (engine_worker_ < 0) {
+            LOG_WARNING("Receiver {}: engine attach failed, using own threads", config_.id);
+            fcntl(socket_fd_, F_SETFL, flags);
+            close_playout_timer();
+            return false;
+        }
+        if (!pull) {
+            arm_playout_timer(std::chrono::steady_clock::now());
+        }
+        
+        LOG_INFO("Receiver {} attached to engine worker {}", config_.id, engine_worker_);
+        return true;
+#else
+        (void)pull;
+        return false;
+#endif
+    }
+    
+    void detach_from_engine() {
+#ifdef __linux__
+        close_playout_timer();
+        if (engine_worker_ >= 0 && packet_ring_rx_) {
+            engine_->detach(jitter_buffer_->event_fd());
+            engine_worker_ = -1;
+        } else if (engine_worker_ >= 0) {
+            // running_ is clear, so handlers no longer swap the socket, the
+            // ring or the stream; this lock waits out a swap in progress
+            int ring_fd = -1;
+            int standby_fd = -1;
+            {
+                std::lock_guard<std::mutex> lock(ring_mutex_);
+                ring_fd = ring_ ? ring_->fd() : -1;
+                standby_fd = standby_.socket_fd;
+            }
+            engine_->detach(socket_fd_);
+            if (ring_fd >= 0) {
+                engine_->detach(ring_fd);
+            }
+            if (standby_fd >= 0) {
+                engine_->detach(standby_fd);
+            }
+            ring_.reset();
+            engine_worker_ = -1;
+            
+            // Own threads block in the receive call
+            int flags = fcntl(socket_fd_, F_GETFL, 0);
+            fcntl(socket_fd_, F_SETFL, flags & ~O_NONBLOCK);
+        }
+#endif
+    }
+
+#ifdef __linux__
+    void close_playout_timer() {
+        if (playout_timer_fd_ >= 0) {
+            engine_->detach(playout_timer_fd_);
+            close(playout_timer_fd_);
+            playout_timer_fd_ = -1;
+        }
+    }
+    
+    // Engine worker: drain a bounded amount, epoll reports the rest
+    void on_socket_ready() {
+        // io_uring receives on behalf of the submitting thread, so the ring
+        // is created here on the worker once the first datagram arrives
+        if (config_.receive_mode == "io_uring" && !ring_failed_ && switch_to_ring()) {
+            return;
+        }
+        
+        if (config_.receive_mode == "poll") {
+            for (uint32_t i = 0; i < config_.rx_batch_size && receive_single(MSG_DONTWAIT); ++i) {
+            }
+        } else {
+            for (int i = 0; i < ENGINE_RX_CALLS; ++i) {
+                if (receive_batch(MSG_DONTWAIT) < static_cast<int>(rx_msgs_.size())) break;
+            }
+        }
+        update_rx_statistics();
+        
+        // New audio resumes playout that ran dry
+        if (playout_waiting_) {
+            run_playout();
+        }
+    }
+    
+    // Engine worker: receive the prepared stream ahead of its switch
+    void on_standby_ready() {
+        if (config_.receive_mode == "poll") {
+            for (uint32_t i = 0; i < config_.rx_batch_size && receive_single(MSG_DONTWAIT, true); ++i) {
+            }
+        } else {
+            for (int i = 0; i < ENGINE_RX_CALLS; ++i) {
+                if (receive_batch(MSG_DONTWAIT, true) < static_cast<int>(rx_msgs_.size())) break;
+            }
+        }
+    }
+    
+    // Engine worker: frames of a block at timestamp that the current
+    // stream still plays (all of them unless a committed switch is due)
+    uint32_t frames_before_switch(uint32_t timestamp, uint32_t frames) const {
+        if (switch_state_.load(std::memory_order_acquire) != SwitchState::Committed) return frames;
+        return frames_before(timestamp, frames, standby_.retire_ts);
+    }
+    
+    // Engine worker: the committed stream takes over. The old socket (or
+    // ring) closes here; the old jitter buffer and description wait in
+    // standby_ for the control thread to release them
+    void swap_to_standby() {
+        std::lock_guard<std::mutex> lock(ring_mutex_);
+        if (!running_) return;
+        
+        if (ring_) {
+            engine_->detach(ring_->fd());
+            ring_.reset();
+        }
+        engine_->detach(socket_fd_);
+        close(socket_fd_);
+        engine_->detach(standby_.socket_fd);
+        socket_fd_ = standby_.socket_fd;
+        standby_.socket_fd = -1;
+        if (engine_->attach(socket_fd_, EPOLLIN, [this](uint32_t) { on_socket_ready(); }, engine_worker_) < 0) {
+            LOG_ERROR("Receiver {}: engine attach of the new stream failed", config_.id);
+        }
+        
+        // Both timelines advance from the switch instant: shift the playout position
+        std::swap(jitter_buffer_, standby_.jitter_buffer);
+        std::swap(sdp_info_, standby_.sdp_info);
+        media_clock_ = standby_.media_clock;
+        playout_next_ts_ += standby_.gate_ts - standby_.retire_ts;
+        last_sequence_valid_ = false;
+        last_transit_valid_ = false;
+        switch_state_.store(SwitchState::Done, std::memory_order_release);
+    }
+    
+    // Move the receive from the socket to a new ring on this worker
+    bool switch_to_ring() {
+        std::lock_guard<std::mutex> lock(ring_mutex_);
+        if (!running_ || !open_ring()) return false;
+        
+        if (engine_->attach(ring_->fd(), EPOLLIN, [this](uint32_t) { on_ring_ready(); }, engine_worker_) < 0) {
+            LOG_WARNING("Receiver {}: engine attach of io_uring failed, using recvmmsg", config_.id);
+            ring_.reset();
+            ring_failed_ = true;
+            return false;
+        }
+        engine_->detach(socket_fd_);
+        return true;
+    }
+    
+    void on_ring_ready() {
+        if (receive_ring(0) < 0) {
+            // Back to recvmmsg on the socket
+            std::lock_guard<std::mutex> lock(ring_mutex_);
+            if (!running_) return;
+            LOG_WARNING("Receiver {}: io_uring receive failed, falling back to recvmmsg", config_.id);
+            ring_failed_ = true;
+            engine_->detach(ring_->fd());
+            ring_.reset();
+            engine_->attach(socket_fd_, EPOLLIN, [this](uint32_t) { on_socket_ready(); }, engine_worker_);
+            return;
+        }
+        update_rx_statistics();
+        
+        if (playout_waiting_) {
+            run_playout();
+        }
+    }
+    
+    // Engine worker, packet ring mode: audio arrived after playout ran dry
+    void on_audio_ready() {
+        uint64_t value;
+        ssize_t n = ::read(jitter_buffer_->event_fd(), &value, sizeof(value));
+        (void)n;
+        if (playout_waiting_) {
+            run_playout();
+        }
+    }
+    
+    void on_playout_timer() {
+        uint64_t expirations;
+        ssize_t n = ::read(playout_timer_fd_, &expirations, sizeof(expirations));
+        (void)n;
+        run_playout();
+    }
+    
+    void run_playout() {
+        playout_waiting_ = false;
+        for (int i = 0; i < ENGINE_PLAYOUT_STEPS; ++i) {
+            std::chrono::steady_clock::time_point wake_at;
+            switch (playout_step(wake_at)) {
+                case PlayoutStep::Continue:
+                    continue;
+                case PlayoutStep::Sleep:
+                    arm_playout_timer(wake_at);
+                    return;
+                case PlayoutStep::WaitData: {
+                    if (packet_ring_rx_ && jitter_buffer_->arm_wait()) {
+                        continue;   // Arrived while this step ran
+                    }
+                    // Received audio restarts playout; the timer only catches a
+                    // stall, so keep one that is already pending
+                    playout_waiting_ = true;
+                    auto now = std::chrono::steady_clock::now();
+                    if (playout_timer_deadline_ <= now) {
+                        arm_playout_timer(now + std::chrono::milliseconds(100));
+                    }
+                    return;
+                }
+            }
+        }
+        // Yield to the other streams on this worker, continue next wakeup
+        arm_playout_timer(std::chrono::steady_clock::now());
+    }
+    
+    void arm_playout_timer(std::chrono::steady_clock::time_point deadline) {
+        // steady_clock is CLOCK_MONOTONIC; a past deadline fires at once
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+        itimerspec spec{};
+        spec.it_value.tv_sec = static_cast<time_t>(ns / 1000000000LL);
+        spec.it_value.tv_nsec = static_cast<long>(ns % 1000000000LL);
+        timerfd_settime(playout_timer_fd_, TFD_TIMER_ABSTIME, &spec, nullptr);
+        playout_timer_deadline_ = deadline;
+    }
+#endif
+    
+    // Pull mode: runs on the PipeWire RT thread, must not block or allocate
+    void pull_playout(uint8_t* data, uint32_t frames) {
+        const size_t bpf = sdp_info_.format.bytes_per_frame();
+        const size_t total = static_cast<size_t>(frames) * bpf;
+        stats_.playout_wakeups++;
+        
+        if (audio_config_.playout_mode == "ptp" && ptp_sync_ && ptp_sync_->has_valid_time()) {
+            uint32_t due = media_clock_.rtp_timestamp(ptp_sync_->get_ptp_timestamp()) -
+                           audio_config_.link_offset_samples;
+            int32_t drift = static_cast<int32_t>(due - pull_next_ts_);
+            if (!pull_locked_ || std::abs(drift) > static_cast<int32_t>(frames * 2)) {
+                // Graph clock and PTP have diverged by more than a cycle: realign
+                pull_next_ts_ = due;
+                pull_locked_ = true;
+            }
+            if (!jitter_buffer_->read(pull_next_ts_, data, frames)) {
+                stats_.underruns = jitter_buffer_->get_underruns();
+            }
+            pull_next_ts_ += frames;
+            return;
+        }
+        pull_locked_ = false;
+        
+        size_t filled = 0;
+        while (filled < total) {
+            size_t size;
+            uint32_t timestamp;
+            if (!jitter_buffer_->pop(data + filled, total - filled, size, timestamp)) break;
+            filled += size;
+        }
+        if (filled < total) {
+            std::memset(data + filled, 0, total - filled);
+            stats_.underruns = jitter_buffer_->get_underruns();
+        }
+    }
+    
+    // Absolute-deadline sleep: immune to the drift of relative sleeps after EINTR
+    static void sleep_until(std::chrono::steady_clock::time_point deadline) {
+#ifdef __linux__
+        // steady_clock is CLOCK_MONOTONIC
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+        timespec ts{};
+        ts.tv_sec = static_cast<time_t>(ns / 1000000000LL);
+        ts.tv_nsec = static_cast<long>(ns % 1000000000LL);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+        }
+#else
+        std::this_thread::sleep_until(deadline);
+#endif
     }
     
     void notify_state_change() {
@@ -611,22 +1861,96 @@ private:
     
     std::shared_ptr<PipeWireOutput> audio_sink_;
     std::shared_ptr<PTPSync> ptp_sync_;
+    JitterBuffer::Config jitter_config_;
     std::unique_ptr<JitterBuffer> jitter_buffer_;
+    std::vector<uint8_t> decode_buffer_;  // Depacketized host-order samples
     
     std::string sender_id_;
     
 #ifdef __linux__
     int socket_fd_ = -1;
+    
+    // Single-datagram receive buffer (poll mode)
+    std::vector<uint8_t> rx_buffer_;
+    
+    // Batched receive slots
+    std::vector<uint8_t> rx_slots_;
+    std::vector<uint8_t> rx_control_;
+    std::vector<iovec> rx_iovecs_;
+    std::vector<mmsghdr> rx_msgs_;
+    
+    // io_uring receive (receive thread or engine worker)
+    std::unique_ptr<UringReceiveRing> ring_;
+    mutable std::mutex ring_mutex_;     // Engine mode: swapping between socket and ring
+    UringReceiveStats ring_stats_{};
+    ArrivalClock ring_clock_{};
+    bool ring_clock_valid_ = false;
+    bool ring_failed_ = false;          // Unsupported here; stay on recvmmsg
 #endif
     
     std::thread receive_thread_;
     std::thread playout_thread_;
     
+    // Shared engine (no own threads while attached)
+    std::shared_ptr<ReceiverEngine> engine_;
+    int engine_worker_ = -1;
+    int playout_timer_fd_ = -1;
+    std::chrono::steady_clock::time_point playout_timer_deadline_;
+    bool playout_waiting_ = false;
+    
+    // Shared packet ring (receive_mode "packet_ring")
+    std::shared_ptr<PacketRing> packet_ring_;
+    bool packet_ring_rx_ = false;       // Subscribed for this run, no receive thread
+    
+    // Push-mode playout state (playout thread or engine worker)
+    std::vector<uint8_t> playout_buffer_;
+    uint32_t playout_block_ = 0;
+    uint32_t playout_next_ts_ = 0;
+    bool playout_ptp_locked_ = false;
+    bool playout_ptp_mode_ = false;
+    
+    // Stream media clock (RTP <-> PTP), set on start
+    MediaClock media_clock_;
+    
+    // Pull-mode PTP playout position (PipeWire RT thread only)
+    uint32_t pull_next_ts_ = 0;
+    bool pull_locked_ = false;
+    
+    // Timed switch (prepare_switch). Prepared on the control thread; once
+    // committed the engine worker swaps it in and marks it Done, and the
+    // control thread releases what it left behind
+    enum class SwitchState {
+        Idle,
+        Prepared,       // New stream received alongside (or receiver started and gated)
+        Committed,      // Worker swaps at retire_ts
+        Done            // Swapped; standby_ holds the old jitter buffer
+    };
+    struct StandbyStream {
+        SDPInfo sdp_info;                   // Restart: the previous stream, to restore
+        AudioFormat format;
+        MediaClock media_clock;
+        std::unique_ptr<JitterBuffer> jitter_buffer;
+        int socket_fd = -1;
+        uint32_t gate_ts = 0;               // New stream's RTP timestamp at the switch
+        uint32_t retire_ts = 0;             // Current stream's RTP timestamp at the switch
+        bool restart = false;               // Receiver was stopped and started gated
+        bool reconnect = false;             // Restart: it was connected before
+    };
+    std::mutex switch_mutex_;               // Control side of the switch; never taken by the data path
+    std::atomic<SwitchState> switch_state_{SwitchState::Idle};
+    StandbyStream standby_;
+    uint64_t switch_handle_ = 0;
+    uint64_t next_switch_handle_ = 1;
+    bool start_gated_ = false;              // Data path: drop audio before start_gate_ts_
+    uint32_t start_gate_ts_ = 0;
+    
     ReceiverStatistics stats_{};
     std::function<void(ReceiverState)> state_callback_;
     
     uint16_t last_sequence_ = 0;
     bool last_sequence_valid_ = false;
+    double last_transit_ = 0.0;
+    bool last_transit_valid_ = false;
 };
 
 // ==================== AES67Receiver ====================
@@ -640,6 +1964,8 @@ bool AES67Receiver::configure(const ReceiverConfig& config, const AudioProcessin
 }
 void AES67Receiver::set_audio_sink(std::shared_ptr<PipeWireOutput> sink) { impl_->set_audio_sink(std::move(sink)); }
 void AES67Receiver::set_ptp_sync(std::shared_ptr<PTPSync> ptp) { impl_->set_ptp_sync(std::move(ptp)); }
+void AES67Receiver::set_engine(std::shared_ptr<ReceiverEngine> engine) { impl_->set_engine(std::move(engine)); }
+void AES67Receiver::set_packet_ring(std::shared_ptr<PacketRing> ring) { impl_->set_packet_ring(std::move(ring)); }
 bool AES67Receiver::initialize() { return impl_->initialize(); }
 bool AES67Receiver::connect(const std::string& sdp) { return impl_->connect(sdp); }
 bool AES67Receiver::connect(const std::string& source_ip, uint16_t port, const AudioFormat& format) {
@@ -648,6 +1974,15 @@ bool AES67Receiver::connect(const std::string& source_ip, uint16_t port, const A
 void AES67Receiver::disconnect() { impl_->disconnect(); }
 bool AES67Receiver::start() { return impl_->start(); }
 void AES67Receiver::stop() { impl_->stop(); }
+uint64_t AES67Receiver::prepare_switch(const std::string& sdp, int64_t switch_ns) {
+    return impl_->prepare_switch(sdp, switch_ns);
+}
+uint64_t AES67Receiver::prepare_switch(const std::string& source_ip, uint16_t port, const AudioFormat& format,
+                                       int64_t switch_ns) {
+    return impl_->prepare_switch(source_ip, port, format, switch_ns);
+}
+bool AES67Receiver::commit_switch(uint64_t handle) { return impl_->commit_switch(handle); }
+void AES67Receiver::cancel_switch(uint64_t handle) { impl_->cancel_switch(handle); }
 bool AES67Receiver::is_running() const { return impl_->is_running(); }
 bool AES67Receiver::is_connected() const { return impl_->is_connected(); }
 ReceiverState AES67Receiver::get_state() const { return impl_->get_state(); }
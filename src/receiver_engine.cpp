@@ -0,0 +1,372 @@
+// SPDX-License-Identifier: MIT
+/*
+ * RPi-AES67 - Professional AES67 Sender/Receiver for Raspberry Pi 5
+ * Copyright (c) 2025 DHPKE
+ *
+ * Shared receiver I/O reactor implementation.
+ */
+
+#include "rpi_aes67/receiver_engine.h"
+#include "rpi_aes67/logger.h"
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+#include <algorithm>
+#include <cstring>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+namespace rpi_aes67 {
+
+namespace {
+
+// epoll user data of the stop eventfd
+constexpr uint64_t WAKE_KEY = ~0ULL;
+
+// Worker whose loop runs on this thread (nullptr elsewhere)
+thread_local const void* t_current_worker = nullptr;
+
+}  // namespace
+
+class ReceiverEngine::Impl {
+public:
+    Impl() = default;
+    
+    ~Impl() {
+        stop();
+    }
+    
+    bool start(const ReceiverEngineConfig& config) {
+        if (running_) return true;
+
+#ifdef __linux__
+        config_ = config;
+        uint32_t count = config_.workers;
+        if (count == 0) {
+            count = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+        config_.max_events = std::clamp<uint32_t>(config_.max_events, 1, 1024);
+        
+        for (uint32_t i = 0; i < count; ++i) {
+            auto worker = std::make_shared<Worker>();
+            worker->index = i;
+            worker->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+            worker->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (worker->epoll_fd < 0 || worker->wake_fd < 0) {
+                LOG_ERROR("Receiver engine: failed to create worker {}: {}", i, strerror(errno));
+                close_worker(*worker);
+                close_workers();
+                return false;
+            }
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.u64 = WAKE_KEY;
+            epoll_ctl(worker->epoll_fd, EPOLL_CTL_ADD, worker->wake_fd, &event);
+            workers_.push_back(std::move(worker));
+        }
+        
+        running_ = true;
+        for (auto& worker : workers_) {
+            Worker* w = worker.get();
+            w->thread = std::thread([this, w]() { worker_loop(*w); });
+        }
+        
+        LOG_INFO("Receiver engine started with {} worker(s)", count);
+        return true;
+#else
+        (void)config;
+        LOG_ERROR("Receiver engine requires Linux");
+        return false;
+#endif
+    }
+    
+    void stop() {
+        if (!running_) return;
+        running_ = false;
+
+#ifdef __linux__
+        for (auto& worker : workers_) {
+            uint64_t one = 1;
+            ssize_t n = ::write(worker->wake_fd, &one, sizeof(one));
+            (void)n;
+        }
+        for (auto& worker : workers_) {
+            if (worker->thread.joinable()) {
+                worker->thread.join();
+            }
+        }
+        close_workers();
+#endif
+        LOG_INFO("Receiver engine stopped");
+    }
+    
+    bool is_running() const { return running_; }
+    
+    uint32_t worker_count() const {
+        std::lock_guard<std::mutex> lock(attach_mutex_);
+        return static_cast<uint32_t>(workers_.size());
+    }
+    
+    // The attach lock is never held while waiting for a worker lock:
+    // handlers (which run under their worker lock) may attach and detach
+    int attach(int fd, uint32_t events, Handler handler, int worker_index) {
+#ifdef __linux__
+        if (fd < 0 || !handler) return -1;
+        
+        std::shared_ptr<Worker> worker;
+        auto source = std::make_shared<Source>();
+        source->handler = std::move(handler);
+        {
+            std::lock_guard<std::mutex> lock(attach_mutex_);
+            if (!running_ || workers_.empty()) return -1;
+            if (fd_worker_.count(fd) != 0) {
+                LOG_ERROR("Receiver engine: descriptor {} is already attached", fd);
+                return -1;
+            }
+            if (worker_index < 0 || static_cast<size_t>(worker_index) >= workers_.size()) {
+                auto least = std::min_element(workers_.begin(), workers_.end(),
+                    [](const auto& a, const auto& b) { return a->attached < b->attached; });
+                worker_index = static_cast<int>(least - workers_.begin());
+            }
+            worker = workers_[static_cast<size_t>(worker_index)];
+            fd_worker_[fd] = worker;
+            worker->attached++;
+            
+            // The generation tells a reused descriptor number from the one it replaced
+            source->key = (static_cast<uint64_t>(++generation_) << 32) | static_cast<uint32_t>(fd);
+        }
+        
+        bool added;
+        {
+            WorkerLock lock(*worker);
+            epoll_event event{};
+            event.events = events;
+            event.data.u64 = source->key;
+            added = worker->epoll_fd >= 0 && epoll_ctl(worker->epoll_fd, EPOLL_CTL_ADD, fd, &event) == 0;
+            if (added) {
+                worker->sources[fd] = source;
+            }
+        }
+        
+        if (!added) {
+            LOG_ERROR("Receiver engine: failed to watch descriptor {}: {}", fd, strerror(errno));
+            std::lock_guard<std::mutex> lock(attach_mutex_);
+            auto it = fd_worker_.find(fd);
+            if (it != fd_worker_.end() && it->second == worker) {
+                fd_worker_.erase(it);
+                worker->attached--;
+            }
+            return -1;
+        }
+        return worker_index;
+#else
+        (void)fd;
+        (void)events;
+        (void)handler;
+        (void)worker_index;
+        return -1;
+#endif
+    }
+    
+    void detach(int fd) {
+#ifdef __linux__
+        std::shared_ptr<Worker> worker;
+        {
+            std::lock_guard<std::mutex> lock(attach_mutex_);
+            auto it = fd_worker_.find(fd);
+            if (it == fd_worker_.end()) return;
+            worker = it->second;
+            fd_worker_.erase(it);
+            worker->attached--;
+        }
+        
+        // Taking the worker lock waits out a dispatch in progress; if we are
+        // called from the handler itself, the dispatcher's copy keeps it alive
+        WorkerLock lock(*worker);
+        auto it = worker->sources.find(fd);
+        if (it != worker->sources.end()) {
+            if (worker->epoll_fd >= 0) {
+                epoll_ctl(worker->epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+            }
+            worker->sources.erase(it);
+        }
+#else
+        (void)fd;
+#endif
+    }
+    
+    ReceiverEngineStatistics get_statistics() const {
+        std::lock_guard<std::mutex> lock(attach_mutex_);
+        ReceiverEngineStatistics stats;
+        stats.workers = static_cast<uint32_t>(workers_.size());
+        for (const auto& worker : workers_) {
+            stats.wakeups += worker->wakeups.load(std::memory_order_relaxed);
+            stats.events += worker->events.load(std::memory_order_relaxed);
+            stats.attached.push_back(worker->attached);
+        }
+        return stats;
+    }
+
+private:
+    struct Source {
+        uint64_t key = 0;
+        Handler handler;
+    };
+    
+    struct Worker {
+        uint32_t index = 0;
+        int epoll_fd = -1;
+        int wake_fd = -1;
+        std::thread thread;
+        
+        // Held for a whole dispatch batch; detach() takes it to wait one out
+        std::mutex mutex;
+        std::unordered_map<int, std::shared_ptr<Source>> sources;
+        uint32_t attached = 0;          // Guarded by attach_mutex_
+        
+        std::atomic<uint64_t> wakeups{0};
+        std::atomic<uint64_t> events{0};
+    };
+    
+    // Worker mutex, skipped when already held by this thread (calls from a handler)
+    class WorkerLock {
+    public:
+        explicit WorkerLock(Worker& worker)
+            : worker_(worker), owned_(t_current_worker != &worker) {
+            if (owned_) worker_.mutex.lock();
+        }
+        ~WorkerLock() {
+            if (owned_) worker_.mutex.unlock();
+        }
+        WorkerLock(const WorkerLock&) = delete;
+        WorkerLock& operator=(const WorkerLock&) = delete;
+    
+    private:
+        Worker& worker_;
+        bool owned_;
+    };
+
+#ifdef __linux__
+    void worker_loop(Worker& worker) {
+        t_current_worker = &worker;
+        apply_worker_policy(worker.index);
+        
+        std::vector<epoll_event> events(config_.max_events);
+        while (running_) {
+            int count = epoll_wait(worker.epoll_fd, events.data(), static_cast<int>(events.size()), -1);
+            if (count < 0) {
+                if (errno == EINTR) continue;
+                LOG_ERROR("Receiver engine: epoll_wait failed on worker {}: {}", worker.index, strerror(errno));
+                break;
+            }
+            worker.wakeups.fetch_add(1, std::memory_order_relaxed);
+            
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            for (int i = 0; i < count; ++i) {
+                uint64_t key = events[i].data.u64;
+                if (key == WAKE_KEY) continue;
+                
+                // Skip events of descriptors detached earlier in this batch
+                auto it = worker.sources.find(static_cast<int>(key & 0xFFFFFFFFu));
+                if (it == worker.sources.end() || it->second->key != key) continue;
+                
+                std::shared_ptr<Source> source = it->second;
+                source->handler(events[i].events);
+                worker.events.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+    
+    void apply_worker_policy(uint32_t index) {
+        int cpu = index < config_.worker_cpus.size() ? config_.worker_cpus[index] : -1;
+        if (cpu >= 0) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(cpu, &cpus);
+            if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) != 0) {
+                LOG_WARNING("Receiver engine: failed to pin worker {} to CPU {}", index, cpu);
+            }
+        }
+        if (config_.worker_priority > 0) {
+            sched_param param{};
+            param.sched_priority = config_.worker_priority;
+            if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0) {
+                LOG_WARNING("Receiver engine: SCHED_FIFO priority {} not permitted (needs CAP_SYS_NICE or rtprio limit)",
+                           config_.worker_priority);
+            }
+        }
+    }
+    
+    static void close_worker(Worker& worker) {
+        if (worker.epoll_fd >= 0) {
+            close(worker.epoll_fd);
+            worker.epoll_fd = -1;
+        }
+        if (worker.wake_fd >= 0) {
+            close(worker.wake_fd);
+            worker.wake_fd = -1;
+        }
+    }
+    
+    void close_workers() {
+        std::lock_guard<std::mutex> lock(attach_mutex_);
+        for (auto& worker : workers_) {
+            std::lock_guard<std::mutex> worker_lock(worker->mutex);
+            close_worker(*worker);
+            worker->sources.clear();
+        }
+        workers_.clear();
+        fd_worker_.clear();
+    }
+#endif
+    
+    ReceiverEngineConfig config_;
+    std::atomic<bool> running_{false};
+    
+    mutable std::mutex attach_mutex_;   // Worker list and descriptor ownership
+    std::vector<std::shared_ptr<Worker>> workers_;
+    std::unordered_map<int, std::shared_ptr<Worker>> fd_worker_;
+    uint32_t generation_ = 0;
+};
+
+// ReceiverEngine public interface
+
+ReceiverEngine::ReceiverEngine() : impl_(std::make_unique<Impl>()) {}
+ReceiverEngine::~ReceiverEngine() = default;
+
+bool ReceiverEngine::start(const ReceiverEngineConfig& config) {
+    return impl_->start(config);
+}
+
+void ReceiverEngine::stop() {
+    impl_->stop();
+}
+
+bool ReceiverEngine::is_running() const {
+    return impl_->is_running();
+}
+
+uint32_t ReceiverEngine::worker_count() const {
+    return impl_->worker_count();
+}
+
+int ReceiverEngine::attach(int fd, uint32_t events, Handler handler, int worker) {
+    return impl_->attach(fd, events, std::move(handler), worker);
+}
+
+void ReceiverEngine::detach(int fd) {
+    impl_->detach(fd);
+}
+
+ReceiverEngineStatistics ReceiverEngine::get_statistics() const {
+    return impl_->get_statistics();
+}
+
+}  // namespace rpi_aes67
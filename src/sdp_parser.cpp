@@ -0,0 +1,423 @@
+// SPDX-License-Identifier: MIT
+/*
+ * RPi-AES67 - Professional AES67 Sender/Receiver for Raspberry Pi 5
+ * Copyright (c) 2025 DHPKE
+ *
+ * SDP parser implementation.
+ */
+
+#include "rpi_aes67/receiver.h"
+#include "rpi_aes67/logger.h"
+#include "rpi_aes67/media_clock.h"
+#include <algorithm>
+#include <charconv>
+
+namespace rpi_aes67 {
+
+namespace {
+
+constexpr std::string_view WHITESPACE = " \t";
+
+// Next whitespace-separated token; empty at the end of the text
+std::string_view next_token(std::string_view& text) {
+    size_t start = text.find_first_not_of(WHITESPACE);
+    if (start == std::string_view::npos) {
+        text = {};
+        return {};
+    }
+    text.remove_prefix(start);
+    size_t end = std::min(text.find_first_of(WHITESPACE), text.size());
+    std::string_view token = text.substr(0, end);
+    text.remove_prefix(end);
+    return token;
+}
+
+// Text before the first separator; text keeps what follows it
+std::string_view split(std::string_view& text, char separator) {
+    size_t pos = text.find(separator);
+    std::string_view head = text.substr(0, pos);
+    text = pos == std::string_view::npos ? std::string_view{} : text.substr(pos + 1);
+    return head;
+}
+
+template <typename T>
+bool parse_number(std::string_view text, T& value) {
+    if (text.empty()) return false;
+    auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return ec == std::errc() && end == text.data() + text.size();
+}
+
+bool is_ipv4(std::string_view text) {
+    if (std::count(text.begin(), text.end(), '.') != 3) return false;
+    for (int i = 0; i < 4; ++i) {
+        std::string_view octet = split(text, '.');
+        uint8_t value;
+        if (octet.size() > 3 || !parse_number(octet, value)) return false;
+        if ((i < 3) == text.empty()) return false;
+    }
+    return true;
+}
+
+// Decimal milliseconds ("1", "0.125", "0.333") to microseconds
+bool parse_ptime_us(std::string_view text, uint32_t& us) {
+    std::string_view whole = split(text, '.');
+    uint32_t ms = 0;
+    if (!parse_number(whole, ms) || ms > 1000000) return false;
+    
+    uint32_t fraction = 0;
+    uint32_t scale = 100;
+    for (size_t i = 0; i < text.size(); ++i) {
+        char c = text[i];
+        if (c < '0' || c > '9') return false;
+        if (i < 3) {
+            fraction += static_cast<uint32_t>(c - '0') * scale;
+            scale /= 10;
+        } else if (i == 3 && c >= '5') {
+            fraction += 1;   // Round to the microsecond
+        }
+    }
+    us = ms * 1000 + fraction;
+    return true;
+}
+
+uint8_t bit_depth_for(std::string_view encoding) {
+    if (encoding == "L16") return 16;
+    if (encoding == "L24") return 24;
+    if (encoding == "L32") return 32;
+    return 0;
+}
+
+/**
+ * Parser state for one description: session-level defaults, the section
+ * being filled and the first error.
+ */
+class SDPReader {
+public:
+    explicit SDPReader(SDPInfo& info) : info_(info) {}
+    
+    void parse(std::string_view sdp) {
+        while (!sdp.empty() && !info_.error) {
+            std::string_view line = split(sdp, '\n');
+            ++line_;
+            if (!line.empty() && line.back() == '\r') {
+                line.remove_suffix(1);
+            }
+            if (line.empty()) continue;
+            if (line.size() < 2 || line[1] != '=') {
+                fail(SDPErrorCode::MalformedLine, "expected <type>=<value>");
+                return;
+            }
+            
+            std::string_view value = line.substr(2);
+            switch (line[0]) {
+                case 's':
+                    info_.session_name = std::string(value);
+                    break;
+                case 'o':
+                    parse_origin(value);
+                    break;
+                case 'c':
+                    parse_connection(value);
+                    break;
+                case 'm':
+                    parse_media(value);
+                    break;
+                case 'a':
+                    parse_attribute(value);
+                    break;
+                default:
+                    break;
+            }
+        }
+        if (!info_.error) {
+            finish();
+        }
+    }
+
+private:
+    // Section attributes apply to the current m= section, or to the
+    // session defaults before the first one
+    SDPMedia& target() { return info_.media.empty() ? session_ : info_.media.back(); }
+    
+    bool fail(SDPErrorCode code, std::string_view message, uint32_t line) {
+        if (!info_.error) {
+            info_.error.code = code;
+            info_.error.line = line;
+            info_.error.message = std::string(message);
+        }
+        return false;
+    }
+    
+    bool fail(SDPErrorCode code, std::string_view message) { return fail(code, message, line_); }
+    
+    // o=<username> <sess-id> <sess-version> <nettype> <addrtype> <address>
+    void parse_origin(std::string_view value) {
+        next_token(value);
+        std::string_view session_id = next_token(value);
+        next_token(value);
+        next_token(value);
+        next_token(value);
+        std::string_view address = next_token(value);
+        if (address.empty()) {
+            fail(SDPErrorCode::MalformedLine, "o= needs six fields");
+            return;
+        }
+        info_.session_id = std::string(session_id);
+        info_.origin_address = std::string(address);
+    }
+    
+    // c=IN IP4 <address>[/<ttl>[/<count>]]
+    void parse_connection(std::string_view value) {
+        std::string_view nettype = next_token(value);
+        std::string_view addrtype = next_token(value);
+        std::string_view address = next_token(value);
+        if (address.empty()) {
+            fail(SDPErrorCode::MalformedLine, "c= needs three fields");
+            return;
+        }
+        if (nettype != "IN" || addrtype != "IP4") {
+            fail(SDPErrorCode::UnsupportedAddress, "only IN IP4 connections are supported");
+            return;
+        }
+        
+        std::string_view host = split(address, '/');
+        if (!is_ipv4(host)) {
+            fail(SDPErrorCode::InvalidAddress, "c= address is not IPv4");
+            return;
+        }
+        uint8_t ttl = 0;
+        uint16_t count = 1;
+        if (!address.empty()) {
+            std::string_view ttl_text = split(address, '/');
+            if (!parse_number(ttl_text, ttl) || (!address.empty() && (!parse_number(address, count) || count == 0))) {
+                fail(SDPErrorCode::InvalidNumber, "c= TTL or address count out of range");
+                return;
+            }
+        }
+        
+        SDPMedia& media = target();
+        media.connection_address = std::string(host);
+        media.ttl = ttl;
+        media.address_count = count;
+    }
+    
+    // m=<media> <port>[/<count>] <proto> <fmt> ...
+    void parse_media(std::string_view value) {
+        SDPMedia media = session_;
+        media.media = std::string(next_token(value));
+        std::string_view port = next_token(value);
+        media.protocol = std::string(next_token(value));
+        std::string_view format = next_token(value);
+        if (format.empty()) {
+            fail(SDPErrorCode::InvalidMedia, "m= needs media, port, protocol and a format");
+            return;
+        }
+        
+        std::string_view port_text = split(port, '/');
+        if (!parse_number(port_text, media.port) ||
+            (!port.empty() && (!parse_number(port, media.port_count) || media.port_count == 0))) {
+            fail(SDPErrorCode::InvalidNumber, "m= port is not a valid number");
+            return;
+        }
+        
+        // RTP formats are payload types; other protocols use their own tokens
+        if (media.protocol.compare(0, 4, "RTP/") == 0) {
+            if (!parse_number(format, media.payload_type) || media.payload_type > 127) {
+                fail(SDPErrorCode::InvalidMedia, "m= payload type out of range");
+                return;
+            }
+        }
+        info_.media.push_back(std::move(media));
+    }
+    
+    void parse_attribute(std::string_view value) {
+        std::string_view name = split(value, ':');
+        SDPMedia& media = target();
+        
+        if (name == "rtpmap") {
+            parse_rtpmap(value);
+        } else if (name == "ptime") {
+            if (!parse_ptime_us(value, media.packet_time_us) || media.packet_time_us == 0) {
+                fail(SDPErrorCode::InvalidAttribute, "a=ptime is not a positive decimal");
+            }
+        } else if (name == "framecount") {
+            if (!parse_number(value, media.framecount)) {
+                fail(SDPErrorCode::InvalidAttribute, "a=framecount is not a number");
+            }
+        } else if (name == "mediaclk") {
+            // RFC 7273: RTP timestamp offset from the reference clock epoch
+            if (!MediaClock::parse_mediaclk(value, media.media_clock_offset)) {
+                LOG_WARNING("SDP: unsupported media clock '{}', assuming direct=0", value);
+                media.media_clock_offset = 0;
+            }
+        } else if (name == "ts-refclk") {
+            parse_refclk(value, media);
+        } else if (name == "source-filter") {
+            parse_source_filter(value, media);
+        }
+    }
+    
+    // a=rtpmap:<payload type> <encoding>/<clock rate>[/<channels>]
+    void parse_rtpmap(std::string_view value) {
+        uint8_t payload_type = 0;
+        std::string_view encoding = next_token(value);
+        if (!parse_number(encoding, payload_type)) {
+            fail(SDPErrorCode::InvalidAttribute, "a=rtpmap payload type is not a number");
+            return;
+        }
+        encoding = next_token(value);
+        std::string_view name = split(encoding, '/');
+        std::string_view rate = split(encoding, '/');
+        uint32_t sample_rate = 0;
+        uint8_t channels = 1;   // RFC 4566: one channel unless given
+        if (name.empty() || !parse_number(rate, sample_rate) || sample_rate == 0 ||
+            (!encoding.empty() && (!parse_number(encoding, channels) || channels == 0))) {
+            fail(SDPErrorCode::InvalidAttribute, "a=rtpmap needs <encoding>/<rate>[/<channels>]");
+            return;
+        }
+        
+        // Only the mapping of the section's payload type matters
+        if (info_.media.empty() || info_.media.back().payload_type != payload_type) return;
+        SDPMedia& media = info_.media.back();
+        media.encoding = std::string(name);
+        media.format.sample_rate = sample_rate;
+        media.format.channels = channels;
+        if (uint8_t depth = bit_depth_for(name)) {
+            media.format.bit_depth = depth;
+        }
+    }
+    
+    // a=ts-refclk:ptp=IEEE1588-<version>:<clock identity>[:<domain>]
+    static void parse_refclk(std::string_view value, SDPMedia& media) {
+        constexpr std::string_view ptp = "ptp=IEEE1588-";
+        size_t pos = value.find(ptp);
+        if (pos == std::string_view::npos) return;
+        value.remove_prefix(pos + ptp.size());
+        
+        size_t version = value.find_first_not_of("0123456789");
+        if (version == 0 || version == std::string_view::npos || value[version] != ':') return;
+        value.remove_prefix(version + 1);
+        size_t end = std::min(value.find_first_not_of("0123456789ABCDEFabcdef:-"), value.size());
+        if (end > 0) {
+            media.ptp_clock_id = std::string(value.substr(0, end));
+        }
+    }
+    
+    // a=source-filter: <incl|excl> IN IP4 <destination> <source> ...
+    void parse_source_filter(std::string_view value, SDPMedia& media) {
+        std::string_view mode = next_token(value);
+        std::string_view nettype = next_token(value);
+        std::string_view addrtype = next_token(value);
+        std::string_view destination = next_token(value);
+        if ((mode != "incl" && mode != "excl") || nettype != "IN" || destination.empty() ||
+            value.find_first_not_of(WHITESPACE) == std::string_view::npos) {
+            fail(SDPErrorCode::InvalidAttribute, "a=source-filter needs <incl|excl> IN <addrtype> <dest> <source>...");
+            return;
+        }
+        // IPv6 filters may describe other sections; they do not apply here
+        if (addrtype != "IP4" && addrtype != "*") return;
+        
+        std::vector<std::string> sources;
+        for (std::string_view source = next_token(value); !source.empty(); source = next_token(value)) {
+            if (!is_ipv4(source)) {
+                fail(SDPErrorCode::InvalidAddress, "a=source-filter source is not IPv4");
+                return;
+            }
+            sources.emplace_back(source);
+        }
+        media.source_filter = std::string(mode);
+        media.source_addresses = std::move(sources);
+    }
+    
+    // Flatten the first audio section into the stream fields
+    void finish() {
+        const SDPMedia* audio = nullptr;
+        for (const auto& media : info_.media) {
+            if (media.media == "audio") {
+                audio = &media;
+                break;
+            }
+        }
+        if (audio == nullptr) {
+            fail(SDPErrorCode::MissingMedia, "no audio m= section", 0);
+            return;
+        }
+        if (audio->connection_address.empty()) {
+            fail(SDPErrorCode::MissingConnection, "audio section has no c= line", 0);
+            return;
+        }
+        
+        SDPMedia stream = *audio;
+        if (stream.encoding.empty()) {
+            // RFC 3551 static audio payload types used for linear PCM
+            if (stream.payload_type == 10 || stream.payload_type == 11) {
+                stream.encoding = "L16";
+                stream.format.sample_rate = 44100;
+                stream.format.channels = stream.payload_type == 10 ? 2 : 1;
+                stream.format.bit_depth = 16;
+            } else {
+                fail(SDPErrorCode::MissingRtpmap, "no a=rtpmap for the audio payload type", 0);
+                return;
+            }
+        }
+        
+        info_.source_ip = stream.connection_address;
+        info_.port = stream.port;
+        info_.payload_type = stream.payload_type;
+        info_.encoding = stream.encoding;
+        info_.format = stream.format;
+        info_.packet_time_us = stream.packet_time_us;
+        info_.ptp_clock_id = stream.ptp_clock_id;
+        info_.media_clock_offset = stream.media_clock_offset;
+        info_.framecount = stream.framecount;
+        info_.ttl = stream.ttl;
+        info_.address_count = stream.address_count;
+        info_.source_filter = stream.source_filter;
+        info_.source_addresses = stream.source_addresses;
+        
+        info_.is_valid = info_.port > 0 && info_.format.sample_rate > 0 && info_.format.channels > 0;
+    }
+    
+    SDPInfo& info_;
+    SDPMedia session_;
+    uint32_t line_ = 0;
+};
+
+}  // namespace
+
+// ==================== SDPParser ====================
+
+SDPInfo SDPParser::parse(std::string_view sdp) {
+    SDPInfo info;
+    SDPReader(info).parse(sdp);
+    return info;
+}
+
+bool SDPParser::validate_aes67(const SDPInfo& info) {
+    if (!info.is_valid) return false;
+    
+    // AES67 requirements:
+    // - Sample rate: 48000 Hz (mandatory), 96000 Hz, 44100 Hz also allowed
+    // - Bit depth: 16, 24, or 32 bit linear PCM
+    // - Packet time: 1ms (mandatory), 125µs, 250µs, 333µs, 4ms also allowed
+    
+    bool valid_sample_rate = info.format.sample_rate == 44100 ||
+                            info.format.sample_rate == 48000 ||
+                            info.format.sample_rate == 96000;
+    
+    bool valid_bit_depth = info.format.bit_depth == 16 ||
+                          info.format.bit_depth == 24 ||
+                          info.format.bit_depth == 32;
+    
+    bool valid_encoding = info.encoding == "L16" ||
+                         info.encoding == "L24" ||
+                         info.encoding == "L32";
+    
+    return valid_sample_rate && valid_bit_depth && valid_encoding;
+}
+
+AudioFormat SDPParser::extract_format(const SDPInfo& info) {
+    return info.format;
+}
+
+}  // namespace rpi_aes67
@@ -8,6 +8,9 @@
 
 #include "rpi_aes67/sender.h"
 #include "rpi_aes67/logger.h"
+#include "rpi_aes67/media_clock.h"
+#include "rpi_aes67/pcm_codec.h"
+#include "rpi_aes67/spsc_ring.h"
 #include <thread>
 #include <mutex>
 #include <condition_variable>
@@ -15,12 +18,21 @@
 #include <iomanip>
 #include <cstring>
 #include <random>
+#include <algorithm>
 
 #ifdef __linux__
 #include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/eventfd.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
+#include <linux/net_tstamp.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
 #include <unistd.h>
+#include <cerrno>
 #endif
 
 namespace rpi_aes67 {
@@ -38,6 +50,20 @@ struct RTPHeader {
     uint32_t ssrc;      // Synchronization source
 };
 
+// Packets queued per sendmmsg call (a 1024-frame quantum at 125us ptime is 171)
+constexpr size_t TX_BATCH_SIZE = 256;
+
+// RTP timeline drift from the media clock: within one packet time it is
+// left alone, up to the default receiver link offset each packet drops or
+// repeats one frame until it is gone, beyond that (PTP stepped, capture
+// stalled) re-anchored
+constexpr uint32_t RTP_STEP_MS = 10;
+
+// Paced TX: packets a late TX thread may send back to back before it
+// restarts its schedule, and how far ahead SO_TXTIME launch times are set
+constexpr int64_t TX_MAX_CATCHUP_PACKETS = 4;
+constexpr int64_t TX_TXTIME_LEAD_NS = 500000;
+
 // ==================== AES67Sender::Impl ====================
 
 class AES67Sender::Impl {
@@ -104,6 +130,8 @@ public:
             if (!initialize()) return false;
         }
         
+        prepare_packetizer();
+        
         // Create UDP socket
 #ifdef __linux__
         socket_fd_ = socket(AF_INET, SOCK_DGRAM, 0);
@@ -121,6 +149,9 @@ public:
         dest_addr_.sin_family = AF_INET;
         dest_addr_.sin_port = htons(config_.port);
         inet_pton(AF_INET, config_.multicast_ip.c_str(), &dest_addr_.sin_addr);
+        
+        prepare_tx_thread();
+        prepare_tx_pool();
 #endif
         
         // Start audio source
@@ -130,6 +161,11 @@ public:
         
         // Start transmission thread
         running_ = true;
+#ifdef __linux__
+        if (tx_threaded_) {
+            tx_thread_ = std::thread(&Impl::tx_loop, this);
+        }
+#endif
         state_ = SenderState::Running;
         stats_.start_time = std::chrono::steady_clock::now();
         
@@ -149,6 +185,16 @@ public:
         }
         
 #ifdef __linux__
+        if (tx_thread_.joinable()) {
+            uint64_t one = 1;
+            ssize_t n = ::write(tx_event_fd_, &one, sizeof(one));
+            (void)n;
+            tx_thread_.join();
+        }
+        if (tx_event_fd_ >= 0) {
+            close(tx_event_fd_);
+            tx_event_fd_ = -1;
+        }
         if (socket_fd_ >= 0) {
             close(socket_fd_);
             socket_fd_ = -1;
@@ -199,66 +245,440 @@ public:
     
 private:
     void on_audio_data(const AudioBuffer& buffer) {
-        if (!running_) return;
+        if (!running_ || bytes_per_packet_ == 0) return;
         
-        // Calculate samples per packet based on packet time
-        uint32_t samples_per_packet = (config_.sample_rate * config_.packet_time_us) / 1000000;
-        size_t bytes_per_packet = samples_per_packet * format_.bytes_per_frame();
+        // Only whole frames are packetized
+        const size_t frame_bytes = format_.bytes_per_frame();
+        const uint8_t* data = buffer.data;
+        size_t remaining = buffer.size - buffer.size % frame_bytes;
         
-        // Get RTP timestamp
-        uint32_t rtp_timestamp;
-        if (ptp_sync_ && ptp_sync_->is_synchronized()) {
-            rtp_timestamp = ptp_sync_->get_rtp_timestamp(config_.sample_rate);
-        } else {
-            // Use local timestamp
-            rtp_timestamp = stats_.rtp_timestamp;
+        // The RTP timeline advances by frames sent. It is anchored to the
+        // media clock once; capture clock drift is slewed out so PTP-scheduled
+        // receivers never see a jump larger than their link offset.
+        uint32_t carried_frames = static_cast<uint32_t>(tx_fifo_fill_ / frame_bytes);
+        if (ptp_sync_ && ptp_sync_->has_valid_time()) {
+            uint32_t media_ts = media_clock_.rtp_timestamp(ptp_sync_->get_ptp_timestamp());
+            int32_t drift = static_cast<int32_t>(media_ts - (next_rtp_timestamp_ + carried_frames));
+            int32_t tolerance = static_cast<int32_t>(samples_per_packet_);
+            int32_t max_slew = static_cast<int32_t>(config_.sample_rate * RTP_STEP_MS / 1000);
+            if (!rtp_anchored_ || drift > max_slew || drift < -max_slew) {
+                if (rtp_anchored_) {
+                    LOG_WARNING("Sender {}: RTP timeline {} samples off media clock, re-anchoring",
+                               config_.id, drift);
+                }
+                next_rtp_timestamp_ = media_ts - carried_frames;
+                rtp_slew_ = 0;
+                rtp_anchored_ = true;
+            } else if (rtp_slew_ != 0 || drift > tolerance || drift < -tolerance) {
+                rtp_slew_ = drift;
+            }
+        } else if (!rtp_anchored_) {
+            // Free-running: continue from where the last run stopped
+            next_rtp_timestamp_ = stats_.rtp_timestamp;
+            rtp_anchored_ = true;
         }
         
-        // Send packets
-        const uint8_t* data = buffer.data;
-        size_t remaining = buffer.size;
+#ifdef __linux__
+        const uint64_t first_sequence = stats_.sequence_number;
+#endif
         
-        while (remaining >= bytes_per_packet) {
-            send_rtp_packet(data, bytes_per_packet, rtp_timestamp);
+        // Packetize. Timestamps always advance by the frames in a packet;
+        // a slew is taken out in the samples instead, one frame dropped or
+        // repeated per packet
+        while (remaining > 0) {
+            if (tx_fifo_fill_ == 0) {
+                tx_packet_adjust_ = next_packet_adjust();
+                
+                // Whole packets straight from the capture buffer
+                if (tx_packet_adjust_ == 0 && remaining >= bytes_per_packet_) {
+                    queue_rtp_packet(data, bytes_per_packet_, next_rtp_timestamp_);
+                    next_rtp_timestamp_ += samples_per_packet_;
+                    data += bytes_per_packet_;
+                    remaining -= bytes_per_packet_;
+                    continue;
+                }
+            }
+            
+            // Assemble in the FIFO, carried to the next callback if short.
+            // A repeated frame takes one input frame less, a dropped one more
+            size_t packet_input = tx_packet_adjust_ > 0 ? bytes_per_packet_ - frame_bytes
+                                : tx_packet_adjust_ < 0 ? bytes_per_packet_ + frame_bytes
+                                : bytes_per_packet_;
+            size_t take = std::min(remaining, packet_input - tx_fifo_fill_);
+            memcpy(tx_fifo_.data() + tx_fifo_fill_, data, take);
+            tx_fifo_fill_ += take;
+            data += take;
+            remaining -= take;
             
-            data += bytes_per_packet;
-            remaining -= bytes_per_packet;
-            rtp_timestamp += samples_per_packet;
+            if (tx_fifo_fill_ == packet_input) {
+                if (tx_packet_adjust_ > 0) {
+                    memcpy(tx_fifo_.data() + packet_input, tx_fifo_.data() + packet_input - frame_bytes,
+                           frame_bytes);
+                }
+                queue_rtp_packet(tx_fifo_.data(), bytes_per_packet_, next_rtp_timestamp_);
+                next_rtp_timestamp_ += samples_per_packet_;
+                tx_fifo_fill_ = 0;
+            }
         }
         
-        stats_.rtp_timestamp = rtp_timestamp;
+        // Hand the quantum to the TX thread, or send it all at once
+#ifdef __linux__
+        if (tx_threaded_) {
+            tx_quantum_packets_.store(static_cast<uint32_t>(buffer.size / bytes_per_packet_) + 1,
+                                      std::memory_order_relaxed);
+            if (stats_.sequence_number != first_sequence) {
+                tx_quanta_queued_.fetch_add(1, std::memory_order_relaxed);
+            }
+            signal_tx_thread();
+            stats_.rtp_timestamp = next_rtp_timestamp_;
+            return;
+        }
+#endif
+        if (flush_tx_batch()) {
+            stats_.tx_quanta++;
+            update_syscalls_per_quantum();
+        }
+        stats_.rtp_timestamp = next_rtp_timestamp_;
     }
     
-    void send_rtp_packet(const uint8_t* data, size_t size, uint32_t timestamp) {
-        // Build RTP packet
-        std::vector<uint8_t> packet(sizeof(RTPHeader) + size);
-        
-        RTPHeader* header = reinterpret_cast<RTPHeader*>(packet.data());
-        header->v = 2;
-        header->p = 0;
-        header->x = 0;
-        header->cc = 0;
-        header->m = 0;
-        header->pt = config_.payload_type;
-        header->seq = htons(static_cast<uint16_t>(stats_.sequence_number++));
-        header->ts = htonl(timestamp);
-        header->ssrc = htonl(ssrc_);
+    // On the thread that sends: the audio callback, or the TX thread
+    void update_syscalls_per_quantum() {
+        if (stats_.tx_quanta > 0) {
+            stats_.syscalls_per_quantum = static_cast<double>(stats_.tx_syscalls) /
+                                          static_cast<double>(stats_.tx_quanta);
+        }
+    }
+    
+    // Frame correction for the next packet while a slew is pending: +1
+    // repeats a frame (the timeline is behind the media clock), -1 drops one
+    int32_t next_packet_adjust() {
+        if (rtp_slew_ > 0 && samples_per_packet_ > 1) {
+            rtp_slew_--;
+            return 1;
+        }
+        if (rtp_slew_ < 0) {
+            rtp_slew_++;
+            return -1;
+        }
+        return 0;
+    }
+    
+    // Reset the packetizer for a new run; allocates, so call before audio starts
+    void prepare_packetizer() {
+        samples_per_packet_ = std::max<uint32_t>(
+            SDPGenerator::samples_per_packet(config_.sample_rate, config_.packet_time_us), 1);
+        bytes_per_packet_ = samples_per_packet_ * format_.bytes_per_frame();
+        tx_fifo_.assign(bytes_per_packet_ + format_.bytes_per_frame(), 0);   // Room for a dropped frame
+        tx_fifo_fill_ = 0;
+        tx_packet_adjust_ = 0;
+        rtp_anchored_ = false;
+        rtp_slew_ = 0;
+        media_clock_ = MediaClock(config_.sample_rate);    // a=mediaclk:direct=0
+    }
+    
+#ifdef __linux__
+    // Preallocate headers, payload slots and scatter-gather vectors so the
+    // audio callback never allocates
+    void prepare_tx_pool() {
+        tx_payload_size_ = bytes_per_packet_;
+        
+        RTPHeader header{};
+        header.v = 2;
+        header.pt = config_.payload_type;
+        header.ssrc = htonl(ssrc_);
+        tx_headers_.assign(TX_BATCH_SIZE, header);
+        tx_payloads_.assign(TX_BATCH_SIZE * tx_payload_size_, 0);
+        tx_iovecs_.assign(TX_BATCH_SIZE * 2, iovec{});
+        tx_msgs_.assign(TX_BATCH_SIZE, mmsghdr{});
+        
+        for (size_t i = 0; i < TX_BATCH_SIZE; ++i) {
+            tx_iovecs_[i * 2].iov_base = &tx_headers_[i];
+            tx_iovecs_[i * 2].iov_len = sizeof(RTPHeader);
+            tx_iovecs_[i * 2 + 1].iov_base = tx_payloads_.data() + i * tx_payload_size_;
+            
+            msghdr& msg = tx_msgs_[i].msg_hdr;
+            msg.msg_name = &dest_addr_;
+            msg.msg_namelen = sizeof(dest_addr_);
+            msg.msg_iov = &tx_iovecs_[i * 2];
+            msg.msg_iovlen = 2;
+        }
+        
+        // One SCM_TXTIME launch time per packet
+        tx_control_.assign(txtime_clock_ >= 0 ? TX_BATCH_SIZE * CMSG_SPACE(sizeof(uint64_t)) : 0, 0);
+        for (size_t i = 0; i < TX_BATCH_SIZE && !tx_control_.empty(); ++i) {
+            msghdr& msg = tx_msgs_[i].msg_hdr;
+            msg.msg_control = tx_control_.data() + i * CMSG_SPACE(sizeof(uint64_t));
+            msg.msg_controllen = CMSG_SPACE(sizeof(uint64_t));
+            
+            cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+            cmsg->cmsg_level = SOL_SOCKET;
+#ifdef SCM_TXTIME
+            cmsg->cmsg_type = SCM_TXTIME;
+#endif
+            cmsg->cmsg_len = CMSG_LEN(sizeof(uint64_t));
+        }
+        tx_count_ = 0;
+    }
+    
+    // Set up the ring and wakeup for the paced TX thread; allocates, so call
+    // before audio starts
+    void prepare_tx_thread() {
+        tx_threaded_ = config_.tx_mode == "thread";
+        txtime_clock_ = -1;
+        if (!tx_threaded_) return;
         
-        // Copy audio data
-        std::memcpy(packet.data() + sizeof(RTPHeader), data, size);
+        // Ring records are a prefilled RTP header followed by the encoded payload
+        tx_record_size_ = sizeof(RTPHeader) + bytes_per_packet_;
+        size_t queue_frames = static_cast<size_t>(config_.sample_rate) * config_.tx_queue_ms / 1000;
+        size_t records = std::max<size_t>(queue_frames / samples_per_packet_, 2);
+        tx_ring_.allocate(records * tx_record_size_);
         
-        // Send packet
+        RTPHeader header{};
+        header.v = 2;
+        header.pt = config_.payload_type;
+        header.ssrc = htonl(ssrc_);
+        tx_stage_.assign(tx_record_size_, 0);
+        memcpy(tx_stage_.data(), &header, sizeof(header));
+        tx_quantum_packets_.store(1, std::memory_order_relaxed);
+        
+        if (tx_event_fd_ < 0) {
+            tx_event_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        }
+        
+        if (config_.tx_pacing != "deadline") {
+            clockid_t clock = config_.tx_pacing == "etf" ? CLOCK_TAI : CLOCK_MONOTONIC;
+#ifdef SO_TXTIME
+            sock_txtime txtime{};
+            txtime.clockid = clock;
+            txtime.flags = 0;
+            if (setsockopt(socket_fd_, SOL_SOCKET, SO_TXTIME, &txtime, sizeof(txtime)) == 0) {
+                txtime_clock_ = clock;
+            } else {
+                LOG_WARNING("Sender {}: SO_TXTIME unavailable ({}), pacing in user space",
+                           config_.id, strerror(errno));
+            }
+#else
+            (void)clock;
+            LOG_WARNING("Sender {}: SO_TXTIME not supported by this build, pacing in user space",
+                       config_.id);
+#endif
+        }
+        
+        LOG_INFO("Sender {} TX thread: {} pacing, {} packet queue", config_.id,
+                txtime_clock_ >= 0 ? config_.tx_pacing : std::string("deadline"), records);
+    }
+    
+    /**
+     * Paced transmission. Packets leave one packet time apart on an absolute
+     * CLOCK_MONOTONIC schedule: either the thread sleeps until each deadline
+     * and sends, or (SO_TXTIME) it hands each batch to the fq/etf qdisc with
+     * per-packet launch times. When capture runs faster than the schedule
+     * the interval shortens slightly until the backlog is back to about two
+     * quanta; after an idle gap the schedule restarts.
+     */
+    void tx_loop() {
+        apply_tx_thread_policy();
+        
+        const int64_t packet_ns = static_cast<int64_t>(samples_per_packet_) * 1000000000LL /
+                                  config_.sample_rate;
+        int64_t txtime_offset = 0;
+        if (txtime_clock_ == CLOCK_TAI) {
+            txtime_offset = clock_ns(CLOCK_TAI) - clock_ns(CLOCK_MONOTONIC);
+        }
+        int64_t deadline = 0;
+        
+        while (running_) {
+            size_t queued = tx_ring_.read_available() / tx_record_size_;
+            if (queued == 0) {
+                wait_for_tx_packets(std::chrono::milliseconds(100));
+                continue;
+            }
+            
+            int64_t now = clock_ns(CLOCK_MONOTONIC);
+            int64_t earliest = txtime_clock_ >= 0 ? now + TX_TXTIME_LEAD_NS : now;
+            if (deadline == 0 || earliest - deadline > TX_MAX_CATCHUP_PACKETS * packet_ns) {
+                deadline = earliest;
+            }
+            
+            int64_t backlog = static_cast<int64_t>(queued) + std::max<int64_t>(deadline - now, 0) / packet_ns;
+            int64_t target = 2 * static_cast<int64_t>(tx_quantum_packets_.load(std::memory_order_relaxed));
+            int64_t interval = backlog > target ? packet_ns - packet_ns / 64 : packet_ns;
+            
+            if (txtime_clock_ < 0) {
+                if (deadline > now) {
+                    sleep_until_ns(deadline);
+                    if (!running_) break;
+                }
+                read_tx_record(0);
+                tx_count_ = 1;
+                
+                double error_us = static_cast<double>(clock_ns(CLOCK_MONOTONIC) - deadline) / 1000.0;
+                stats_.tx_pacing_error_us += (error_us - stats_.tx_pacing_error_us) / 16.0;
+                stats_.tx_pacing_error_max_us = std::max(stats_.tx_pacing_error_max_us, error_us);
+                
+                flush_tx_batch();
+                deadline += interval;
+            } else {
+                size_t count = std::min(queued, TX_BATCH_SIZE);
+                for (size_t i = 0; i < count; ++i) {
+                    read_tx_record(i);
+                    uint64_t launch = static_cast<uint64_t>(deadline + txtime_offset);
+                    memcpy(CMSG_DATA(CMSG_FIRSTHDR(&tx_msgs_[i].msg_hdr)), &launch, sizeof(launch));
+                    deadline += interval;
+                }
+                tx_count_ = count;
+                flush_tx_batch();
+            }
+            
+            // Quanta are counted here, where their system calls are
+            stats_.tx_quanta += tx_quanta_queued_.exchange(0, std::memory_order_relaxed);
+            update_syscalls_per_quantum();
+        }
+    }
+    
+    // Copy the next ring record into pool slot @p slot
+    void read_tx_record(size_t slot) {
+        tx_ring_.read(reinterpret_cast<uint8_t*>(&tx_headers_[slot]), sizeof(RTPHeader));
+        iovec& payload = tx_iovecs_[slot * 2 + 1];
+        payload.iov_len = tx_ring_.read(static_cast<uint8_t*>(payload.iov_base), bytes_per_packet_);
+    }
+    
+    // Block the TX thread until the audio callback queues packets
+    void wait_for_tx_packets(std::chrono::milliseconds timeout) {
+        tx_waiting_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (tx_ring_.read_available() == 0 && running_) {
+            pollfd pfd{};
+            pfd.fd = tx_event_fd_;
+            pfd.events = POLLIN;
+            if (::poll(&pfd, 1, static_cast<int>(timeout.count())) > 0) {
+                uint64_t value;
+                ssize_t n = ::read(tx_event_fd_, &value, sizeof(value));
+                (void)n;
+            }
+        }
+        tx_waiting_.store(false, std::memory_order_relaxed);
+    }
+    
+    // Wake the TX thread; only costs a system call while it is waiting
+    void signal_tx_thread() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (tx_waiting_.load(std::memory_order_relaxed) &&
+            tx_waiting_.exchange(false, std::memory_order_relaxed)) {
+            uint64_t one = 1;
+            ssize_t n = ::write(tx_event_fd_, &one, sizeof(one));
+            (void)n;
+        }
+    }
+    
+    void apply_tx_thread_policy() {
+        if (config_.tx_cpu >= 0) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(config_.tx_cpu, &cpus);
+            if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) != 0) {
+                LOG_WARNING("Sender {}: failed to pin TX thread to CPU {}", config_.id, config_.tx_cpu);
+            }
+        }
+        if (config_.tx_priority > 0) {
+            sched_param param{};
+            param.sched_priority = config_.tx_priority;
+            if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0) {
+                LOG_WARNING("Sender {}: SCHED_FIFO priority {} not permitted (needs CAP_SYS_NICE or rtprio limit)",
+                           config_.id, config_.tx_priority);
+            }
+        }
+    }
+    
+    static int64_t clock_ns(clockid_t clock) {
+        timespec ts{};
+        clock_gettime(clock, &ts);
+        return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+    }
+    
+    static void sleep_until_ns(int64_t deadline) {
+        timespec ts{};
+        ts.tv_sec = static_cast<time_t>(deadline / 1000000000LL);
+        ts.tv_nsec = static_cast<long>(deadline % 1000000000LL);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+        }
+    }
+#endif
+    
+    void queue_rtp_packet(const uint8_t* data, size_t size, uint32_t timestamp) {
 #ifdef __linux__
-        if (socket_fd_ >= 0) {
-            ssize_t sent = sendto(socket_fd_, packet.data(), packet.size(), 0,
-                                  reinterpret_cast<sockaddr*>(&dest_addr_),
-                                  sizeof(dest_addr_));
-            if (sent > 0) {
-                stats_.packets_sent++;
-                stats_.bytes_sent += sent;
-                stats_.last_packet_time = std::chrono::steady_clock::now();
+        if (tx_threaded_) {
+            enqueue_tx_record(data, size, timestamp);
+            return;
+        }
+        
+        if (tx_count_ == tx_msgs_.size() && !flush_tx_batch()) return;
+        if (tx_msgs_.empty() || size > tx_payload_size_) return;
+        
+        RTPHeader& header = tx_headers_[tx_count_];
+        header.seq = htons(static_cast<uint16_t>(stats_.sequence_number++));
+        header.ts = htonl(timestamp);
+        
+        // Host S16/S24/S32 LE samples to network byte order L16/L24/L32,
+        // straight into the payload slot
+        iovec& payload = tx_iovecs_[tx_count_ * 2 + 1];
+        PCMCodec::encode(data, PCMCodec::format_for(format_.bit_depth),
+                         static_cast<uint8_t*>(payload.iov_base), PCMCodec::encoding_for(format_.bit_depth),
+                         size / std::max<uint32_t>(format_.bytes_per_sample(), 1));
+        payload.iov_len = size;
+        ++tx_count_;
+#else
+        (void)data;
+        (void)size;
+        (void)timestamp;
+#endif
+    }
+
+#ifdef __linux__
+    // Encode one packet into the TX ring (audio callback side)
+    void enqueue_tx_record(const uint8_t* data, size_t size, uint32_t timestamp) {
+        if (size != bytes_per_packet_ || tx_ring_.write_available() < tx_record_size_) {
+            stats_.tx_dropped++;
+            stats_.sequence_number++;
+            return;
+        }
+        
+        RTPHeader* header = reinterpret_cast<RTPHeader*>(tx_stage_.data());
+        header->seq = htons(static_cast<uint16_t>(stats_.sequence_number++));
+        header->ts = htonl(timestamp);
+        PCMCodec::encode(data, PCMCodec::format_for(format_.bit_depth),
+                         tx_stage_.data() + sizeof(RTPHeader), PCMCodec::encoding_for(format_.bit_depth),
+                         size / std::max<uint32_t>(format_.bytes_per_sample(), 1));
+        tx_ring_.write(tx_stage_.data(), tx_record_size_);
+    }
+#endif
+    
+    // Send all queued packets; returns false if nothing was queued
+    bool flush_tx_batch() {
+#ifdef __linux__
+        if (tx_count_ == 0) return false;
+        
+        size_t offset = 0;
+        while (offset < tx_count_ && socket_fd_ >= 0) {
+            int sent = sendmmsg(socket_fd_, tx_msgs_.data() + offset,
+                                static_cast<unsigned int>(tx_count_ - offset), 0);
+            stats_.tx_syscalls++;
+            if (sent <= 0) break;
+            
+            for (int i = 0; i < sent; ++i) {
+                stats_.bytes_sent += tx_msgs_[offset + i].msg_len;
             }
+            stats_.packets_sent += sent;
+            offset += sent;
         }
+        
+        if (offset > 0) {
+            stats_.last_packet_time = std::chrono::steady_clock::now();
+        }
+        tx_count_ = 0;
+        return true;
+#else
+        return false;
 #endif
     }
     
@@ -281,9 +701,41 @@ private:
     uint64_t session_id_ = 0;
     std::string origin_address_ = "0.0.0.0";
     
+    // Packetizer: packet size and the partial packet carried between callbacks
+    uint32_t samples_per_packet_ = 0;
+    size_t bytes_per_packet_ = 0;
+    std::vector<uint8_t> tx_fifo_;
+    size_t tx_fifo_fill_ = 0;
+    int32_t tx_packet_adjust_ = 0;      // Frame repeated (+1) or dropped (-1) in the FIFO packet
+    uint32_t next_rtp_timestamp_ = 0;   // RTP timestamp of the first carried frame
+    bool rtp_anchored_ = false;
+    int32_t rtp_slew_ = 0;              // Frames still to drop or repeat toward the media clock
+    MediaClock media_clock_;
+
 #ifdef __linux__
     int socket_fd_ = -1;
     sockaddr_in dest_addr_{};
+    
+    // Transmit pool: header and payload slot per packet, two iovecs each
+    std::vector<RTPHeader> tx_headers_;
+    std::vector<uint8_t> tx_payloads_;
+    std::vector<iovec> tx_iovecs_;
+    std::vector<mmsghdr> tx_msgs_;
+    std::vector<uint8_t> tx_control_;
+    size_t tx_payload_size_ = 0;
+    size_t tx_count_ = 0;
+    
+    // Paced TX thread, fed by the audio callback through tx_ring_
+    bool tx_threaded_ = false;
+    SPSCRing<uint8_t> tx_ring_;
+    std::vector<uint8_t> tx_stage_;
+    size_t tx_record_size_ = 0;
+    std::atomic<uint32_t> tx_quantum_packets_{1};
+    std::atomic<uint64_t> tx_quanta_queued_{0};     // Quanta queued since the TX thread last counted
+    std::thread tx_thread_;
+    int tx_event_fd_ = -1;
+    int txtime_clock_ = -1;             // SO_TXTIME clock, -1 when pacing in user space
+    alignas(64) std::atomic<bool> tx_waiting_{false};
 #endif
     
     SenderStatistics stats_{};
@@ -326,6 +778,12 @@ void AES67Sender::recover() { impl_->recover(); }
 
 // ==================== SDPGenerator ====================
 
+uint32_t SDPGenerator::samples_per_packet(uint32_t sample_rate, uint32_t packet_time_us) {
+    // Round to the nearest frame: 333us at 48kHz is 16 frames, not 15
+    return static_cast<uint32_t>(
+        (static_cast<uint64_t>(sample_rate) * packet_time_us + 500000) / 1000000);
+}
+
 std::string SDPGenerator::generate(
     const SenderConfig& config,
     uint64_t session_id,
@@ -337,7 +795,7 @@ std::string SDPGenerator::generate(
     format.bit_depth = config.bit_depth;
     
     return generate(config.multicast_ip, config.port, config.payload_type,
-                   format, config.label, session_id, origin_address);
+                   format, config.label, session_id, origin_address, config.packet_time_us);
 }
 
 std::string SDPGenerator::generate(
@@ -347,7 +805,8 @@ std::string SDPGenerator::generate(
     const AudioFormat& format,
     const std::string& session_name,
     uint64_t session_id,
-    const std::string& origin_address) {
+    const std::string& origin_address,
+    uint32_t packet_time_us) {
     
     std::ostringstream sdp;
     
@@ -379,8 +838,17 @@ std::string SDPGenerator::generate(
         << format.encoding_name() << "/" << format.sample_rate 
         << "/" << static_cast<int>(format.channels) << "\r\n";
     
-    // a=ptime (AES67 requires 1ms packet time)
-    sdp << "a=ptime:1\r\n";
+    // a=ptime in milliseconds (1 is mandatory for AES67; 0.125, 0.25, 0.333, 4 optional)
+    sdp << "a=ptime:" << packet_time_us / 1000;
+    if (packet_time_us % 1000 != 0) {
+        std::string fraction = std::to_string(1000 + packet_time_us % 1000).substr(1);
+        fraction.erase(fraction.find_last_not_of('0') + 1);
+        sdp << "." << fraction;
+    }
+    sdp << "\r\n";
+    
+    // a=framecount (frames per packet)
+    sdp << "a=framecount:" << samples_per_packet(format.sample_rate, packet_time_us) << "\r\n";
     
     // a=ts-refclk (PTP clock reference for AES67)
     sdp << "a=ts-refclk:ptp=IEEE1588-2008\r\n";
@@ -0,0 +1,429 @@
+// SPDX-License-Identifier: MIT
+/*
+ * RPi-AES67 - Professional AES67 Sender/Receiver for Raspberry Pi 5
+ * Copyright (c) 2025 DHPKE
+ *
+ * io_uring receive ring implementation (raw kernel interface, no liburing).
+ */
+
+#include "rpi_aes67/uring_receive_ring.h"
+#include "rpi_aes67/logger.h"
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+
+#ifdef HAVE_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace rpi_aes67 {
+
+#ifdef HAVE_IO_URING
+namespace {
+
+constexpr uint16_t BUFFER_GROUP = 0;
+constexpr uint64_t RECV_USER_DATA = 1;
+constexpr uint32_t SQ_ENTRIES = 4;
+
+int io_uring_setup(uint32_t entries, io_uring_params* params) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int io_uring_enter(int fd, uint32_t to_submit, uint32_t min_complete, uint32_t flags,
+                   const void* arg, size_t arg_size) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, arg, arg_size));
+}
+
+int io_uring_register(int fd, uint32_t opcode, const void* arg, uint32_t nr_args) {
+    return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+template <typename T>
+T* ring_field(void* base, uint32_t offset) {
+    return reinterpret_cast<T*>(static_cast<uint8_t*>(base) + offset);
+}
+
+}  // namespace
+#endif
+
+class UringReceiveRing::Impl {
+public:
+    Impl() = default;
+    
+    ~Impl() {
+        close();
+    }
+    
+    bool open(int socket_fd, const UringReceiveConfig& config, PacketHandler handler) {
+#ifdef HAVE_IO_URING
+        close();
+        
+        uint32_t buffers = std::clamp<uint32_t>(config.buffers, 2, 32768);
+        if ((buffers & (buffers - 1)) != 0) {
+            LOG_ERROR("io_uring receive: buffer count {} is not a power of two", buffers);
+            return false;
+        }
+        socket_fd_ = socket_fd;
+        handler_ = std::move(handler);
+        buffer_count_ = buffers;
+        buffer_size_ = config.buffer_size;
+        stats_ = {};
+        received_ = false;
+        
+        // Only the kernel receive timestamp is requested as control data
+        msg_ = {};
+        msg_.msg_controllen = CMSG_SPACE(sizeof(timespec));
+        if (buffer_size_ < sizeof(io_uring_recvmsg_out) + msg_.msg_controllen + 64) {
+            LOG_ERROR("io_uring receive: buffer size {} too small", buffer_size_);
+            return false;
+        }
+        
+        if (!setup_ring() || !setup_buffers() || !arm()) {
+            close();
+            return false;
+        }
+        return true;
+#else
+        (void)socket_fd;
+        (void)config;
+        (void)handler;
+        return false;
+#endif
+    }
+    
+    void close() {
+#ifdef HAVE_IO_URING
+        if (ring_fd_ >= 0 && armed_) {
+            // Wait out the receive before the buffers go away
+            io_uring_sync_cancel_reg cancel{};
+            cancel.addr = RECV_USER_DATA;
+            cancel.timeout.tv_sec = -1;
+            cancel.timeout.tv_nsec = -1;
+            io_uring_register(ring_fd_, IORING_REGISTER_SYNC_CANCEL, &cancel, 1);
+        }
+        armed_ = false;
+        
+        if (ring_fd_ >= 0) {
+            ::close(ring_fd_);
+            ring_fd_ = -1;
+        }
+        if (sqes_ != nullptr) {
+            munmap(sqes_, sqes_size_);
+            sqes_ = nullptr;
+        }
+        if (cq_ptr_ != nullptr && cq_ptr_ != sq_ptr_) {
+            munmap(cq_ptr_, cq_size_);
+        }
+        cq_ptr_ = nullptr;
+        if (sq_ptr_ != nullptr) {
+            munmap(sq_ptr_, sq_size_);
+            sq_ptr_ = nullptr;
+        }
+        if (buf_ring_ != nullptr) {
+            munmap(buf_ring_, buf_ring_size_);
+            buf_ring_ = nullptr;
+        }
+        if (buffers_ != nullptr) {
+            munmap(buffers_, buffers_size_);
+            buffers_ = nullptr;
+        }
+        handler_ = nullptr;
+#endif
+    }
+    
+    int fd() const { return ring_fd_; }
+    
+    int process(int timeout_ms) {
+#ifdef HAVE_IO_URING
+        if (ring_fd_ < 0) return -1;
+        
+        uint32_t head = *cq_head_;
+        uint32_t tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+        if (head == tail && timeout_ms > 0) {
+            wait(timeout_ms);
+            tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+        }
+        
+        int packets = 0;
+        uint32_t recycled = 0;
+        bool rearm = false;
+        bool failed = false;
+        for (; head != tail; ++head) {
+            const io_uring_cqe& cqe = cqes_[head & cq_mask_];
+            stats_.completions++;
+            
+            // Without F_MORE the multishot request has ended
+            if ((cqe.flags & IORING_CQE_F_MORE) == 0) {
+                rearm = true;
+            }
+            if (cqe.res < 0) {
+                if (cqe.res == -ENOBUFS) {
+                    stats_.no_buffers++;
+                } else if (!received_) {
+                    // Multishot recvmsg unsupported (pre-6.0 kernels: EINVAL)
+                    LOG_WARNING("io_uring receive failed: {}", strerror(-cqe.res));
+                    failed = true;
+                }
+                continue;
+            }
+            if ((cqe.flags & IORING_CQE_F_BUFFER) == 0) continue;
+            
+            uint16_t bid = static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+            const uint8_t* buffer = buffers_ + static_cast<size_t>(bid) * buffer_size_;
+            const auto* out = reinterpret_cast<const io_uring_recvmsg_out*>(buffer);
+            if (out->flags & MSG_TRUNC) {
+                stats_.truncated++;
+            } else {
+                const uint8_t* control = buffer + sizeof(io_uring_recvmsg_out) + msg_.msg_namelen;
+                const uint8_t* payload = control + msg_.msg_controllen;
+                timespec kernel_ts{};
+                bool have_ts = (out->flags & MSG_CTRUNC) == 0 &&
+                               read_timestamp(control, out->controllen, kernel_ts);
+                handler_(payload, out->payloadlen, have_ts ? &kernel_ts : nullptr);
+                received_ = true;
+                stats_.packets++;
+                packets++;
+            }
+            add_buffer(bid, recycled++);
+        }
+        __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+        
+        if (recycled > 0) {
+            buf_tail_ = static_cast<uint16_t>(buf_tail_ + recycled);
+            __atomic_store_n(&buf_ring_->tail, buf_tail_, __ATOMIC_RELEASE);
+        }
+        if (failed) return -1;
+        if (rearm) {
+            armed_ = false;
+            stats_.rearms++;
+            if (!arm()) return -1;
+        }
+        return packets;
+#else
+        (void)timeout_ms;
+        return -1;
+#endif
+    }
+    
+    UringReceiveStats get_stats() const { return stats_; }
+
+private:
+#ifdef HAVE_IO_URING
+    bool setup_ring() {
+        io_uring_params params{};
+        params.flags = IORING_SETUP_CQSIZE;
+        // Every datagram completion holds a buffer, so the CQ never needs
+        // more than the buffers plus a few error completions
+        params.cq_entries = buffer_count_ * 2;
+        ring_fd_ = io_uring_setup(SQ_ENTRIES, &params);
+        if (ring_fd_ < 0) {
+            LOG_WARNING("io_uring unavailable: {}", strerror(errno));
+            return false;
+        }
+        
+        sq_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+        cq_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_mmap) {
+            sq_size_ = cq_size_ = std::max(sq_size_, cq_size_);
+        }
+        sq_ptr_ = map_ring(sq_size_, IORING_OFF_SQ_RING);
+        cq_ptr_ = single_mmap ? sq_ptr_ : map_ring(cq_size_, IORING_OFF_CQ_RING);
+        sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = static_cast<io_uring_sqe*>(map_ring(sqes_size_, IORING_OFF_SQES));
+        if (sq_ptr_ == nullptr || cq_ptr_ == nullptr || sqes_ == nullptr) {
+            LOG_ERROR("io_uring receive: failed to map the rings: {}", strerror(errno));
+            return false;
+        }
+        
+        sq_tail_ = ring_field<uint32_t>(sq_ptr_, params.sq_off.tail);
+        sq_mask_ = *ring_field<uint32_t>(sq_ptr_, params.sq_off.ring_mask);
+        sq_array_ = ring_field<uint32_t>(sq_ptr_, params.sq_off.array);
+        cq_head_ = ring_field<uint32_t>(cq_ptr_, params.cq_off.head);
+        cq_tail_ = ring_field<uint32_t>(cq_ptr_, params.cq_off.tail);
+        cq_mask_ = *ring_field<uint32_t>(cq_ptr_, params.cq_off.ring_mask);
+        cqes_ = ring_field<io_uring_cqe>(cq_ptr_, params.cq_off.cqes);
+        ext_arg_ = (params.features & IORING_FEAT_EXT_ARG) != 0;
+        return true;
+    }
+    
+    void* map_ring(size_t size, uint64_t offset) {
+        void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         ring_fd_, static_cast<off_t>(offset));
+        return ptr == MAP_FAILED ? nullptr : ptr;
+    }
+    
+    bool setup_buffers() {
+        // Page-aligned ring of buffer descriptors, shared with the kernel
+        buf_ring_size_ = buffer_count_ * sizeof(io_uring_buf);
+        void* ring = mmap(nullptr, buf_ring_size_, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        buffers_size_ = static_cast<size_t>(buffer_count_) * buffer_size_;
+        void* memory = mmap(nullptr, buffers_size_, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+        buf_ring_ = ring == MAP_FAILED ? nullptr : static_cast<io_uring_buf_ring*>(ring);
+        buffers_ = memory == MAP_FAILED ? nullptr : static_cast<uint8_t*>(memory);
+        if (buf_ring_ == nullptr || buffers_ == nullptr) {
+            LOG_ERROR("io_uring receive: failed to allocate buffers: {}", strerror(errno));
+            return false;
+        }
+        
+        io_uring_buf_reg reg{};
+        reg.ring_addr = reinterpret_cast<uint64_t>(buf_ring_);
+        reg.ring_entries = buffer_count_;
+        reg.bgid = BUFFER_GROUP;
+        if (io_uring_register(ring_fd_, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+            LOG_WARNING("io_uring provided-buffer rings unsupported: {}", strerror(errno));
+            return false;
+        }
+        
+        buf_tail_ = 0;
+        for (uint32_t i = 0; i < buffer_count_; ++i) {
+            add_buffer(static_cast<uint16_t>(i), i);
+        }
+        buf_tail_ = static_cast<uint16_t>(buffer_count_);
+        __atomic_store_n(&buf_ring_->tail, buf_tail_, __ATOMIC_RELEASE);
+        return true;
+    }
+    
+    // Stage buffer bid at tail + offset; published by the caller
+    void add_buffer(uint16_t bid, uint32_t offset) {
+        // Indexed by hand: in C++ the UAPI flexible array sits after an
+        // empty struct member, 8 bytes past where the kernel expects it
+        io_uring_buf& buf = reinterpret_cast<io_uring_buf*>(buf_ring_)[(buf_tail_ + offset) & (buffer_count_ - 1)];
+        buf.addr = reinterpret_cast<uint64_t>(buffers_ + static_cast<size_t>(bid) * buffer_size_);
+        buf.len = buffer_size_;
+        buf.bid = bid;
+    }
+    
+    // Submit the multishot recvmsg
+    bool arm() {
+        uint32_t tail = *sq_tail_;
+        uint32_t index = tail & sq_mask_;
+        io_uring_sqe& sqe = sqes_[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_RECVMSG;
+        sqe.fd = socket_fd_;
+        sqe.addr = reinterpret_cast<uint64_t>(&msg_);
+        sqe.len = 0;                    // No cap on the selected buffer's length
+        sqe.flags = IOSQE_BUFFER_SELECT;
+        sqe.ioprio = IORING_RECV_MULTISHOT;
+        sqe.buf_group = BUFFER_GROUP;
+        sqe.user_data = RECV_USER_DATA;
+        sq_array_[index] = index;
+        __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+        
+        int ret = io_uring_enter(ring_fd_, 1, 0, 0, nullptr, 0);
+        stats_.syscalls++;
+        if (ret != 1) {
+            LOG_WARNING("io_uring receive: submit failed: {}", strerror(ret < 0 ? errno : EAGAIN));
+            return false;
+        }
+        armed_ = true;
+        return true;
+    }
+    
+    // Block until a completion is posted or the timeout expires
+    void wait(int timeout_ms) {
+        if (ext_arg_) {
+            __kernel_timespec ts{};
+            ts.tv_sec = timeout_ms / 1000;
+            ts.tv_nsec = static_cast<long long>(timeout_ms % 1000) * 1000000;
+            io_uring_getevents_arg arg{};
+            arg.ts = reinterpret_cast<uint64_t>(&ts);
+            io_uring_enter(ring_fd_, 0, 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+        } else {
+            pollfd pfd{};
+            pfd.fd = ring_fd_;
+            pfd.events = POLLIN;
+            poll(&pfd, 1, timeout_ms);
+        }
+        stats_.syscalls++;
+    }
+    
+    static bool read_timestamp(const uint8_t* control, uint32_t length, timespec& ts) {
+        msghdr msg{};
+        msg.msg_control = const_cast<uint8_t*>(control);
+        msg.msg_controllen = length;
+        for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+            if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+                std::memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    msghdr msg_{};                      // Template read by every multishot completion
+    
+    void* sq_ptr_ = nullptr;
+    void* cq_ptr_ = nullptr;
+    size_t sq_size_ = 0;
+    size_t cq_size_ = 0;
+    io_uring_sqe* sqes_ = nullptr;
+    size_t sqes_size_ = 0;
+    uint32_t* sq_tail_ = nullptr;
+    uint32_t* sq_array_ = nullptr;
+    uint32_t sq_mask_ = 0;
+    uint32_t* cq_head_ = nullptr;
+    uint32_t* cq_tail_ = nullptr;
+    uint32_t cq_mask_ = 0;
+    io_uring_cqe* cqes_ = nullptr;
+    bool ext_arg_ = false;
+    
+    io_uring_buf_ring* buf_ring_ = nullptr;
+    size_t buf_ring_size_ = 0;
+    uint8_t* buffers_ = nullptr;
+    size_t buffers_size_ = 0;
+    uint16_t buf_tail_ = 0;
+#endif
+    
+    int ring_fd_ = -1;
+    int socket_fd_ = -1;
+    bool armed_ = false;
+    bool received_ = false;
+    uint32_t buffer_count_ = 0;
+    uint32_t buffer_size_ = 0;
+    PacketHandler handler_;
+    UringReceiveStats stats_{};
+};
+
+// UringReceiveRing public interface
+
+UringReceiveRing::UringReceiveRing() : impl_(std::make_unique<Impl>()) {}
+UringReceiveRing::~UringReceiveRing() = default;
+
+bool UringReceiveRing::is_available() {
+#ifdef HAVE_IO_URING
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool UringReceiveRing::open(int socket_fd, const UringReceiveConfig& config, PacketHandler handler) {
+    return impl_->open(socket_fd, config, std::move(handler));
+}
+
+void UringReceiveRing::close() {
+    impl_->close();
+}
+
+int UringReceiveRing::fd() const {
+    return impl_->fd();
+}
+
+int UringReceiveRing::process(int timeout_ms) {
+    return impl_->process(timeout_ms);
+}
+
+UringReceiveStats UringReceiveRing::get_stats() const {
+    return impl_->get_stats();
+}
+
+}  // namespace rpi_aes67